@@ -0,0 +1,2431 @@
+//
+// Created by cedri on 2023-12-03.
+//
+
+#include "Test_t_circuit.h"
+
+//Construit le circuit d'exemple de circuit_logique.c: S0 = NOT(E0 | E1) ^ (E1 & E2)
+static t_circuit *construire_circuit_exemple(void)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_porte *porte_ou = t_circuit_ajouter_porte(circuit, PORTE_OU);
+    t_porte *porte_et = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte *porte_not = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte *porte_xor = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+    t_entree *entree0 = t_circuit_ajouter_entree(circuit);
+    t_entree *entree1 = t_circuit_ajouter_entree(circuit);
+    t_entree *entree2 = t_circuit_ajouter_entree(circuit);
+    t_sortie *sortie0 = t_circuit_ajouter_sortie(circuit);
+
+    t_porte_relier(porte_ou, 0, t_entree_get_pin(entree0));
+    t_porte_relier(porte_ou, 1, t_entree_get_pin(entree1));
+    t_porte_relier(porte_et, 0, t_entree_get_pin(entree1));
+    t_porte_relier(porte_et, 1, t_entree_get_pin(entree2));
+    t_porte_relier(porte_not, 0, t_porte_get_pin_sortie(porte_ou));
+    t_porte_relier(porte_xor, 0, t_porte_get_pin_sortie(porte_not));
+    t_porte_relier(porte_xor, 1, t_porte_get_pin_sortie(porte_et));
+    t_sortie_relier(sortie0, t_porte_get_pin_sortie(porte_xor));
+
+    return circuit;
+}
+
+
+void test_t_circuit_ordonner(void)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_entree *entree0 = t_circuit_ajouter_entree(circuit);
+    t_sortie *sortie0 = t_circuit_ajouter_sortie(circuit);
+
+    //Les portes sont ajoutées dans l'ordre inverse de leur évaluation
+    t_porte *porte_fin = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte *porte_milieu = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte *porte_debut = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_circuit *autre;
+    t_netlist *netlist;
+    unsigned long revision;
+    int signal[1] = {1};
+
+    t_porte_relier(porte_debut, 0, t_entree_get_pin(entree0));
+    t_porte_relier(porte_milieu, 0, t_porte_get_pin_sortie(porte_debut));
+    t_porte_relier(porte_fin, 0, t_porte_get_pin_sortie(porte_milieu));
+    t_sortie_relier(sortie0, t_porte_get_pin_sortie(porte_fin));
+
+    if(t_circuit_ordonner(circuit) && circuit->nb_niveaux == 3 && circuit->ordre[0] == porte_debut
+       && circuit->ordre[2] == porte_fin)
+    {
+        printf("Test t_circuit_ordonner reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_circuit_ordonner (niveaux: %d)\n", circuit->nb_niveaux);
+    }
+
+    t_circuit_reset(circuit);
+    t_circuit_appliquer_signal(circuit, signal, 1);
+
+    if(t_circuit_propager_signal(circuit) && t_sortie_get_valeur(sortie0) == 0)
+    {
+        printf("Test propagation ordonnee reussi\n");
+    }
+    else
+    {
+        printf("Echec de la propagation (Attendue: 0, Actuelle: %d)\n", t_sortie_get_valeur(sortie0));
+    }
+
+    //Le nouveau lien doit invalider l'ordre calculé: la porte du début est retirée de la chaîne
+    t_porte_relier(porte_milieu, 0, t_entree_get_pin(entree0));
+    t_sortie_relier(sortie0, t_porte_get_pin_sortie(porte_fin));
+
+    if(t_circuit_ordonner(circuit) && circuit->nb_niveaux == 2)
+    {
+        printf("Test invalidation de l'ordre reussi\n");
+    }
+    else
+    {
+        printf("Echec du test d'invalidation (niveaux: %d)\n", circuit->nb_niveaux);
+    }
+
+    //Les liens d'un autre circuit ne touchent pas la révision de celui-ci: sa netlist est gardée
+    netlist = t_circuit_get_netlist(circuit);
+    revision = circuit->revision_liens;
+    autre = construire_circuit_exemple();
+    t_circuit_ordonner(autre);
+
+    if(netlist != NULL && t_circuit_get_netlist(circuit) == netlist && circuit->revision_liens == revision
+       && circuit->ordre_a_jour)
+    {
+        printf("Test revision par circuit reussi\n");
+    }
+    else
+    {
+        printf("Echec du test revision par circuit\n");
+    }
+
+    t_circuit_destroy(autre);
+    t_circuit_destroy(circuit);
+}
+
+void test_t_circuit_boucle(void)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_entree *entree0 = t_circuit_ajouter_entree(circuit);
+    t_sortie *sortie0 = t_circuit_ajouter_sortie(circuit);
+    t_porte *porte_et = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte *porte_not = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte *porte_aval = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte *boucle[3];
+    t_circuit *chaine = t_circuit_init();
+    t_circuit *englobant = t_circuit_init();
+    t_porte *tampon = t_circuit_ajouter_porte(englobant, PORTE_BUF);
+    t_instance *instance;
+    t_porte *boucle_tampon[1];
+    t_instance *boucle_instances[1];
+    t_pin_sortie *source;
+    int nb_boucle;
+    int nb_instances;
+
+    //P0 et P1 forment une boucle, P2 est seulement en aval
+    t_porte_relier(porte_et, 0, t_entree_get_pin(entree0));
+    t_porte_relier(porte_et, 1, t_porte_get_pin_sortie(porte_not));
+    t_porte_relier(porte_not, 0, t_porte_get_pin_sortie(porte_et));
+    t_porte_relier(porte_aval, 0, t_porte_get_pin_sortie(porte_et));
+    t_sortie_relier(sortie0, t_porte_get_pin_sortie(porte_aval));
+
+    nb_boucle = t_circuit_get_portes_boucle(circuit, boucle);
+
+    if(t_circuit_ordonner(circuit) == 0 && nb_boucle == 2)
+    {
+        printf("Test boucle reussi: %s, %s\n", boucle[0]->nom, boucle[1]->nom);
+    }
+    else
+    {
+        printf("Echec du test boucle (%d portes en boucle)\n", nb_boucle);
+    }
+
+    //Boucle à travers une instance de 8 portes NOT: seule la porte du circuit englobant est
+    //retournée (le tableau n'a que englobant->nb_portes éléments), l'instance est signalée à part
+    source = t_entree_get_pin(t_circuit_ajouter_entree(chaine));
+
+    for(int i = 0;i<8;i++)
+    {
+        t_porte *porte = t_circuit_ajouter_porte(chaine, PORTE_NOT);
+
+        t_porte_relier(porte, 0, source);
+        source = t_porte_get_pin_sortie(porte);
+    }
+
+    t_sortie_relier(t_circuit_ajouter_sortie(chaine), source);
+    instance = t_circuit_ajouter_instance(englobant, chaine);
+    t_instance_relier(instance, 0, t_porte_get_pin_sortie(tampon));
+    t_porte_relier(tampon, 0, t_instance_get_pin_sortie(instance, 0));
+    t_sortie_relier(t_circuit_ajouter_sortie(englobant), t_porte_get_pin_sortie(tampon));
+
+    nb_boucle = t_circuit_get_portes_boucle(englobant, boucle_tampon);
+    nb_instances = t_circuit_get_instances_boucle(englobant, boucle_instances);
+
+    if(t_circuit_ordonner(englobant) == 0 && nb_boucle == 1 && boucle_tampon[0] == tampon
+       && nb_instances == 1 && boucle_instances[0] == instance)
+    {
+        printf("Test boucle a travers une instance reussi\n");
+    }
+    else
+    {
+        printf("Echec du test boucle a travers une instance (%d portes, %d instances)\n", nb_boucle, nb_instances);
+    }
+
+    t_circuit_destroy(englobant);
+    t_circuit_destroy(chaine);
+    t_circuit_destroy(circuit);
+}
+
+void test_t_circuit_simuler_lot(void)
+{
+    t_circuit *circuit = construire_circuit_exemple();
+    uint64_t entrees[3] = {0, 0, 0};
+    uint64_t sortie = 0;
+    int signal[3];
+    int erreurs = 0;
+
+    //Les 8 vecteurs possibles: le bit k de l'entrée i est le bit i du vecteur k
+    for(int k = 0;k<8;k++)
+    {
+        for(int i = 0;i<3;i++)
+        {
+            entrees[i] |= (uint64_t)((k >> i) & 1) << k;
+        }
+    }
+
+    if(t_circuit_simuler_lot(circuit, entrees, &sortie, 1) == 0)
+    {
+        printf("Echec du test t_circuit_simuler_lot: simulation impossible\n");
+    }
+
+    for(int k = 0;k<8;k++)
+    {
+        for(int i = 0;i<3;i++)
+        {
+            signal[i] = (k >> i) & 1;
+        }
+
+        t_circuit_reset(circuit);
+        t_circuit_appliquer_signal(circuit, signal, 3);
+        t_circuit_propager_signal(circuit);
+
+        if(t_sortie_get_valeur(circuit->sorties[0]) != (int)((sortie >> k) & 1))
+        {
+            erreurs++;
+        }
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test t_circuit_simuler_lot reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_circuit_simuler_lot (%d vecteurs differents)\n", erreurs);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+void test_t_netlist_simuler(void)
+{
+    t_circuit *circuit = construire_circuit_exemple();
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    int signal[3];
+    int resultat[1];
+    int erreurs = 0;
+
+    if(netlist == NULL)
+    {
+        printf("Echec du test t_netlist_simuler: compilation impossible\n");
+        t_circuit_destroy(circuit);
+
+        return;
+    }
+
+    for(int k = 0;k<8;k++)
+    {
+        for(int i = 0;i<3;i++)
+        {
+            signal[i] = (k >> i) & 1;
+        }
+
+        t_netlist_simuler(netlist, signal, resultat);
+
+        t_circuit_reset(circuit);
+        t_circuit_appliquer_signal(circuit, signal, 3);
+        t_circuit_propager_signal(circuit);
+
+        if(t_sortie_get_valeur(circuit->sorties[0]) != resultat[0])
+        {
+            erreurs++;
+        }
+    }
+
+    //L'entrée E1 alimente deux portes (OU et ET)
+    if(erreurs == 0 && netlist->debut_fanout[2] - netlist->debut_fanout[1] == 2 && netlist->nb_niveaux == 3)
+    {
+        printf("Test t_netlist_simuler reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_netlist_simuler (%d vecteurs differents)\n", erreurs);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+void test_t_netlist_simuler_increment(void)
+{
+    t_circuit *circuit = construire_circuit_exemple();
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    int signal[3] = {0, 0, 0};
+    int attendu[1];
+    int resultat[1];
+    int valeur;
+    int nb_evaluees = 0;
+    int erreurs = 0;
+
+    t_netlist_simuler(netlist, signal, resultat);
+
+    //Parcours en code de Gray: au pas k, seul le bit de poids le plus faible de k change
+    for(int k = 1;k<8;k++)
+    {
+        int bit = 0;
+
+        while(((k >> bit) & 1) == 0)
+        {
+            bit++;
+        }
+
+        valeur = 1 - signal[bit];
+        nb_evaluees += t_netlist_simuler_increment(netlist, &bit, &valeur, 1);
+        signal[bit] = valeur;
+        t_netlist_lire_sorties(netlist, resultat);
+
+        //Comparaison avec une simulation complète sur une autre netlist
+        t_netlist *reference = t_netlist_compiler(circuit);
+        t_netlist_simuler(reference, signal, attendu);
+        t_netlist_destroy(reference);
+
+        if(attendu[0] != resultat[0])
+        {
+            erreurs++;
+        }
+    }
+
+    if(erreurs == 0 && nb_evaluees < 7 * netlist->nb_portes)
+    {
+        printf("Test t_netlist_simuler_increment reussi (%d evaluations au lieu de %d)\n",
+               nb_evaluees, 7 * netlist->nb_portes);
+    }
+    else
+    {
+        printf("Echec du test t_netlist_simuler_increment (%d vecteurs differents)\n", erreurs);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+void test_t_simulation_parallele(void)
+{
+    //Grille de 64 x 16 portes: chaque niveau a 64 portes indépendantes
+    const e_types_portes types[3] = {PORTE_ET, PORTE_OU, PORTE_XOR};
+    t_circuit *circuit = t_circuit_init();
+    t_porte *couche[2][64];
+    t_simulation_parallele *simulation;
+    uint64_t entrees[8 * 2];
+    uint64_t sorties_serie[64 * 2];
+    uint64_t sorties_parallele[64 * 2];
+    int erreurs = 0;
+
+    for(int i = 0;i<8;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+        entrees[2 * i] = 0x9E3779B97F4A7C15ull * (i + 1);
+        entrees[2 * i + 1] = ~entrees[2 * i] ^ ((uint64_t)i << 17);
+    }
+
+    for(int d = 0;d<16;d++)
+    {
+        for(int j = 0;j<64;j++)
+        {
+            couche[d % 2][j] = t_circuit_ajouter_porte(circuit, types[(d + j) % 3]);
+            t_porte_relier(couche[d % 2][j], 0, d == 0 ? t_entree_get_pin(circuit->entrees[j % 8])
+                                                       : t_porte_get_pin_sortie(couche[(d + 1) % 2][j]));
+            t_porte_relier(couche[d % 2][j], 1, d == 0 ? t_entree_get_pin(circuit->entrees[(j + 3) % 8])
+                                                       : t_porte_get_pin_sortie(couche[(d + 1) % 2][(j + 1) % 64]));
+        }
+    }
+
+    for(int j = 0;j<64;j++)
+    {
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(couche[1][j]));
+    }
+
+    t_circuit_simuler_lot(circuit, entrees, sorties_serie, 2);
+    simulation = t_simulation_parallele_init(t_circuit_get_netlist(circuit), 4);
+
+    //Seuil minimal: tous les niveaux sont partagés entre les fils. Le groupe de fils est réutilisé
+    //pour plusieurs lots, puis avec un seuil qui force l'évaluation série.
+    simulation->seuil = 1;
+
+    for(int essai = 0;essai<3;essai++)
+    {
+        if(essai == 2)
+        {
+            simulation->seuil = 1 << 30;
+        }
+
+        memset(sorties_parallele, 0, sizeof(sorties_parallele));
+        t_simulation_parallele_simuler_lot(simulation, entrees, sorties_parallele, 2);
+
+        if(memcmp(sorties_serie, sorties_parallele, sizeof(sorties_serie)) != 0)
+        {
+            erreurs++;
+        }
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test t_simulation_parallele reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_simulation_parallele (%d lots differents)\n", erreurs);
+    }
+
+    t_simulation_parallele_destroy(simulation);
+    t_circuit_destroy(circuit);
+}
+
+//Puits de test: compte les vecteurs reçus (appelé par plusieurs fils)
+typedef struct {
+    pthread_mutex_t verrou;
+    uint64_t nb_vecteurs;
+} t_compteur_vecteurs;
+
+static void compter_vecteurs(void *contexte, uint64_t premier_vecteur, int nb_vecteurs, const uint64_t sorties[],
+                             int nb_mots)
+{
+    t_compteur_vecteurs *compteur = (t_compteur_vecteurs*)contexte;
+
+    (void)premier_vecteur;
+    (void)sorties;
+    (void)nb_mots;
+    pthread_mutex_lock(&compteur->verrou);
+    compteur->nb_vecteurs += nb_vecteurs;
+    pthread_mutex_unlock(&compteur->verrou);
+}
+
+void test_t_balayage(void)
+{
+    //Grille de 32 x 8 portes alimentée par 12 entrées: 4096 vecteurs possibles
+    const e_types_portes types[3] = {PORTE_XOR, PORTE_ET, PORTE_OU};
+    t_circuit *circuit = t_circuit_init();
+    t_porte *couche[2][32];
+    t_compteur_vecteurs compteur;
+    uint64_t *table = (uint64_t*)malloc(sizeof(uint64_t) * 32 * 64);
+    uint64_t *decale = (uint64_t*)malloc(sizeof(uint64_t) * 32 * 64);
+    uint64_t *liste = (uint64_t*)malloc(sizeof(uint64_t) * 4096);
+    uint64_t entrees[12] = {0};
+    uint64_t sorties[32];
+    int erreurs = 0;
+
+    for(int i = 0;i<12;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+    }
+
+    for(int d = 0;d<8;d++)
+    {
+        for(int j = 0;j<32;j++)
+        {
+            couche[d % 2][j] = t_circuit_ajouter_porte(circuit, types[(d * 7 + j) % 3]);
+            t_porte_relier(couche[d % 2][j], 0, d == 0 ? t_entree_get_pin(circuit->entrees[j % 12])
+                                                       : t_porte_get_pin_sortie(couche[(d + 1) % 2][j]));
+            t_porte_relier(couche[d % 2][j], 1, d == 0 ? t_entree_get_pin(circuit->entrees[(j + 5) % 12])
+                                                       : t_porte_get_pin_sortie(couche[(d + 1) % 2][(j + 3) % 32]));
+        }
+    }
+
+    for(int j = 0;j<32;j++)
+    {
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(couche[1][j]));
+    }
+
+    //Table de vérité complète, avec 3 fils et un puits
+    pthread_mutex_init(&compteur.verrou, NULL);
+    compteur.nb_vecteurs = 0;
+
+    if(t_balayage_plage(circuit, 0, 4096, 3, table, compter_vecteurs, &compteur) < 0 || compteur.nb_vecteurs != 4096)
+    {
+        erreurs++;
+    }
+
+    //Les 64 premiers vecteurs, simulés sans balayage
+    for(int k = 0;k<64;k++)
+    {
+        for(int i = 0;i<12;i++)
+        {
+            entrees[i] |= (uint64_t)((k >> i) & 1) << k;
+        }
+    }
+
+    t_circuit_simuler_lot(circuit, entrees, sorties, 1);
+
+    for(int j = 0;j<32;j++)
+    {
+        erreurs += sorties[j] != table[j * 64];
+    }
+
+    //Plage qui ne commence pas sur un multiple de 64, comparée à une liste des mêmes vecteurs
+    for(int v = 0;v<4096 - 100;v++)
+    {
+        liste[v] = (uint64_t)(v + 100);
+    }
+
+    t_balayage_plage(circuit, 100, 4096 - 100, 4, decale, NULL, NULL);
+    t_balayage_liste(circuit, liste, 4096 - 100, 2, table, NULL, NULL);
+
+    for(int j = 0;j<32;j++)
+    {
+        for(int w = 0;w<(4096 - 100) / 64;w++)
+        {
+            erreurs += decale[j * 62 + w] != table[j * 62 + w];
+        }
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test t_balayage reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_balayage (%d erreurs)\n", erreurs);
+    }
+
+    pthread_mutex_destroy(&compteur.verrou);
+    free(table);
+    free(decale);
+    free(liste);
+    t_circuit_destroy(circuit);
+}
+
+void test_t_code_natif(void)
+{
+    t_circuit *circuit = construire_circuit_exemple();
+    t_code_natif *code = t_code_natif_compiler(circuit);
+    uint64_t entrees[3 * 5];
+    uint64_t sorties_interpretees[5];
+    uint64_t sorties_natives[5];
+
+    if(code == NULL)
+    {
+        //Le compilateur du système peut manquer: le test ne peut pas être fait
+        printf("Test t_code_natif ignore (compilation impossible)\n");
+        t_circuit_destroy(circuit);
+
+        return;
+    }
+
+    //5 mots par entrée: un groupe complet de 4 mots et un groupe partiel
+    for(int i = 0;i<3 * 5;i++)
+    {
+        entrees[i] = 0x9E3779B97F4A7C15ull * (i + 7) ^ ((uint64_t)i << 40);
+    }
+
+    t_circuit_simuler_lot(circuit, entrees, sorties_interpretees, 5);
+    t_code_natif_simuler_lot(code, entrees, sorties_natives, 5);
+
+    if(memcmp(sorties_interpretees, sorties_natives, sizeof(sorties_natives)) == 0)
+    {
+        printf("Test t_code_natif reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_code_natif\n");
+    }
+
+    t_code_natif_destroy(code);
+    t_circuit_destroy(circuit);
+}
+
+void test_t_circuit_portes_n(void)
+{
+    //Portes à N entrées et types étendus: 5 entrées, les 32 vecteurs possibles
+    t_circuit *circuit = t_circuit_init();
+    t_code_natif *code;
+    t_porte *portes[7];
+    uint64_t entrees[5] = {0, 0, 0, 0, 0};
+    uint64_t sorties[4];
+    uint64_t sorties_natives[4];
+    uint64_t attendu[4];
+    uint64_t e[5];
+    int signal[5];
+    int erreurs = 0;
+
+    for(int i = 0;i<5;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+    }
+
+    portes[0] = t_circuit_ajouter_porte_n(circuit, PORTE_ET, 5);
+    portes[1] = t_circuit_ajouter_porte_n(circuit, PORTE_NAND, 3);
+    portes[2] = t_circuit_ajouter_porte_n(circuit, PORTE_NOR, 3);
+    portes[3] = t_circuit_ajouter_porte_n(circuit, PORTE_XNOR, 3);
+    portes[4] = t_circuit_ajouter_porte(circuit, PORTE_BUF);
+    portes[5] = t_circuit_ajouter_porte(circuit, PORTE_MUX);
+    portes[6] = t_circuit_ajouter_porte_n(circuit, PORTE_OU, 4);
+
+    for(int i = 0;i<5;i++)
+    {
+        t_porte_relier(portes[0], i, t_entree_get_pin(circuit->entrees[i]));
+    }
+
+    for(int i = 0;i<3;i++)
+    {
+        t_porte_relier(portes[1], i, t_entree_get_pin(circuit->entrees[i]));
+        t_porte_relier(portes[2], i, t_entree_get_pin(circuit->entrees[i + 1]));
+        t_porte_relier(portes[3], i, t_entree_get_pin(circuit->entrees[2 * i]));
+    }
+
+    t_porte_relier(portes[4], 0, t_entree_get_pin(circuit->entrees[3]));
+    t_porte_relier(portes[5], 0, t_entree_get_pin(circuit->entrees[0]));
+    t_porte_relier(portes[5], 1, t_porte_get_pin_sortie(portes[1]));
+    t_porte_relier(portes[5], 2, t_porte_get_pin_sortie(portes[2]));
+    t_porte_relier(portes[6], 0, t_porte_get_pin_sortie(portes[0]));
+    t_porte_relier(portes[6], 1, t_porte_get_pin_sortie(portes[3]));
+    t_porte_relier(portes[6], 2, t_porte_get_pin_sortie(portes[4]));
+    t_porte_relier(portes[6], 3, t_porte_get_pin_sortie(portes[5]));
+
+    for(int j = 0;j<4;j++)
+    {
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(portes[3 + j]));
+    }
+
+    //Le bit k de l'entrée i est le bit i du vecteur k
+    for(int k = 0;k<32;k++)
+    {
+        for(int i = 0;i<5;i++)
+        {
+            entrees[i] |= (uint64_t)((k >> i) & 1) << k;
+        }
+    }
+
+    memcpy(e, entrees, sizeof(e));
+    attendu[0] = ~(e[0] ^ e[2] ^ e[4]);
+    attendu[1] = e[3];
+    attendu[2] = (~(e[0] & e[1] & e[2]) & ~e[0]) | (~(e[1] | e[2] | e[3]) & e[0]);
+    attendu[3] = (e[0] & e[1] & e[2] & e[3] & e[4]) | attendu[0] | attendu[1] | attendu[2];
+
+    if(t_circuit_simuler_lot(circuit, entrees, sorties, 1) == 0)
+    {
+        erreurs++;
+    }
+
+    for(int j = 0;j<4;j++)
+    {
+        erreurs += (uint32_t)sorties[j] != (uint32_t)attendu[j];
+    }
+
+    //L'interpréteur des portes doit donner les mêmes sorties
+    for(int k = 0;k<32;k++)
+    {
+        for(int i = 0;i<5;i++)
+        {
+            signal[i] = (k >> i) & 1;
+        }
+
+        t_circuit_reset(circuit);
+        t_circuit_appliquer_signal(circuit, signal, 5);
+        t_circuit_propager_signal(circuit);
+
+        for(int j = 0;j<4;j++)
+        {
+            erreurs += t_sortie_get_valeur(circuit->sorties[j]) != (int)((attendu[j] >> k) & 1);
+        }
+    }
+
+    code = t_code_natif_compiler(circuit);
+
+    if(code != NULL)
+    {
+        t_code_natif_simuler_lot(code, entrees, sorties_natives, 1);
+        erreurs += memcmp(sorties, sorties_natives, sizeof(sorties)) != 0;
+        t_code_natif_destroy(code);
+    }
+
+    if(erreurs == 0 && t_circuit_ajouter_porte_n(circuit, PORTE_MUX, 2) == NULL
+       && t_circuit_ajouter_porte_n(circuit, PORTE_ET, 1) == NULL)
+    {
+        printf("Test portes a N entrees reussi\n");
+    }
+    else
+    {
+        printf("Echec du test portes a N entrees (%d erreurs)\n", erreurs);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+//Additionneur complet: entrées a, b, retenue; sorties somme, retenue
+static t_circuit *test_t_circuit_additionneur_complet(void)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_porte *portes[5];
+
+    for(int i = 0;i<3;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+    }
+
+    portes[0] = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+    portes[1] = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+    portes[2] = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    portes[3] = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    portes[4] = t_circuit_ajouter_porte(circuit, PORTE_OU);
+    t_porte_relier(portes[0], 0, t_entree_get_pin(circuit->entrees[0]));
+    t_porte_relier(portes[0], 1, t_entree_get_pin(circuit->entrees[1]));
+    t_porte_relier(portes[1], 0, t_porte_get_pin_sortie(portes[0]));
+    t_porte_relier(portes[1], 1, t_entree_get_pin(circuit->entrees[2]));
+    t_porte_relier(portes[2], 0, t_entree_get_pin(circuit->entrees[0]));
+    t_porte_relier(portes[2], 1, t_entree_get_pin(circuit->entrees[1]));
+    t_porte_relier(portes[3], 0, t_porte_get_pin_sortie(portes[0]));
+    t_porte_relier(portes[3], 1, t_entree_get_pin(circuit->entrees[2]));
+    t_porte_relier(portes[4], 0, t_porte_get_pin_sortie(portes[2]));
+    t_porte_relier(portes[4], 1, t_porte_get_pin_sortie(portes[3]));
+    t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(portes[1]));
+    t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(portes[4]));
+
+
+    return circuit;
+}
+
+//Additionneur fait de 4 instances de "definition", un additionneur de "largeur" bits
+//Entrées: a (4 * largeur bits), b (4 * largeur bits), retenue; sorties: somme, retenue
+static t_circuit *test_t_circuit_additionneur_instances(t_circuit *definition, int largeur)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_instance *instance;
+    t_pin_sortie *retenue;
+    int nb_bits = 4 * largeur;
+
+    for(int i = 0;i<2 * nb_bits + 1;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+    }
+
+    retenue = t_entree_get_pin(circuit->entrees[2 * nb_bits]);
+
+    for(int j = 0;j<4;j++)
+    {
+        instance = t_circuit_ajouter_instance(circuit, definition);
+
+        for(int b = 0;b<largeur;b++)
+        {
+            t_instance_relier(instance, b, t_entree_get_pin(circuit->entrees[j * largeur + b]));
+            t_instance_relier(instance, largeur + b, t_entree_get_pin(circuit->entrees[nb_bits + j * largeur + b]));
+        }
+
+        t_instance_relier(instance, 2 * largeur, retenue);
+
+        for(int b = 0;b<largeur;b++)
+        {
+            t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_instance_get_pin_sortie(instance, b));
+        }
+
+        retenue = t_instance_get_pin_sortie(instance, largeur);
+    }
+
+    t_sortie_relier(t_circuit_ajouter_sortie(circuit), retenue);
+
+
+    return circuit;
+}
+
+void test_t_circuit_instances(void)
+{
+    //Additionneur de 16 bits: 4 instances d'un additionneur de 4 bits, lui-même fait de 4
+    //instances d'un additionneur complet. Une porte NOT du circuit lit la retenue finale.
+    t_circuit *complet = test_t_circuit_additionneur_complet();
+    t_circuit *quatre_bits = test_t_circuit_additionneur_instances(complet, 1);
+    t_circuit *seize_bits = test_t_circuit_additionneur_instances(quatre_bits, 4);
+    t_circuit *six_bits;
+    t_circuit *aplati;
+    t_porte *inverse = t_circuit_ajouter_porte(seize_bits, PORTE_NOT);
+    t_instance *instance;
+    t_pin_sortie *retenue;
+    uint64_t entrees[33];
+    uint64_t sorties[18];
+    uint64_t a;
+    uint64_t b;
+    uint64_t somme;
+    int signal[33];
+    int largeur;
+    int premier_bit;
+    int erreurs = 0;
+
+    t_porte_relier(inverse, 0, seize_bits->sorties[16]->pin->liaison);
+    t_sortie_relier(t_circuit_ajouter_sortie(seize_bits), t_porte_get_pin_sortie(inverse));
+
+    for(int i = 0;i<33;i++)
+    {
+        entrees[i] = 0x9E3779B97F4A7C15ull * (i + 3) ^ ((uint64_t)i << 29);
+    }
+
+    if(t_circuit_simuler_lot(seize_bits, entrees, sorties, 1) == 0)
+    {
+        erreurs++;
+    }
+
+    //Le bit k de chaque mot est un vecteur: on compare à l'addition
+    for(int k = 0;k<64;k++)
+    {
+        a = 0;
+        b = 0;
+        somme = 0;
+
+        for(int i = 0;i<16;i++)
+        {
+            a |= ((entrees[i] >> k) & 1) << i;
+            b |= ((entrees[16 + i] >> k) & 1) << i;
+        }
+
+        for(int j = 0;j<17;j++)
+        {
+            somme |= ((sorties[j] >> k) & 1) << j;
+        }
+
+        erreurs += somme != a + b + ((entrees[32] >> k) & 1);
+        erreurs += ((sorties[17] >> k) & 1) == ((sorties[16] >> k) & 1);
+    }
+
+    //L'interpréteur doit donner les mêmes sorties, sur les pins des instances aussi
+    for(int k = 0;k<4;k++)
+    {
+        for(int i = 0;i<33;i++)
+        {
+            signal[i] = (int)((entrees[i] >> k) & 1);
+        }
+
+        t_circuit_reset(seize_bits);
+        t_circuit_appliquer_signal(seize_bits, signal, 33);
+        erreurs += t_circuit_propager_signal(seize_bits) == 0;
+
+        for(int j = 0;j<18;j++)
+        {
+            erreurs += t_sortie_get_valeur(seize_bits->sorties[j]) != (int)((sorties[j] >> k) & 1);
+        }
+
+        erreurs += t_pin_sortie_get_valeur(seize_bits->instances[3]->sorties[4]) != (int)((sorties[16] >> k) & 1);
+    }
+
+    //Additionneur de 6 bits fait des instances [complet, quatre_bits, complet]: la définition du
+    //milieu, modifiée après l'ajout des instances, est ré-aplatie pendant l'aplatissement du circuit
+    six_bits = t_circuit_init();
+
+    for(int i = 0;i<13;i++)
+    {
+        t_circuit_ajouter_entree(six_bits);
+    }
+
+    retenue = t_entree_get_pin(six_bits->entrees[12]);
+
+    for(int j = 0;j<3;j++)
+    {
+        instance = t_circuit_ajouter_instance(six_bits, j == 1 ? quatre_bits : complet);
+        largeur = j == 1 ? 4 : 1;
+        premier_bit = j == 2 ? 5 : j;
+
+        for(int b = 0;b<largeur;b++)
+        {
+            t_instance_relier(instance, b, t_entree_get_pin(six_bits->entrees[premier_bit + b]));
+            t_instance_relier(instance, largeur + b, t_entree_get_pin(six_bits->entrees[6 + premier_bit + b]));
+            t_sortie_relier(t_circuit_ajouter_sortie(six_bits), t_instance_get_pin_sortie(instance, b));
+        }
+
+        t_instance_relier(instance, 2 * largeur, retenue);
+        retenue = t_instance_get_pin_sortie(instance, largeur);
+    }
+
+    t_sortie_relier(t_circuit_ajouter_sortie(six_bits), retenue);
+    t_sortie_relier(quatre_bits->sorties[0], quatre_bits->sorties[0]->pin->liaison);
+
+    for(int k = 0;k<64;k++)
+    {
+        for(int i = 0;i<13;i++)
+        {
+            signal[i] = (int)((entrees[i] >> k) & 1);
+        }
+
+        a = 0;
+        b = 0;
+        somme = 0;
+        t_circuit_reset(six_bits);
+        t_circuit_appliquer_signal(six_bits, signal, 13);
+        erreurs += t_circuit_propager_signal(six_bits) == 0;
+
+        for(int i = 0;i<6;i++)
+        {
+            a |= (uint64_t)signal[i] << i;
+            b |= (uint64_t)signal[6 + i] << i;
+        }
+
+        for(int j = 0;j<7;j++)
+        {
+            somme |= (uint64_t)(t_sortie_get_valeur(six_bits->sorties[j]) == 1) << j;
+        }
+
+        erreurs += somme != a + b + (uint64_t)signal[12];
+    }
+
+    aplati = t_circuit_aplatir(seize_bits);
+
+    if(erreurs == 0 && aplati != NULL && aplati->nb_portes == 1 + 16 * 5 && aplati->nb_instances == 0
+       && t_circuit_ajouter_instance(complet, complet) == NULL
+       && t_circuit_get_memoire(seize_bits) < t_circuit_get_memoire(aplati))
+    {
+        printf("Test instances de circuits reussi\n");
+    }
+    else
+    {
+        printf("Echec du test instances de circuits (%d erreurs)\n", erreurs);
+    }
+
+    t_circuit_destroy(aplati);
+    t_circuit_destroy(six_bits);
+    t_circuit_destroy(seize_bits);
+    t_circuit_destroy(quatre_bits);
+    t_circuit_destroy(complet);
+}
+
+void test_t_circuit_sequentiel(void)
+{
+    //Compteur de 4 bits avec validation: q(i) change quand toutes les bascules de rang inférieur
+    //valent 1 et que l'entrée vaut 1. Les sorties d'un cycle sont l'état avant le front d'horloge.
+    t_circuit *circuit = t_circuit_init();
+    t_circuit *bascule;
+    t_circuit *autre;
+    t_simulation_parallele *simulation;
+    t_aig *aig;
+    t_porte *bascules[4];
+    t_porte *inversion;
+    t_porte *retenue;
+    t_pin_sortie *propagation;
+    uint64_t entrees[40];
+    uint64_t sorties[40 * 4];
+    int compteurs[64] = {0};
+    int signal[1];
+    int compteur = 0;
+    int erreurs = 0;
+
+    t_circuit_ajouter_entree(circuit);
+    propagation = t_entree_get_pin(circuit->entrees[0]);
+
+    for(int i = 0;i<4;i++)
+    {
+        bascules[i] = t_circuit_ajouter_porte(circuit, PORTE_DFF);
+        inversion = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+        t_porte_relier(inversion, 0, t_porte_get_pin_sortie(bascules[i]));
+        t_porte_relier(inversion, 1, propagation);
+        t_porte_relier(bascules[i], 0, t_porte_get_pin_sortie(inversion));
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(bascules[i]));
+
+        if(i < 3)
+        {
+            retenue = t_circuit_ajouter_porte(circuit, PORTE_ET);
+            t_porte_relier(retenue, 0, t_porte_get_pin_sortie(bascules[i]));
+            t_porte_relier(retenue, 1, propagation);
+            propagation = t_porte_get_pin_sortie(retenue);
+        }
+    }
+
+    //Chaque bit des mots est une séquence indépendante
+    for(int c = 0;c<40;c++)
+    {
+        entrees[c] = 0x9E3779B97F4A7C15ull * (uint64_t)(c + 1) ^ ((uint64_t)c << 33);
+    }
+
+    if(t_circuit_ordonner(circuit) == 0 || t_circuit_simuler_cycles(circuit, entrees, sorties, 40, 1) == 0)
+    {
+        erreurs++;
+    }
+
+    for(int c = 0;c<40;c++)
+    {
+        for(int k = 0;k<64;k++)
+        {
+            for(int i = 0;i<4;i++)
+            {
+                erreurs += (int)((sorties[c * 4 + i] >> k) & 1) != ((compteurs[k] >> i) & 1);
+            }
+
+            compteurs[k] = (compteurs[k] + (int)((entrees[c] >> k) & 1)) & 15;
+        }
+    }
+
+    //L'interpréteur, cycle par cycle, doit suivre la séquence du bit 0
+    for(int c = 0;c<40;c++)
+    {
+        signal[0] = (int)(entrees[c] & 1);
+        t_circuit_reset(circuit);
+        t_circuit_appliquer_signal(circuit, signal, 1);
+        erreurs += t_circuit_propager_signal(circuit) == 0;
+
+        for(int i = 0;i<4;i++)
+        {
+            erreurs += t_sortie_get_valeur(circuit->sorties[i]) != ((compteur >> i) & 1);
+        }
+
+        erreurs += t_circuit_front_horloge(circuit) == 0;
+        compteur = (compteur + signal[0]) & 15;
+    }
+
+    //Après une remise à zéro, le premier cycle repart de l'état 0
+    t_circuit_reinitialiser_etats(circuit);
+    t_circuit_simuler_cycles(circuit, entrees, sorties, 1, 1);
+    erreurs += sorties[0] != 0 || sorties[3] != 0;
+
+    //Bascule qui s'inverse à chaque cycle (0, 1, 0, 1, ...), simulée un cycle par appel: la
+    //construction d'un autre circuit entre deux appels ne doit pas remettre son état à zéro
+    bascule = t_circuit_init();
+    bascules[0] = t_circuit_ajouter_porte(bascule, PORTE_DFF);
+    inversion = t_circuit_ajouter_porte(bascule, PORTE_NOT);
+    t_porte_relier(inversion, 0, t_porte_get_pin_sortie(bascules[0]));
+    t_porte_relier(bascules[0], 0, t_porte_get_pin_sortie(inversion));
+    t_sortie_relier(t_circuit_ajouter_sortie(bascule), t_porte_get_pin_sortie(bascules[0]));
+
+    for(int c = 0;c<6;c++)
+    {
+        erreurs += t_circuit_simuler_cycles(bascule, entrees, sorties, 1, 1) == 0;
+        erreurs += sorties[0] != (c % 2 ? ~(uint64_t)0 : 0);
+        autre = t_circuit_init();
+        t_porte_relier(t_circuit_ajouter_porte(autre, PORTE_NOT), 0, t_entree_get_pin(t_circuit_ajouter_entree(autre)));
+        t_circuit_destroy(autre);
+    }
+
+    t_circuit_destroy(bascule);
+
+    //Bascule qui garde un 1 (q = q OU entrée): après deux cycles à 1, tous les moteurs de
+    //simulation par lots lisent l'état courant, 1, même avec l'entrée à 0
+    bascule = t_circuit_init();
+    bascules[0] = t_circuit_ajouter_porte(bascule, PORTE_DFF);
+    inversion = t_circuit_ajouter_porte(bascule, PORTE_OU);
+    t_porte_relier(inversion, 0, t_porte_get_pin_sortie(bascules[0]));
+    t_porte_relier(inversion, 1, t_entree_get_pin(t_circuit_ajouter_entree(bascule)));
+    t_porte_relier(bascules[0], 0, t_porte_get_pin_sortie(inversion));
+    t_sortie_relier(t_circuit_ajouter_sortie(bascule), t_porte_get_pin_sortie(bascules[0]));
+    entrees[0] = ~(uint64_t)0;
+    entrees[1] = ~(uint64_t)0;
+    erreurs += t_circuit_simuler_cycles(bascule, entrees, sorties, 2, 1) == 0;
+    entrees[0] = 0;
+
+    sorties[0] = 0;
+    erreurs += t_circuit_simuler_lot(bascule, entrees, sorties, 1) == 0 || sorties[0] != ~(uint64_t)0;
+
+    simulation = t_simulation_parallele_init(t_circuit_get_netlist(bascule), 2);
+    sorties[0] = 0;
+    erreurs += simulation == NULL || t_simulation_parallele_simuler_lot(simulation, entrees, sorties, 1) == 0
+               || sorties[0] != ~(uint64_t)0;
+
+    sorties[0] = 0;
+    erreurs += t_balayage_plage(bascule, 0, 64, 2, sorties, NULL, NULL) < 0 || sorties[0] != ~(uint64_t)0;
+
+    //L'AIG a son propre état: il est amené au même point par les mêmes cycles
+    aig = t_aig_compiler(bascule);
+    entrees[0] = ~(uint64_t)0;
+    erreurs += aig == NULL || t_aig_simuler_cycles(aig, entrees, sorties, 2, 1) == 0;
+    entrees[0] = 0;
+    sorties[0] = 0;
+    erreurs += aig == NULL || t_aig_simuler_lot(aig, entrees, sorties, 1) == 0 || sorties[0] != ~(uint64_t)0;
+
+    if(simulation != NULL)
+    {
+        t_simulation_parallele_destroy(simulation);
+    }
+
+    if(aig != NULL)
+    {
+        t_aig_destroy(aig);
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test circuit sequentiel reussi\n");
+    }
+    else
+    {
+        printf("Echec du test circuit sequentiel (%d erreurs)\n", erreurs);
+    }
+
+    t_circuit_destroy(bascule);
+    t_circuit_destroy(circuit);
+}
+
+void test_t_circuit_optimisation(void)
+{
+    //S0 = a & b construit trois fois (double NOT, ET commuté, OU avec a & NOT a & x qui vaut 0),
+    //S1 = MUX(NOT a, c & 1, b) qui devient MUX(a, b, c) et S2 = S0 ^ S0 qui vaut 0. La porte NAND
+    //(le x) ne sert plus à rien une fois le ET replié.
+    t_circuit *circuit = t_circuit_init();
+    t_circuit *optimise;
+    t_rapport_optimisation rapport;
+    t_pin_sortie *a;
+    t_pin_sortie *b;
+    t_pin_sortie *c;
+    t_porte *portes[12];
+    uint64_t entrees[3] = {0xAAull, 0xCCull, 0xF0ull};
+    uint64_t attendu[3];
+    uint64_t obtenu[3];
+    int erreurs = 0;
+
+    for(int i = 0;i<3;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+        t_circuit_ajouter_sortie(circuit);
+    }
+
+    a = t_entree_get_pin(circuit->entrees[0]);
+    b = t_entree_get_pin(circuit->entrees[1]);
+    c = t_entree_get_pin(circuit->entrees[2]);
+    portes[0] = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte_relier(portes[0], 0, a);
+    portes[1] = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte_relier(portes[1], 0, portes[0]->sortie);
+    portes[2] = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte_relier(portes[2], 0, portes[1]->sortie);
+    t_porte_relier(portes[2], 1, b);
+    portes[3] = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte_relier(portes[3], 0, b);
+    t_porte_relier(portes[3], 1, a);
+    portes[7] = t_circuit_ajouter_porte(circuit, PORTE_NAND);
+    t_porte_relier(portes[7], 0, a);
+    t_porte_relier(portes[7], 1, c);
+    portes[4] = t_circuit_ajouter_porte_n(circuit, PORTE_ET, 3);
+    t_porte_relier(portes[4], 0, a);
+    t_porte_relier(portes[4], 1, portes[0]->sortie);
+    t_porte_relier(portes[4], 2, portes[7]->sortie);
+    portes[5] = t_circuit_ajouter_porte(circuit, PORTE_OU);
+    t_porte_relier(portes[5], 0, portes[2]->sortie);
+    t_porte_relier(portes[5], 1, portes[4]->sortie);
+    portes[6] = t_circuit_ajouter_porte(circuit, PORTE_OU);
+    t_porte_relier(portes[6], 0, portes[3]->sortie);
+    t_porte_relier(portes[6], 1, portes[5]->sortie);
+    portes[8] = t_circuit_ajouter_porte(circuit, PORTE_UN);
+    portes[9] = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte_relier(portes[9], 0, portes[8]->sortie);
+    t_porte_relier(portes[9], 1, c);
+    portes[10] = t_circuit_ajouter_porte(circuit, PORTE_MUX);
+    t_porte_relier(portes[10], 0, portes[0]->sortie);
+    t_porte_relier(portes[10], 1, portes[9]->sortie);
+    t_porte_relier(portes[10], 2, b);
+    portes[11] = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+    t_porte_relier(portes[11], 0, portes[6]->sortie);
+    t_porte_relier(portes[11], 1, portes[2]->sortie);
+    t_sortie_relier(circuit->sorties[0], portes[6]->sortie);
+    t_sortie_relier(circuit->sorties[1], portes[10]->sortie);
+    t_sortie_relier(circuit->sorties[2], portes[11]->sortie);
+
+    optimise = t_optimisation_simplifier(circuit, &rapport);
+
+    if(optimise == NULL || t_circuit_simuler_lot(circuit, entrees, attendu, 1) == 0
+       || t_circuit_simuler_lot(optimise, entrees, obtenu, 1) == 0)
+    {
+        erreurs++;
+    }
+    else
+    {
+        //Restent ET(a, b), MUX(a, b, c) et la constante 0
+        erreurs += optimise->nb_portes != 3 || rapport.nb_portes_avant != 12 || rapport.nb_portes_apres != 3;
+        erreurs += rapport.nb_constantes != 3 || rapport.nb_mortes == 0;
+        erreurs += rapport.nb_niveaux_apres != 1 || rapport.nb_niveaux_avant <= rapport.nb_niveaux_apres;
+
+        for(int j = 0;j<3;j++)
+        {
+            erreurs += (attendu[j] & 0xFF) != (obtenu[j] & 0xFF);
+        }
+
+        erreurs += (obtenu[0] & 0xFF) != (0xAAull & 0xCCull) || (obtenu[2] & 0xFF) != 0;
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test circuit optimisation reussi\n");
+    }
+    else
+    {
+        printf("Echec du test circuit optimisation (%d erreurs)\n", erreurs);
+    }
+
+    if(optimise != NULL)
+    {
+        t_circuit_destroy(optimise);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+void test_t_aig(void)
+{
+    //Circuit pseudo-aléatoire avec tous les types de portes et trois bascules: le graphe ET-inverseur
+    //doit donner les mêmes sorties que la netlist, cycle par cycle
+    const e_types_portes types[NB_TYPES_PORTES - 1] = {PORTE_ET, PORTE_OU, PORTE_XOR, PORTE_NOT, PORTE_NAND, PORTE_NOR,
+                                                       PORTE_XNOR, PORTE_BUF, PORTE_MUX, PORTE_ZERO, PORTE_UN};
+    t_circuit *circuit = t_circuit_init();
+    t_pin_sortie *signaux[8 + 3 + 80];
+    t_porte *bascules[3];
+    t_porte *porte;
+    t_aig *aig;
+    uint64_t entrees[20 * 8 * 2];
+    uint64_t attendu[20 * 6 * 2];
+    uint64_t obtenu[20 * 6 * 2];
+    uint64_t alea = 12345;
+    int nb_signaux = 0;
+    int nb_entrees;
+    int erreurs = 0;
+
+    for(int i = 0;i<8;i++)
+    {
+        signaux[nb_signaux++] = t_entree_get_pin(t_circuit_ajouter_entree(circuit));
+    }
+
+    for(int b = 0;b<3;b++)
+    {
+        bascules[b] = t_circuit_ajouter_porte(circuit, PORTE_DFF);
+        signaux[nb_signaux++] = t_porte_get_pin_sortie(bascules[b]);
+    }
+
+    for(int k = 0;k<80;k++)
+    {
+        alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+        nb_entrees = t_porte_nb_entrees_defaut(types[(alea >> 33) % (NB_TYPES_PORTES - 1)]);
+
+        if(nb_entrees == 2)
+        {
+            nb_entrees += (int)((alea >> 40) % 3);
+        }
+
+        porte = t_circuit_ajouter_porte_n(circuit, types[(alea >> 33) % (NB_TYPES_PORTES - 1)], nb_entrees);
+
+        for(int i = 0;i<nb_entrees;i++)
+        {
+            alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+            t_porte_relier(porte, i, signaux[(alea >> 33) % nb_signaux]);
+        }
+
+        signaux[nb_signaux++] = t_porte_get_pin_sortie(porte);
+    }
+
+    for(int b = 0;b<3;b++)
+    {
+        t_porte_relier(bascules[b], 0, signaux[nb_signaux - 1 - 7 * b]);
+    }
+
+    for(int j = 0;j<6;j++)
+    {
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), signaux[nb_signaux - 1 - 5 * j]);
+    }
+
+    for(int i = 0;i<20 * 8 * 2;i++)
+    {
+        alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+        entrees[i] = alea ^ (alea >> 29);
+    }
+
+    aig = t_aig_compiler(circuit);
+
+    if(aig == NULL || t_netlist_simuler_cycles(t_circuit_get_netlist(circuit), entrees, attendu, 20, 2) == 0
+       || t_aig_simuler_cycles(aig, entrees, obtenu, 20, 2) == 0)
+    {
+        erreurs++;
+    }
+    else
+    {
+        erreurs += aig->nb_bascules != 3 || aig->nb_variables != 1 + 8 + 3 + aig->nb_et;
+        erreurs += memcmp(attendu, obtenu, sizeof(attendu)) != 0;
+
+        //Une remise à zéro refait la même séquence
+        t_aig_reinitialiser_etats(aig);
+        t_aig_simuler_cycles(aig, entrees, obtenu, 20, 2);
+        erreurs += memcmp(attendu, obtenu, sizeof(attendu)) != 0;
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test graphe ET-inverseur reussi (%d noeuds ET, %d niveaux)\n", aig->nb_et, aig->nb_niveaux);
+    }
+    else
+    {
+        printf("Echec du test graphe ET-inverseur (%d erreurs)\n", erreurs);
+    }
+
+    if(aig != NULL)
+    {
+        t_aig_destroy(aig);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+//Additionneur complet dont la retenue est le OU de nb_termes produits parmi ab, ac et bc
+//(3: la majorité, équivalente à test_t_circuit_additionneur_complet; 2: une retenue fausse)
+static t_circuit *test_t_circuit_additionneur_majorite(int nb_termes)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_porte *somme = t_circuit_ajouter_porte_n(circuit, PORTE_XOR, 3);
+    t_porte *retenue = t_circuit_ajouter_porte_n(circuit, PORTE_OU, nb_termes);
+    t_porte *produit;
+
+    for(int i = 0;i<3;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+        t_porte_relier(somme, i, t_entree_get_pin(circuit->entrees[i]));
+    }
+
+    for(int t = 0;t<nb_termes;t++)
+    {
+        produit = t_circuit_ajouter_porte(circuit, PORTE_ET);
+        t_porte_relier(produit, 0, t_entree_get_pin(circuit->entrees[t / 2]));
+        t_porte_relier(produit, 1, t_entree_get_pin(circuit->entrees[1 + (t + 1) / 2]));
+        t_porte_relier(retenue, t, t_porte_get_pin_sortie(produit));
+    }
+
+    t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(somme));
+    t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(retenue));
+
+
+    return circuit;
+}
+
+void test_t_equivalence(void)
+{
+    //Deux additionneurs de 16 bits dont les retenues sont construites différemment: le hachage
+    //ne suffit pas, le solveur prouve l'équivalence. Une retenue fausse est trouvée par la
+    //simulation aléatoire. Enfin, ET(e0..e39) et NOR(NOT e0..NOT e38, e39) ne diffèrent que si
+    //e0 à e38 valent 1: seul le solveur trouve ce contre-exemple.
+    t_circuit *complets[3] = {test_t_circuit_additionneur_complet(), test_t_circuit_additionneur_majorite(3),
+                              test_t_circuit_additionneur_majorite(2)};
+    t_circuit *quatre_bits[3];
+    t_circuit *seize_bits[3];
+    t_circuit *et = t_circuit_init();
+    t_circuit *nor = t_circuit_init();
+    t_porte *porte_et = t_circuit_ajouter_porte_n(et, PORTE_ET, 40);
+    t_porte *porte_nor = t_circuit_ajouter_porte_n(nor, PORTE_NOR, 40);
+    t_porte *inverse;
+    t_rapport_equivalence rapport;
+    int contre_exemple[40];
+    int resultats[2];
+    int erreurs = 0;
+
+    for(int c = 0;c<3;c++)
+    {
+        quatre_bits[c] = test_t_circuit_additionneur_instances(complets[c], 1);
+        seize_bits[c] = test_t_circuit_additionneur_instances(quatre_bits[c], 4);
+    }
+
+    erreurs += t_equivalence_verifier(seize_bits[0], seize_bits[1], contre_exemple, &rapport) != EQUIVALENTS;
+    erreurs += rapport.nb_variables == 0 || rapport.sortie != -1;
+    erreurs += t_equivalence_verifier(seize_bits[0], seize_bits[2], contre_exemple, &rapport) != DIFFERENTS;
+    erreurs += rapport.trouve_par_simulation == 0 || rapport.sortie < 1;
+    erreurs += t_equivalence_verifier(seize_bits[0], seize_bits[0], NULL, &rapport) != EQUIVALENTS;
+    erreurs += rapport.nb_sorties_fusionnees != 17 || rapport.nb_variables != 0;
+
+    for(int i = 0;i<40;i++)
+    {
+        t_circuit_ajouter_entree(et);
+        t_circuit_ajouter_entree(nor);
+        t_porte_relier(porte_et, i, t_entree_get_pin(et->entrees[i]));
+
+        if(i < 39)
+        {
+            inverse = t_circuit_ajouter_porte(nor, PORTE_NOT);
+            t_porte_relier(inverse, 0, t_entree_get_pin(nor->entrees[i]));
+            t_porte_relier(porte_nor, i, t_porte_get_pin_sortie(inverse));
+        }
+        else
+        {
+            t_porte_relier(porte_nor, i, t_entree_get_pin(nor->entrees[i]));
+        }
+    }
+
+    t_sortie_relier(t_circuit_ajouter_sortie(et), t_porte_get_pin_sortie(porte_et));
+    t_sortie_relier(t_circuit_ajouter_sortie(nor), t_porte_get_pin_sortie(porte_nor));
+
+    erreurs += t_equivalence_verifier(et, nor, contre_exemple, &rapport) != DIFFERENTS;
+    erreurs += rapport.trouve_par_simulation || rapport.sortie != 0;
+
+    for(int i = 0;i<39;i++)
+    {
+        erreurs += contre_exemple[i] != 1;
+    }
+
+    t_netlist_simuler(t_circuit_get_netlist(et), contre_exemple, &resultats[0]);
+    t_netlist_simuler(t_circuit_get_netlist(nor), contre_exemple, &resultats[1]);
+    erreurs += resultats[0] == resultats[1];
+
+    if(erreurs == 0)
+    {
+        printf("Test equivalence reussi (%lld conflits pour le dernier contre-exemple)\n", rapport.nb_conflits);
+    }
+    else
+    {
+        printf("Echec du test equivalence (%d erreurs)\n", erreurs);
+    }
+
+    for(int c = 0;c<3;c++)
+    {
+        t_circuit_destroy(seize_bits[c]);
+        t_circuit_destroy(quatre_bits[c]);
+        t_circuit_destroy(complets[c]);
+    }
+
+    t_circuit_destroy(et);
+    t_circuit_destroy(nor);
+}
+
+void test_t_sat(void)
+{
+    //Formules 3-SAT aléatoires de 16 variables autour du seuil (70 clauses): le solveur doit
+    //conclure comme l'énumération des 2^16 affectations, et son affectation doit tout satisfaire
+    uint64_t alea = 2024;
+    int clauses[70][3];
+    int clause[3];
+    int satisfaite;
+    int existe;
+    int resultat;
+    int nb_satisfiables = 0;
+    int erreurs = 0;
+    t_sat *sat;
+
+    for(int f = 0;f<40;f++)
+    {
+        sat = t_sat_init(16);
+
+        for(int c = 0;c<70;c++)
+        {
+            for(int k = 0;k<3;k++)
+            {
+                alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+                clauses[c][k] = SAT_LITTERAL((int)((alea >> 33) % 16), (int)((alea >> 40) & 1));
+                clause[k] = clauses[c][k];
+            }
+
+            t_sat_ajouter_clause(sat, clause, 3);
+        }
+
+        existe = 0;
+
+        for(int affectation = 0;affectation<(1 << 16) && existe == 0;affectation++)
+        {
+            satisfaite = 1;
+
+            for(int c = 0;c<70 && satisfaite;c++)
+            {
+                satisfaite = 0;
+
+                for(int k = 0;k<3;k++)
+                {
+                    satisfaite |= ((affectation >> (clauses[c][k] >> 1)) & 1) != (clauses[c][k] & 1);
+                }
+            }
+
+            existe = satisfaite;
+        }
+
+        resultat = t_sat_resoudre(sat, 0);
+        erreurs += resultat != (existe ? SAT_SATISFIABLE : SAT_INSATISFIABLE);
+        nb_satisfiables += existe;
+
+        for(int c = 0;c<70 && resultat == SAT_SATISFIABLE;c++)
+        {
+            satisfaite = 0;
+
+            for(int k = 0;k<3;k++)
+            {
+                satisfaite |= t_sat_valeur(sat, clauses[c][k] >> 1) != (clauses[c][k] & 1);
+            }
+
+            erreurs += satisfaite == 0;
+        }
+
+        t_sat_destroy(sat);
+    }
+
+    if(erreurs == 0 && nb_satisfiables > 0 && nb_satisfiables < 40)
+    {
+        printf("Test solveur SAT reussi (%d formules satisfiables sur 40)\n", nb_satisfiables);
+    }
+    else
+    {
+        printf("Echec du test solveur SAT (%d erreurs)\n", erreurs);
+    }
+}
+
+//Simulation de référence d'une faute (faute NULL: circuit sans faute) sur 64 vecteurs: toutes les
+//portes sont évaluées. observes reçoit les mots des sorties puis des entrées des bascules.
+static void test_t_fautes_reference(const t_netlist *netlist, const t_faute *faute, uint64_t valeurs[],
+                                    uint64_t observes[])
+{
+    uint64_t colle = faute != NULL && faute->valeur ? ~0ull : 0;
+    int signaux[8];
+    int porte;
+
+    valeurs[netlist->nb_nets] = colle;
+
+    if(faute != NULL && faute->lecteur == -1 && faute->net < netlist->nb_entrees)
+    {
+        valeurs[faute->net] = colle;
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        if(faute != NULL && faute->lecteur == -1 && faute->net == netlist->nb_entrees + k)
+        {
+            valeurs[faute->net] = colle;
+            continue;
+        }
+
+        for(int i = netlist->debut_entrees[k];i<netlist->debut_entrees[k + 1];i++)
+        {
+            signaux[i - netlist->debut_entrees[k]] = netlist->entrees[i];
+        }
+
+        if(faute != NULL && faute->lecteur == k)
+        {
+            signaux[faute->entree] = netlist->nb_nets;
+        }
+
+        t_porte_calculer_mots((e_types_portes)netlist->types[k], valeurs, signaux,
+                              netlist->debut_entrees[k + 1] - netlist->debut_entrees[k], &valeurs[netlist->nb_entrees + k], 1);
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        observes[j] = faute != NULL && faute->lecteur == netlist->nb_portes + j ? colle : valeurs[netlist->sorties[j]];
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        porte = netlist->bascules[b];
+        observes[netlist->nb_sorties + b] = faute != NULL && faute->lecteur == porte ? colle
+                                            : valeurs[netlist->entrees[netlist->debut_entrees[porte]]];
+    }
+}
+
+void test_t_fautes(void)
+{
+    //Circuit pseudo-aléatoire de 8 entrées, 2 bascules et 60 portes, simulé pour ses 1024 vecteurs
+    //(entrées et états): les fautes détectées doivent être celles d'une simulation de référence qui
+    //évalue toutes les portes pour chaque faute
+    const e_types_portes types[9] = {PORTE_ET, PORTE_OU, PORTE_XOR, PORTE_NOT, PORTE_NAND, PORTE_NOR,
+                                     PORTE_XNOR, PORTE_BUF, PORTE_MUX};
+    t_circuit *circuit = t_circuit_init();
+    t_circuit *autre;
+    t_pin_sortie *signaux[8 + 2 + 60];
+    t_porte *bascules[2];
+    t_porte *porte;
+    t_netlist *netlist;
+    t_fautes *fautes;
+    t_faute *faute;
+    uint64_t entrees[10 * 16];
+    uint64_t valeurs[8 + 62 + 1];
+    uint64_t bons[16][5 + 2];
+    uint64_t observes[5 + 2];
+    uint64_t difference;
+    uint64_t alea = 777;
+    int nb_signaux = 0;
+    int nb_entrees;
+    int nb_detectees = 0;
+    int detectee;
+    int erreurs = 0;
+
+    for(int i = 0;i<8;i++)
+    {
+        signaux[nb_signaux++] = t_entree_get_pin(t_circuit_ajouter_entree(circuit));
+    }
+
+    for(int b = 0;b<2;b++)
+    {
+        bascules[b] = t_circuit_ajouter_porte(circuit, PORTE_DFF);
+        signaux[nb_signaux++] = t_porte_get_pin_sortie(bascules[b]);
+    }
+
+    for(int k = 0;k<60;k++)
+    {
+        alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+        nb_entrees = t_porte_nb_entrees_defaut(types[(alea >> 33) % 9]);
+
+        if(nb_entrees == 2)
+        {
+            nb_entrees += (int)((alea >> 40) % 3);
+        }
+
+        porte = t_circuit_ajouter_porte_n(circuit, types[(alea >> 33) % 9], nb_entrees);
+
+        for(int i = 0;i<nb_entrees;i++)
+        {
+            alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+            t_porte_relier(porte, i, signaux[(alea >> 33) % nb_signaux]);
+        }
+
+        signaux[nb_signaux++] = t_porte_get_pin_sortie(porte);
+    }
+
+    for(int b = 0;b<2;b++)
+    {
+        t_porte_relier(bascules[b], 0, signaux[nb_signaux - 2 - 9 * b]);
+    }
+
+    for(int j = 0;j<5;j++)
+    {
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), signaux[nb_signaux - 1 - 6 * j]);
+    }
+
+    //Vecteur v: la pseudo-entrée i vaut le bit i de v
+    for(int i = 0;i<10;i++)
+    {
+        for(int w = 0;w<16;w++)
+        {
+            entrees[i * 16 + w] = 0;
+
+            for(int bit = 0;bit<64;bit++)
+            {
+                entrees[i * 16 + w] |= (uint64_t)(((64 * w + bit) >> i) & 1) << bit;
+            }
+        }
+    }
+
+    fautes = t_fautes_init(circuit);
+    netlist = t_circuit_get_netlist(circuit);
+
+    if(fautes == NULL || t_fautes_simuler_lot(fautes, entrees, 1024) != fautes->nb_detectees)
+    {
+        erreurs++;
+    }
+    else
+    {
+        for(int w = 0;w<16;w++)
+        {
+            for(int i = 0;i<10;i++)
+            {
+                valeurs[i < 8 ? i : 8 + netlist->bascules[i - 8]] = entrees[i * 16 + w];
+            }
+
+            test_t_fautes_reference(netlist, NULL, valeurs, bons[w]);
+        }
+
+        for(int f = 0;f<fautes->nb_fautes;f++)
+        {
+            faute = &fautes->fautes[f];
+            detectee = 0;
+
+            for(int w = 0;w<16;w++)
+            {
+                for(int i = 0;i<10;i++)
+                {
+                    valeurs[i < 8 ? i : 8 + netlist->bascules[i - 8]] = entrees[i * 16 + w];
+                }
+
+                test_t_fautes_reference(netlist, faute, valeurs, observes);
+                difference = 0;
+
+                for(int j = 0;j<5 + 2;j++)
+                {
+                    difference |= observes[j] ^ bons[w][j];
+                }
+
+                detectee |= difference != 0;
+
+                //Le vecteur retenu par le simulateur doit détecter la faute
+                if(faute->vecteur >= 64 * w && faute->vecteur < 64 * (w + 1))
+                {
+                    erreurs += ((difference >> (faute->vecteur - 64 * w)) & 1) == 0;
+                }
+            }
+
+            erreurs += detectee != (faute->vecteur >= 0);
+            nb_detectees += detectee;
+        }
+
+        //Les fautes restantes sont indétectables: de nouveaux vecteurs n'en détectent aucune
+        erreurs += nb_detectees != fautes->nb_detectees || nb_detectees == fautes->nb_fautes;
+        //Construire un autre circuit ne recompile pas la netlist gardée par le simulateur
+        autre = construire_circuit_exemple();
+        erreurs += t_circuit_get_netlist(autre) == NULL || t_circuit_get_netlist(circuit) != netlist;
+        t_circuit_destroy(autre);
+        erreurs += t_fautes_simuler_aleatoire(fautes, 5000) != 0 || fautes->nb_vecteurs != 1024 + 5000;
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test simulation de fautes reussi (%d fautes, couverture %.1f %%)\n", fautes->nb_fautes,
+               100.0 * t_fautes_couverture(fautes));
+    }
+    else
+    {
+        printf("Echec du test simulation de fautes (%d erreurs)\n", erreurs);
+    }
+
+    if(fautes != NULL)
+    {
+        t_fautes_destroy(fautes);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+void test_t_analyse_temporelle(void)
+{
+    //Circuit exemple: P0 = E0 OU E1, P1 = E1 ET E2, P2 = NOT P0, P3 = P2 XOR P1 -> S0
+    t_circuit *circuit = construire_circuit_exemple();
+    t_circuit *autre;
+    t_analyse_temporelle *analyse;
+    int delais[NB_TYPES_PORTES] = {5, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
+    t_porte *bascule;
+    t_porte *porte_not;
+    char chemin[64];
+    int erreurs = 0;
+
+    //Délais unitaires: le plus long chemin passe par le OU et le NOT
+    analyse = t_analyse_temporelle_calculer(circuit, NULL);
+    t_analyse_temporelle_chemin_critique(analyse, chemin, sizeof(chemin));
+    erreurs += analyse->profondeur != 3 || strcmp(chemin, "E0->P0->P2->P3->S0") != 0;
+    erreurs += analyse->largeur_max != 2 || analyse->fanout_max != 2 || analyse->net_fanout_max != 1;
+    erreurs += analyse->nb_nets_sans_lecteur != 0 || analyse->arrivees[3 + 1] != 1;
+
+    //Un texte tronqué garde la longueur complète
+    erreurs += t_analyse_temporelle_chemin_critique(analyse, chemin, 6) != strlen("E0->P0->P2->P3->S0");
+    erreurs += strcmp(chemin, "E0->P") != 0;
+    t_analyse_temporelle_destroy(analyse);
+
+    //ET lent (délai 5): le chemin critique passe par le ET
+    analyse = t_analyse_temporelle_calculer(circuit, delais);
+    t_analyse_temporelle_chemin_critique(analyse, chemin, sizeof(chemin));
+    erreurs += analyse->profondeur != 6 || strcmp(chemin, "E1->P1->P3->S0") != 0;
+    t_analyse_temporelle_destroy(analyse);
+
+    //Une bascule dont l'entrée est plus tardive que la sortie termine le chemin critique
+    bascule = t_circuit_ajouter_porte(circuit, PORTE_DFF);
+    porte_not = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte_relier(porte_not, 0, t_porte_get_pin_sortie(circuit->portes[3]));
+    t_porte_relier(bascule, 0, t_porte_get_pin_sortie(porte_not));
+    analyse = t_analyse_temporelle_calculer(circuit, NULL);
+    t_analyse_temporelle_chemin_critique(analyse, chemin, sizeof(chemin));
+    erreurs += analyse->profondeur != 4 || strcmp(chemin, "E0->P0->P2->P3->P5->P4") != 0;
+    erreurs += analyse->nb_nets_sans_lecteur != 1;
+
+    //L'analyse lit la netlist du circuit: construire un autre circuit ne doit pas la recompiler
+    autre = construire_circuit_exemple();
+    t_circuit_ordonner(autre);
+    erreurs += t_circuit_get_netlist(circuit) != analyse->netlist;
+    erreurs += strcmp(t_analyse_temporelle_nom_net(analyse, 3 + 5), "P5") != 0;
+    t_circuit_destroy(autre);
+
+    if(erreurs == 0)
+    {
+        printf("Test analyse temporelle reussi (%s)\n", chemin);
+    }
+    else
+    {
+        printf("Echec du test analyse temporelle (%d erreurs, %s)\n", erreurs, chemin);
+    }
+
+    t_analyse_temporelle_destroy(analyse);
+    t_circuit_destroy(circuit);
+}
+
+void test_t_generateur(void)
+{
+    //Les circuits arithmétiques générés calculent ce qu'ils annoncent; le graphe aléatoire est valide
+    //et a la profondeur demandée
+    t_parametres_aleatoire parametres = {40, 3000, 25, 4, 6, 99};
+    t_circuit *additionneur = t_generateur_additionneur(12);
+    t_circuit *multiplicateur = t_generateur_multiplicateur(6, 0);
+    t_circuit *parite = t_generateur_parite(13, 3);
+    t_circuit *aleatoire = t_generateur_aleatoire(&parametres);
+    int signal[25];
+    int resultat[25];
+    unsigned a;
+    unsigned b;
+    unsigned obtenu;
+    uint64_t alea = 31;
+    int erreurs = 0;
+
+    if(additionneur == NULL || multiplicateur == NULL || parite == NULL || aleatoire == NULL)
+    {
+        erreurs++;
+    }
+
+    for(int v = 0;v<200 && erreurs == 0;v++)
+    {
+        alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+        a = (unsigned)(alea >> 40) & 0xFFF;
+        b = (unsigned)(alea >> 20) & 0xFFF;
+
+        //a + b + retenue sur 12 bits
+        for(int i = 0;i<12;i++)
+        {
+            signal[i] = (a >> i) & 1;
+            signal[12 + i] = (b >> i) & 1;
+        }
+
+        signal[24] = (int)(alea & 1);
+        t_netlist_simuler(t_circuit_get_netlist(additionneur), signal, resultat);
+        obtenu = 0;
+
+        for(int j = 0;j<13;j++)
+        {
+            obtenu |= (unsigned)resultat[j] << j;
+        }
+
+        erreurs += obtenu != a + b + (unsigned)(alea & 1);
+
+        //a * b sur 6 bits: les 12 premières entrées sont les deux opérandes
+        t_netlist_simuler(t_circuit_get_netlist(multiplicateur), signal, resultat);
+        obtenu = 0;
+
+        for(int j = 0;j<12;j++)
+        {
+            obtenu |= (unsigned)resultat[j] << j;
+        }
+
+        erreurs += obtenu != (a & 0x3F) * (a >> 6);
+
+        //Parité des 13 premières entrées
+        t_netlist_simuler(t_circuit_get_netlist(parite), signal, resultat);
+        obtenu = 0;
+
+        for(int i = 0;i<13;i++)
+        {
+            obtenu ^= (unsigned)signal[i];
+        }
+
+        erreurs += resultat[0] != (int)obtenu;
+    }
+
+    if(erreurs == 0)
+    {
+        erreurs += t_circuit_est_valide(additionneur) == 0 || t_circuit_est_valide(multiplicateur) == 0;
+        erreurs += t_circuit_est_valide(parite) == 0 || parite->nb_portes != 7;
+        erreurs += t_circuit_est_valide(aleatoire) == 0 || aleatoire->nb_portes != 3000;
+        erreurs += t_circuit_get_netlist(aleatoire)->nb_niveaux != 25 || aleatoire->nb_sorties != 3000 / 25;
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test generateur de circuits reussi\n");
+    }
+    else
+    {
+        printf("Echec du test generateur de circuits (%d erreurs)\n", erreurs);
+    }
+
+    if(additionneur != NULL)
+    {
+        t_circuit_destroy(additionneur);
+    }
+
+    if(multiplicateur != NULL)
+    {
+        t_circuit_destroy(multiplicateur);
+    }
+
+    if(parite != NULL)
+    {
+        t_circuit_destroy(parite);
+    }
+
+    if(aleatoire != NULL)
+    {
+        t_circuit_destroy(aleatoire);
+    }
+}
+
+void test_t_circuit_index_noms(void)
+{
+    //Les composants se retrouvent par leur nom, y compris ceux ajoutés après une première recherche,
+    //et les liens d'une pin se nomment à partir des pins entrée
+    t_circuit *circuit = t_circuit_init();
+    t_entree *entree = t_circuit_ajouter_entree(circuit);
+    t_porte *et = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte *inverse = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_sortie *sortie = t_circuit_ajouter_sortie(circuit);
+    t_porte *portes[1500];
+    char texte[64];
+    char nom[16];
+    int erreurs = 0;
+
+    t_porte_relier(et, 0, t_entree_get_pin(entree));
+    t_porte_relier(et, 1, t_entree_get_pin(entree));
+    t_porte_relier(inverse, 0, t_entree_get_pin(entree));
+    t_sortie_relier(sortie, t_porte_get_pin_sortie(et));
+
+    erreurs += t_circuit_trouver_porte(circuit, "P1") != inverse || t_circuit_trouver_entree(circuit, "E0") != entree;
+    erreurs += t_circuit_trouver_sortie(circuit, "S0") != sortie || t_circuit_trouver_porte(circuit, "S0") != NULL;
+    erreurs += t_circuit_trouver_porte(circuit, "P2") != NULL || t_circuit_trouver_instance(circuit, "I0") != NULL;
+
+    //Assez de portes pour que l'index soit agrandi plusieurs fois
+    for(int k = 0;k<1500;k++)
+    {
+        portes[k] = t_circuit_ajouter_porte(circuit, PORTE_BUF);
+    }
+
+    for(int k = 0;k<1500;k++)
+    {
+        snprintf(nom, sizeof(nom), "P%d", k + 2);
+        erreurs += t_circuit_trouver_porte(circuit, nom) != portes[k];
+    }
+
+    t_pin_sortie_serialiser_liens(t_entree_get_pin(entree), circuit, texte);
+    erreurs += strcmp(texte, "P0,P0,P1") != 0;
+    t_pin_sortie_serialiser_liens(t_porte_get_pin_sortie(et), circuit, texte);
+    erreurs += strcmp(texte, "S0") != 0;
+    t_pin_sortie_serialiser_liens(t_porte_get_pin_sortie(inverse), circuit, texte);
+    erreurs += strcmp(texte, "") != 0;
+    erreurs += t_porte_get_pin_sortie(et)->porte != et || t_entree_get_pin(entree)->entree != entree;
+    erreurs += sortie->pin->sortie != sortie;
+
+    if(erreurs == 0)
+    {
+        printf("Test index des noms du circuit reussi\n");
+    }
+    else
+    {
+        printf("Echec du test index des noms du circuit (%d erreurs)\n", erreurs);
+    }
+
+    t_circuit_destroy(circuit);
+}
+
+void test_t_table_verite(void)
+{
+    //Chaque bit de la table est la sortie simulée pour son vecteur; moins de 6 entrées: bits inutilisés à 0
+    t_circuit *additionneur = t_generateur_additionneur(2);
+    t_circuit *multiplicateur = t_generateur_multiplicateur(3, 0);
+    t_circuit *parite = t_generateur_parite(5, 2);
+    t_circuit *circuits[3] = {additionneur, multiplicateur, parite};
+    t_table_verite *tables[3] = {NULL, NULL, NULL};
+    int signal[6];
+    int resultat[6];
+    int erreurs = 0;
+
+    for(int c = 0;c<3;c++)
+    {
+        tables[c] = circuits[c] == NULL ? NULL : t_table_verite_calculer(circuits[c], 2);
+
+        if(tables[c] == NULL)
+        {
+            erreurs++;
+            continue;
+        }
+
+        for(uint64_t v = 0;v<((uint64_t)1 << tables[c]->nb_entrees);v++)
+        {
+            for(int i = 0;i<tables[c]->nb_entrees;i++)
+            {
+                signal[i] = (int)((v >> i) & 1);
+            }
+
+            t_netlist_simuler(t_circuit_get_netlist(circuits[c]), signal, resultat);
+
+            for(int j = 0;j<tables[c]->nb_sorties;j++)
+            {
+                erreurs += t_table_verite_valeur(tables[c], j, v) != resultat[j];
+            }
+        }
+    }
+
+    if(erreurs == 0)
+    {
+        //Additionneur 2 bits (a0 a1 b0 b1 retenue): 32 vecteurs sur 64 bits
+        erreurs += tables[0]->nb_mots != 1 || (tables[0]->mots[0] >> 32) != 0;
+        erreurs += t_table_verite_nb_uns(tables[2], 0) != 16 || t_table_verite_nb_uns(tables[1], 5) != 6;
+
+        //somme0 = a0 ^ b0 ^ retenue; le bit 5 du produit 3 bits dépend de toutes les entrées
+        for(int i = 0;i<5;i++)
+        {
+            erreurs += t_table_verite_depend(tables[0], 0, i) != (i == 0 || i == 2 || i == 4);
+            erreurs += t_table_verite_depend(tables[2], 0, i) != 1;
+            erreurs += t_table_verite_depend(tables[1], 5, i) != 1;
+        }
+
+        erreurs += t_table_verite_comparer(tables[2], tables[2]) != -1 || t_table_verite_comparer(tables[0], tables[1]) != 3;
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test table de verite reussi\n");
+    }
+    else
+    {
+        printf("Echec du test table de verite (%d erreurs)\n", erreurs);
+    }
+
+    for(int c = 0;c<3;c++)
+    {
+        t_table_verite_destroy(tables[c]);
+        t_circuit_destroy(circuits[c]);
+    }
+}
+
+void test_t_bdd(void)
+{
+    //Les BDD déroulés redonnent les tables de vérité du balayage; une parité de 64 entrées,
+    //hors de portée d'une table, a un BDD de 2 noeuds par entrée (un seul pour la dernière)
+    t_parametres_aleatoire parametres = {14, 400, 12, 3, 4, 7};
+    t_circuit *circuits[3] = {t_generateur_additionneur(4), t_generateur_multiplicateur(4, 0),
+                              t_generateur_aleatoire(&parametres)};
+    t_circuit *parite = t_generateur_parite(64, 4);
+    t_circuit *grand = t_generateur_multiplicateur(8, 0);
+    t_table_verite *table;
+    t_table_verite *deroulee;
+    t_bdd *bdd;
+    t_bdd *entrelace;
+    int ordre[9] = {0, 4, 1, 5, 2, 6, 3, 7, 8};
+    int valeurs[14];
+    int erreurs = 0;
+
+    for(int c = 0;c<3;c++)
+    {
+        table = circuits[c] == NULL ? NULL : t_table_verite_calculer(circuits[c], 1);
+        bdd = circuits[c] == NULL ? NULL : t_bdd_compiler(circuits[c], NULL, 0);
+        deroulee = bdd == NULL ? NULL : t_bdd_table_verite(bdd);
+
+        if(table == NULL || deroulee == NULL)
+        {
+            erreurs++;
+        }
+        else
+        {
+            erreurs += t_table_verite_comparer(table, deroulee) != -1;
+
+            for(int j = 0;j<bdd->nb_sorties;j++)
+            {
+                erreurs += t_bdd_nb_solutions(bdd, bdd->sorties[j]) != (double)t_table_verite_nb_uns(table, j);
+            }
+
+            for(uint64_t v = 0;v<((uint64_t)1 << table->nb_entrees);v += 37)
+            {
+                for(int i = 0;i<table->nb_entrees;i++)
+                {
+                    valeurs[i] = (int)((v >> i) & 1);
+                }
+
+                erreurs += t_bdd_evaluer(bdd, bdd->sorties[0], valeurs) != t_table_verite_valeur(table, 0, v);
+            }
+        }
+
+        t_table_verite_destroy(table);
+        t_table_verite_destroy(deroulee);
+        t_bdd_destroy(bdd);
+    }
+
+    //Additionneur: l'ordre entrelacé a0 b0 a1 b1... donne la même fonction avec une retenue plus petite
+    bdd = t_bdd_compiler(circuits[0], NULL, 0);
+    entrelace = t_bdd_compiler(circuits[0], ordre, 0);
+
+    if(bdd == NULL || entrelace == NULL)
+    {
+        erreurs++;
+    }
+    else
+    {
+        table = t_bdd_table_verite(bdd);
+        deroulee = t_bdd_table_verite(entrelace);
+        erreurs += table == NULL || deroulee == NULL || t_table_verite_comparer(table, deroulee) != -1;
+        erreurs += t_bdd_taille(entrelace, entrelace->sorties[4]) >= t_bdd_taille(bdd, bdd->sorties[4]);
+        erreurs += entrelace->nb_succes_cache == 0;
+        t_table_verite_destroy(table);
+        t_table_verite_destroy(deroulee);
+    }
+
+    t_bdd_destroy(bdd);
+    t_bdd_destroy(entrelace);
+    ordre[0] = 4;
+    erreurs += t_bdd_compiler(circuits[0], ordre, 0) != NULL;
+
+    bdd = t_bdd_compiler(parite, NULL, 0);
+    erreurs += bdd == NULL || t_bdd_taille(bdd, bdd->sorties[0]) != 127 || t_bdd_nb_solutions(bdd, bdd->sorties[0]) != 9223372036854775808.0;
+    erreurs += bdd == NULL || t_bdd_table_verite(bdd) != NULL;
+    t_bdd_destroy(bdd);
+
+    //Les bits du milieu d'un produit ont un BDD exponentiel: la limite de noeuds est respectée
+    erreurs += t_bdd_compiler(grand, NULL, 2000) != NULL;
+
+    if(erreurs == 0)
+    {
+        printf("Test BDD reussi\n");
+    }
+    else
+    {
+        printf("Echec du test BDD (%d erreurs)\n", erreurs);
+    }
+
+    for(int c = 0;c<3;c++)
+    {
+        t_circuit_destroy(circuits[c]);
+    }
+
+    t_circuit_destroy(parite);
+    t_circuit_destroy(grand);
+}
+
+//Valeur de référence d'une porte à quatre valeurs: la valeur commune à toutes les façons de remplacer
+//les X et Z des entrées par 0 ou 1, X si elles ne donnent pas toutes la même sortie
+static int test_t_logique4_reference(e_types_portes type, const int valeurs[], int nb_entrees)
+{
+    uint64_t entrees[3];
+    int signaux[3] = {0, 1, 2};
+    uint64_t sortie;
+    int resultat = -2;
+
+    for(int choix = 0;choix<(1 << nb_entrees);choix++)
+    {
+        for(int i = 0;i<nb_entrees;i++)
+        {
+            entrees[i] = valeurs[i] == LOGIQUE_0 || valeurs[i] == LOGIQUE_1 ? (uint64_t)valeurs[i] : (uint64_t)((choix >> i) & 1);
+        }
+
+        t_porte_calculer_mots(type, entrees, signaux, nb_entrees, &sortie, 1);
+
+        if(resultat != -2 && resultat != (int)(sortie & 1))
+        {
+
+            return LOGIQUE_X;
+        }
+
+        resultat = (int)(sortie & 1);
+    }
+
+
+    return resultat;
+}
+
+void test_t_logique4(void)
+{
+    //Chaque porte donne, pour toutes les combinaisons de 0, 1, X et Z de ses entrées (une par bit
+    //d'un mot), la valeur certaine ou X; une pin inactive est un X; un registre à remise à zéro
+    //synchrone part de X et devient connu au cycle de remise à zéro
+    const e_types_portes types[] = {PORTE_ET, PORTE_OU, PORTE_XOR, PORTE_NAND, PORTE_NOR, PORTE_XNOR, PORTE_NOT,
+                                    PORTE_BUF, PORTE_MUX, PORTE_ZERO, PORTE_UN};
+    const int codes[4] = {LOGIQUE_0, LOGIQUE_1, LOGIQUE_X, LOGIQUE_Z};
+    t_parametres_aleatoire parametres = {16, 500, 10, 3, 4, 5};
+    t_circuit *aleatoire = t_generateur_aleatoire(&parametres);
+    t_circuit *registre = t_circuit_init();
+    t_logique4 *simulation = NULL;
+    t_porte *porte = t_porte_init(0, PORTE_ET);
+    t_entree *entree = t_entree_init(0);
+    t_porte *bascules[4];
+    t_porte *validation;
+    t_porte *remise;
+    t_porte *inverse;
+    uint64_t uns[16 * 4];
+    uint64_t zeros[16 * 4];
+    uint64_t sorties_uns[50 * 4];
+    uint64_t sorties_zeros[50 * 4];
+    uint64_t sorties_0[50 * 4];
+    uint64_t sorties_1[50 * 4];
+    uint64_t sortie_uns;
+    uint64_t sortie_zeros;
+    int signaux[3] = {0, 1, 2};
+    int valeurs[3];
+    int resultat[4];
+    int nb_entrees;
+    int obtenu;
+    uint64_t alea = 17;
+    int erreurs = 0;
+
+    for(int t = 0;t<(int)(sizeof(types) / sizeof(types[0]));t++)
+    {
+        for(nb_entrees = 0;nb_entrees<=3;nb_entrees++)
+        {
+            if(t_porte_nb_entrees_valide(types[t], nb_entrees) == 0)
+            {
+                continue;
+            }
+
+            //Le bit k des rails de l'entrée i code la valeur (k >> 2i) & 3
+            for(int i = 0;i<3;i++)
+            {
+                uns[i] = 0;
+                zeros[i] = 0;
+
+                for(int k = 0;k<64;k++)
+                {
+                    uns[i] |= (uint64_t)(codes[(k >> 2 * i) & 3] == LOGIQUE_1 || codes[(k >> 2 * i) & 3] == LOGIQUE_X) << k;
+                    zeros[i] |= (uint64_t)(codes[(k >> 2 * i) & 3] == LOGIQUE_0 || codes[(k >> 2 * i) & 3] == LOGIQUE_X) << k;
+                }
+            }
+
+            t_porte_calculer_mots_x(types[t], uns, zeros, signaux, nb_entrees, &sortie_uns, &sortie_zeros, 1);
+
+            for(int k = 0;k<(1 << 2 * nb_entrees);k++)
+            {
+                for(int i = 0;i<nb_entrees;i++)
+                {
+                    valeurs[i] = codes[(k >> 2 * i) & 3];
+                }
+
+                obtenu = ((sortie_uns >> k) & 1) == ((sortie_zeros >> k) & 1) ? (((sortie_uns >> k) & 1) ? LOGIQUE_X : LOGIQUE_Z)
+                                                                               : (int)((sortie_uns >> k) & 1);
+                erreurs += obtenu != test_t_logique4_reference(types[t], valeurs, nb_entrees);
+            }
+        }
+    }
+
+    //ET dont une entrée est inactive: 0 si l'autre vaut 0, inconnu (-1) si elle vaut 1
+    t_porte_relier(porte, 0, t_entree_get_pin(entree));
+    t_pin_entree_set_valeur(porte->entrees[0], 0);
+    t_porte_calculer_sorties(porte);
+    erreurs += t_pin_sortie_get_valeur(t_porte_get_pin_sortie(porte)) != 0;
+    t_pin_entree_set_valeur(porte->entrees[0], 1);
+    t_porte_calculer_sorties(porte);
+    erreurs += t_pin_sortie_get_valeur(t_porte_get_pin_sortie(porte)) != -1;
+
+    //Registre de 4 bits: d = NOT(remise) ET (q XOR validation)
+    t_circuit_ajouter_entree(registre);
+    t_circuit_ajouter_entree(registre);
+    inverse = t_circuit_ajouter_porte(registre, PORTE_NOT);
+    t_porte_relier(inverse, 0, t_entree_get_pin(registre->entrees[0]));
+
+    for(int i = 0;i<4;i++)
+    {
+        bascules[i] = t_circuit_ajouter_porte(registre, PORTE_DFF);
+        validation = t_circuit_ajouter_porte(registre, PORTE_XOR);
+        remise = t_circuit_ajouter_porte(registre, PORTE_ET);
+        t_porte_relier(validation, 0, t_porte_get_pin_sortie(bascules[i]));
+        t_porte_relier(validation, 1, t_entree_get_pin(registre->entrees[1]));
+        t_porte_relier(remise, 0, t_porte_get_pin_sortie(inverse));
+        t_porte_relier(remise, 1, t_porte_get_pin_sortie(validation));
+        t_porte_relier(bascules[i], 0, t_porte_get_pin_sortie(remise));
+        t_sortie_relier(t_circuit_ajouter_sortie(registre), t_porte_get_pin_sortie(bascules[i]));
+    }
+
+    //Cycle 0: remise pour la moitié des séquences, validation à 0; cycle 1: remise partout;
+    //cycle 2: validation à X
+    simulation = t_logique4_init(registre);
+    uns[0] = 0x00000000FFFFFFFFull; zeros[0] = ~uns[0]; uns[1] = 0; zeros[1] = ~(uint64_t)0;
+    uns[2] = ~(uint64_t)0; zeros[2] = 0; uns[3] = 0; zeros[3] = ~(uint64_t)0;
+    uns[4] = 0; zeros[4] = ~(uint64_t)0; uns[5] = ~(uint64_t)0; zeros[5] = ~(uint64_t)0;
+
+    if(simulation == NULL || t_logique4_nb_etats_inconnus(simulation) != -1)
+    {
+        erreurs++;
+    }
+    else
+    {
+        erreurs += t_logique4_simuler_cycles(simulation, uns, zeros, sorties_uns, sorties_zeros, 1, 1) == 0;
+        erreurs += t_logique4_nb_etats_inconnus(simulation) != 4 * 32;
+        erreurs += sorties_uns[0] != ~(uint64_t)0 || sorties_zeros[3] != ~(uint64_t)0;
+        erreurs += t_logique4_simuler_cycles(simulation, &uns[2], &zeros[2], sorties_uns, sorties_zeros, 1, 1) == 0;
+        erreurs += t_logique4_nb_etats_inconnus(simulation) != 0;
+        erreurs += t_logique4_simuler_cycles(simulation, &uns[4], &zeros[4], sorties_uns, sorties_zeros, 1, 1) == 0;
+        erreurs += sorties_uns[2] != 0 || sorties_zeros[2] != ~(uint64_t)0 || t_logique4_nb_etats_inconnus(simulation) != 4 * 64;
+        t_logique4_reinitialiser_etats(simulation);
+        valeurs[0] = LOGIQUE_0;
+        valeurs[1] = LOGIQUE_Z;
+        erreurs += t_logique4_simuler(simulation, valeurs, resultat) == 0 || resultat[0] != LOGIQUE_X;
+        valeurs[1] = 3;
+        erreurs += t_logique4_simuler(simulation, valeurs, resultat) != 0;
+    }
+
+    t_logique4_destroy(simulation);
+
+    //Graphe aléatoire: sans X, mêmes sorties que la simulation à deux valeurs; avec l'entrée 0 à X,
+    //toute sortie connue est la sortie obtenue avec l'entrée 0 à 0 et à 1
+    simulation = aleatoire == NULL ? NULL : t_logique4_init(aleatoire);
+
+    if(simulation == NULL)
+    {
+        erreurs++;
+    }
+    else
+    {
+        for(int i = 0;i<16 * 4;i++)
+        {
+            alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+            uns[i] = alea ^ (alea >> 29);
+            zeros[i] = ~uns[i];
+        }
+
+        t_circuit_simuler_lot(aleatoire, uns, sorties_0, 4);
+        erreurs += aleatoire->nb_sorties != 50 || t_logique4_simuler_lot(simulation, uns, zeros, sorties_uns, sorties_zeros, 4) == 0;
+
+        for(int w = 0;w<50 * 4;w++)
+        {
+            erreurs += sorties_uns[w] != sorties_0[w] || sorties_zeros[w] != ~sorties_0[w];
+        }
+
+        memset(uns, 0, sizeof(uint64_t) * 4);
+        t_circuit_simuler_lot(aleatoire, uns, sorties_0, 4);
+        memset(uns, 0xFF, sizeof(uint64_t) * 4);
+        t_circuit_simuler_lot(aleatoire, uns, sorties_1, 4);
+        memset(zeros, 0xFF, sizeof(uint64_t) * 4);
+        t_logique4_simuler_lot(simulation, uns, zeros, sorties_uns, sorties_zeros, 4);
+
+        for(int w = 0;w<50 * 4;w++)
+        {
+            //Connu à 1: 1 dans les deux cas; connu à 0: 0 dans les deux cas
+            erreurs += ((sorties_uns[w] & ~sorties_zeros[w]) & ~(sorties_0[w] & sorties_1[w])) != 0;
+            erreurs += ((sorties_zeros[w] & ~sorties_uns[w]) & (sorties_0[w] | sorties_1[w])) != 0;
+        }
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test logique a quatre valeurs reussi\n");
+    }
+    else
+    {
+        printf("Echec du test logique a quatre valeurs (%d erreurs)\n", erreurs);
+    }
+
+    t_logique4_destroy(simulation);
+    t_porte_destroy(porte);
+    t_entree_destroy(entree);
+    t_circuit_destroy(registre);
+
+    if(aleatoire != NULL)
+    {
+        t_circuit_destroy(aleatoire);
+    }
+}
+
+void test_t_activite(void)
+{
+    //Lot: les transitions comptées sont celles obtenues bit par bit sur les vecteurs consécutifs de
+    //deux lots; cycles: une bascule qui s'inverse à chaque cycle change 64 fois par front d'horloge
+    t_parametres_aleatoire parametres = {16, 500, 10, 3, 4, 5};
+    t_circuit *aleatoire = t_generateur_aleatoire(&parametres);
+    t_circuit *bascule = t_circuit_init();
+    t_circuit *autre;
+    t_netlist *netlist = NULL;
+    t_activite *activite = NULL;
+    t_porte *etat;
+    t_porte *inverse;
+    uint64_t entrees[16 * 4];
+    uint64_t sorties[50 * 4];
+    long long *attendues = NULL;
+    signed char *precedents = NULL;
+    long long total = 0;
+    size_t net;
+    int bit;
+    uint64_t alea = 29;
+    int erreurs = 0;
+
+    netlist = aleatoire == NULL ? NULL : t_circuit_get_netlist(aleatoire);
+
+    if(netlist != NULL)
+    {
+        attendues = (long long*)calloc(netlist->nb_portes + 1, sizeof(long long));
+        precedents = (signed char*)malloc(netlist->nb_portes + 1);
+    }
+
+    if(netlist == NULL || attendues == NULL || precedents == NULL || t_netlist_compter_transitions(netlist, 1) == 0)
+    {
+        erreurs++;
+    }
+    else
+    {
+        activite = t_activite_calculer(aleatoire, 0);
+        erreurs += activite == NULL || activite->nb_paires != 0 || activite->nb_transitions != 0;
+        t_activite_destroy(activite);
+        memset(precedents, -1, netlist->nb_portes + 1);
+
+        for(int l = 0;l<2;l++)
+        {
+            for(int i = 0;i<16 * 4;i++)
+            {
+                alea = alea * 6364136223846793005ull + 1442695040888963407ull;
+                entrees[i] = alea ^ (alea >> 29);
+            }
+
+            erreurs += t_netlist_simuler_lot(netlist, entrees, sorties, 4) == 0;
+
+            for(int k = 0;k<netlist->nb_portes;k++)
+            {
+                net = (size_t)(netlist->nb_entrees + k) * 4;
+
+                for(int v = 0;v<64 * 4 && netlist->types[k] != PORTE_DFF;v++)
+                {
+                    bit = (int)((netlist->valeurs[net + v / 64] >> (v % 64)) & 1);
+                    attendues[k] += precedents[k] != -1 && precedents[k] != bit;
+                    precedents[k] = (signed char)bit;
+                }
+
+                erreurs += netlist->transitions[k] != attendues[k];
+                total += l == 1 ? attendues[k] : 0;
+            }
+        }
+
+        //Les compteurs survivent à la construction d'un autre circuit
+        autre = construire_circuit_exemple();
+        erreurs += t_circuit_get_netlist(autre) == NULL;
+        t_circuit_destroy(autre);
+        activite = t_activite_calculer(aleatoire, 10);
+        erreurs += activite == NULL;
+
+        if(activite != NULL)
+        {
+            erreurs += activite->nb_paires != 2 * 64 * 4 - 1 || activite->nb_transitions != total || activite->nb_chaudes != 10;
+
+            for(int i = 0;i<activite->nb_chaudes;i++)
+            {
+                erreurs += activite->transitions_chaudes[i] != attendues[activite->chaudes[i]];
+                erreurs += i > 0 && activite->transitions_chaudes[i] > activite->transitions_chaudes[i - 1];
+            }
+
+            for(int t = 0;t<NB_TYPES_PORTES;t++)
+            {
+                erreurs += t_activite_facteur(activite, (e_types_portes)t) < 0 || t_activite_facteur(activite, (e_types_portes)t) > 1;
+            }
+        }
+
+        erreurs += t_netlist_compter_transitions(netlist, 0) == 0 || t_activite_calculer(aleatoire, 10) != NULL;
+
+        //Modifier le circuit recompile sa netlist (comptage perdu); le rapport garde ses noms
+        erreurs += t_netlist_compter_transitions(netlist, 1) == 0;
+        t_circuit_ajouter_porte(aleatoire, PORTE_NOT);
+        erreurs += t_activite_calculer(aleatoire, 10) != NULL;
+        erreurs += activite != NULL && (activite->noms_chaudes[0] == NULL || activite->noms_chaudes[0][0] != 'P');
+        t_activite_destroy(activite);
+    }
+
+    //Bascule dont l'entrée est son état inversé: 5 cycles, dont le premier ne fait qu'amorcer
+    etat = t_circuit_ajouter_porte(bascule, PORTE_DFF);
+    inverse = t_circuit_ajouter_porte(bascule, PORTE_NOT);
+    t_porte_relier(inverse, 0, t_porte_get_pin_sortie(etat));
+    t_porte_relier(etat, 0, t_porte_get_pin_sortie(inverse));
+    t_sortie_relier(t_circuit_ajouter_sortie(bascule), t_porte_get_pin_sortie(etat));
+    netlist = t_circuit_get_netlist(bascule);
+
+    if(netlist == NULL || t_netlist_compter_transitions(netlist, 1) == 0)
+    {
+        erreurs++;
+    }
+    else
+    {
+        erreurs += t_netlist_simuler_cycles(netlist, entrees, sorties, 5, 1) == 0;
+        activite = t_activite_calculer(bascule, 2);
+        erreurs += activite == NULL || activite->nb_paires != 4 * 64 || activite->transitions_types[PORTE_NOT] != 4 * 64
+                   || activite->transitions_types[PORTE_DFF] != 5 * 64 || activite->fanouts_chaudes[0] != 2;
+        t_activite_destroy(activite);
+    }
+
+    t_circuit_destroy(aleatoire);
+    t_circuit_destroy(bascule);
+    free(attendues);
+    free(precedents);
+
+    if(erreurs == 0)
+    {
+        printf("Test t_activite reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_activite (%d erreurs)\n", erreurs);
+    }
+}
@@ -0,0 +1,72 @@
+//
+// Created by cedri on 2023-12-03.
+//
+
+#ifndef PORTE_LOGIQUES_TEST_T_CIRCUIT_H
+#define PORTE_LOGIQUES_TEST_T_CIRCUIT_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "t_circuit.h"
+#include "t_simulation_parallele.h"
+#include "t_balayage.h"
+#include "t_code_natif.h"
+#include "t_optimisation.h"
+#include "t_aig.h"
+#include "t_equivalence.h"
+#include "t_fautes.h"
+#include "t_analyse_temporelle.h"
+#include "t_generateur.h"
+#include "t_table_verite.h"
+#include "t_bdd.h"
+#include "t_logique4.h"
+#include "t_activite.h"
+
+void test_t_circuit_ordonner(void);
+
+void test_t_circuit_boucle(void);
+
+void test_t_circuit_simuler_lot(void);
+
+void test_t_netlist_simuler(void);
+
+void test_t_netlist_simuler_increment(void);
+
+void test_t_simulation_parallele(void);
+
+void test_t_balayage(void);
+
+void test_t_code_natif(void);
+
+void test_t_circuit_portes_n(void);
+
+void test_t_circuit_instances(void);
+
+void test_t_circuit_sequentiel(void);
+
+void test_t_circuit_optimisation(void);
+
+void test_t_aig(void);
+
+void test_t_sat(void);
+
+void test_t_equivalence(void);
+
+void test_t_fautes(void);
+
+void test_t_analyse_temporelle(void);
+
+void test_t_generateur(void);
+
+void test_t_circuit_index_noms(void);
+
+void test_t_table_verite(void);
+
+void test_t_bdd(void);
+
+void test_t_logique4(void);
+
+void test_t_activite(void);
+
+#endif //PORTE_LOGIQUES_TEST_T_CIRCUIT_H
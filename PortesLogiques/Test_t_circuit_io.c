@@ -0,0 +1,590 @@
+//
+// Created by cedri on 2023-12-03.
+//
+
+#include "Test_t_circuit_io.h"
+
+#define FICHIER_TEST "test_t_circuit_io.tmp"
+
+//Donne à chaque entrée le mot qui énumère toutes les combinaisons: le bit v de l'entrée i vaut
+//le bit i de v (nb_entrees <= 6, un seul mot par entrée)
+static void remplir_combinaisons(uint64_t entrees[], int nb_entrees)
+{
+    for(int i = 0;i<nb_entrees;i++)
+    {
+        entrees[i] = 0;
+
+        for(int v = 0;v<(1 << nb_entrees);v++)
+        {
+            entrees[i] |= (uint64_t)((v >> i) & 1) << v;
+        }
+    }
+}
+
+//Écrit un texte dans le fichier de test
+static void ecrire_fichier_test(const char *contenu)
+{
+    FILE *fichier = fopen(FICHIER_TEST, "w");
+
+    fputs(contenu, fichier);
+    fclose(fichier);
+}
+
+//Vrai si les deux circuits donnent les mêmes sorties pour toutes les combinaisons d'entrées
+static int memes_sorties(t_circuit *circuit1, t_circuit *circuit2)
+{
+    uint64_t entrees[6];
+    uint64_t sorties1[4];
+    uint64_t sorties2[4];
+    uint64_t masque;
+
+    if(circuit2 == NULL || circuit1->nb_entrees != circuit2->nb_entrees || circuit1->nb_sorties != circuit2->nb_sorties)
+    {
+
+        return 0;
+    }
+
+    masque = circuit1->nb_entrees >= 6 ? ~(uint64_t)0 : ((uint64_t)1 << (1 << circuit1->nb_entrees)) - 1;
+    remplir_combinaisons(entrees, circuit1->nb_entrees);
+
+    if(t_circuit_simuler_lot(circuit1, entrees, sorties1, 1) == 0 || t_circuit_simuler_lot(circuit2, entrees, sorties2, 1) == 0)
+    {
+
+        return 0;
+    }
+
+    for(int j = 0;j<circuit1->nb_sorties;j++)
+    {
+        if(((sorties1[j] ^ sorties2[j]) & masque) != 0)
+        {
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+void test_t_circuit_io_aller_retour(void)
+{
+    //S0 = NOT(E0 | E1) ^ (E1 & E2), S1 = E1 & E2. Les portes sont créées de la sortie vers les
+    //entrées pour que le fichier texte utilise des portes définies plus loin.
+    t_circuit *circuit = t_circuit_init();
+    t_porte *porte_xor = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+    t_porte *porte_not = t_circuit_ajouter_porte(circuit, PORTE_NOT);
+    t_porte *porte_ou = t_circuit_ajouter_porte(circuit, PORTE_OU);
+    t_porte *porte_et = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_entree *entree0 = t_circuit_ajouter_entree(circuit);
+    t_entree *entree1 = t_circuit_ajouter_entree(circuit);
+    t_entree *entree2 = t_circuit_ajouter_entree(circuit);
+    t_sortie *sortie0 = t_circuit_ajouter_sortie(circuit);
+    t_sortie *sortie1 = t_circuit_ajouter_sortie(circuit);
+    t_circuit *copie;
+    t_circuit *redondant;
+    t_circuit *optimise;
+    int erreurs;
+
+    t_porte_relier(porte_ou, 0, t_entree_get_pin(entree0));
+    t_porte_relier(porte_ou, 1, t_entree_get_pin(entree1));
+    t_porte_relier(porte_et, 0, t_entree_get_pin(entree1));
+    t_porte_relier(porte_et, 1, t_entree_get_pin(entree2));
+    t_porte_relier(porte_not, 0, t_porte_get_pin_sortie(porte_ou));
+    t_porte_relier(porte_xor, 0, t_porte_get_pin_sortie(porte_not));
+    t_porte_relier(porte_xor, 1, t_porte_get_pin_sortie(porte_et));
+    t_sortie_relier(sortie0, t_porte_get_pin_sortie(porte_xor));
+    t_sortie_relier(sortie1, t_porte_get_pin_sortie(porte_et));
+
+    copie = t_circuit_sauvegarder_texte(circuit, FICHIER_TEST) ? t_circuit_charger_texte(FICHIER_TEST) : NULL;
+
+    if(memes_sorties(circuit, copie) && copie->nb_portes == 4 && copie->portes[0]->type == PORTE_XOR)
+    {
+        printf("Test format texte reussi\n");
+    }
+    else
+    {
+        printf("Echec du test format texte\n");
+    }
+
+    if(copie != NULL)
+    {
+        t_circuit_destroy(copie);
+    }
+
+    copie = t_circuit_sauvegarder_bench(circuit, FICHIER_TEST) ? t_circuit_charger_bench(FICHIER_TEST) : NULL;
+
+    if(memes_sorties(circuit, copie))
+    {
+        printf("Test format .bench (ecriture) reussi\n");
+    }
+    else
+    {
+        printf("Echec du test format .bench (ecriture)\n");
+    }
+
+    if(copie != NULL)
+    {
+        t_circuit_destroy(copie);
+    }
+
+    copie = t_circuit_sauvegarder_binaire(circuit, FICHIER_TEST) ? t_circuit_charger_binaire(FICHIER_TEST) : NULL;
+
+    if(memes_sorties(circuit, copie) && copie->nb_portes == 4 && copie->portes[3]->type == PORTE_ET)
+    {
+        printf("Test format binaire reussi\n");
+    }
+    else
+    {
+        printf("Echec du test format binaire\n");
+    }
+
+    if(copie != NULL)
+    {
+        t_circuit_destroy(copie);
+    }
+
+    //S0 = E0 & NOT E0 (toujours 0) et S1 = E1: une fois optimisé, E0 n'est plus lue mais le circuit
+    //reste valide et s'écrit dans chaque format
+    redondant = t_circuit_init();
+    t_circuit_ajouter_entree(redondant);
+    t_circuit_ajouter_entree(redondant);
+    porte_not = t_circuit_ajouter_porte(redondant, PORTE_NOT);
+    porte_et = t_circuit_ajouter_porte(redondant, PORTE_ET);
+    t_porte_relier(porte_not, 0, t_entree_get_pin(redondant->entrees[0]));
+    t_porte_relier(porte_et, 0, t_entree_get_pin(redondant->entrees[0]));
+    t_porte_relier(porte_et, 1, t_porte_get_pin_sortie(porte_not));
+    t_sortie_relier(t_circuit_ajouter_sortie(redondant), t_porte_get_pin_sortie(porte_et));
+    t_sortie_relier(t_circuit_ajouter_sortie(redondant), t_entree_get_pin(redondant->entrees[1]));
+    optimise = t_optimisation_simplifier(redondant, NULL);
+    erreurs = optimise == NULL || t_entree_est_reliee(optimise->entrees[0]) || t_circuit_est_valide(optimise)
+              || t_circuit_est_simulable(optimise) == 0;
+
+    for(int format = 0;format<3 && erreurs == 0;format++)
+    {
+        copie = format == 0 ? (t_circuit_sauvegarder_texte(optimise, FICHIER_TEST) ? t_circuit_charger_texte(FICHIER_TEST) : NULL)
+              : format == 1 ? (t_circuit_sauvegarder_bench(optimise, FICHIER_TEST) ? t_circuit_charger_bench(FICHIER_TEST) : NULL)
+              : (t_circuit_sauvegarder_binaire(optimise, FICHIER_TEST) ? t_circuit_charger_binaire(FICHIER_TEST) : NULL);
+        erreurs += memes_sorties(redondant, copie) == 0;
+
+        if(copie != NULL)
+        {
+            t_circuit_destroy(copie);
+        }
+    }
+
+    if(erreurs == 0)
+    {
+        printf("Test ecriture d'un circuit optimise reussi\n");
+    }
+    else
+    {
+        printf("Echec du test ecriture d'un circuit optimise (%d erreurs)\n", erreurs);
+    }
+
+    if(optimise != NULL)
+    {
+        t_circuit_destroy(optimise);
+    }
+
+    t_circuit_destroy(redondant);
+
+    //Un fichier binaire tronqué doit être refusé
+    ecrire_fichier_test("PLB1");
+
+    if(t_circuit_charger_binaire(FICHIER_TEST) == NULL)
+    {
+        printf("Test fichier binaire invalide reussi\n");
+    }
+    else
+    {
+        printf("Echec du test fichier binaire invalide\n");
+    }
+
+    //Une sortie définie deux fois doit être refusée
+    ecrire_fichier_test("ENTREES 1\nSORTIES 1\nP0 NOT E0\nS0 P0\nS0 E0\n");
+
+    if(t_circuit_charger_texte(FICHIER_TEST) == NULL)
+    {
+        printf("Test sortie texte en double reussi\n");
+    }
+    else
+    {
+        printf("Echec du test sortie texte en double\n");
+    }
+
+    remove(FICHIER_TEST);
+    t_circuit_destroy(circuit);
+}
+
+void test_t_circuit_io_bench(void)
+{
+    //c17 (ISCAS-85), avec les portes dans le désordre
+    t_circuit *circuit;
+    uint64_t entrees[5];
+    uint64_t sorties[2];
+    uint64_t g1, g2, g3, g6, g7, g10, g11, g16, g19;
+    int succes;
+
+    ecrire_fichier_test("# c17\n"
+                        "INPUT(G1)\nINPUT(G2)\nINPUT(G3)\nINPUT(G6)\nINPUT(G7)\n"
+                        "OUTPUT(G22)\nOUTPUT(G23)\n"
+                        "G22 = NAND(G10, G16)\n"
+                        "G23 = NAND(G16, G19)\n"
+                        "G10 = NAND(G1, G3)\n"
+                        "G11 = NAND(G3, G6)\n"
+                        "G16 = NAND(G2, G11)\n"
+                        "G19 = NAND(G11, G7)\n");
+    circuit = t_circuit_charger_bench(FICHIER_TEST);
+    remplir_combinaisons(entrees, 5);
+
+    //Chaque NAND devient une seule porte
+    succes = circuit != NULL && circuit->nb_entrees == 5 && circuit->nb_sorties == 2 && circuit->nb_portes == 6
+             && t_circuit_simuler_lot(circuit, entrees, sorties, 1);
+
+    g1 = entrees[0];
+    g2 = entrees[1];
+    g3 = entrees[2];
+    g6 = entrees[3];
+    g7 = entrees[4];
+    g10 = ~(g1 & g3);
+    g11 = ~(g3 & g6);
+    g16 = ~(g2 & g11);
+    g19 = ~(g11 & g7);
+
+    if(succes && (uint32_t)sorties[0] == (uint32_t)~(g10 & g16) && (uint32_t)sorties[1] == (uint32_t)~(g16 & g19))
+    {
+        printf("Test chargement .bench (c17) reussi\n");
+    }
+    else
+    {
+        printf("Echec du test chargement .bench (c17)\n");
+    }
+
+    if(circuit != NULL)
+    {
+        t_circuit_destroy(circuit);
+    }
+
+    //Un signal jamais défini doit être signalé
+    ecrire_fichier_test("INPUT(a)\nOUTPUT(b)\nb = AND(a, c)\n");
+
+    if(t_circuit_charger_bench(FICHIER_TEST) == NULL)
+    {
+        printf("Test .bench signal non defini reussi\n");
+    }
+    else
+    {
+        printf("Echec du test .bench signal non defini\n");
+    }
+
+    //Les définitions mal formées doivent être refusées
+    succes = 1;
+    ecrire_fichier_test("INPUT(a)\nOUTPUT(y)\ny = AND(a,\n");
+    succes = succes && t_circuit_charger_bench(FICHIER_TEST) == NULL;
+    ecrire_fichier_test("INPUT(a)\nINPUT(b)\nOUTPUT(y)\ny = AND a b\n");
+    succes = succes && t_circuit_charger_bench(FICHIER_TEST) == NULL;
+    ecrire_fichier_test("INPUT(a)\nOUTPUT(a)\n(\n");
+    succes = succes && t_circuit_charger_bench(FICHIER_TEST) == NULL;
+
+    if(succes)
+    {
+        printf("Test .bench lignes invalides reussi\n");
+    }
+    else
+    {
+        printf("Echec du test .bench lignes invalides\n");
+    }
+
+    remove(FICHIER_TEST);
+}
+
+void test_t_circuit_io_blif(void)
+{
+    //Additionneur complet: somme en couverture des uns, retenue en couverture des zéros
+    t_circuit *circuit;
+    uint64_t entrees[3];
+    uint64_t sorties[2];
+    uint64_t a, b, c;
+
+    ecrire_fichier_test(".model additionneur\n"
+                        ".inputs a b \\\n c\n"
+                        ".outputs somme retenue\n"
+                        ".names a b c somme\n"
+                        "100 1\n010 1\n001 1\n111 1\n"
+                        ".names a b c retenue\n"
+                        "00- 0\n0-0 0\n-00 0\n"
+                        ".end\n");
+    circuit = t_circuit_charger_blif(FICHIER_TEST);
+    remplir_combinaisons(entrees, 3);
+    a = entrees[0];
+    b = entrees[1];
+    c = entrees[2];
+
+    if(circuit != NULL && t_circuit_simuler_lot(circuit, entrees, sorties, 1)
+       && (uint8_t)sorties[0] == (uint8_t)(a ^ b ^ c) && (uint8_t)sorties[1] == (uint8_t)((a & b) | (a & c) | (b & c)))
+    {
+        printf("Test chargement BLIF reussi\n");
+    }
+    else
+    {
+        printf("Echec du test chargement BLIF\n");
+    }
+
+    if(circuit != NULL)
+    {
+        t_circuit_destroy(circuit);
+    }
+
+    //Une valeur initiale de bascule inconnue doit être refusée
+    ecrire_fichier_test(".model bascule\n.inputs a\n.outputs y\n.latch a y 5\n.end\n");
+
+    if(t_circuit_charger_blif(FICHIER_TEST) == NULL)
+    {
+        printf("Test BLIF valeur initiale invalide reussi\n");
+    }
+    else
+    {
+        printf("Echec du test BLIF valeur initiale invalide\n");
+    }
+
+    remove(FICHIER_TEST);
+}
+
+//Simule la suite de vecteurs "vecteurs" et compare les sorties écrites à "attendu"
+static int sequence_identique(t_circuit *circuit, const char *vecteurs, const char *attendu)
+{
+    FILE *entrees = tmpfile();
+    FILE *sorties = tmpfile();
+    char resultat[64] = "";
+    size_t longueur = 0;
+    int nb_cycles = -1;
+
+    if(circuit != NULL && entrees != NULL && sorties != NULL)
+    {
+        fputs(vecteurs, entrees);
+        rewind(entrees);
+        t_circuit_reinitialiser_etats(circuit);
+        nb_cycles = t_circuit_simuler_sequence(circuit, entrees, sorties);
+        rewind(sorties);
+        longueur = fread(resultat, 1, sizeof(resultat) - 1, sorties);
+        resultat[longueur] = '\0';
+    }
+
+    if(entrees != NULL)
+    {
+        fclose(entrees);
+    }
+
+    if(sorties != NULL)
+    {
+        fclose(sorties);
+    }
+
+
+    return nb_cycles == 4 && strcmp(resultat, attendu) == 0;
+}
+
+void test_t_circuit_io_sequence(void)
+{
+    //Bascule T (q change quand t vaut 1) et r, la valeur de q au cycle précédent
+    const char *vecteurs = "1\n1\n0\n# commentaire\n\n1\n";
+    const char *attendu = "00\n10\n01\n00\n";
+    t_circuit *bench;
+    t_circuit *blif;
+    FILE *entrees = tmpfile();
+    FILE *sorties = tmpfile();
+    int succes;
+
+    ecrire_fichier_test("INPUT(t)\nOUTPUT(q)\nOUTPUT(r)\n"
+                        "q = DFF(d)\nd = XOR(t, q)\nr = DFF(q)\n");
+    bench = t_circuit_charger_bench(FICHIER_TEST);
+    ecrire_fichier_test(".model bascule\n.inputs t\n.outputs q r\n"
+                        ".names t q d\n10 1\n01 1\n"
+                        ".latch d q re clk 0\n.latch q r 2\n.end\n");
+    blif = t_circuit_charger_blif(FICHIER_TEST);
+    succes = sequence_identique(bench, vecteurs, attendu) && sequence_identique(blif, vecteurs, attendu);
+
+    //Une ligne invalide arrête la simulation
+    if(succes && entrees != NULL && sorties != NULL)
+    {
+        fputs("1\n2\n", entrees);
+        rewind(entrees);
+        succes = t_circuit_simuler_sequence(bench, entrees, sorties) == -1;
+    }
+
+    if(succes)
+    {
+        printf("Test simulation d'une suite de vecteurs reussi\n");
+    }
+    else
+    {
+        printf("Echec du test simulation d'une suite de vecteurs\n");
+    }
+
+    if(entrees != NULL)
+    {
+        fclose(entrees);
+    }
+
+    if(sorties != NULL)
+    {
+        fclose(sorties);
+    }
+
+    if(bench != NULL)
+    {
+        t_circuit_destroy(bench);
+    }
+
+    if(blif != NULL)
+    {
+        t_circuit_destroy(blif);
+    }
+
+    remove(FICHIER_TEST);
+}
+
+//Lit un fichier texte de sorties de l'additionneur et compte les lignes qui diffèrent de a + b + retenue
+static int compter_sommes_fausses(const char *nom_fichier, const int operandes[], int nb_vecteurs)
+{
+    FILE *fichier = fopen(nom_fichier, "r");
+    char ligne[16];
+    int somme;
+    int erreurs = 0;
+    int v = 0;
+
+    if(fichier == NULL)
+    {
+
+        return nb_vecteurs + 1;
+    }
+
+    while(fgets(ligne, sizeof(ligne), fichier) != NULL)
+    {
+        somme = 0;
+
+        for(int j = 0;j<5;j++)
+        {
+            somme |= (ligne[j] - '0') << j;
+        }
+
+        erreurs += v >= nb_vecteurs
+                   || somme != (operandes[v] & 15) + ((operandes[v] >> 4) & 15) + (operandes[v] >> 8);
+        v++;
+    }
+
+    fclose(fichier);
+
+
+    return erreurs + (v != nb_vecteurs);
+}
+
+void test_t_vecteurs(void)
+{
+    //Additionneur de 4 bits simulé d'un fichier à l'autre, en texte et en binaire, avec et sans
+    //double tampon. Le nombre de vecteurs n'est pas un multiple de 64.
+    t_circuit *additionneur = t_generateur_additionneur(4);
+    const int nb_vecteurs = 9000;
+    int *operandes = (int*)malloc(sizeof(int) * nb_vecteurs);
+    uint64_t bloc[5 * 3];
+    FILE *fichier = fopen(FICHIER_TEST, "w");
+    t_lecteur_vecteurs *lecteur;
+    int nb_lus = 0;
+    int nb;
+    int somme;
+    int erreurs = 0;
+
+    if(additionneur == NULL || operandes == NULL || fichier == NULL)
+    {
+        erreurs++;
+    }
+
+    for(int v = 0;v<nb_vecteurs && erreurs == 0;v++)
+    {
+        operandes[v] = (int)((v * 2654435761u) >> 7) & 511;
+
+        if(v == 10)
+        {
+            fputs("# commentaire\n\n", fichier);
+        }
+
+        for(int i = 0;i<9;i++)
+        {
+            fputc('0' + ((operandes[v] >> i) & 1), fichier);
+            fputs(i == 3 ? " " : "", fichier);
+        }
+
+        fputc('\n', fichier);
+    }
+
+    if(fichier != NULL)
+    {
+        fclose(fichier);
+    }
+
+    for(int asynchrone = 0;asynchrone<2 && erreurs == 0;asynchrone++)
+    {
+        erreurs += t_vecteurs_simuler_fichiers(additionneur, FICHIER_TEST, "test_t_vecteurs_1.tmp", VECTEURS_TEXTE,
+                                               asynchrone) != nb_vecteurs;
+        erreurs += compter_sommes_fausses("test_t_vecteurs_1.tmp", operandes, nb_vecteurs);
+        erreurs += t_vecteurs_simuler_fichiers(additionneur, FICHIER_TEST, "test_t_vecteurs_2.tmp", VECTEURS_BINAIRE,
+                                               asynchrone) != nb_vecteurs;
+
+        //Relecture du fichier binaire par blocs de 3 mots (les paquets ne tombent pas sur les blocs)
+        lecteur = t_lecteur_vecteurs_ouvrir("test_t_vecteurs_2.tmp", 5, 3, asynchrone);
+        nb_lus = 0;
+
+        while(lecteur != NULL && (nb = t_lecteur_vecteurs_lire(lecteur, bloc)) > 0)
+        {
+            for(int v = 0;v<nb;v++)
+            {
+                somme = 0;
+
+                for(int j = 0;j<5;j++)
+                {
+                    somme |= (int)((bloc[j * 3 + v / 64] >> (v % 64)) & 1) << j;
+                }
+
+                erreurs += somme != (operandes[nb_lus + v] & 15) + ((operandes[nb_lus + v] >> 4) & 15)
+                                    + (operandes[nb_lus + v] >> 8);
+            }
+
+            //Les bits après le dernier vecteur valent 0
+            for(int j = 0;j<5 && nb % 64 != 0;j++)
+            {
+                erreurs += (bloc[j * 3 + nb / 64] >> (nb % 64)) != 0;
+            }
+
+            nb_lus += nb;
+        }
+
+        erreurs += lecteur == NULL || nb_lus != nb_vecteurs;
+        t_lecteur_vecteurs_fermer(lecteur);
+    }
+
+    //Un fichier binaire dont les vecteurs n'ont pas le bon nombre de signaux est refusé, ainsi qu'une
+    //ligne invalide dans un fichier texte
+    erreurs += erreurs == 0 && t_lecteur_vecteurs_ouvrir("test_t_vecteurs_2.tmp", 9, 1, 0) != NULL;
+    ecrire_fichier_test("000000000\n0000x0000\n");
+    erreurs += additionneur != NULL && t_vecteurs_simuler_fichiers(additionneur, FICHIER_TEST, "test_t_vecteurs_1.tmp",
+                                                                   VECTEURS_TEXTE, 1) != -1;
+
+    if(erreurs == 0)
+    {
+        printf("Test fichiers de vecteurs reussi\n");
+    }
+    else
+    {
+        printf("Echec du test fichiers de vecteurs (%d erreurs)\n", erreurs);
+    }
+
+    if(additionneur != NULL)
+    {
+        t_circuit_destroy(additionneur);
+    }
+
+    free(operandes);
+    remove(FICHIER_TEST);
+    remove("test_t_vecteurs_1.tmp");
+    remove("test_t_vecteurs_2.tmp");
+}
@@ -0,0 +1,25 @@
+//
+// Created by cedri on 2023-12-03.
+//
+
+#ifndef PORTE_LOGIQUES_TEST_T_CIRCUIT_IO_H
+#define PORTE_LOGIQUES_TEST_T_CIRCUIT_IO_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "t_circuit.h"
+#include "t_circuit_io.h"
+#include "t_generateur.h"
+#include "t_vecteurs.h"
+#include "t_optimisation.h"
+
+void test_t_circuit_io_aller_retour(void);
+
+void test_t_circuit_io_bench(void);
+
+void test_t_circuit_io_blif(void);
+
+void test_t_circuit_io_sequence(void);
+
+void test_t_vecteurs(void);
+#endif //PORTE_LOGIQUES_TEST_T_CIRCUIT_IO_H
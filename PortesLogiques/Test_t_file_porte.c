@@ -0,0 +1,66 @@
+//
+// Created by cedri on 2023-12-03.
+//
+
+#include "Test_t_file_porte.h"
+
+#define NB_PORTES_TEST 1000
+
+void test_t_file_porte_circulaire(void)
+{
+    t_porte *portes[NB_PORTES_TEST];
+    t_file_porte *file = t_file_porte_initialiser(4);
+    int erreurs = 0;
+
+    for(int i = 0;i<NB_PORTES_TEST;i++)
+    {
+        portes[i] = t_porte_init(i, PORTE_NOT);
+    }
+
+    //La file doit s'agrandir bien au-delà de sa capacité initiale
+    t_file_porte_enfiler_tableau(file, portes, NB_PORTES_TEST / 2);
+
+    //Une porte déjà présente n'est pas ajoutée une deuxième fois
+    t_file_porte_enfiler(file, portes[0]);
+
+    for(int i = 0;i<NB_PORTES_TEST / 4;i++)
+    {
+        if(t_file_porte_defiler(file) != portes[i])
+        {
+            erreurs++;
+        }
+    }
+
+    //Les ajouts suivants reviennent au début du tableau circulaire
+    t_file_porte_enfiler_tableau(file, &portes[NB_PORTES_TEST / 2], NB_PORTES_TEST / 2);
+
+    if(t_file_porte_contient(file, portes[0]) || !t_file_porte_contient(file, portes[NB_PORTES_TEST / 4])
+       || t_file_porte_dernier(file) != portes[NB_PORTES_TEST - 1])
+    {
+        erreurs++;
+    }
+
+    for(int i = NB_PORTES_TEST / 4;i<NB_PORTES_TEST;i++)
+    {
+        if(t_file_porte_defiler(file) != portes[i])
+        {
+            erreurs++;
+        }
+    }
+
+    if(erreurs == 0 && t_file_porte_est_vide(file))
+    {
+        printf("Test t_file_porte circulaire reussi\n");
+    }
+    else
+    {
+        printf("Echec du test t_file_porte circulaire (%d erreurs)\n", erreurs);
+    }
+
+    t_file_porte_detruire(file);
+
+    for(int i = 0;i<NB_PORTES_TEST;i++)
+    {
+        t_porte_destroy(portes[i]);
+    }
+}
@@ -0,0 +1,13 @@
+//
+// Created by cedri on 2023-12-03.
+//
+
+#ifndef PORTE_LOGIQUES_TEST_T_FILE_PORTE_H
+#define PORTE_LOGIQUES_TEST_T_FILE_PORTE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "t_file_porte.h"
+
+void test_t_file_porte_circulaire(void);
+#endif //PORTE_LOGIQUES_TEST_T_FILE_PORTE_H
@@ -0,0 +1,1778 @@
+/*
+BANC D'ESSAI DU SIMULATEUR DE CIRCUIT LOGIQUE
+
+Construit un grand circuit en grille (largeur x profondeur portes) et mesure le temps de
+construction, de validation, d'ordonnancement et de simulation, ainsi que la mémoire utilisée.
+
+La porte j de la couche d lit les sorties des portes j et j+1 de la couche d-1. La première
+couche lit seulement 16 entrées: chaque entrée alimente donc des centaines de portes.
+
+Utilisation: bench_circuit [largeur] [profondeur] [arene|malloc|io|parallele [nb_fils]|balayage [nb_fils]|natif|optimiser|aig|analyse|x|activite]
+			 bench_circuit charger fichier
+			 bench_circuit optimiser fichier
+			 bench_circuit analyse fichier
+			 bench_circuit hierarchie [nb_bits]
+			 bench_circuit sequentiel [nb_bits] [nb_cycles]
+			 bench_circuit equivalence [nb_bits]
+			 bench_circuit fautes [nb_bits|fichier] [nb_vecteurs]
+			 bench_circuit serialiser [nb_portes]
+			 bench_circuit vecteurs [nb_vecteurs]
+			 bench_circuit fonctions [nb_bits]
+			 (par défaut: 1000 x 1000 = un million de portes, construit dans l'arène du circuit)
+
+Le mode "malloc" construit la même grille avec des composants créés un à un (t_porte_init,
+t_entree_init, t_sortie_init) pour comparer le temps de construction et la mémoire maximale
+avec l'arène. Chaque mode doit être lancé dans son propre processus pour que la mémoire
+maximale mesurée soit la sienne.
+
+Le mode "io" écrit la grille dans chacun des formats de t_circuit_io (texte, .bench, binaire)
+et mesure le temps d'écriture, la taille du fichier et le temps de chargement. Le mode "charger"
+mesure le temps de chargement d'un fichier existant (par exemple un circuit ISCAS .bench),
+puis le convertit au format binaire et mesure le chargement du fichier binaire.
+
+Le mode "parallele" simule la grille avec t_simulation_parallele pour 1 à nb_fils fils (par défaut:
+le nombre de processeurs) et affiche l'accélération par rapport à un seul fil.
+
+Le mode "balayage" calcule la table de vérité complète de la grille (2^16 vecteurs) avec
+t_balayage_plage pour 1 à nb_fils fils, et affiche le nombre de vols de travail.
+
+Le mode "natif" compile la grille en code machine (t_code_natif) et compare, sur les mêmes
+vecteurs, l'interpréteur des portes (t_circuit_propager_signal), la netlist (t_circuit_simuler_lot)
+et le code compilé. La compilation coûte de l'ordre d'une milliseconde par porte (gcc -O2): préférer
+une grille de 100 x 20 pour un essai rapide.
+
+Le mode "optimiser" simplifie la grille (ou un fichier chargé) avec t_optimisation_simplifier,
+affiche le rapport (portes et niveaux avant et après) et compare le temps de simulation de la netlist
+avant et après sur les mêmes vecteurs. Dans la grille, la première couche ne lit que 16 entrées: les
+portes qui lisent la même paire d'entrées sont identiques et le partage des portes les fusionne.
+
+Le mode "aig" traduit la grille en graphe ET-inverseur (t_aig_compiler): chaque XOR y devient trois
+noeuds ET. Il affiche la taille du graphe et compare sa simulation à celle de la netlist.
+
+Le mode "analyse" fait l'analyse temporelle de la grille (ou d'un fichier chargé) avec
+t_analyse_temporelle_calculer (délais unitaires) et affiche la profondeur, le chemin critique, la
+largeur des niveaux et les statistiques de fanout.
+
+Le mode "x" simule la grille en logique à quatre valeurs (t_logique4) sur les mêmes vecteurs que la
+netlist, puis avec la première entrée à X, et affiche le coût du codage à deux rails et la proportion
+de sorties inconnues.
+
+Le mode "activite" simule la grille avec et sans le comptage des transitions de chaque porte
+(t_netlist_compter_transitions) sur les mêmes vecteurs, affiche le surcoût du comptage, puis le
+rapport d'activité (t_activite) avec les 10 portes les plus actives.
+
+Le mode "hierarchie" construit un additionneur de nb_bits bits (par défaut: 100000) de deux façons:
+avec une instance d'un additionneur complet par bit (t_circuit_ajouter_instance), puis porte par
+porte. Il compare la mémoire des deux circuits (t_circuit_get_memoire), mesure l'aplatissement et
+vérifie que les deux simulations donnent les mêmes sorties.
+
+Le mode "sequentiel" construit un compteur de nb_bits bascules (par défaut: 32) et simule nb_cycles
+cycles d'horloge (par défaut: un million) avec t_circuit_simuler_cycles, pour une seule séquence
+(un mot) puis pour 64 * NB_MOTS_LOT séquences à la fois, et affiche le nombre de cycles par seconde.
+
+Le mode "equivalence" construit un multiplicateur en tableau de nb_bits bits (par défaut: 6) et
+vérifie avec t_equivalence_verifier qu'il calcule la même chose que le multiplicateur aux
+opérandes échangés (a * b contre b * a: un problème difficile pour le solveur SAT, dont le coût
+croît très vite avec nb_bits) et que sa version optimisée (t_optimisation_simplifier).
+
+Le mode "fautes" énumère les fautes de collage d'un multiplicateur en tableau de nb_bits bits (par
+défaut: 16, la taille du circuit ISCAS c6288) ou d'un fichier, puis simule jusqu'à nb_vecteurs
+vecteurs aléatoires (par défaut: 65536) avec t_fautes et affiche la couverture par paliers.
+
+Le mode "serialiser" génère un graphe aléatoire de nb_portes portes (par défaut: 100000), puis
+transforme en texte les liens de toutes les pins sortie (t_pin_sortie_serialiser_liens) et retrouve
+chaque porte par son nom (t_circuit_trouver_porte). Il compare ces temps à ceux de l'ancienne méthode,
+qui parcourt toutes les portes pour chaque lien: elle est mesurée sur NB_PINS_PARCOURS pins et son
+temps total est extrapolé.
+
+Le mode "vecteurs" écrit nb_vecteurs vecteurs aléatoires (par défaut: 2^20) pour un multiplicateur de
+16 bits dans un fichier texte et dans un fichier binaire (t_vecteurs), puis mesure le débit d'un fichier à
+l'autre: t_circuit_simuler_sequence (un vecteur par ligne), puis t_vecteurs_simuler_fichiers sans et avec
+double tampon, en texte et en binaire. Les fichiers de sorties sont comparés entre eux.
+
+Le mode "fonctions" calcule la fonction complète de chaque sortie d'un multiplicateur de nb_bits bits
+(par défaut: 10, soit 2^20 vecteurs): table de vérité par le balayage (t_table_verite_calculer, 1 fil puis
+un fil par processeur) et BDD (t_bdd_compiler, puis t_bdd_table_verite). Il les compare à l'interpréteur
+des portes (t_circuit_propager_signal), mesuré sur NB_VECTEURS_FONCTIONS vecteurs et extrapolé aux 2^n
+vecteurs. Il construit enfin le BDD d'un additionneur de 64 bits (129 entrées), hors de portée d'une
+table, avec l'ordre entrelacé a0 b0 a1 b1...
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "t_circuit.h"
+#include "t_circuit_io.h"
+#include "t_simulation_parallele.h"
+#include "t_balayage.h"
+#include "t_code_natif.h"
+#include "t_optimisation.h"
+#include "t_aig.h"
+#include "t_equivalence.h"
+#include "t_fautes.h"
+#include "t_analyse_temporelle.h"
+#include "t_generateur.h"
+#include "t_vecteurs.h"
+#include "t_table_verite.h"
+#include "t_bdd.h"
+#include "t_logique4.h"
+#include "t_activite.h"
+
+#define NB_ENTREES_GRILLE 16
+#define NB_MOTS_LOT 4
+#define FICHIER_BENCH_IO "bench_circuit_io.tmp"
+#define FICHIER_VECTEURS_TEXTE "bench_vecteurs_texte.tmp"
+#define FICHIER_VECTEURS_BINAIRE "bench_vecteurs_binaire.tmp"
+#define FICHIER_SORTIES_REFERENCE "bench_sorties_reference.tmp"
+#define FICHIER_SORTIES "bench_sorties.tmp"
+#define NB_MOTS_PARALLELE 64
+#define NB_REPETITIONS_PARALLELE 5
+#define NB_VECTEURS_INTERPRETEUR 64
+#define NB_CYCLES_TRANCHE 4096
+#define NB_PINS_PARCOURS 200
+#define NB_VECTEURS_FONCTIONS 4096
+
+//Retourne le temps écoulé en secondes depuis une origine arbitraire
+static double temps_courant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+//Retourne la mémoire maximale utilisée par le processus (en kilo-octets)
+static long memoire_max_ko(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss;
+}
+
+//Construit la grille avec des composants alloués un à un (sans circuit ni arène), puis la détruit
+static int bench_malloc(int largeur, int profondeur)
+{
+    const e_types_portes types[3] = {PORTE_ET, PORTE_OU, PORTE_XOR};
+    t_entree *entrees[NB_ENTREES_GRILLE];
+    t_porte **portes = (t_porte**)malloc(sizeof(t_porte*) * largeur * profondeur);
+    t_sortie **sorties = (t_sortie**)malloc(sizeof(t_sortie*) * largeur);
+    t_porte *porte;
+    long memoire_debut = memoire_max_ko();
+    double debut = temps_courant();
+
+    for(int i = 0;i<NB_ENTREES_GRILLE;i++)
+    {
+        entrees[i] = t_entree_init(i);
+    }
+
+    for(int d = 0;d<profondeur;d++)
+    {
+        for(int j = 0;j<largeur;j++)
+        {
+            porte = t_porte_init(d * largeur + j, types[(d + j) % 3]);
+            portes[d * largeur + j] = porte;
+
+            if(d == 0)
+            {
+                t_porte_relier(porte, 0, t_entree_get_pin(entrees[j % NB_ENTREES_GRILLE]));
+                t_porte_relier(porte, 1, t_entree_get_pin(entrees[(j + 1) % NB_ENTREES_GRILLE]));
+            }
+            else
+            {
+                t_porte_relier(porte, 0, t_porte_get_pin_sortie(portes[(d - 1) * largeur + j]));
+                t_porte_relier(porte, 1, t_porte_get_pin_sortie(portes[(d - 1) * largeur + (j + 1) % largeur]));
+            }
+        }
+    }
+
+    for(int j = 0;j<largeur;j++)
+    {
+        sorties[j] = t_sortie_init(j);
+        t_sortie_relier(sorties[j], t_porte_get_pin_sortie(portes[(profondeur - 1) * largeur + j]));
+    }
+
+    printf("portes: %d (malloc)\n", largeur * profondeur);
+    printf("construction: %.3f s\n", temps_courant() - debut);
+    printf("memoire par porte: %.1f octets\n",
+           (memoire_max_ko() - memoire_debut) * 1024.0 / (largeur * profondeur));
+
+    debut = temps_courant();
+
+    for(int i = 0;i<largeur * profondeur;i++)
+    {
+        t_porte_destroy(portes[i]);
+    }
+
+    for(int i = 0;i<NB_ENTREES_GRILLE;i++)
+    {
+        t_entree_destroy(entrees[i]);
+    }
+
+    for(int j = 0;j<largeur;j++)
+    {
+        t_sortie_destroy(sorties[j]);
+    }
+
+    printf("destruction: %.3f s\n", temps_courant() - debut);
+    printf("memoire maximale: %ld Ko\n", memoire_max_ko());
+
+    free(portes);
+    free(sorties);
+
+
+    return 0;
+}
+
+//Taille d'un fichier en octets
+static long taille_fichier(const char *nom_fichier)
+{
+    FILE *fichier = fopen(nom_fichier, "rb");
+    long taille;
+
+    if(fichier == NULL)
+    {
+
+        return -1;
+    }
+
+    fseek(fichier, 0, SEEK_END);
+    taille = ftell(fichier);
+    fclose(fichier);
+
+
+    return taille;
+}
+
+//Charge un fichier avec la fonction de chargement correspondant à son extension
+static t_circuit *charger_selon_extension(const char *nom_fichier)
+{
+    const char *extension = strrchr(nom_fichier, '.');
+
+    if(extension != NULL && strcmp(extension, ".bench") == 0)
+    {
+
+        return t_circuit_charger_bench(nom_fichier);
+    }
+
+    if(extension != NULL && strcmp(extension, ".blif") == 0)
+    {
+
+        return t_circuit_charger_blif(nom_fichier);
+    }
+
+    if(extension != NULL && strcmp(extension, ".plb") == 0)
+    {
+
+        return t_circuit_charger_binaire(nom_fichier);
+    }
+
+
+    return t_circuit_charger_texte(nom_fichier);
+}
+
+//Écrit le circuit dans chaque format puis le recharge
+static void bench_io(t_circuit *circuit)
+{
+    const char *noms_formats[3] = {"texte", ".bench", "binaire"};
+    int (*sauvegarder[3])(t_circuit*, const char*) = {t_circuit_sauvegarder_texte, t_circuit_sauvegarder_bench,
+                                                      t_circuit_sauvegarder_binaire};
+    t_circuit *(*charger[3])(const char*) = {t_circuit_charger_texte, t_circuit_charger_bench,
+                                             t_circuit_charger_binaire};
+    t_circuit *copie;
+    double debut;
+    double duree_ecriture;
+    double duree_lecture;
+
+    for(int f = 0;f<3;f++)
+    {
+        debut = temps_courant();
+
+        if(sauvegarder[f](circuit, FICHIER_BENCH_IO) == 0)
+        {
+            continue;
+        }
+
+        duree_ecriture = temps_courant() - debut;
+        debut = temps_courant();
+        copie = charger[f](FICHIER_BENCH_IO);
+        duree_lecture = temps_courant() - debut;
+
+        printf("format %-7s: ecriture %.3f s, %ld octets, chargement %.3f s (%d portes)\n", noms_formats[f],
+               duree_ecriture, taille_fichier(FICHIER_BENCH_IO), duree_lecture, copie != NULL ? copie->nb_portes : -1);
+
+        if(copie != NULL)
+        {
+            t_circuit_destroy(copie);
+        }
+    }
+
+    remove(FICHIER_BENCH_IO);
+}
+
+//Mesure le chargement d'un fichier existant et de sa conversion au format binaire
+static int bench_charger(const char *nom_fichier)
+{
+    t_circuit *circuit;
+    double debut;
+    double duree;
+
+    debut = temps_courant();
+    circuit = charger_selon_extension(nom_fichier);
+    duree = temps_courant() - debut;
+
+    if(circuit == NULL)
+    {
+
+        return 1;
+    }
+
+    printf("%s: %d entrees, %d sorties, %d portes, chargement %.3f ms\n", nom_fichier, circuit->nb_entrees,
+           circuit->nb_sorties, circuit->nb_portes, duree * 1000.0);
+
+    if(t_circuit_sauvegarder_binaire(circuit, FICHIER_BENCH_IO))
+    {
+        t_circuit_destroy(circuit);
+        debut = temps_courant();
+        circuit = t_circuit_charger_binaire(FICHIER_BENCH_IO);
+        duree = temps_courant() - debut;
+        printf("binaire: %ld octets, chargement %.3f ms\n", taille_fichier(FICHIER_BENCH_IO), duree * 1000.0);
+        remove(FICHIER_BENCH_IO);
+    }
+
+    if(circuit != NULL)
+    {
+        t_circuit_destroy(circuit);
+    }
+
+
+    return 0;
+}
+
+//Simule la grille avec 1 à nb_fils_max fils
+static void bench_parallele(t_circuit *circuit, int nb_fils_max)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    t_simulation_parallele *simulation;
+    uint64_t *valeurs = (uint64_t*)malloc(sizeof(uint64_t) * netlist->nb_nets * NB_MOTS_PARALLELE);
+    double debut;
+    double duree;
+    double duree_un_fil = 0;
+
+    for(int i = 0;i<netlist->nb_entrees * NB_MOTS_PARALLELE;i++)
+    {
+        valeurs[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    }
+
+    for(int nb_fils = 1;nb_fils<=nb_fils_max;nb_fils++)
+    {
+        simulation = t_simulation_parallele_init(netlist, nb_fils);
+
+        if(simulation == NULL)
+        {
+            break;
+        }
+
+        //Premier lot hors mesure: plan d'évaluation et pages du tableau de valeurs
+        t_simulation_parallele_evaluer(simulation, valeurs, NB_MOTS_PARALLELE);
+        debut = temps_courant();
+
+        for(int r = 0;r<NB_REPETITIONS_PARALLELE;r++)
+        {
+            t_simulation_parallele_evaluer(simulation, valeurs, NB_MOTS_PARALLELE);
+        }
+
+        duree = (temps_courant() - debut) / NB_REPETITIONS_PARALLELE;
+
+        if(nb_fils == 1)
+        {
+            duree_un_fil = duree;
+        }
+
+        printf("%d fil(s): %.4f s par lot de %d vecteurs, %.1f M portes-mots/s, acceleration %.2f\n", nb_fils,
+               duree, 64 * NB_MOTS_PARALLELE, (double)netlist->nb_portes * NB_MOTS_PARALLELE / duree / 1e6,
+               duree_un_fil / duree);
+        t_simulation_parallele_destroy(simulation);
+    }
+
+    free(valeurs);
+}
+
+//Calcule la table de vérité de la grille avec 1 à nb_fils_max fils
+static void bench_balayage(t_circuit *circuit, int nb_fils_max)
+{
+    uint64_t nb_vecteurs = (uint64_t)1 << circuit->nb_entrees;
+    uint64_t *table = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_sorties * ((nb_vecteurs + 63) / 64));
+    long long nb_vols;
+    double debut;
+    double duree;
+    double duree_un_fil = 0;
+
+    for(int nb_fils = 1;nb_fils<=nb_fils_max;nb_fils++)
+    {
+        debut = temps_courant();
+        nb_vols = t_balayage_plage(circuit, 0, nb_vecteurs, nb_fils, table, NULL, NULL);
+        duree = temps_courant() - debut;
+
+        if(nb_fils == 1)
+        {
+            duree_un_fil = duree;
+        }
+
+        printf("balayage %d fil(s): %llu vecteurs en %.3f s (%.2f M vecteurs/s), %lld vols, acceleration %.2f\n",
+               nb_fils, (unsigned long long)nb_vecteurs, duree, nb_vecteurs / duree / 1e6, nb_vols, duree_un_fil / duree);
+    }
+
+    free(table);
+}
+
+//Traduit le circuit en graphe ET-inverseur (t_aig) et compare sa simulation à celle de la netlist
+//Analyse temporelle du circuit avec les délais unitaires
+static int bench_analyse(t_circuit *circuit)
+{
+    t_analyse_temporelle *analyse;
+    double debut;
+
+    t_circuit_get_netlist(circuit);
+    debut = temps_courant();
+    analyse = t_analyse_temporelle_calculer(circuit, NULL);
+
+    if(analyse == NULL)
+    {
+
+        return 1;
+    }
+
+    printf("analyse temporelle: %.3f s\n", temps_courant() - debut);
+    t_analyse_temporelle_afficher_rapport(analyse);
+    t_analyse_temporelle_destroy(analyse);
+
+
+    return 0;
+}
+
+static void bench_aig(t_circuit *circuit)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    uint64_t *entrees = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_entrees * NB_MOTS_PARALLELE);
+    uint64_t *sorties_netlist = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE);
+    uint64_t *sorties_aig = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE);
+    t_aig *aig;
+    double debut;
+    double duree_netlist;
+    double duree_aig;
+
+    debut = temps_courant();
+    aig = t_aig_compiler(circuit);
+    printf("traduction en graphe ET-inverseur: %.3f s\n", temps_courant() - debut);
+
+    if(aig == NULL)
+    {
+        free(entrees);
+        free(sorties_netlist);
+        free(sorties_aig);
+
+        return;
+    }
+
+    printf("graphe: %d noeuds ET, %d niveaux, %.1f Mo (netlist: %d portes, %d liens, %.1f Mo)\n", aig->nb_et,
+           aig->nb_niveaux, sizeof(uint32_t) * 2.0 * aig->nb_et / 1e6, netlist->nb_portes,
+           netlist->debut_entrees[netlist->nb_portes],
+           (sizeof(int) * (netlist->nb_portes + 1.0 + netlist->debut_entrees[netlist->nb_portes]) + netlist->nb_portes) / 1e6);
+
+    for(int i = 0;i<circuit->nb_entrees * NB_MOTS_PARALLELE;i++)
+    {
+        entrees[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    }
+
+    debut = temps_courant();
+
+    for(int r = 0;r<NB_REPETITIONS_PARALLELE;r++)
+    {
+        t_netlist_simuler_lot(netlist, entrees, sorties_netlist, NB_MOTS_PARALLELE);
+    }
+
+    duree_netlist = (temps_courant() - debut) / NB_REPETITIONS_PARALLELE;
+    debut = temps_courant();
+
+    for(int r = 0;r<NB_REPETITIONS_PARALLELE;r++)
+    {
+        t_aig_simuler_lot(aig, entrees, sorties_aig, NB_MOTS_PARALLELE);
+    }
+
+    duree_aig = (temps_courant() - debut) / NB_REPETITIONS_PARALLELE;
+    printf("simulation de %d vecteurs: netlist %.3f ms (%.1f M portes-mots/s), graphe %.3f ms (%.1f M noeuds-mots/s)\n",
+           64 * NB_MOTS_PARALLELE, duree_netlist * 1000.0, (double)netlist->nb_portes * NB_MOTS_PARALLELE / duree_netlist / 1e6,
+           duree_aig * 1000.0, (double)aig->nb_et * NB_MOTS_PARALLELE / duree_aig / 1e6);
+    printf("sorties identiques: %d\n",
+           memcmp(sorties_netlist, sorties_aig, sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE) == 0);
+
+    t_aig_destroy(aig);
+    free(entrees);
+    free(sorties_netlist);
+    free(sorties_aig);
+}
+
+//Optimise le circuit (t_optimisation) et compare la simulation avant et après sur les mêmes vecteurs
+//Compare la simulation à quatre valeurs (deux rails) à celle de la netlist, puis propage un X
+static void bench_x(t_circuit *circuit)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    size_t taille_entrees = sizeof(uint64_t) * circuit->nb_entrees * NB_MOTS_PARALLELE;
+    size_t taille_sorties = sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE;
+    uint64_t *uns = (uint64_t*)malloc(taille_entrees);
+    uint64_t *zeros = (uint64_t*)malloc(taille_entrees);
+    uint64_t *sorties_netlist = (uint64_t*)malloc(taille_sorties);
+    uint64_t *sorties_uns = (uint64_t*)malloc(taille_sorties);
+    uint64_t *sorties_zeros = (uint64_t*)malloc(taille_sorties);
+    t_logique4 *simulation = t_logique4_init(circuit);
+    long long nb_inconnues = 0;
+    double debut;
+    double duree_netlist;
+    double duree_x;
+    int differences = 0;
+
+    if(netlist == NULL || simulation == NULL || uns == NULL || zeros == NULL || sorties_netlist == NULL
+       || sorties_uns == NULL || sorties_zeros == NULL)
+    {
+        t_logique4_destroy(simulation);
+        free(uns);
+        free(zeros);
+        free(sorties_netlist);
+        free(sorties_uns);
+        free(sorties_zeros);
+
+        return;
+    }
+
+    for(int i = 0;i<circuit->nb_entrees * NB_MOTS_PARALLELE;i++)
+    {
+        uns[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+        zeros[i] = ~uns[i];
+    }
+
+    debut = temps_courant();
+
+    for(int r = 0;r<NB_REPETITIONS_PARALLELE;r++)
+    {
+        t_netlist_simuler_lot(netlist, uns, sorties_netlist, NB_MOTS_PARALLELE);
+    }
+
+    duree_netlist = (temps_courant() - debut) / NB_REPETITIONS_PARALLELE;
+    debut = temps_courant();
+
+    for(int r = 0;r<NB_REPETITIONS_PARALLELE;r++)
+    {
+        t_logique4_simuler_lot(simulation, uns, zeros, sorties_uns, sorties_zeros, NB_MOTS_PARALLELE);
+    }
+
+    duree_x = (temps_courant() - debut) / NB_REPETITIONS_PARALLELE;
+
+    for(int j = 0;j<circuit->nb_sorties * NB_MOTS_PARALLELE;j++)
+    {
+        differences += sorties_uns[j] != sorties_netlist[j] || sorties_zeros[j] != ~sorties_netlist[j];
+    }
+
+    printf("simulation de %d vecteurs: netlist %.3f ms, quatre valeurs %.3f ms (x%.2f), %d mots differents\n",
+           64 * NB_MOTS_PARALLELE, duree_netlist * 1000.0, duree_x * 1000.0, duree_x / duree_netlist, differences);
+
+    //Première entrée à X pour tous les vecteurs
+    for(int m = 0;m<NB_MOTS_PARALLELE;m++)
+    {
+        uns[m] = ~(uint64_t)0;
+        zeros[m] = ~(uint64_t)0;
+    }
+
+    t_logique4_simuler_lot(simulation, uns, zeros, sorties_uns, sorties_zeros, NB_MOTS_PARALLELE);
+
+    for(int j = 0;j<circuit->nb_sorties * NB_MOTS_PARALLELE;j++)
+    {
+        nb_inconnues += __builtin_popcountll(sorties_uns[j] & sorties_zeros[j]);
+    }
+
+    printf("premiere entree a X: %.1f %% des valeurs de sortie inconnues\n",
+           100.0 * nb_inconnues / (64.0 * NB_MOTS_PARALLELE * circuit->nb_sorties));
+
+    t_logique4_destroy(simulation);
+    free(uns);
+    free(zeros);
+    free(sorties_netlist);
+    free(sorties_uns);
+    free(sorties_zeros);
+}
+
+static void bench_activite(t_circuit *circuit)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    uint64_t *entrees = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_entrees * NB_MOTS_PARALLELE);
+    uint64_t *sorties = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE);
+    t_activite *activite;
+    double debut;
+    double duree_simple = 0;
+    double duree_comptage = 0;
+
+    if(netlist == NULL || entrees == NULL || sorties == NULL)
+    {
+        free(entrees);
+        free(sorties);
+
+        return;
+    }
+
+    for(int i = 0;i<circuit->nb_entrees * NB_MOTS_PARALLELE;i++)
+    {
+        entrees[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    }
+
+    //Les deux simulations alternent pour subir les mêmes variations de la machine
+    for(int r = 0;r<NB_REPETITIONS_PARALLELE;r++)
+    {
+        t_netlist_compter_transitions(netlist, 0);
+        debut = temps_courant();
+        t_netlist_simuler_lot(netlist, entrees, sorties, NB_MOTS_PARALLELE);
+        duree_simple += temps_courant() - debut;
+
+        t_netlist_compter_transitions(netlist, 1);
+        debut = temps_courant();
+        t_netlist_simuler_lot(netlist, entrees, sorties, NB_MOTS_PARALLELE);
+        duree_comptage += temps_courant() - debut;
+    }
+
+    printf("simulation de %d vecteurs: %.3f ms, avec comptage des transitions %.3f ms (surcout %.1f %%)\n",
+           64 * NB_MOTS_PARALLELE, duree_simple * 1000.0 / NB_REPETITIONS_PARALLELE,
+           duree_comptage * 1000.0 / NB_REPETITIONS_PARALLELE, 100.0 * (duree_comptage - duree_simple) / duree_simple);
+
+    activite = t_activite_calculer(circuit, 10);
+
+    if(activite != NULL)
+    {
+        t_activite_afficher_rapport(activite);
+    }
+
+    t_activite_destroy(activite);
+    t_netlist_compter_transitions(netlist, 0);
+    free(entrees);
+    free(sorties);
+}
+
+static int bench_optimiser(t_circuit *circuit)
+{
+    t_rapport_optimisation rapport;
+    t_circuit *optimise;
+    t_netlist *netlists[2];
+    uint64_t *entrees = (uint64_t*)malloc(sizeof(uint64_t) * (circuit->nb_entrees + 1) * NB_MOTS_PARALLELE);
+    uint64_t *sorties[2];
+    double durees[2];
+    double debut;
+    int egales;
+
+    debut = temps_courant();
+    optimise = t_optimisation_simplifier(circuit, &rapport);
+    printf("optimisation: %.3f s\n", temps_courant() - debut);
+
+    if(optimise == NULL || entrees == NULL)
+    {
+        free(entrees);
+
+        return 1;
+    }
+
+    t_optimisation_afficher_rapport(&rapport);
+
+    for(int i = 0;i<circuit->nb_entrees * NB_MOTS_PARALLELE;i++)
+    {
+        entrees[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    }
+
+    netlists[0] = t_circuit_get_netlist(circuit);
+    netlists[1] = t_circuit_get_netlist(optimise);
+
+    for(int v = 0;v<2;v++)
+    {
+        sorties[v] = (uint64_t*)malloc(sizeof(uint64_t) * (circuit->nb_sorties + 1) * NB_MOTS_PARALLELE);
+        debut = temps_courant();
+
+        for(int r = 0;r<NB_REPETITIONS_PARALLELE;r++)
+        {
+            t_netlist_simuler_lot(netlists[v], entrees, sorties[v], NB_MOTS_PARALLELE);
+        }
+
+        durees[v] = (temps_courant() - debut) / NB_REPETITIONS_PARALLELE;
+    }
+
+    egales = memcmp(sorties[0], sorties[1], sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE) == 0;
+    printf("simulation de %d vecteurs: %.3f ms avant, %.3f ms apres (acceleration %.2f), sorties identiques: %d\n",
+           64 * NB_MOTS_PARALLELE, durees[0] * 1000.0, durees[1] * 1000.0, durees[0] / durees[1], egales);
+    t_circuit_destroy(optimise);
+    free(entrees);
+    free(sorties[0]);
+    free(sorties[1]);
+
+
+    return egales == 0;
+}
+
+//Compare l'interpréteur, la netlist et le code compilé sur les mêmes vecteurs
+static void bench_natif(t_circuit *circuit)
+{
+    t_code_natif *code;
+    uint64_t *entrees = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_entrees * NB_MOTS_PARALLELE);
+    uint64_t *sorties_netlist = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE);
+    uint64_t *sorties_natives = (uint64_t*)malloc(sizeof(uint64_t) * circuit->nb_sorties * NB_MOTS_PARALLELE);
+    int *signal = (int*)malloc(sizeof(int) * circuit->nb_entrees);
+    double debut;
+    double duree_interpreteur;
+    double duree_netlist;
+    double duree_native;
+    int differences = 0;
+
+    for(int i = 0;i<circuit->nb_entrees * NB_MOTS_PARALLELE;i++)
+    {
+        entrees[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    }
+
+    debut = temps_courant();
+    code = t_code_natif_compiler(circuit);
+
+    if(code == NULL)
+    {
+        free(entrees);
+        free(sorties_netlist);
+        free(sorties_natives);
+        free(signal);
+
+        return;
+    }
+
+    printf("generation et compilation: %.3f s (dont compilateur: %.3f s)\n", temps_courant() - debut,
+           code->duree_compilation);
+
+    //Interpréteur: un vecteur à la fois (les 64 vecteurs du premier mot)
+    debut = temps_courant();
+
+    for(int k = 0;k<NB_VECTEURS_INTERPRETEUR;k++)
+    {
+        for(int i = 0;i<circuit->nb_entrees;i++)
+        {
+            signal[i] = (int)((entrees[i * NB_MOTS_PARALLELE] >> k) & 1);
+        }
+
+        t_circuit_reset(circuit);
+        t_circuit_appliquer_signal(circuit, signal, circuit->nb_entrees);
+        t_circuit_propager_signal(circuit);
+    }
+
+    duree_interpreteur = (temps_courant() - debut) / NB_VECTEURS_INTERPRETEUR;
+
+    t_circuit_simuler_lot(circuit, entrees, sorties_netlist, NB_MOTS_PARALLELE);
+    debut = temps_courant();
+    t_circuit_simuler_lot(circuit, entrees, sorties_netlist, NB_MOTS_PARALLELE);
+    duree_netlist = (temps_courant() - debut) / (64 * NB_MOTS_PARALLELE);
+
+    t_code_natif_simuler_lot(code, entrees, sorties_natives, NB_MOTS_PARALLELE);
+    debut = temps_courant();
+    t_code_natif_simuler_lot(code, entrees, sorties_natives, NB_MOTS_PARALLELE);
+    duree_native = (temps_courant() - debut) / (64 * NB_MOTS_PARALLELE);
+
+    for(int j = 0;j<circuit->nb_sorties * NB_MOTS_PARALLELE;j++)
+    {
+        differences += sorties_netlist[j] != sorties_natives[j];
+    }
+
+    printf("interpreteur: %.3f us par vecteur\n", duree_interpreteur * 1e6);
+    printf("netlist:      %.3f us par vecteur (x%.1f)\n", duree_netlist * 1e6, duree_interpreteur / duree_netlist);
+    printf("code natif:   %.3f us par vecteur (x%.1f), %d mots differents de la netlist\n", duree_native * 1e6,
+           duree_interpreteur / duree_native, differences);
+
+    t_code_natif_destroy(code);
+    free(entrees);
+    free(sorties_netlist);
+    free(sorties_natives);
+    free(signal);
+}
+
+//Ajoute un additionneur complet au circuit: somme et retenue de a, b et retenue
+static void ajouter_additionneur_complet(t_circuit *circuit, t_pin_sortie *a, t_pin_sortie *b, t_pin_sortie *retenue,
+                                         t_pin_sortie **somme, t_pin_sortie **retenue_sortie)
+{
+    t_porte *ou_exclusif = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+    t_porte *addition = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+    t_porte *et_entrees = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte *et_retenue = t_circuit_ajouter_porte(circuit, PORTE_ET);
+    t_porte *ou = t_circuit_ajouter_porte(circuit, PORTE_OU);
+
+    t_porte_relier(ou_exclusif, 0, a);
+    t_porte_relier(ou_exclusif, 1, b);
+    t_porte_relier(addition, 0, t_porte_get_pin_sortie(ou_exclusif));
+    t_porte_relier(addition, 1, retenue);
+    t_porte_relier(et_entrees, 0, a);
+    t_porte_relier(et_entrees, 1, b);
+    t_porte_relier(et_retenue, 0, t_porte_get_pin_sortie(ou_exclusif));
+    t_porte_relier(et_retenue, 1, retenue);
+    t_porte_relier(ou, 0, t_porte_get_pin_sortie(et_entrees));
+    t_porte_relier(ou, 1, t_porte_get_pin_sortie(et_retenue));
+    *somme = t_porte_get_pin_sortie(addition);
+    *retenue_sortie = t_porte_get_pin_sortie(ou);
+}
+
+//Additionneur de nb_bits bits: entrées a, b, retenue; sorties somme, retenue. Chaque bit est une
+//instance de "definition" (un additionneur complet) ou, si definition est NULL, cinq portes.
+static t_circuit *construire_additionneur(int nb_bits, t_circuit *definition)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_instance *instance;
+    t_pin_sortie *retenue;
+    t_pin_sortie *somme;
+
+    for(int i = 0;i<2 * nb_bits + 1;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+    }
+
+    retenue = t_entree_get_pin(circuit->entrees[2 * nb_bits]);
+
+    for(int b = 0;b<nb_bits;b++)
+    {
+        if(definition != NULL)
+        {
+            instance = t_circuit_ajouter_instance(circuit, definition);
+            t_instance_relier(instance, 0, t_entree_get_pin(circuit->entrees[b]));
+            t_instance_relier(instance, 1, t_entree_get_pin(circuit->entrees[nb_bits + b]));
+            t_instance_relier(instance, 2, retenue);
+            somme = t_instance_get_pin_sortie(instance, 0);
+            retenue = t_instance_get_pin_sortie(instance, 1);
+        }
+        else
+        {
+            ajouter_additionneur_complet(circuit, t_entree_get_pin(circuit->entrees[b]),
+                                         t_entree_get_pin(circuit->entrees[nb_bits + b]), retenue, &somme, &retenue);
+        }
+
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), somme);
+    }
+
+    t_sortie_relier(t_circuit_ajouter_sortie(circuit), retenue);
+
+
+    return circuit;
+}
+
+//Vérifie l'équivalence de a * b et b * a (multiplicateurs de nb_bits bits), puis d'un multiplicateur
+//et de sa version optimisée
+static int bench_equivalence(int nb_bits)
+{
+    t_circuit *produit = t_generateur_multiplicateur(nb_bits, 0);
+    t_circuit *commute = t_generateur_multiplicateur(nb_bits, 1);
+    t_circuit *optimise = t_optimisation_simplifier(produit, NULL);
+    t_circuit *circuits[2] = {commute, optimise};
+    const char *noms[2] = {"b * a", "optimise"};
+    t_rapport_equivalence rapport;
+    double debut;
+    int resultat;
+
+    printf("multiplicateur %d x %d bits: %d portes\n", nb_bits, nb_bits, produit->nb_portes);
+
+    for(int c = 0;c<2 && circuits[c] != NULL;c++)
+    {
+        debut = temps_courant();
+        resultat = t_equivalence_verifier(produit, circuits[c], NULL, &rapport);
+        printf("a * b contre %s: %s en %.3f s (%d noeuds ET, %d sorties fusionnees, %lld vecteurs simules, "
+               "%d variables, %d clauses, %lld conflits, %lld decisions)\n", noms[c],
+               resultat == EQUIVALENTS ? "equivalents" : resultat == DIFFERENTS ? "differents" : "inconnu",
+               temps_courant() - debut, rapport.nb_noeuds_et, rapport.nb_sorties_fusionnees, rapport.nb_vecteurs_simules,
+               rapport.nb_variables, rapport.nb_clauses, rapport.nb_conflits, rapport.nb_decisions);
+    }
+
+    if(optimise != NULL)
+    {
+        t_circuit_destroy(optimise);
+    }
+
+    t_circuit_destroy(produit);
+    t_circuit_destroy(commute);
+
+
+    return 0;
+}
+
+//Couverture de vecteurs aléatoires sur les fautes de collage du circuit, par paliers de vecteurs
+static int bench_fautes(t_circuit *circuit, long long nb_vecteurs)
+{
+    t_fautes *fautes;
+    long long palier = 256;
+    double debut;
+
+    debut = temps_courant();
+    fautes = t_fautes_init(circuit);
+
+    if(fautes == NULL)
+    {
+
+        return 1;
+    }
+
+    printf("%d portes, %d fautes enumerees en %.3f s\n", circuit->nb_portes, fautes->nb_fautes, temps_courant() - debut);
+    debut = temps_courant();
+
+    while(fautes->nb_vecteurs < nb_vecteurs && fautes->nb_restantes > 0)
+    {
+        palier = palier < nb_vecteurs ? palier : nb_vecteurs;
+        t_fautes_simuler_aleatoire(fautes, palier - fautes->nb_vecteurs);
+        printf("%8lld vecteurs: couverture %.2f %% (%d fautes restantes), %.3f s\n", fautes->nb_vecteurs,
+               100.0 * t_fautes_couverture(fautes), fautes->nb_restantes, temps_courant() - debut);
+        palier *= 4;
+    }
+
+    t_fautes_afficher_rapport(fautes);
+    t_fautes_destroy(fautes);
+
+
+    return 0;
+}
+
+//Ancienne transformation en texte des liens d'une pin: chaque lien est cherché parmi les entrées de
+//toutes les portes et parmi les sorties du circuit
+static void serialiser_par_parcours(t_pin_sortie *pin, t_circuit *circuit, char *resultat)
+{
+    resultat[0] = '\0';
+
+    for(int i = 0;i<pin->nb_liaisons;i++)
+    {
+        for(int j = 0;j<circuit->nb_portes;j++)
+        {
+            for(int k = 0;k<circuit->portes[j]->nb_entrees;k++)
+            {
+                if(circuit->portes[j]->entrees[k] == pin->liaisons[i])
+                {
+                    strcat(resultat, circuit->portes[j]->nom);
+                    strcat(resultat, ",");
+                }
+            }
+        }
+
+        for(int j = 0;j<circuit->nb_sorties;j++)
+        {
+            if(circuit->sorties[j]->pin == pin->liaisons[i])
+            {
+                strcat(resultat, circuit->sorties[j]->nom);
+                strcat(resultat, ",");
+            }
+        }
+    }
+
+    if(strlen(resultat) > 0)
+    {
+        resultat[strlen(resultat) - 1] = '\0';
+    }
+}
+
+//Transforme en texte les liens de toutes les pins d'un graphe aléatoire et retrouve chaque porte par son
+//nom, avec l'index des noms puis par parcours des composants
+static int bench_serialiser(int nb_portes)
+{
+    t_parametres_aleatoire parametres = {64, nb_portes, 100, 3, 8, 1};
+    t_circuit *circuit = t_generateur_aleatoire(&parametres);
+    t_pin_sortie **pins;
+    char *tampon;
+    char *reference;
+    int nb_pins;
+    int max_liaisons = 0;
+    int nb_echantillons;
+    int nb_trouvees = 0;
+    int differences = 0;
+    long long nb_caracteres = 0;
+    double debut;
+    double duree_index;
+    double duree_parcours;
+
+    if(circuit == NULL)
+    {
+
+        return 1;
+    }
+
+    nb_pins = circuit->nb_entrees + circuit->nb_portes;
+    pins = (t_pin_sortie**)malloc(sizeof(t_pin_sortie*) * nb_pins);
+
+    for(int p = 0;pins != NULL && p<nb_pins;p++)
+    {
+        pins[p] = p < circuit->nb_entrees ? circuit->entrees[p]->pin : circuit->portes[p - circuit->nb_entrees]->sortie;
+        max_liaisons = pins[p]->nb_liaisons > max_liaisons ? pins[p]->nb_liaisons : max_liaisons;
+    }
+
+    //Un nom a au plus 11 caractères (P et un entier), plus la virgule
+    tampon = (char*)malloc(12 * (max_liaisons + 1));
+    reference = (char*)malloc(12 * (max_liaisons + 1));
+
+    if(pins == NULL || tampon == NULL || reference == NULL)
+    {
+        free(pins);
+        free(tampon);
+        free(reference);
+        t_circuit_destroy(circuit);
+
+        return 1;
+    }
+
+    printf("graphe aleatoire: %d portes, %d pins sortie, %d liens au plus par pin\n", circuit->nb_portes, nb_pins,
+           max_liaisons);
+
+    debut = temps_courant();
+
+    for(int p = 0;p<nb_pins;p++)
+    {
+        t_pin_sortie_serialiser_liens(pins[p], circuit, tampon);
+        nb_caracteres += (long long)strlen(tampon);
+    }
+
+    duree_index = temps_courant() - debut;
+    nb_echantillons = nb_pins < NB_PINS_PARCOURS ? nb_pins : NB_PINS_PARCOURS;
+    debut = temps_courant();
+
+    for(int e = 0;e<nb_echantillons;e++)
+    {
+        serialiser_par_parcours(pins[(long long)e * nb_pins / nb_echantillons], circuit, reference);
+    }
+
+    duree_parcours = (temps_courant() - debut) * nb_pins / nb_echantillons;
+
+    for(int e = 0;e<nb_echantillons;e++)
+    {
+        t_pin_sortie_serialiser_liens(pins[(long long)e * nb_pins / nb_echantillons], circuit, tampon);
+        serialiser_par_parcours(pins[(long long)e * nb_pins / nb_echantillons], circuit, reference);
+        differences += strcmp(tampon, reference) != 0;
+    }
+
+    printf("serialisation des liens: %.4f s (%lld caracteres) contre %.1f s estimees par parcours des portes "
+           "(%d pins mesurees), %d differences\n", duree_index, nb_caracteres, duree_parcours, nb_echantillons,
+           differences);
+
+    debut = temps_courant();
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        nb_trouvees += t_circuit_trouver_porte(circuit, circuit->portes[k]->nom) == circuit->portes[k];
+    }
+
+    duree_index = temps_courant() - debut;
+    debut = temps_courant();
+
+    for(int e = 0;e<nb_echantillons;e++)
+    {
+        const char *nom = circuit->portes[(long long)e * circuit->nb_portes / nb_echantillons]->nom;
+        int k = 0;
+
+        while(k < circuit->nb_portes && strcmp(circuit->portes[k]->nom, nom) != 0)
+        {
+            k++;
+        }
+
+        nb_trouvees -= k == circuit->nb_portes;
+    }
+
+    duree_parcours = (temps_courant() - debut) * circuit->nb_portes / nb_echantillons;
+    printf("recherche des %d portes par leur nom: %.4f s (index construit compris, %d trouvees) contre %.1f s "
+           "estimees par parcours\n", circuit->nb_portes, duree_index, nb_trouvees, duree_parcours);
+
+    free(pins);
+    free(tampon);
+    free(reference);
+    t_circuit_destroy(circuit);
+
+
+    return differences != 0 || nb_trouvees != nb_portes;
+}
+
+//Vrai si deux fichiers de vecteurs (texte ou binaire) contiennent les mêmes vecteurs
+static int memes_vecteurs(const char *fichier1, const char *fichier2, int nb_signaux)
+{
+    t_lecteur_vecteurs *lecteur1 = t_lecteur_vecteurs_ouvrir(fichier1, nb_signaux, VECTEURS_MOTS_BLOC, 1);
+    t_lecteur_vecteurs *lecteur2 = t_lecteur_vecteurs_ouvrir(fichier2, nb_signaux, VECTEURS_MOTS_BLOC, 1);
+    uint64_t *bloc1 = (uint64_t*)malloc(sizeof(uint64_t) * (nb_signaux + 1) * VECTEURS_MOTS_BLOC);
+    uint64_t *bloc2 = (uint64_t*)malloc(sizeof(uint64_t) * (nb_signaux + 1) * VECTEURS_MOTS_BLOC);
+    int nb1 = -1;
+    int nb2 = -1;
+    int identiques = lecteur1 != NULL && lecteur2 != NULL && bloc1 != NULL && bloc2 != NULL;
+
+    while(identiques && (nb1 = t_lecteur_vecteurs_lire(lecteur1, bloc1)) > 0)
+    {
+        nb2 = t_lecteur_vecteurs_lire(lecteur2, bloc2);
+        identiques = nb1 == nb2 && memcmp(bloc1, bloc2, sizeof(uint64_t) * nb_signaux * VECTEURS_MOTS_BLOC) == 0;
+    }
+
+    identiques = identiques && nb1 == 0 && t_lecteur_vecteurs_lire(lecteur2, bloc2) == 0;
+    t_lecteur_vecteurs_fermer(lecteur1);
+    t_lecteur_vecteurs_fermer(lecteur2);
+    free(bloc1);
+    free(bloc2);
+
+
+    return identiques;
+}
+
+//Débit d'un fichier de vecteurs à l'autre: une ligne à la fois, puis par blocs sans et avec double tampon
+static int bench_vecteurs(long long nb_vecteurs)
+{
+    t_circuit *circuit = t_generateur_multiplicateur(16, 0);
+    const char *entrees[2] = {FICHIER_VECTEURS_TEXTE, FICHIER_VECTEURS_BINAIRE};
+    const char *noms_formats[2] = {"texte", "binaire"};
+    t_ecrivain_vecteurs *ecrivains[2];
+    uint64_t bloc[32 * VECTEURS_MOTS_BLOC];
+    uint64_t etat = 0x9E3779B97F4A7C15ull;
+    FILE *fichier_entrees;
+    FILE *fichier_sorties;
+    long long nb_simules;
+    long long reste;
+    double debut;
+    double duree;
+    int identiques = 1;
+
+    if(circuit == NULL || nb_vecteurs < 1)
+    {
+
+        return 1;
+    }
+
+    ecrivains[0] = t_ecrivain_vecteurs_ouvrir(FICHIER_VECTEURS_TEXTE, VECTEURS_TEXTE, 32, VECTEURS_MOTS_BLOC, 1);
+    ecrivains[1] = t_ecrivain_vecteurs_ouvrir(FICHIER_VECTEURS_BINAIRE, VECTEURS_BINAIRE, 32, VECTEURS_MOTS_BLOC, 1);
+    debut = temps_courant();
+
+    for(reste = nb_vecteurs;reste > 0 && ecrivains[0] != NULL && ecrivains[1] != NULL;reste -= 64 * VECTEURS_MOTS_BLOC)
+    {
+        for(int m = 0;m<32 * VECTEURS_MOTS_BLOC;m++)
+        {
+            etat ^= etat >> 12;
+            etat ^= etat << 25;
+            etat ^= etat >> 27;
+            bloc[m] = etat * 0x2545F4914F6CDD1Dull;
+        }
+
+        for(int f = 0;f<2;f++)
+        {
+            t_ecrivain_vecteurs_ecrire(ecrivains[f], bloc, reste < 64 * VECTEURS_MOTS_BLOC ? (int)reste : 64 * VECTEURS_MOTS_BLOC);
+        }
+    }
+
+    if(t_ecrivain_vecteurs_fermer(ecrivains[0]) == 0 || t_ecrivain_vecteurs_fermer(ecrivains[1]) == 0)
+    {
+        t_circuit_destroy(circuit);
+
+        return 1;
+    }
+
+    printf("multiplicateur 16 x 16 bits (%d portes): %lld vecteurs ecrits en %.3f s (texte %ld octets, binaire %ld octets)\n",
+           circuit->nb_portes, nb_vecteurs, temps_courant() - debut, taille_fichier(FICHIER_VECTEURS_TEXTE),
+           taille_fichier(FICHIER_VECTEURS_BINAIRE));
+
+    //Ancienne méthode: un vecteur par ligne, lu, simulé et écrit avant le suivant
+    fichier_entrees = fopen(FICHIER_VECTEURS_TEXTE, "r");
+    fichier_sorties = fopen(FICHIER_SORTIES_REFERENCE, "w");
+    debut = temps_courant();
+    nb_simules = fichier_entrees != NULL && fichier_sorties != NULL
+                 ? t_circuit_simuler_sequence(circuit, fichier_entrees, fichier_sorties) : -1;
+
+    if(fichier_entrees != NULL)
+    {
+        fclose(fichier_entrees);
+    }
+
+    if(fichier_sorties != NULL)
+    {
+        fclose(fichier_sorties);
+    }
+
+    duree = temps_courant() - debut;
+    printf("%-34s %9.3f s %12.0f vecteurs/s\n", "texte -> texte, une ligne a la fois", duree, nb_simules / duree);
+
+    for(int f = 0;f<2;f++)
+    {
+        for(int asynchrone = 0;asynchrone<2;asynchrone++)
+        {
+            debut = temps_courant();
+            nb_simules = t_vecteurs_simuler_fichiers(circuit, entrees[f], FICHIER_SORTIES, (e_format_vecteurs)f, asynchrone);
+            duree = temps_courant() - debut;
+            identiques = identiques && nb_simules == nb_vecteurs
+                         && memes_vecteurs(FICHIER_SORTIES, FICHIER_SORTIES_REFERENCE, 32);
+            printf("%-7s -> %-7s %-18s %9.3f s %12.0f vecteurs/s\n", noms_formats[f], noms_formats[f],
+                   asynchrone ? "double tampon" : "sans double tampon", duree, nb_simules / duree);
+        }
+    }
+
+    printf("sorties %s\n", identiques ? "identiques" : "DIFFERENTES");
+    remove(FICHIER_VECTEURS_TEXTE);
+    remove(FICHIER_VECTEURS_BINAIRE);
+    remove(FICHIER_SORTIES_REFERENCE);
+    remove(FICHIER_SORTIES);
+    t_circuit_destroy(circuit);
+
+
+    return identiques == 0;
+}
+
+//Table de vérité et BDD d'un multiplicateur, comparés à un appel de t_circuit_propager_signal par vecteur
+static int bench_fonctions(int nb_bits)
+{
+    t_circuit *circuit = t_generateur_multiplicateur(nb_bits, 0);
+    t_circuit *additionneur = t_generateur_additionneur(64);
+    t_table_verite *table = NULL;
+    t_table_verite *deroulee = NULL;
+    t_bdd *bdd = NULL;
+    int signal[2 * 16];
+    int ordre[129];
+    int nb_fils = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int differences = 0;
+    int taille_max = 0;
+    int taille;
+    double debut;
+    double duree_interpreteur;
+    double duree;
+
+    if(circuit == NULL || additionneur == NULL || 2 * nb_bits > TABLE_VERITE_MAX_ENTREES || nb_bits > 16)
+    {
+        printf("nb_bits invalide (au plus %d)\n", TABLE_VERITE_MAX_ENTREES / 2);
+
+        if(circuit != NULL)
+        {
+            t_circuit_destroy(circuit);
+        }
+
+        if(additionneur != NULL)
+        {
+            t_circuit_destroy(additionneur);
+        }
+
+        return 1;
+    }
+
+    printf("multiplicateur %d bits: %d portes, %d entrees, %llu vecteurs\n", nb_bits, circuit->nb_portes,
+           circuit->nb_entrees, 1ull << circuit->nb_entrees);
+
+    debut = temps_courant();
+    table = t_table_verite_calculer(circuit, 1);
+    duree = temps_courant() - debut;
+    printf("table de verite (1 fil):    %9.3f s\n", duree);
+
+    if(nb_fils > 1)
+    {
+        debut = temps_courant();
+        deroulee = t_table_verite_calculer(circuit, nb_fils);
+        printf("table de verite (%d fils):  %9.3f s\n", nb_fils, temps_courant() - debut);
+        differences += deroulee == NULL || table == NULL || t_table_verite_comparer(table, deroulee) != -1;
+        t_table_verite_destroy(deroulee);
+    }
+
+    //Interpréteur: un vecteur à la fois, sur les premiers vecteurs de la table
+    debut = temps_courant();
+
+    for(int v = 0;v<NB_VECTEURS_FONCTIONS && table != NULL;v++)
+    {
+        for(int i = 0;i<circuit->nb_entrees;i++)
+        {
+            signal[i] = (v >> i) & 1;
+        }
+
+        t_circuit_reset(circuit);
+        t_circuit_appliquer_signal(circuit, signal, circuit->nb_entrees);
+        t_circuit_propager_signal(circuit);
+
+        for(int j = 0;j<circuit->nb_sorties;j++)
+        {
+            differences += t_sortie_get_valeur(circuit->sorties[j]) != t_table_verite_valeur(table, j, (uint64_t)v);
+        }
+    }
+
+    duree_interpreteur = (temps_courant() - debut) / NB_VECTEURS_FONCTIONS * (double)(1ull << circuit->nb_entrees);
+    printf("interpreteur (extrapole):   %9.3f s (x%.0f)\n", duree_interpreteur, duree_interpreteur / duree);
+
+    debut = temps_courant();
+    bdd = t_bdd_compiler(circuit, NULL, 0);
+    duree = temps_courant() - debut;
+
+    if(bdd != NULL)
+    {
+        for(int j = 0;j<bdd->nb_sorties;j++)
+        {
+            taille = t_bdd_taille(bdd, bdd->sorties[j]);
+            taille_max = taille > taille_max ? taille : taille_max;
+        }
+
+        printf("BDD:                        %9.3f s, %d noeuds (plus grande sortie: %d), cache: %.1f %% de succes\n",
+               duree, bdd->nb_noeuds, taille_max, 100.0 * bdd->nb_succes_cache / (bdd->nb_calculs + 1));
+        debut = temps_courant();
+        deroulee = t_bdd_table_verite(bdd);
+        printf("BDD deroule en table:       %9.3f s\n", temps_courant() - debut);
+        differences += deroulee == NULL || table == NULL || t_table_verite_comparer(table, deroulee) != -1;
+        t_table_verite_destroy(deroulee);
+        t_bdd_destroy(bdd);
+    }
+
+    //Additionneur de 64 bits (a0..a63, b0..b63, retenue): ordre entrelacé
+    for(int i = 0;i<64;i++)
+    {
+        ordre[2 * i] = i;
+        ordre[2 * i + 1] = 64 + i;
+    }
+
+    ordre[128] = 128;
+    debut = temps_courant();
+    bdd = t_bdd_compiler(additionneur, ordre, 0);
+    duree = temps_courant() - debut;
+
+    if(bdd != NULL)
+    {
+        printf("additionneur 64 bits:       %9.3f s, %d noeuds, retenue: %d noeuds, %.4g solutions sur 2^129\n", duree,
+               bdd->nb_noeuds, t_bdd_taille(bdd, bdd->sorties[64]), t_bdd_nb_solutions(bdd, bdd->sorties[64]));
+        t_bdd_destroy(bdd);
+    }
+
+    printf("%d differences\n", differences);
+    t_table_verite_destroy(table);
+    t_circuit_destroy(circuit);
+    t_circuit_destroy(additionneur);
+
+
+    return differences != 0;
+}
+
+//Compare un additionneur fait d'instances d'un additionneur complet au même circuit construit porte par porte
+static int bench_hierarchie(int nb_bits)
+{
+    t_circuit *complet;
+    t_circuit *hierarchique;
+    t_circuit *plat;
+    t_circuit *aplati;
+    t_pin_sortie *somme;
+    t_pin_sortie *retenue;
+    uint64_t *entrees;
+    uint64_t *sorties_hierarchiques;
+    uint64_t *sorties_plates;
+    size_t memoire_hierarchique;
+    size_t memoire_plate;
+    double debut;
+    int identiques;
+
+    if(nb_bits < 1)
+    {
+        printf("Utilisation: bench_circuit hierarchie [nb_bits >= 1]\n");
+
+        return 1;
+    }
+
+    complet = t_circuit_init();
+
+    for(int i = 0;i<3;i++)
+    {
+        t_circuit_ajouter_entree(complet);
+    }
+
+    ajouter_additionneur_complet(complet, t_entree_get_pin(complet->entrees[0]), t_entree_get_pin(complet->entrees[1]),
+                                 t_entree_get_pin(complet->entrees[2]), &somme, &retenue);
+    t_sortie_relier(t_circuit_ajouter_sortie(complet), somme);
+    t_sortie_relier(t_circuit_ajouter_sortie(complet), retenue);
+
+    debut = temps_courant();
+    hierarchique = construire_additionneur(nb_bits, complet);
+    printf("additionneur de %d bits, %d instances: construction %.3f s\n", nb_bits, hierarchique->nb_instances,
+           temps_courant() - debut);
+    debut = temps_courant();
+    plat = construire_additionneur(nb_bits, NULL);
+    printf("additionneur de %d bits, %d portes: construction %.3f s\n", nb_bits, plat->nb_portes,
+           temps_courant() - debut);
+
+    //La définition est partagée: elle n'est comptée qu'une fois
+    memoire_hierarchique = t_circuit_get_memoire(hierarchique) + t_circuit_get_memoire(complet);
+    memoire_plate = t_circuit_get_memoire(plat);
+    printf("memoire: hierarchique %zu Ko, plat %zu Ko (%.1f fois moins)\n", memoire_hierarchique / 1024,
+           memoire_plate / 1024, (double)memoire_plate / memoire_hierarchique);
+
+    debut = temps_courant();
+    aplati = t_circuit_aplatir(hierarchique);
+    printf("aplatissement: %.3f s (%d portes)\n", temps_courant() - debut, aplati != NULL ? aplati->nb_portes : 0);
+
+    entrees = (uint64_t*)malloc(sizeof(uint64_t) * (2 * nb_bits + 1) * NB_MOTS_LOT);
+    sorties_hierarchiques = (uint64_t*)malloc(sizeof(uint64_t) * (nb_bits + 1) * NB_MOTS_LOT);
+    sorties_plates = (uint64_t*)malloc(sizeof(uint64_t) * (nb_bits + 1) * NB_MOTS_LOT);
+
+    for(int i = 0;i<(2 * nb_bits + 1) * NB_MOTS_LOT;i++)
+    {
+        entrees[i] = 0x9E3779B97F4A7C15ull * (uint64_t)(i + 1);
+    }
+
+    //La première simulation du circuit hiérarchique l'aplatit et compile la netlist
+    debut = temps_courant();
+    t_circuit_simuler_lot(hierarchique, entrees, sorties_hierarchiques, NB_MOTS_LOT);
+    printf("simulation hierarchique (aplatissement et netlist compris): %.3f s\n", temps_courant() - debut);
+    debut = temps_courant();
+    t_circuit_simuler_lot(plat, entrees, sorties_plates, NB_MOTS_LOT);
+    printf("simulation plate (netlist comprise): %.3f s\n", temps_courant() - debut);
+
+    identiques = memcmp(sorties_hierarchiques, sorties_plates, sizeof(uint64_t) * (nb_bits + 1) * NB_MOTS_LOT) == 0;
+    printf("sorties %s\n", identiques ? "identiques" : "DIFFERENTES");
+    printf("memoire maximale: %ld Ko\n", memoire_max_ko());
+
+    t_circuit_destroy(aplati);
+    t_circuit_destroy(hierarchique);
+    t_circuit_destroy(plat);
+    t_circuit_destroy(complet);
+    free(entrees);
+    free(sorties_hierarchiques);
+    free(sorties_plates);
+
+
+    return identiques == 0;
+}
+
+//Simule nb_cycles cycles du compteur par tranches de NB_CYCLES_TRANCHE cycles; retourne le nombre de cycles par seconde
+static double bench_cycles(t_circuit *circuit, int nb_cycles, int nb_mots, uint64_t *entrees, uint64_t *sorties)
+{
+    double debut;
+    int nb;
+
+    t_circuit_reinitialiser_etats(circuit);
+    debut = temps_courant();
+
+    for(int c = 0;c<nb_cycles;c += NB_CYCLES_TRANCHE)
+    {
+        nb = nb_cycles - c < NB_CYCLES_TRANCHE ? nb_cycles - c : NB_CYCLES_TRANCHE;
+        t_circuit_simuler_cycles(circuit, entrees, sorties, nb, nb_mots);
+    }
+
+
+    return nb_cycles / (temps_courant() - debut);
+}
+
+//Compteur de nb_bits bascules (une bascule, un XOR et un ET par bit) simulé cycle par cycle
+static int bench_sequentiel(int nb_bits, int nb_cycles)
+{
+    t_circuit *circuit = t_circuit_init();
+    t_porte *bascule;
+    t_porte *inversion;
+    t_porte *retenue;
+    t_pin_sortie *propagation;
+    uint64_t *entrees;
+    uint64_t *sorties;
+    double cycles_par_seconde;
+
+    if(nb_bits < 1 || nb_cycles < 1)
+    {
+        printf("Utilisation: bench_circuit sequentiel [nb_bits >= 1] [nb_cycles >= 1]\n");
+        t_circuit_destroy(circuit);
+
+        return 1;
+    }
+
+    t_circuit_ajouter_entree(circuit);
+    propagation = t_entree_get_pin(circuit->entrees[0]);
+
+    for(int i = 0;i<nb_bits;i++)
+    {
+        bascule = t_circuit_ajouter_porte(circuit, PORTE_DFF);
+        inversion = t_circuit_ajouter_porte(circuit, PORTE_XOR);
+        retenue = t_circuit_ajouter_porte(circuit, PORTE_ET);
+        t_porte_relier(inversion, 0, t_porte_get_pin_sortie(bascule));
+        t_porte_relier(inversion, 1, propagation);
+        t_porte_relier(bascule, 0, t_porte_get_pin_sortie(inversion));
+        t_porte_relier(retenue, 0, t_porte_get_pin_sortie(bascule));
+        t_porte_relier(retenue, 1, propagation);
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(bascule));
+        propagation = t_porte_get_pin_sortie(retenue);
+    }
+
+    t_sortie_relier(t_circuit_ajouter_sortie(circuit), propagation);
+
+    entrees = (uint64_t*)malloc(sizeof(uint64_t) * NB_CYCLES_TRANCHE * NB_MOTS_LOT);
+    sorties = (uint64_t*)malloc(sizeof(uint64_t) * NB_CYCLES_TRANCHE * (nb_bits + 1) * NB_MOTS_LOT);
+
+    //Le compteur avance à chaque cycle: toutes les bascules finissent par changer
+    for(int i = 0;i<NB_CYCLES_TRANCHE * NB_MOTS_LOT;i++)
+    {
+        entrees[i] = ~(uint64_t)0;
+    }
+
+    printf("compteur de %d bits: %d portes, %d niveaux\n", nb_bits, circuit->nb_portes,
+           t_circuit_get_netlist(circuit)->nb_niveaux);
+
+    cycles_par_seconde = bench_cycles(circuit, nb_cycles, 1, entrees, sorties);
+    printf("%d cycles, 1 sequence: %.2f M cycles/s (%.1f M portes/s)\n", nb_cycles, cycles_par_seconde / 1e6,
+           cycles_par_seconde * circuit->nb_portes / 1e6);
+
+    cycles_par_seconde = bench_cycles(circuit, nb_cycles, NB_MOTS_LOT, entrees, sorties);
+    printf("%d cycles, %d sequences: %.2f M cycles/s (%.1f M sequences-cycles/s)\n", nb_cycles, 64 * NB_MOTS_LOT,
+           cycles_par_seconde / 1e6, cycles_par_seconde * 64 * NB_MOTS_LOT / 1e6);
+
+    t_circuit_destroy(circuit);
+    free(entrees);
+    free(sorties);
+
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int largeur = argc > 1 ? atoi(argv[1]) : 1000;
+    int profondeur = argc > 2 ? atoi(argv[2]) : 1000;
+    const e_types_portes types[3] = {PORTE_ET, PORTE_OU, PORTE_XOR};
+    t_circuit *circuit;
+    t_porte **couche_precedente;
+    t_porte **couche;
+    t_porte **echange;
+    t_pin_sortie *source_a;
+    t_pin_sortie *source_b;
+    uint64_t *entrees;
+    uint64_t *sorties;
+    long memoire_debut;
+    double debut;
+    double duree;
+    int valide;
+
+    if(argc > 2 && strcmp(argv[1], "charger") == 0)
+    {
+
+        return bench_charger(argv[2]);
+    }
+
+    if(argc > 2 && strcmp(argv[1], "optimiser") == 0)
+    {
+        circuit = charger_selon_extension(argv[2]);
+        valide = circuit != NULL && bench_optimiser(circuit) == 0;
+
+        if(circuit != NULL)
+        {
+            t_circuit_destroy(circuit);
+        }
+
+        return valide == 0;
+    }
+
+    if(argc > 2 && strcmp(argv[1], "analyse") == 0)
+    {
+        circuit = charger_selon_extension(argv[2]);
+        valide = circuit != NULL && bench_analyse(circuit) == 0;
+
+        if(circuit != NULL)
+        {
+            t_circuit_destroy(circuit);
+        }
+
+        return valide == 0;
+    }
+
+    if(argc > 1 && strcmp(argv[1], "hierarchie") == 0)
+    {
+
+        return bench_hierarchie(argc > 2 ? atoi(argv[2]) : 100000);
+    }
+
+    if(argc > 1 && strcmp(argv[1], "sequentiel") == 0)
+    {
+
+        return bench_sequentiel(argc > 2 ? atoi(argv[2]) : 32, argc > 3 ? atoi(argv[3]) : 1000000);
+    }
+
+    if(argc > 1 && strcmp(argv[1], "vecteurs") == 0)
+    {
+
+        return bench_vecteurs(argc > 2 ? atoll(argv[2]) : 1 << 20);
+    }
+
+    if(argc > 1 && strcmp(argv[1], "fonctions") == 0)
+    {
+
+        return bench_fonctions(argc > 2 ? atoi(argv[2]) : 10);
+    }
+
+    if(argc > 1 && strcmp(argv[1], "serialiser") == 0)
+    {
+
+        return bench_serialiser(argc > 2 ? atoi(argv[2]) : 100000);
+    }
+
+    if(argc > 1 && strcmp(argv[1], "equivalence") == 0)
+    {
+
+        return bench_equivalence(argc > 2 ? atoi(argv[2]) : 6);
+    }
+
+    if(argc > 1 && strcmp(argv[1], "fautes") == 0)
+    {
+        if(argc > 2 && atoi(argv[2]) <= 0)
+        {
+            circuit = charger_selon_extension(argv[2]);
+        }
+        else
+        {
+            circuit = t_generateur_multiplicateur(argc > 2 ? atoi(argv[2]) : 16, 0);
+        }
+
+        valide = circuit != NULL && bench_fautes(circuit, argc > 3 ? atoll(argv[3]) : 65536) == 0;
+
+        if(circuit != NULL)
+        {
+            t_circuit_destroy(circuit);
+        }
+
+        return valide == 0;
+    }
+
+    if(largeur < 2 || profondeur < 1)
+    {
+        printf("Utilisation: bench_circuit [largeur >= 2] [profondeur >= 1] [arene|malloc|io|parallele [nb_fils]|balayage [nb_fils]|natif|optimiser|aig|analyse]\n"
+               "             bench_circuit charger fichier\n"
+               "             bench_circuit optimiser fichier\n"
+               "             bench_circuit analyse fichier\n"
+               "             bench_circuit hierarchie [nb_bits]\n"
+               "             bench_circuit sequentiel [nb_bits] [nb_cycles]\n"
+               "             bench_circuit equivalence [nb_bits]\n"
+               "             bench_circuit fautes [nb_bits|fichier] [nb_vecteurs]\n"
+               "             bench_circuit serialiser [nb_portes]\n"
+               "             bench_circuit vecteurs [nb_vecteurs]\n");
+
+        return 1;
+    }
+
+    if(argc > 3 && strcmp(argv[3], "malloc") == 0)
+    {
+
+        return bench_malloc(largeur, profondeur);
+    }
+
+    couche_precedente = (t_porte**)malloc(sizeof(t_porte*) * largeur);
+    couche = (t_porte**)malloc(sizeof(t_porte*) * largeur);
+    entrees = (uint64_t*)malloc(sizeof(uint64_t) * NB_ENTREES_GRILLE * NB_MOTS_LOT);
+    sorties = (uint64_t*)malloc(sizeof(uint64_t) * largeur * NB_MOTS_LOT);
+    memoire_debut = memoire_max_ko();
+
+    //Construction
+    debut = temps_courant();
+    circuit = t_circuit_init();
+
+    for(int i = 0;i<NB_ENTREES_GRILLE;i++)
+    {
+        t_circuit_ajouter_entree(circuit);
+    }
+
+    for(int d = 0;d<profondeur;d++)
+    {
+        for(int j = 0;j<largeur;j++)
+        {
+            couche[j] = t_circuit_ajouter_porte(circuit, types[(d + j) % 3]);
+
+            if(d == 0)
+            {
+                source_a = t_entree_get_pin(circuit->entrees[j % NB_ENTREES_GRILLE]);
+                source_b = t_entree_get_pin(circuit->entrees[(j + 1) % NB_ENTREES_GRILLE]);
+            }
+            else
+            {
+                source_a = t_porte_get_pin_sortie(couche_precedente[j]);
+                source_b = t_porte_get_pin_sortie(couche_precedente[(j + 1) % largeur]);
+            }
+
+            t_porte_relier(couche[j], 0, source_a);
+            t_porte_relier(couche[j], 1, source_b);
+        }
+
+        echange = couche_precedente;
+        couche_precedente = couche;
+        couche = echange;
+    }
+
+    for(int j = 0;j<largeur;j++)
+    {
+        t_sortie_relier(t_circuit_ajouter_sortie(circuit), t_porte_get_pin_sortie(couche_precedente[j]));
+    }
+
+    printf("portes: %d, entrees: %d, sorties: %d\n", circuit->nb_portes, circuit->nb_entrees, circuit->nb_sorties);
+    printf("construction: %.3f s\n", temps_courant() - debut);
+    printf("memoire par porte: %.1f octets\n",
+           (memoire_max_ko() - memoire_debut) * 1024.0 / circuit->nb_portes);
+
+    debut = temps_courant();
+    valide = t_circuit_est_valide(circuit);
+    printf("circuit valide: %d (%.3f s)\n", valide, temps_courant() - debut);
+
+    debut = temps_courant();
+    t_circuit_ordonner(circuit);
+    printf("ordonnancement: %d niveaux (%.3f s)\n", circuit->nb_niveaux, temps_courant() - debut);
+
+    debut = temps_courant();
+    t_circuit_get_netlist(circuit);
+    printf("compilation netlist: %.3f s\n", temps_courant() - debut);
+
+    for(int i = 0;i<NB_ENTREES_GRILLE * NB_MOTS_LOT;i++)
+    {
+        entrees[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    }
+
+    debut = temps_courant();
+    t_circuit_simuler_lot(circuit, entrees, sorties, NB_MOTS_LOT);
+    duree = temps_courant() - debut;
+    printf("simulation de %d vecteurs: %.3f s (%.1f M portes-mots/s)\n", 64 * NB_MOTS_LOT, duree,
+           (double)circuit->nb_portes * NB_MOTS_LOT / duree / 1e6);
+
+    printf("memoire maximale: %ld Ko\n", memoire_max_ko());
+
+    if(argc > 3 && strcmp(argv[3], "io") == 0)
+    {
+        bench_io(circuit);
+    }
+
+    if(argc > 3 && strcmp(argv[3], "parallele") == 0)
+    {
+        bench_parallele(circuit, argc > 4 ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN));
+    }
+
+    if(argc > 3 && strcmp(argv[3], "balayage") == 0)
+    {
+        bench_balayage(circuit, argc > 4 ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN));
+    }
+
+    if(argc > 3 && strcmp(argv[3], "natif") == 0)
+    {
+        bench_natif(circuit);
+    }
+
+    if(argc > 3 && strcmp(argv[3], "optimiser") == 0)
+    {
+        bench_optimiser(circuit);
+    }
+
+    if(argc > 3 && strcmp(argv[3], "aig") == 0)
+    {
+        bench_aig(circuit);
+    }
+
+    if(argc > 3 && strcmp(argv[3], "analyse") == 0)
+    {
+        bench_analyse(circuit);
+    }
+
+    if(argc > 3 && strcmp(argv[3], "x") == 0)
+    {
+        bench_x(circuit);
+    }
+
+    if(argc > 3 && strcmp(argv[3], "activite") == 0)
+    {
+        bench_activite(circuit);
+    }
+
+    debut = temps_courant();
+    t_circuit_destroy(circuit);
+    printf("destruction: %.3f s\n", temps_courant() - debut);
+    free(couche_precedente);
+    free(couche);
+    free(entrees);
+    free(sorties);
+
+
+    return 0;
+}
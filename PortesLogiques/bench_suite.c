@@ -0,0 +1,323 @@
+/*
+SUITE DE BANCS D'ESSAI DES MOTEURS DE SIMULATION
+
+Génère des circuits paramétrés (t_generateur) et mesure, pour chacun:
+- le temps de construction, de validation (t_circuit_est_valide), d'ordonnancement et de
+  compilation en netlist;
+- pour chaque moteur de simulation, le nombre de vecteurs simulés par seconde et le nombre
+  d'évaluations de portes par seconde (portes du circuit x vecteurs):
+  - "interpreteur": t_circuit_appliquer_signal et t_circuit_propager_signal, un vecteur à la fois;
+  - "netlist": t_netlist_simuler_lot, 64 vecteurs par mot;
+  - "parallele": t_simulation_parallele_simuler_lot avec nb_fils fils;
+  - "aig": t_aig_simuler_lot sur le graphe ET-inverseur (les évaluations comptent les portes du
+    circuit, pas les noeuds ET).
+  Chaque moteur est aussi comparé à la netlist sur les mêmes vecteurs (colonne "identique").
+
+Circuits (la taille est multipliée par l'échelle): additionneur de 256 bits, multiplicateur de
+16 x 16 bits, arbre de parité de 4096 entrées, graphe aléatoire large (100000 portes sur 50
+niveaux) et graphe aléatoire profond (100000 portes sur 2000 niveaux).
+
+Les résultats sont écrits au format CSV (une ligne par circuit et par moteur, précédée d'une ligne
+d'en-tête) sur la sortie standard ou dans un fichier; la progression est affichée sur la sortie
+d'erreur.
+
+Utilisation: bench_suite [echelle] [nb_fils] [fichier.csv]
+			 (par défaut: échelle 1, nb_fils = nombre de processeurs, sortie standard)
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "t_circuit.h"
+#include "t_simulation_parallele.h"
+#include "t_aig.h"
+#include "t_generateur.h"
+
+#define NB_CIRCUITS_SUITE 5
+#define NB_MOTEURS_SUITE 4
+#define NB_MOTS_SUITE 16 //Mots de 64 vecteurs par lot simulé
+#define DUREE_MESURE_SUITE 0.25 //Durée minimale de la mesure de chaque moteur (en secondes)
+
+/*
+Moteurs de simulation d'un circuit.
+*/
+typedef struct {
+	t_circuit *circuit;
+	t_netlist *netlist;
+	t_simulation_parallele *parallele;
+	t_aig *aig;
+	int *signal; //Vecteur de l'interpréteur
+} t_moteurs_suite;
+
+//Simule un lot (ou un seul vecteur pour l'interpréteur); retourne le nombre de vecteurs simulés
+typedef long long (*t_simulateur_suite)(t_moteurs_suite *moteurs, const uint64_t entrees[], uint64_t sorties[]);
+
+//Retourne le temps écoulé en secondes depuis une origine arbitraire
+static double temps_courant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+//Interpréteur: le premier vecteur du lot (bit 0 du premier mot); chaque sortie reçoit 0 ou 1
+static long long simuler_interpreteur(t_moteurs_suite *moteurs, const uint64_t entrees[], uint64_t sorties[])
+{
+    t_circuit *circuit = moteurs->circuit;
+
+    for(int i = 0;i<circuit->nb_entrees;i++)
+    {
+        moteurs->signal[i] = (int)(entrees[i * NB_MOTS_SUITE] & 1);
+    }
+
+    t_circuit_reset(circuit);
+    t_circuit_appliquer_signal(circuit, moteurs->signal, circuit->nb_entrees);
+    t_circuit_propager_signal(circuit);
+
+    for(int j = 0;j<circuit->nb_sorties;j++)
+    {
+        sorties[j * NB_MOTS_SUITE] = (uint64_t)t_sortie_get_valeur(circuit->sorties[j]) & 1;
+    }
+
+
+    return 1;
+}
+
+static long long simuler_netlist(t_moteurs_suite *moteurs, const uint64_t entrees[], uint64_t sorties[])
+{
+
+    return t_netlist_simuler_lot(moteurs->netlist, entrees, sorties, NB_MOTS_SUITE) ? 64 * NB_MOTS_SUITE : 0;
+}
+
+static long long simuler_parallele(t_moteurs_suite *moteurs, const uint64_t entrees[], uint64_t sorties[])
+{
+
+    return t_simulation_parallele_simuler_lot(moteurs->parallele, entrees, sorties, NB_MOTS_SUITE) ? 64 * NB_MOTS_SUITE : 0;
+}
+
+static long long simuler_aig(t_moteurs_suite *moteurs, const uint64_t entrees[], uint64_t sorties[])
+{
+
+    return t_aig_simuler_lot(moteurs->aig, entrees, sorties, NB_MOTS_SUITE) ? 64 * NB_MOTS_SUITE : 0;
+}
+
+//Simule des lots pendant au moins DUREE_MESURE_SUITE secondes; retourne le nombre de vecteurs par seconde
+static double mesurer(t_simulateur_suite simuler, t_moteurs_suite *moteurs, const uint64_t entrees[], uint64_t sorties[])
+{
+    long long nb_vecteurs = 0;
+    long long nb;
+    double debut = temps_courant();
+    double duree;
+
+    do
+    {
+        nb = simuler(moteurs, entrees, sorties);
+
+        if(nb == 0)
+        {
+
+            return 0;
+        }
+
+        nb_vecteurs += nb;
+        duree = temps_courant() - debut;
+    }
+    while(duree < DUREE_MESURE_SUITE);
+
+
+    return nb_vecteurs / duree;
+}
+
+//Construit le circuit c de la suite et écrit son nom
+static t_circuit *generer(int c, int echelle, char *nom, size_t taille)
+{
+    t_parametres_aleatoire parametres = {0};
+
+    switch(c)
+    {
+        case 0:
+            snprintf(nom, taille, "additionneur_%d", 256 * echelle);
+
+            return t_generateur_additionneur(256 * echelle);
+        case 1:
+            snprintf(nom, taille, "multiplicateur_%d", 16 * echelle);
+
+            return t_generateur_multiplicateur(16 * echelle, 0);
+        case 2:
+            snprintf(nom, taille, "parite_%d", 4096 * echelle);
+
+            return t_generateur_parite(4096 * echelle, 2);
+        default:
+            parametres.nb_portes = 100000 * echelle;
+            parametres.max_entrees_porte = 3;
+            parametres.graine = (uint64_t)c;
+            parametres.nb_entrees = c == 3 ? 256 : 64;
+            parametres.nb_niveaux = c == 3 ? 50 : 2000;
+            parametres.fanout_max = c == 3 ? 8 : 4;
+            snprintf(nom, taille, "aleatoire_%s_%d", c == 3 ? "large" : "profond", parametres.nb_portes);
+
+            return t_generateur_aleatoire(&parametres);
+    }
+}
+
+//Mesure un circuit et écrit une ligne par moteur
+static int bench_circuit_suite(FILE *resultats, int c, int echelle, int nb_fils)
+{
+    const char *noms_moteurs[NB_MOTEURS_SUITE] = {"interpreteur", "netlist", "parallele", "aig"};
+    const t_simulateur_suite simulateurs[NB_MOTEURS_SUITE] = {simuler_interpreteur, simuler_netlist,
+                                                              simuler_parallele, simuler_aig};
+    t_moteurs_suite moteurs = {0};
+    uint64_t *entrees;
+    uint64_t *reference;
+    uint64_t *sorties;
+    char nom[64];
+    double durees[4];
+    double preparation;
+    double vecteurs_par_s;
+    double debut;
+    int identique;
+
+    debut = temps_courant();
+    moteurs.circuit = generer(c, echelle, nom, sizeof(nom));
+    durees[0] = temps_courant() - debut;
+
+    if(moteurs.circuit == NULL)
+    {
+
+        return 0;
+    }
+
+    debut = temps_courant();
+    t_circuit_est_valide(moteurs.circuit);
+    durees[1] = temps_courant() - debut;
+    debut = temps_courant();
+    t_circuit_ordonner(moteurs.circuit);
+    durees[2] = temps_courant() - debut;
+    debut = temps_courant();
+    moteurs.netlist = t_circuit_get_netlist(moteurs.circuit);
+    durees[3] = temps_courant() - debut;
+
+    entrees = (uint64_t*)malloc(sizeof(uint64_t) * (moteurs.circuit->nb_entrees + 1) * NB_MOTS_SUITE);
+    reference = (uint64_t*)malloc(sizeof(uint64_t) * (moteurs.circuit->nb_sorties + 1) * NB_MOTS_SUITE);
+    sorties = (uint64_t*)malloc(sizeof(uint64_t) * (moteurs.circuit->nb_sorties + 1) * NB_MOTS_SUITE);
+    moteurs.signal = (int*)malloc(sizeof(int) * (moteurs.circuit->nb_entrees + 1));
+
+    if(moteurs.netlist == NULL || entrees == NULL || reference == NULL || sorties == NULL || moteurs.signal == NULL)
+    {
+        free(entrees);
+        free(reference);
+        free(sorties);
+        free(moteurs.signal);
+        t_circuit_destroy(moteurs.circuit);
+
+        return 0;
+    }
+
+    for(int i = 0;i<moteurs.circuit->nb_entrees * NB_MOTS_SUITE;i++)
+    {
+        entrees[i] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    }
+
+    t_netlist_simuler_lot(moteurs.netlist, entrees, reference, NB_MOTS_SUITE);
+    fprintf(stderr, "%s: %d portes, %d niveaux\n", nom, moteurs.circuit->nb_portes, moteurs.netlist->nb_niveaux);
+
+    for(int m = 0;m<NB_MOTEURS_SUITE;m++)
+    {
+        //Préparation du moteur hors mesure (fils, graphe ET-inverseur)
+        debut = temps_courant();
+
+        if(m == 2)
+        {
+            moteurs.parallele = t_simulation_parallele_init(moteurs.netlist, nb_fils);
+        }
+        else if(m == 3)
+        {
+            moteurs.aig = t_aig_compiler(moteurs.circuit);
+        }
+
+        preparation = temps_courant() - debut;
+
+        if((m == 2 && moteurs.parallele == NULL) || (m == 3 && moteurs.aig == NULL))
+        {
+            continue;
+        }
+
+        memset(sorties, 0, sizeof(uint64_t) * moteurs.circuit->nb_sorties * NB_MOTS_SUITE);
+        simulateurs[m](&moteurs, entrees, sorties);
+        identique = 1;
+
+        //L'interpréteur ne simule que le premier vecteur de chaque lot
+        for(int j = 0;j<moteurs.circuit->nb_sorties;j++)
+        {
+            for(int w = 0;w<(m == 0 ? 1 : NB_MOTS_SUITE);w++)
+            {
+                identique &= ((sorties[j * NB_MOTS_SUITE + w] ^ reference[j * NB_MOTS_SUITE + w]) & (m == 0 ? 1 : ~0ull)) == 0;
+            }
+        }
+
+        vecteurs_par_s = mesurer(simulateurs[m], &moteurs, entrees, sorties);
+        fprintf(resultats, "%s,%d,%d,%d,%d,%.6f,%.6f,%.6f,%.6f,%s,%.6f,%.0f,%.0f,%d\n", nom, moteurs.circuit->nb_portes,
+                moteurs.circuit->nb_entrees, moteurs.circuit->nb_sorties, moteurs.netlist->nb_niveaux, durees[0], durees[1],
+                durees[2], durees[3], noms_moteurs[m], preparation, vecteurs_par_s,
+                vecteurs_par_s * moteurs.circuit->nb_portes, identique);
+        fflush(resultats);
+        fprintf(stderr, "  %-12s %14.0f vecteurs/s %16.0f portes/s%s\n", noms_moteurs[m], vecteurs_par_s,
+                vecteurs_par_s * moteurs.circuit->nb_portes, identique ? "" : " (RESULTATS DIFFERENTS)");
+    }
+
+    if(moteurs.parallele != NULL)
+    {
+        t_simulation_parallele_destroy(moteurs.parallele);
+    }
+
+    if(moteurs.aig != NULL)
+    {
+        t_aig_destroy(moteurs.aig);
+    }
+
+    free(entrees);
+    free(reference);
+    free(sorties);
+    free(moteurs.signal);
+    t_circuit_destroy(moteurs.circuit);
+
+
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    int echelle = argc > 1 ? atoi(argv[1]) : 1;
+    int nb_fils = argc > 2 ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    FILE *resultats = argc > 3 ? fopen(argv[3], "w") : stdout;
+    int succes = 1;
+
+    if(echelle < 1 || nb_fils < 1 || resultats == NULL)
+    {
+        printf("Utilisation: bench_suite [echelle >= 1] [nb_fils >= 1] [fichier.csv]\n");
+
+        return 1;
+    }
+
+    fprintf(resultats, "circuit,portes,entrees,sorties,niveaux,construction_s,validation_s,ordonnancement_s,"
+                       "compilation_s,moteur,preparation_s,vecteurs_par_s,evaluations_par_s,identique\n");
+
+    for(int c = 0;c<NB_CIRCUITS_SUITE;c++)
+    {
+        succes &= bench_circuit_suite(resultats, c, echelle, nb_fils);
+    }
+
+    if(resultats != stdout)
+    {
+        fclose(resultats);
+    }
+
+
+    return succes == 0;
+}
@@ -0,0 +1,232 @@
+//
+// Activité de commutation des portes d'un circuit (voir t_activite.h).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "t_activite.h"
+#include "t_netlist.h"
+
+//Porte candidate au classement des plus actives
+struct t_porte_active {
+    long long transitions;
+    int porte;
+};
+
+typedef struct t_porte_active t_porte_active;
+
+//Ordre décroissant des transitions, puis ordre d'évaluation
+static int t_activite_comparer(const void *a, const void *b)
+{
+    const t_porte_active *porte_a = (const t_porte_active*)a;
+    const t_porte_active *porte_b = (const t_porte_active*)b;
+
+    if(porte_a->transitions != porte_b->transitions)
+    {
+
+        return porte_a->transitions < porte_b->transitions ? 1 : -1;
+    }
+
+
+    return porte_a->porte - porte_b->porte;
+}
+
+//Nombre de lectures du net de chaque porte (entrées de portes et sorties du circuit)
+static int *t_activite_fanouts(const t_netlist *netlist)
+{
+    int *fanouts = (int*)calloc(netlist->nb_portes + 1, sizeof(int));
+    int net;
+
+    if(fanouts == NULL)
+    {
+
+        return NULL;
+    }
+
+    for(int i = 0;i<netlist->debut_entrees[netlist->nb_portes];i++)
+    {
+        net = netlist->entrees[i] - netlist->nb_entrees;
+
+        if(net >= 0)
+        {
+            fanouts[net]++;
+        }
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        net = netlist->sorties[j] - netlist->nb_entrees;
+
+        if(net >= 0)
+        {
+            fanouts[net]++;
+        }
+    }
+
+
+    return fanouts;
+}
+
+t_activite *t_activite_calculer(t_circuit *circuit, int nb_chaudes)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    t_activite *activite;
+    t_porte_active *classement;
+    const char *nom;
+    int *fanouts;
+
+    if(netlist == NULL || netlist->transitions == NULL)
+    {
+
+        return NULL;
+    }
+
+    nb_chaudes = nb_chaudes < 0 ? 0 : nb_chaudes > netlist->nb_portes ? netlist->nb_portes : nb_chaudes;
+    activite = (t_activite*)calloc(1, sizeof(t_activite));
+    fanouts = t_activite_fanouts(netlist);
+    classement = (t_porte_active*)malloc(sizeof(t_porte_active) * (netlist->nb_portes + 1));
+
+    if(activite == NULL || fanouts == NULL || classement == NULL)
+    {
+        free(activite);
+        free(fanouts);
+        free(classement);
+
+        return NULL;
+    }
+
+    activite->nb_paires = netlist->nb_paires;
+    activite->nb_chaudes = nb_chaudes;
+    activite->chaudes = (int*)malloc(sizeof(int) * (nb_chaudes + 1));
+    activite->noms_chaudes = (char**)calloc(nb_chaudes + 1, sizeof(char*));
+    activite->types_chaudes = (e_types_portes*)malloc(sizeof(e_types_portes) * (nb_chaudes + 1));
+    activite->transitions_chaudes = (long long*)malloc(sizeof(long long) * (nb_chaudes + 1));
+    activite->fanouts_chaudes = (int*)malloc(sizeof(int) * (nb_chaudes + 1));
+
+    if(activite->chaudes == NULL || activite->noms_chaudes == NULL || activite->types_chaudes == NULL
+       || activite->transitions_chaudes == NULL || activite->fanouts_chaudes == NULL)
+    {
+        t_activite_destroy(activite);
+        free(fanouts);
+        free(classement);
+
+        return NULL;
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        activite->transitions_types[netlist->types[k]] += netlist->transitions[k];
+        activite->nb_portes_types[netlist->types[k]]++;
+        activite->nb_transitions += netlist->transitions[k];
+        activite->charge_commutee += (double)netlist->transitions[k] * fanouts[k];
+        classement[k].transitions = netlist->transitions[k];
+        classement[k].porte = k;
+    }
+
+    qsort(classement, netlist->nb_portes, sizeof(t_porte_active), t_activite_comparer);
+
+    for(int i = 0;i<nb_chaudes;i++)
+    {
+        nom = netlist->portes[classement[i].porte]->nom;
+        activite->chaudes[i] = classement[i].porte;
+        activite->noms_chaudes[i] = (char*)malloc(strlen(nom) + 1);
+        activite->types_chaudes[i] = (e_types_portes)netlist->types[classement[i].porte];
+        activite->transitions_chaudes[i] = classement[i].transitions;
+        activite->fanouts_chaudes[i] = fanouts[classement[i].porte];
+
+        if(activite->noms_chaudes[i] == NULL)
+        {
+            t_activite_destroy(activite);
+            free(fanouts);
+            free(classement);
+
+            return NULL;
+        }
+
+        strcpy(activite->noms_chaudes[i], nom);
+    }
+
+    free(fanouts);
+    free(classement);
+
+
+    return activite;
+}
+
+void t_activite_destroy(t_activite *activite)
+{
+    if(activite != NULL)
+    {
+        for(int i = 0;i<activite->nb_chaudes && activite->noms_chaudes != NULL;i++)
+        {
+            free(activite->noms_chaudes[i]);
+        }
+
+        free(activite->chaudes);
+        free(activite->noms_chaudes);
+        free(activite->types_chaudes);
+        free(activite->transitions_chaudes);
+        free(activite->fanouts_chaudes);
+        free(activite);
+    }
+}
+
+double t_activite_facteur(const t_activite *activite, e_types_portes type)
+{
+    if(activite->nb_portes_types[type] == 0 || activite->nb_paires == 0)
+    {
+
+        return 0;
+    }
+
+
+    return (double)activite->transitions_types[type] / activite->nb_portes_types[type] / activite->nb_paires;
+}
+
+void t_activite_afficher_rapport(const t_activite *activite)
+{
+    printf("Paires de vecteurs: %lli, transitions: %lli, charge commutee: %.0f\n", activite->nb_paires,
+           activite->nb_transitions, activite->charge_commutee);
+
+    for(int t = 0;t<NB_TYPES_PORTES;t++)
+    {
+        if(activite->nb_portes_types[t] > 0)
+        {
+            printf("  %-5s %6i portes %12lli transitions, activite %.3f\n", t_porte_get_nom_type((e_types_portes)t),
+                   activite->nb_portes_types[t], activite->transitions_types[t], t_activite_facteur(activite, (e_types_portes)t));
+        }
+    }
+
+    for(int i = 0;i<activite->nb_chaudes;i++)
+    {
+        printf("  %3i. %-12s %-5s %12lli transitions, activite %.3f, fanout %i\n", i + 1,
+               activite->noms_chaudes[i], t_porte_get_nom_type(activite->types_chaudes[i]), activite->transitions_chaudes[i],
+               activite->nb_paires > 0 ? (double)activite->transitions_chaudes[i] / activite->nb_paires : 0.0,
+               activite->fanouts_chaudes[i]);
+    }
+}
+
+int t_activite_exporter(const t_activite *activite, const char *nom_fichier)
+{
+    FILE *fichier = fopen(nom_fichier, "w");
+
+    if(fichier == NULL)
+    {
+
+        return 0;
+    }
+
+    fprintf(fichier, "rang,nom,type,transitions,activite,fanout,charge\n");
+
+    for(int i = 0;i<activite->nb_chaudes;i++)
+    {
+        fprintf(fichier, "%i,%s,%s,%lli,%.6f,%i,%lli\n", i + 1, activite->noms_chaudes[i],
+                t_porte_get_nom_type(activite->types_chaudes[i]), activite->transitions_chaudes[i],
+                activite->nb_paires > 0 ? (double)activite->transitions_chaudes[i] / activite->nb_paires : 0.0,
+                activite->fanouts_chaudes[i], activite->transitions_chaudes[i] * activite->fanouts_chaudes[i]);
+    }
+
+
+    return fclose(fichier) == 0;
+}
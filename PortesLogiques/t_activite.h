@@ -0,0 +1,97 @@
+/*
+Module: T_ACTIVITE
+Description: Activité de commutation des portes d'un circuit, pour estimer sa puissance dynamique.
+			 Les transitions de la sortie de chaque porte sont comptées par la netlist pendant la
+			 simulation (voir t_netlist_compter_transitions); ce module les regroupe par type de
+			 porte et classe les signaux les plus actifs.
+
+			 Le facteur d'activité d'un signal est son nombre de transitions divisé par le nombre
+			 de paires de vecteurs consécutifs observées. La puissance dynamique d'une porte est
+			 proportionnelle à ses transitions fois la capacité qu'elle charge, estimée par son
+			 fanout (nombre de lectures de sa sortie par des portes et des sorties du circuit).
+*/
+
+#ifndef T_ACTIVITE_H_
+#define T_ACTIVITE_H_
+
+#include "t_circuit.h"
+
+typedef struct t_circuit t_circuit;
+
+struct t_activite {
+	long long nb_paires; //Nombre de paires de vecteurs consécutifs observées
+	long long nb_transitions; //Nombre total de transitions des sorties de portes
+	double charge_commutee; //Somme des transitions pondérées par le fanout de chaque porte
+
+	long long transitions_types[NB_TYPES_PORTES]; //Transitions par type de porte
+	int nb_portes_types[NB_TYPES_PORTES]; //Nombre de portes de chaque type
+
+	//Portes les plus actives, par activité décroissante. Leurs noms et leurs types sont copiés:
+	//le rapport reste lisible si le circuit est modifié ou détruit.
+	int *chaudes; //Indice de chacune dans l'ordre d'évaluation de la netlist observée
+	char **noms_chaudes; //Nom de chacune
+	e_types_portes *types_chaudes; //Type de chacune
+	long long *transitions_chaudes; //Nombre de transitions de chacune
+	int *fanouts_chaudes; //Fanout de chacune
+	int nb_chaudes;
+};
+
+typedef struct t_activite t_activite;
+
+/*
+Fonction: T_ACTIVITE_CALCULER
+Description: Relève l'activité observée depuis le dernier t_netlist_compter_transitions(netlist, 1)
+			 de la netlist du circuit. Les compteurs appartiennent à la netlist: ils survivent aux
+			 modifications des autres circuits, mais une modification du circuit lui-même (ou d'une
+			 définition de ses instances) fait recompiler sa netlist, qui ne compte plus rien.
+Paramètres:
+- circuit: Pointeur vers le circuit (sa netlist doit compter les transitions).
+- nb_chaudes: Nombre maximal de portes les plus actives à retenir.
+Retour: Pointeur vers l'activité, NULL si le circuit n'a pas de netlist, si elle ne compte pas les
+		transitions (comptage jamais activé, ou perdu parce que le circuit a été modifié depuis:
+		il faut le réactiver) ou si la mémoire manque.
+*/
+t_activite *t_activite_calculer(t_circuit *circuit, int nb_chaudes);
+
+/*
+Fonction: T_ACTIVITE_DESTROY
+Description: Libère la mémoire occupée par l'activité.
+Paramètres:
+- activite: Pointeur vers l'activité à détruire (NULL: aucun effet).
+Retour: Aucun.
+*/
+void t_activite_destroy(t_activite *activite);
+
+/*
+Fonction: T_ACTIVITE_FACTEUR
+Description: Calcule le facteur d'activité moyen d'un type de porte (transitions par porte et par
+			 paire de vecteurs).
+Paramètres:
+- activite: Pointeur vers l'activité.
+- type: Type de porte.
+Retour: Facteur entre 0 et 1, 0 si aucune porte de ce type ou aucune paire n'a été observée.
+*/
+double t_activite_facteur(const t_activite *activite, e_types_portes type);
+
+/*
+Fonction: T_ACTIVITE_AFFICHER_RAPPORT
+Description: Affiche les transitions et le facteur d'activité de chaque type de porte, puis les
+			 portes les plus actives.
+Paramètres:
+- activite: Pointeur vers l'activité.
+Retour: Aucun.
+*/
+void t_activite_afficher_rapport(const t_activite *activite);
+
+/*
+Fonction: T_ACTIVITE_EXPORTER
+Description: Écrit les portes les plus actives dans un fichier CSV (une ligne par porte: rang, nom,
+			 type, transitions, facteur d'activité, fanout, charge commutée).
+Paramètres:
+- activite: Pointeur vers l'activité.
+- nom_fichier: Chemin du fichier à créer.
+Retour: Booléen: Vrai si le fichier a été écrit, faux sinon.
+*/
+int t_activite_exporter(const t_activite *activite, const char *nom_fichier);
+
+#endif
@@ -0,0 +1,523 @@
+//
+// Graphe ET-inverseur compilé à partir d'un t_circuit (voir t_aig.h).
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "t_aig.h"
+#include "t_netlist.h"
+
+/*
+État de la traduction: table de hachage des noeuds ET déjà créés (adressage ouvert, -1 pour une
+case vide) et niveau de chaque noeud.
+*/
+typedef struct {
+	t_aig *aig;
+	int premier_et; //Variable du premier noeud ET
+	int *table;
+	size_t masque_table; //Taille de la table - 1 (une puissance de 2)
+	int *niveaux;
+} t_construction_aig;
+
+//Alloue les valeurs des variables pour au moins nb_mots mots par variable
+static int t_aig_reserver_mots(t_aig *aig, int nb_mots)
+{
+    uint64_t *valeurs;
+
+    if(nb_mots <= aig->nb_mots)
+    {
+
+        return 1;
+    }
+
+    valeurs = (uint64_t*)realloc(aig->valeurs, sizeof(uint64_t) * aig->nb_variables * nb_mots);
+
+    if(valeurs == NULL)
+    {
+
+        return 0;
+    }
+
+    aig->valeurs = valeurs;
+
+    if(aig->nb_bascules > 0)
+    {
+        valeurs = (uint64_t*)realloc(aig->suivants, sizeof(uint64_t) * aig->nb_bascules * nb_mots);
+
+        if(valeurs == NULL)
+        {
+
+            return 0;
+        }
+
+        aig->suivants = valeurs;
+    }
+
+    aig->nb_mots = nb_mots;
+
+
+    return 1;
+}
+
+//Retourne le littéral de a ET b: un cas trivial, un noeud déjà créé ou un nouveau noeud
+static uint32_t t_aig_et(t_construction_aig *construction, uint32_t a, uint32_t b)
+{
+    t_aig *aig = construction->aig;
+    uint32_t temporaire;
+    uint64_t hachage;
+    size_t position;
+    int niveau_a;
+    int niveau_b;
+    int k;
+
+    if(a > b)
+    {
+        temporaire = a;
+        a = b;
+        b = temporaire;
+    }
+
+    if(a == AIG_FAUX || (a ^ 1u) == b)
+    {
+
+        return AIG_FAUX;
+    }
+
+    if(a == AIG_VRAI || a == b)
+    {
+
+        return b;
+    }
+
+    hachage = ((uint64_t)a << 32 | b) * 0x9E3779B97F4A7C15ull;
+    position = (size_t)(hachage ^ hachage >> 31) & construction->masque_table;
+
+    while(construction->table[position] != -1)
+    {
+        k = construction->table[position];
+
+        if(aig->operandes[2 * k] == a && aig->operandes[2 * k + 1] == b)
+        {
+
+            return AIG_LITTERAL(construction->premier_et + k, 0);
+        }
+
+        position = (position + 1) & construction->masque_table;
+    }
+
+    k = aig->nb_et++;
+    aig->operandes[2 * k] = a;
+    aig->operandes[2 * k + 1] = b;
+    construction->table[position] = k;
+
+    niveau_a = AIG_VARIABLE(a) < construction->premier_et ? 0 : construction->niveaux[AIG_VARIABLE(a) - construction->premier_et];
+    niveau_b = AIG_VARIABLE(b) < construction->premier_et ? 0 : construction->niveaux[AIG_VARIABLE(b) - construction->premier_et];
+    construction->niveaux[k] = 1 + (niveau_a > niveau_b ? niveau_a : niveau_b);
+
+    if(construction->niveaux[k] > aig->nb_niveaux)
+    {
+        aig->nb_niveaux = construction->niveaux[k];
+    }
+
+
+    return AIG_LITTERAL(construction->premier_et + k, 0);
+}
+
+//a OU b = NOT (NOT a ET NOT b)
+static uint32_t t_aig_ou(t_construction_aig *construction, uint32_t a, uint32_t b)
+{
+
+    return t_aig_et(construction, a ^ 1u, b ^ 1u) ^ 1u;
+}
+
+//a XOR b = (a ET NOT b) OU (NOT a ET b)
+static uint32_t t_aig_xor(t_construction_aig *construction, uint32_t a, uint32_t b)
+{
+
+    return t_aig_ou(construction, t_aig_et(construction, a, b ^ 1u), t_aig_et(construction, a ^ 1u, b));
+}
+
+//Combine les littéraux deux à deux (arbre équilibré) avec l'opération du type de porte
+static uint32_t t_aig_combiner(t_construction_aig *construction, e_types_portes type, uint32_t litteraux[], int nb)
+{
+    int inversion = type == PORTE_NAND || type == PORTE_NOR || type == PORTE_XNOR;
+
+    while(nb > 1)
+    {
+        for(int i = 0;2 * i + 1<nb;i++)
+        {
+            if(type == PORTE_ET || type == PORTE_NAND)
+            {
+                litteraux[i] = t_aig_et(construction, litteraux[2 * i], litteraux[2 * i + 1]);
+            }
+            else if(type == PORTE_OU || type == PORTE_NOR)
+            {
+                litteraux[i] = t_aig_ou(construction, litteraux[2 * i], litteraux[2 * i + 1]);
+            }
+            else
+            {
+                litteraux[i] = t_aig_xor(construction, litteraux[2 * i], litteraux[2 * i + 1]);
+            }
+        }
+
+        if(nb % 2 == 1)
+        {
+            litteraux[nb / 2] = litteraux[nb - 1];
+        }
+
+        nb = (nb + 1) / 2;
+    }
+
+
+    return litteraux[0] ^ (uint32_t)inversion;
+}
+
+//Retourne le littéral de la sortie d'une porte combinatoire dont les entrées sont traduites
+static uint32_t t_aig_traduire_porte(t_construction_aig *construction, e_types_portes type, uint32_t litteraux[], int nb)
+{
+    switch(type)
+    {
+        case PORTE_NOT:
+
+            return litteraux[0] ^ 1u;
+        case PORTE_BUF:
+
+            return litteraux[0];
+        case PORTE_MUX:
+
+            return t_aig_ou(construction, t_aig_et(construction, litteraux[0] ^ 1u, litteraux[1]),
+                            t_aig_et(construction, litteraux[0], litteraux[2]));
+        case PORTE_ZERO:
+
+            return AIG_FAUX;
+        case PORTE_UN:
+
+            return AIG_VRAI;
+        default:
+
+            return t_aig_combiner(construction, type, litteraux, nb);
+    }
+}
+
+//Nombre maximal de noeuds ET créés pour une porte de ce type à nb entrées
+static int t_aig_max_noeuds(e_types_portes type, int nb)
+{
+    switch(type)
+    {
+        case PORTE_ET:
+        case PORTE_OU:
+        case PORTE_NAND:
+        case PORTE_NOR:
+
+            return nb - 1;
+        case PORTE_XOR:
+        case PORTE_XNOR:
+
+            return 3 * (nb - 1);
+        case PORTE_MUX:
+
+            return 3;
+        default:
+
+            return 0;
+    }
+}
+
+//Traduit les portes combinatoires d'une netlist. litteraux_nets contient déjà le littéral des
+//entrées et des bascules; il reçoit celui de chaque porte.
+static void t_aig_traduire_netlist(t_construction_aig *construction, const t_netlist *netlist,
+                                   uint32_t litteraux_nets[], uint32_t tampon[])
+{
+    int nb;
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        if(netlist->types[k] != PORTE_DFF)
+        {
+            nb = netlist->debut_entrees[k + 1] - netlist->debut_entrees[k];
+
+            for(int i = 0;i<nb;i++)
+            {
+                tampon[i] = litteraux_nets[netlist->entrees[netlist->debut_entrees[k] + i]];
+            }
+
+            litteraux_nets[netlist->nb_entrees + k] = t_aig_traduire_porte(construction, (e_types_portes)netlist->types[k], tampon, nb);
+        }
+    }
+}
+
+//Traduit un ou deux circuits qui partagent leurs entrées dans un même graphe (voir t_aig_compiler_paire)
+static t_aig *t_aig_compiler_circuits(t_circuit *circuits[], int nb_circuits)
+{
+    t_netlist *netlists[2];
+    t_construction_aig construction;
+    t_aig *aig;
+    uint32_t *litteraux_nets;
+    uint32_t *tampon;
+    uint32_t *operandes;
+    size_t taille_table = 1;
+    int max_et = 0;
+    int max_entrees = 1;
+    int max_nets = 0;
+    int premiere_bascule = 0;
+    int premiere_sortie = 0;
+    int nb;
+    int succes;
+
+    if(nb_circuits < 1 || nb_circuits > 2)
+    {
+
+        return NULL;
+    }
+
+    for(int c = 0;c<nb_circuits;c++)
+    {
+        netlists[c] = t_circuit_get_netlist(circuits[c]);
+
+        if(netlists[c] == NULL || netlists[c]->nb_entrees != netlists[0]->nb_entrees)
+        {
+
+            return NULL;
+        }
+
+        for(int k = 0;k<netlists[c]->nb_portes;k++)
+        {
+            nb = netlists[c]->debut_entrees[k + 1] - netlists[c]->debut_entrees[k];
+            max_et += t_aig_max_noeuds((e_types_portes)netlists[c]->types[k], nb);
+            max_entrees = nb > max_entrees ? nb : max_entrees;
+        }
+
+        max_nets = netlists[c]->nb_nets > max_nets ? netlists[c]->nb_nets : max_nets;
+    }
+
+    while(taille_table < 2 * (size_t)max_et)
+    {
+        taille_table *= 2;
+    }
+
+    aig = (t_aig*)calloc(1, sizeof(t_aig));
+
+    if(aig == NULL)
+    {
+
+        return NULL;
+    }
+
+    aig->nb_entrees = netlists[0]->nb_entrees;
+
+    for(int c = 0;c<nb_circuits;c++)
+    {
+        aig->nb_sorties += netlists[c]->nb_sorties;
+        aig->nb_bascules += netlists[c]->nb_bascules;
+    }
+
+    aig->operandes = (uint32_t*)malloc(sizeof(uint32_t) * 2 * (max_et + 1));
+    aig->sorties = (uint32_t*)malloc(sizeof(uint32_t) * (aig->nb_sorties + 1));
+    aig->entrees_bascules = (uint32_t*)malloc(sizeof(uint32_t) * (aig->nb_bascules + 1));
+    construction.aig = aig;
+    construction.premier_et = 1 + aig->nb_entrees + aig->nb_bascules;
+    construction.table = (int*)malloc(sizeof(int) * taille_table);
+    construction.masque_table = taille_table - 1;
+    construction.niveaux = (int*)malloc(sizeof(int) * (max_et + 1));
+    litteraux_nets = (uint32_t*)malloc(sizeof(uint32_t) * (max_nets + 1));
+    tampon = (uint32_t*)malloc(sizeof(uint32_t) * max_entrees);
+    succes = aig->operandes != NULL && aig->sorties != NULL && aig->entrees_bascules != NULL
+             && construction.table != NULL && construction.niveaux != NULL && litteraux_nets != NULL && tampon != NULL;
+
+    if(succes)
+    {
+        memset(construction.table, -1, sizeof(int) * taille_table);
+
+        for(int c = 0;c<nb_circuits;c++)
+        {
+            for(int i = 0;i<aig->nb_entrees;i++)
+            {
+                litteraux_nets[i] = AIG_LITTERAL(1 + i, 0);
+            }
+
+            //Les bascules sont des variables: leur état peut être lu avant que leur entrée soit traduite
+            for(int b = 0;b<netlists[c]->nb_bascules;b++)
+            {
+                litteraux_nets[aig->nb_entrees + netlists[c]->bascules[b]] = AIG_LITTERAL(1 + aig->nb_entrees + premiere_bascule + b, 0);
+            }
+
+            t_aig_traduire_netlist(&construction, netlists[c], litteraux_nets, tampon);
+
+            for(int b = 0;b<netlists[c]->nb_bascules;b++)
+            {
+                aig->entrees_bascules[premiere_bascule + b] = litteraux_nets[netlists[c]->entrees[netlists[c]->debut_entrees[netlists[c]->bascules[b]]]];
+            }
+
+            for(int j = 0;j<netlists[c]->nb_sorties;j++)
+            {
+                aig->sorties[premiere_sortie + j] = litteraux_nets[netlists[c]->sorties[j]];
+            }
+
+            premiere_bascule += netlists[c]->nb_bascules;
+            premiere_sortie += netlists[c]->nb_sorties;
+        }
+
+        aig->nb_variables = construction.premier_et + aig->nb_et;
+
+        //Le partage des noeuds laisse une partie du tableau inutilisée
+        operandes = (uint32_t*)realloc(aig->operandes, sizeof(uint32_t) * 2 * (aig->nb_et + 1));
+        aig->operandes = operandes != NULL ? operandes : aig->operandes;
+        succes = t_aig_reserver_mots(aig, 1);
+    }
+
+    free(construction.table);
+    free(construction.niveaux);
+    free(litteraux_nets);
+    free(tampon);
+
+    if(succes == 0)
+    {
+        t_aig_destroy(aig);
+
+        return NULL;
+    }
+
+
+    return aig;
+}
+
+t_aig *t_aig_compiler(t_circuit *circuit)
+{
+
+    return t_aig_compiler_circuits(&circuit, 1);
+}
+
+t_aig *t_aig_compiler_paire(t_circuit *circuit_a, t_circuit *circuit_b)
+{
+    t_circuit *circuits[2] = {circuit_a, circuit_b};
+
+
+    return t_aig_compiler_circuits(circuits, 2);
+}
+
+void t_aig_destroy(t_aig *aig)
+{
+    free(aig->operandes);
+    free(aig->sorties);
+    free(aig->entrees_bascules);
+    free(aig->valeurs);
+    free(aig->suivants);
+    free(aig);
+}
+
+void t_aig_evaluer(const t_aig *aig, uint64_t *valeurs, int nb_mots)
+{
+    const uint32_t *operandes = aig->operandes;
+    uint64_t *sortie = &valeurs[(size_t)(aig->nb_variables - aig->nb_et) * nb_mots];
+    const uint64_t *a;
+    const uint64_t *b;
+    uint64_t inversion_a;
+    uint64_t inversion_b;
+
+    for(int k = 0;k<aig->nb_et;k++)
+    {
+        a = &valeurs[(size_t)AIG_VARIABLE(operandes[2 * k]) * nb_mots];
+        b = &valeurs[(size_t)AIG_VARIABLE(operandes[2 * k + 1]) * nb_mots];
+        inversion_a = 0 - (uint64_t)AIG_EST_INVERSE(operandes[2 * k]);
+        inversion_b = 0 - (uint64_t)AIG_EST_INVERSE(operandes[2 * k + 1]);
+
+        for(int m = 0;m<nb_mots;m++)
+        {
+            sortie[m] = (a[m] ^ inversion_a) & (b[m] ^ inversion_b);
+        }
+
+        sortie += nb_mots;
+    }
+}
+
+//Copie dans destination les mots (nb_mots) de la valeur d'un littéral
+static void t_aig_lire_litteral(const t_aig *aig, uint32_t litteral, uint64_t *destination, int nb_mots)
+{
+    const uint64_t *valeur = &aig->valeurs[(size_t)AIG_VARIABLE(litteral) * nb_mots];
+    uint64_t inversion = 0 - (uint64_t)AIG_EST_INVERSE(litteral);
+
+    for(int m = 0;m<nb_mots;m++)
+    {
+        destination[m] = valeur[m] ^ inversion;
+    }
+}
+
+//Place la constante et l'état des bascules pour des valeurs de nb_mots mots par variable:
+//l'état est remis à zéro s'il a été rangé avec un autre nombre de mots (ou jamais)
+static void t_aig_preparer_etats(t_aig *aig, int nb_mots)
+{
+    memset(aig->valeurs, 0, sizeof(uint64_t) * nb_mots);
+
+    if(aig->nb_mots_etats != nb_mots)
+    {
+        memset(&aig->valeurs[(size_t)(1 + aig->nb_entrees) * nb_mots], 0, sizeof(uint64_t) * aig->nb_bascules * nb_mots);
+        aig->nb_mots_etats = nb_mots;
+    }
+}
+
+int t_aig_simuler_lot(t_aig *aig, const uint64_t entrees[], uint64_t sorties[], int nb_mots)
+{
+    if(t_aig_reserver_mots(aig, nb_mots) == 0)
+    {
+
+        return 0;
+    }
+
+    t_aig_preparer_etats(aig, nb_mots);
+    memcpy(&aig->valeurs[nb_mots], entrees, sizeof(uint64_t) * aig->nb_entrees * nb_mots);
+    t_aig_evaluer(aig, aig->valeurs, nb_mots);
+
+    for(int j = 0;j<aig->nb_sorties;j++)
+    {
+        t_aig_lire_litteral(aig, aig->sorties[j], &sorties[(size_t)j * nb_mots], nb_mots);
+    }
+
+
+    return 1;
+}
+
+int t_aig_simuler_cycles(t_aig *aig, const uint64_t entrees[], uint64_t sorties[], int nb_cycles, int nb_mots)
+{
+    size_t taille_entrees = (size_t)aig->nb_entrees * nb_mots;
+    size_t taille_sorties = (size_t)aig->nb_sorties * nb_mots;
+    uint64_t *etats;
+
+    if(t_aig_reserver_mots(aig, nb_mots) == 0)
+    {
+
+        return 0;
+    }
+
+    t_aig_preparer_etats(aig, nb_mots);
+    etats = &aig->valeurs[(size_t)(1 + aig->nb_entrees) * nb_mots];
+
+    for(int c = 0;c<nb_cycles;c++)
+    {
+        memcpy(&aig->valeurs[nb_mots], &entrees[c * taille_entrees], sizeof(uint64_t) * taille_entrees);
+        t_aig_evaluer(aig, aig->valeurs, nb_mots);
+
+        for(int j = 0;j<aig->nb_sorties;j++)
+        {
+            t_aig_lire_litteral(aig, aig->sorties[j], &sorties[c * taille_sorties + (size_t)j * nb_mots], nb_mots);
+        }
+
+        //Front d'horloge: toutes les entrées des bascules sont lues avant d'écrire les états
+        for(int b = 0;b<aig->nb_bascules;b++)
+        {
+            t_aig_lire_litteral(aig, aig->entrees_bascules[b], &aig->suivants[(size_t)b * nb_mots], nb_mots);
+        }
+
+        if(aig->nb_bascules > 0)
+        {
+            memcpy(etats, aig->suivants, sizeof(uint64_t) * aig->nb_bascules * nb_mots);
+        }
+    }
+
+
+    return 1;
+}
+
+void t_aig_reinitialiser_etats(t_aig *aig)
+{
+    aig->nb_mots_etats = 0;
+}
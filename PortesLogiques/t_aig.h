@@ -0,0 +1,144 @@
+/*
+Module: T_AIG
+Description: Définit le type t_aig, un graphe ET-inverseur (And-Inverter Graph) compilé à partir
+			 d'un circuit. Toutes les portes sont traduites en noeuds ET à deux entrées dont les
+			 arcs peuvent être inversés: le graphe n'a qu'un seul type de noeud, rangé dans un
+			 tableau compact de littéraux de 32 bits (8 octets par noeud).
+
+			 Numérotation (celle du format AIGER): la variable 0 est la constante faux, les
+			 variables 1 à nb_entrees sont les entrées du circuit, puis viennent les bascules,
+			 puis les noeuds ET dans l'ordre d'évaluation. Un littéral vaut 2 * variable, plus 1
+			 si l'arc est inversé (voir AIG_LITTERAL).
+
+			 Traduction des portes: ET à n entrées = arbre équilibré de n-1 noeuds, OU = NOT ET des
+			 entrées inversées, XOR à deux entrées = 3 noeuds, MUX = 3 noeuds; NOT, BUF et les
+			 constantes ne créent aucun noeud (seulement un littéral). Les noeuds identiques sont
+			 partagés (hachage structurel) et les cas triviaux (a ET a, a ET NOT a, a ET 0, a ET 1)
+			 ne créent pas de noeud.
+
+			 Une bascule (PORTE_DFF) est une variable dont la valeur est son état; son entrée est
+			 un littéral lu au front d'horloge (même sémantique que t_netlist_simuler_cycles).
+*/
+
+#ifndef T_AIG_H_
+#define T_AIG_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+
+#define AIG_FAUX 0u //Littéral de la constante faux
+#define AIG_VRAI 1u //Littéral de la constante vrai
+#define AIG_LITTERAL(variable, inverse) ((uint32_t)(variable) << 1 | (uint32_t)(inverse))
+#define AIG_VARIABLE(litteral) ((int)((litteral) >> 1))
+#define AIG_EST_INVERSE(litteral) ((int)((litteral) & 1u))
+
+typedef struct t_circuit t_circuit;
+
+struct t_aig {
+	int nb_entrees; //Nombre d'entrées du circuit
+	int nb_sorties; //Nombre de sorties du circuit
+	int nb_bascules; //Nombre de bascules
+	int nb_et; //Nombre de noeuds ET
+	int nb_variables; //1 + nb_entrees + nb_bascules + nb_et
+	int nb_niveaux; //Profondeur du graphe (nombre de noeuds ET du plus long chemin)
+	//Littéraux lus par les noeuds ET: le noeud k (variable nb_variables - nb_et + k) vaut
+	//operandes[2k] ET operandes[2k+1]
+	uint32_t *operandes;
+	uint32_t *sorties; //Littéral de chaque sortie du circuit
+	uint32_t *entrees_bascules; //Littéral de l'entrée de chaque bascule
+
+	uint64_t *valeurs; //Valeurs des variables (nb_variables * nb_mots mots)
+	int nb_mots; //Nombre de mots par variable alloués dans valeurs
+	uint64_t *suivants; //Prochain état des bascules au front d'horloge (nb_bascules * nb_mots mots)
+	//Nombre de mots par variable de l'état des bascules rangé dans valeurs (0: l'état est à remettre à zéro)
+	int nb_mots_etats;
+};
+
+typedef struct t_aig t_aig;
+
+/*
+Fonction: T_AIG_COMPILER
+Description: Traduit un circuit en graphe ET-inverseur (voir la description du module). Le
+			 circuit peut être modifié ou détruit par la suite sans affecter le graphe.
+Paramètres:
+- circuit: Pointeur vers le circuit à traduire (il est compilé en netlist au besoin).
+Retour: Pointeur vers le graphe créé. NULL si le circuit est invalide, contient une boucle
+		combinatoire ou si la mémoire manque.
+*/
+t_aig *t_aig_compiler(t_circuit *circuit);
+
+/*
+Fonction: T_AIG_COMPILER_PAIRE
+Description: Traduit deux circuits qui ont le même nombre d'entrées dans un même graphe: l'entrée i
+			 des deux circuits est la même variable et les sorties du second circuit suivent celles
+			 du premier. Le hachage structurel partage les noeuds communs aux deux circuits: une
+			 sortie construite de la même façon dans les deux circuits a le même littéral (base de
+			 la vérification d'équivalence, voir t_equivalence.h).
+Paramètres:
+- circuit_a: Pointeur vers le premier circuit (sorties 0 à nb_sorties(a) - 1).
+- circuit_b: Pointeur vers le second circuit (sorties suivantes).
+Retour: Pointeur vers le graphe créé. NULL si un des circuits est invalide ou contient une boucle
+		combinatoire, si les nombres d'entrées diffèrent ou si la mémoire manque.
+*/
+t_aig *t_aig_compiler_paire(t_circuit *circuit_a, t_circuit *circuit_b);
+
+/*
+Fonction: T_AIG_DESTROY
+Description: Libère la mémoire occupée par le graphe.
+Paramètres:
+- aig: Pointeur vers le graphe à détruire.
+Retour: Aucun.
+*/
+void t_aig_destroy(t_aig *aig);
+
+/*
+Fonction: T_AIG_EVALUER
+Description: Évalue tous les noeuds ET dans l'ordre. Les mots de la constante, des entrées et
+			 des bascules doivent déjà être placés dans le tableau valeurs.
+Paramètres:
+- aig: Pointeur vers le graphe.
+- valeurs: Valeurs des variables (nb_variables * nb_mots mots): le mot m de la variable v est
+		   valeurs[v * nb_mots + m].
+- nb_mots: Nombre de mots par variable dans valeurs.
+Retour: Aucun.
+*/
+void t_aig_evaluer(const t_aig *aig, uint64_t *valeurs, int nb_mots);
+
+/*
+Fonction: T_AIG_SIMULER_LOT
+Description: Simule un lot de vecteurs groupés par mots de 64 bits (même disposition que
+			 t_circuit_simuler_lot). Les bascules fournissent leur état courant.
+Paramètres:
+- aig: Pointeur vers le graphe.
+- entrees: Mots des entrées: entrees[i * nb_mots + m] est le mot m de l'entrée i.
+- sorties: Tableau (nb_sorties * nb_mots mots) qui reçoit les mots des sorties.
+- nb_mots: Nombre de mots par entrée.
+Retour: Booléen: Vrai si le lot a été simulé, faux si la mémoire manque.
+*/
+int t_aig_simuler_lot(t_aig *aig, const uint64_t entrees[], uint64_t sorties[], int nb_mots);
+
+/*
+Fonction: T_AIG_SIMULER_CYCLES
+Description: Simule nb_cycles cycles d'horloge (même sémantique et même disposition des
+			 tableaux que t_netlist_simuler_cycles). L'état des bascules est conservé d'un appel
+			 à l'autre; il part de zéro et est remis à zéro si nb_mots change.
+Paramètres:
+- aig: Pointeur vers le graphe.
+- entrees: Mots des entrées de chaque cycle: entrees[(c * nb_entrees + i) * nb_mots + m].
+- sorties: Tableau (nb_cycles * nb_sorties * nb_mots mots) qui reçoit les mots des sorties.
+- nb_cycles: Nombre de cycles à simuler.
+- nb_mots: Nombre de mots par entrée.
+Retour: Booléen: Vrai si les cycles ont été simulés, faux si la mémoire manque.
+*/
+int t_aig_simuler_cycles(t_aig *aig, const uint64_t entrees[], uint64_t sorties[], int nb_cycles, int nb_mots);
+
+/*
+Fonction: T_AIG_REINITIALISER_ETATS
+Description: Remet à zéro l'état de toutes les bascules (au prochain cycle simulé).
+Paramètres:
+- aig: Pointeur vers le graphe.
+Retour: Aucun.
+*/
+void t_aig_reinitialiser_etats(t_aig *aig);
+
+#endif
@@ -0,0 +1,283 @@
+//
+// Analyse temporelle statique d'un circuit (voir t_analyse_temporelle.h).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "t_analyse_temporelle.h"
+#include "t_netlist.h"
+
+//Délai d'une porte: celui du tableau donné, sinon le délai unitaire
+static int t_analyse_temporelle_delai(const int delais[], e_types_portes type)
+{
+    if(delais != NULL)
+    {
+
+        return delais[type];
+    }
+
+
+    return type == PORTE_DFF || type == PORTE_ZERO || type == PORTE_UN ? 0 : 1;
+}
+
+//Temps d'arrivée de chaque net, dans l'ordre d'évaluation. Une bascule est une source: son net
+//garde le temps 0.
+static void t_analyse_temporelle_arrivees(t_analyse_temporelle *analyse, const int delais[])
+{
+    const t_netlist *netlist = analyse->netlist;
+    int net;
+    int entree;
+
+    for(int n = 0;n<netlist->nb_nets;n++)
+    {
+        analyse->arrivees[n] = 0;
+        analyse->predecesseurs[n] = -1;
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        if(netlist->types[k] == PORTE_DFF)
+        {
+            continue;
+        }
+
+        net = netlist->nb_entrees + k;
+
+        for(int i = netlist->debut_entrees[k];i<netlist->debut_entrees[k + 1];i++)
+        {
+            entree = netlist->entrees[i];
+
+            if(analyse->predecesseurs[net] == -1 || analyse->arrivees[entree] > analyse->arrivees[analyse->predecesseurs[net]])
+            {
+                analyse->predecesseurs[net] = entree;
+            }
+        }
+
+        analyse->arrivees[net] = (analyse->predecesseurs[net] == -1 ? 0 : analyse->arrivees[analyse->predecesseurs[net]])
+                                 + t_analyse_temporelle_delai(delais, (e_types_portes)netlist->types[k]);
+    }
+}
+
+//Cherche le point d'arrivée le plus tardif (sorties du circuit puis entrées des bascules) et
+//remonte son chemin critique
+static int t_analyse_temporelle_chemin(t_analyse_temporelle *analyse)
+{
+    const t_netlist *netlist = analyse->netlist;
+    int fin = -1;
+    int net;
+
+    analyse->profondeur = 0;
+    analyse->fin_critique = 0;
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        if(fin == -1 || analyse->arrivees[netlist->sorties[j]] > analyse->profondeur)
+        {
+            fin = netlist->sorties[j];
+            analyse->profondeur = analyse->arrivees[fin];
+            analyse->fin_critique = j;
+        }
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        net = netlist->entrees[netlist->debut_entrees[netlist->bascules[b]]];
+
+        if(fin == -1 || analyse->arrivees[net] > analyse->profondeur)
+        {
+            fin = net;
+            analyse->profondeur = analyse->arrivees[fin];
+            analyse->fin_critique = -1 - netlist->bascules[b];
+        }
+    }
+
+    analyse->nb_chemin = 0;
+
+    for(net = fin;net != -1;net = analyse->predecesseurs[net])
+    {
+        analyse->nb_chemin++;
+    }
+
+    analyse->chemin = (int*)malloc(sizeof(int) * (analyse->nb_chemin + 1));
+
+    if(analyse->chemin == NULL)
+    {
+
+        return 0;
+    }
+
+    net = fin;
+
+    for(int i = analyse->nb_chemin - 1;i>=0;i--)
+    {
+        analyse->chemin[i] = net;
+        net = analyse->predecesseurs[net];
+    }
+
+
+    return 1;
+}
+
+//Largeur des niveaux et lectures de chaque net
+static void t_analyse_temporelle_statistiques(t_analyse_temporelle *analyse)
+{
+    const t_netlist *netlist = analyse->netlist;
+    int nb_liens = netlist->debut_entrees[netlist->nb_portes];
+    int largeur;
+
+    analyse->largeur_max = 0;
+
+    for(int l = 0;l<netlist->nb_niveaux;l++)
+    {
+        largeur = netlist->debut_niveaux[l + 1] - netlist->debut_niveaux[l];
+        analyse->largeur_max = largeur > analyse->largeur_max ? largeur : analyse->largeur_max;
+    }
+
+    analyse->largeur_moyenne = netlist->nb_niveaux > 0 ? (double)netlist->nb_portes / netlist->nb_niveaux : 0;
+
+    for(int i = 0;i<nb_liens;i++)
+    {
+        analyse->fanouts[netlist->entrees[i]]++;
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        analyse->fanouts[netlist->sorties[j]]++;
+    }
+
+    analyse->fanout_max = 0;
+    analyse->net_fanout_max = -1;
+    analyse->nb_nets_sans_lecteur = 0;
+
+    for(int n = 0;n<netlist->nb_nets;n++)
+    {
+        if(analyse->fanouts[n] > analyse->fanout_max)
+        {
+            analyse->fanout_max = analyse->fanouts[n];
+            analyse->net_fanout_max = n;
+        }
+
+        analyse->nb_nets_sans_lecteur += analyse->fanouts[n] == 0;
+    }
+
+    analyse->fanout_moyen = netlist->nb_nets > 0 ? (double)(nb_liens + netlist->nb_sorties) / netlist->nb_nets : 0;
+}
+
+t_analyse_temporelle *t_analyse_temporelle_calculer(t_circuit *circuit, const int delais[])
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    t_analyse_temporelle *analyse;
+
+    if(netlist == NULL)
+    {
+
+        return NULL;
+    }
+
+    analyse = (t_analyse_temporelle*)calloc(1, sizeof(t_analyse_temporelle));
+
+    if(analyse == NULL)
+    {
+
+        return NULL;
+    }
+
+    analyse->netlist = netlist;
+    analyse->circuit = circuit;
+    analyse->arrivees = (int*)malloc(sizeof(int) * (netlist->nb_nets + 1));
+    analyse->predecesseurs = (int*)malloc(sizeof(int) * (netlist->nb_nets + 1));
+    analyse->fanouts = (int*)calloc(netlist->nb_nets + 1, sizeof(int));
+
+    if(analyse->arrivees == NULL || analyse->predecesseurs == NULL || analyse->fanouts == NULL)
+    {
+        t_analyse_temporelle_destroy(analyse);
+
+        return NULL;
+    }
+
+    t_analyse_temporelle_arrivees(analyse, delais);
+    t_analyse_temporelle_statistiques(analyse);
+
+    if(t_analyse_temporelle_chemin(analyse) == 0)
+    {
+        t_analyse_temporelle_destroy(analyse);
+
+        return NULL;
+    }
+
+
+    return analyse;
+}
+
+void t_analyse_temporelle_destroy(t_analyse_temporelle *analyse)
+{
+    free(analyse->arrivees);
+    free(analyse->predecesseurs);
+    free(analyse->fanouts);
+    free(analyse->chemin);
+    free(analyse);
+}
+
+const char *t_analyse_temporelle_nom_net(const t_analyse_temporelle *analyse, int net)
+{
+    if(net < analyse->netlist->nb_entrees)
+    {
+
+        return analyse->circuit->entrees[net]->nom;
+    }
+
+
+    return analyse->netlist->portes[net - analyse->netlist->nb_entrees]->nom;
+}
+
+size_t t_analyse_temporelle_chemin_critique(const t_analyse_temporelle *analyse, char *tampon, size_t taille)
+{
+    size_t longueur = 0;
+    const char *nom;
+    int ecrits;
+
+    if(taille > 0)
+    {
+        tampon[0] = '\0';
+    }
+
+    //Un circuit sans sortie ni bascule n'a pas de chemin
+    for(int i = 0;i<=analyse->nb_chemin && analyse->nb_chemin > 0;i++)
+    {
+        if(i < analyse->nb_chemin)
+        {
+            nom = t_analyse_temporelle_nom_net(analyse, analyse->chemin[i]);
+        }
+        else if(analyse->fin_critique >= 0)
+        {
+            nom = analyse->circuit->sorties[analyse->fin_critique]->nom;
+        }
+        else
+        {
+            nom = analyse->netlist->portes[-1 - analyse->fin_critique]->nom;
+        }
+
+        ecrits = snprintf(longueur < taille ? tampon + longueur : NULL, longueur < taille ? taille - longueur : 0,
+                          "%s%s", i > 0 ? "->" : "", nom);
+        longueur += ecrits > 0 ? (size_t)ecrits : 0;
+    }
+
+
+    return longueur;
+}
+
+void t_analyse_temporelle_afficher_rapport(const t_analyse_temporelle *analyse)
+{
+    size_t longueur = t_analyse_temporelle_chemin_critique(analyse, NULL, 0);
+    char *chemin = (char*)malloc(longueur + 1);
+
+    printf("Profondeur: %i, chemin critique (%i signaux): %s\n", analyse->profondeur, analyse->nb_chemin,
+           chemin != NULL && t_analyse_temporelle_chemin_critique(analyse, chemin, longueur + 1) == longueur ? chemin : "?");
+    printf("Niveaux: %i, largeur max: %i portes, largeur moyenne: %.1f portes\n", analyse->netlist->nb_niveaux,
+           analyse->largeur_max, analyse->largeur_moyenne);
+    printf("Fanout max: %i (%s), fanout moyen: %.2f, signaux sans lecteur: %i\n", analyse->fanout_max,
+           analyse->net_fanout_max >= 0 ? t_analyse_temporelle_nom_net(analyse, analyse->net_fanout_max) : "-",
+           analyse->fanout_moyen, analyse->nb_nets_sans_lecteur);
+    free(chemin);
+}
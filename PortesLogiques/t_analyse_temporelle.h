@@ -0,0 +1,112 @@
+/*
+Module: T_ANALYSE_TEMPORELLE
+Description: Analyse temporelle statique d'un circuit: le temps d'arrivée de chaque signal, la
+			 profondeur logique du circuit et son chemin critique, ainsi que des statistiques de
+			 fanout et de largeur des niveaux.
+
+			 Le temps d'arrivée d'une entrée du circuit (ou de la sortie d'une bascule) est 0; celui
+			 de la sortie d'une porte est le plus grand temps d'arrivée de ses entrées plus le délai
+			 de son type. Avec les délais unitaires, le temps d'arrivée est le nombre de portes du
+			 plus long chemin qui mène au signal. Les points d'arrivée des chemins sont les sorties
+			 du circuit et les entrées des bascules; le chemin critique est le plus long d'entre eux.
+
+			 La largeur des niveaux (nombre de portes que l'évaluateur par niveaux peut traiter
+			 d'un coup, voir t_simulation_parallele) et le fanout (nombre de lectures de chaque
+			 signal par des portes et des sorties) indiquent le comportement des simulateurs.
+*/
+
+#ifndef T_ANALYSE_TEMPORELLE_H_
+#define T_ANALYSE_TEMPORELLE_H_
+
+#include <stddef.h>
+#include "t_circuit.h"
+
+typedef struct t_circuit t_circuit;
+typedef struct t_netlist t_netlist;
+
+/*
+Résultat de l'analyse. Les signaux sont numérotés comme les nets de la netlist du circuit: les
+entrées (0 à nb_entrees - 1) puis la sortie de chaque porte dans l'ordre d'évaluation.
+*/
+struct t_analyse_temporelle {
+	t_netlist *netlist; //Netlist analysée (celle du circuit)
+	t_circuit *circuit; //Circuit dont la netlist est analysée (pour les noms)
+	int *arrivees; //Temps d'arrivée de chaque net
+	int *predecesseurs; //Net d'entrée le plus tardif de la porte de chaque net (-1 pour une source)
+	int *fanouts; //Nombre de lectures de chaque net (entrées de portes et sorties du circuit)
+
+	int profondeur; //Plus grand temps d'arrivée d'un point d'arrivée
+	//Point d'arrivée du chemin critique: sortie j du circuit (j >= 0) ou bascule (-1 - porte dans
+	//l'ordre d'évaluation)
+	int fin_critique;
+	int *chemin; //Nets du chemin critique, de la source au point d'arrivée
+	int nb_chemin;
+
+	int largeur_max; //Nombre maximal de portes d'un niveau
+	double largeur_moyenne; //Nombre moyen de portes par niveau
+	int fanout_max; //Plus grand nombre de lectures d'un net
+	int net_fanout_max; //Net qui a ce nombre de lectures
+	double fanout_moyen; //Nombre moyen de lectures des nets
+	int nb_nets_sans_lecteur; //Nets qui ne sont lus par aucune porte ni aucune sortie
+};
+
+typedef struct t_analyse_temporelle t_analyse_temporelle;
+
+/*
+Fonction: T_ANALYSE_TEMPORELLE_CALCULER
+Description: Analyse un circuit (voir la description du module). L'analyse lit la netlist et les
+			 noms du circuit: elle reste valide tant que le circuit n'est pas modifié ni détruit
+			 (modifier d'autres circuits ne recompile pas sa netlist).
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+- delais: Délai de chaque type de porte (indexé par e_types_portes), ou NULL pour les délais
+		  unitaires: 1 par porte, 0 pour les bascules et les constantes.
+Retour: Pointeur vers l'analyse créée. NULL si le circuit ne peut pas être compilé ou si la
+		mémoire manque.
+*/
+t_analyse_temporelle *t_analyse_temporelle_calculer(t_circuit *circuit, const int delais[]);
+
+/*
+Fonction: T_ANALYSE_TEMPORELLE_DESTROY
+Description: Libère la mémoire occupée par l'analyse.
+Paramètres:
+- analyse: Pointeur vers l'analyse à détruire.
+Retour: Aucun.
+*/
+void t_analyse_temporelle_destroy(t_analyse_temporelle *analyse);
+
+/*
+Fonction: T_ANALYSE_TEMPORELLE_NOM_NET
+Description: Retourne le nom du composant qui produit un net: le nom de l'entrée du circuit ou
+			 celui de la porte (ex.: E0, P3).
+Paramètres:
+- analyse: Pointeur vers l'analyse.
+- net: Numéro du net.
+Retour: Nom du composant.
+*/
+const char *t_analyse_temporelle_nom_net(const t_analyse_temporelle *analyse, int net);
+
+/*
+Fonction: T_ANALYSE_TEMPORELLE_CHEMIN_CRITIQUE
+Description: Écrit le chemin critique sous forme de noms séparés par des flèches, de la source au
+			 point d'arrivée (ex.: E1->P3->P7->S0; un chemin qui finit à une bascule se termine par
+			 le nom de la bascule). Comme snprintf, le texte est tronqué si le tampon est trop petit.
+Paramètres:
+- analyse: Pointeur vers l'analyse.
+- tampon: Tableau qui reçoit le texte (terminé par '\0' si taille > 0).
+- taille: Taille du tampon.
+Retour: Longueur du texte complet (sans le '\0').
+*/
+size_t t_analyse_temporelle_chemin_critique(const t_analyse_temporelle *analyse, char *tampon, size_t taille);
+
+/*
+Fonction: T_ANALYSE_TEMPORELLE_AFFICHER_RAPPORT
+Description: Affiche la profondeur, le chemin critique, la largeur des niveaux et les statistiques
+			 de fanout.
+Paramètres:
+- analyse: Pointeur vers l'analyse.
+Retour: Aucun.
+*/
+void t_analyse_temporelle_afficher_rapport(const t_analyse_temporelle *analyse);
+
+#endif
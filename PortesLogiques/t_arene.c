@@ -0,0 +1,126 @@
+//
+// Arène de mémoire pour les composants d'un circuit (voir t_arene.h).
+//
+
+#include "t_arene.h"
+
+t_arene *t_arene_init(size_t taille_bloc)
+{
+    t_arene *arene;
+
+    arene = (t_arene*)malloc(sizeof(t_arene));
+
+    if(arene == NULL)
+    {
+
+        return NULL;
+    }
+
+    arene->blocs = NULL;
+    arene->taille_bloc = taille_bloc ? taille_bloc : ARENE_TAILLE_BLOC;
+    arene->taille_reservee = 0;
+    arene->taille_utilisee = 0;
+
+
+    return arene;
+}
+
+void t_arene_destroy(t_arene *arene)
+{
+    t_bloc_arene *bloc;
+
+    if(arene == NULL)
+    {
+
+        return;
+    }
+
+    while(arene->blocs != NULL)
+    {
+        bloc = arene->blocs;
+        arene->blocs = bloc->suivant;
+        free(bloc);
+    }
+
+    free(arene);
+}
+
+void *t_arene_allouer(t_arene *arene, size_t taille)
+{
+    t_bloc_arene *bloc;
+    //L'en-tête est arrondi pour que les données du bloc soient alignées
+    const size_t taille_entete = (sizeof(t_bloc_arene) + ARENE_ALIGNEMENT - 1) & ~(size_t)(ARENE_ALIGNEMENT - 1);
+    void *zone;
+
+    if(arene == NULL)
+    {
+
+        return malloc(taille);
+    }
+
+    taille = (taille + ARENE_ALIGNEMENT - 1) & ~(size_t)(ARENE_ALIGNEMENT - 1);
+
+    //Une grande demande reçoit son propre bloc, placé derrière le bloc courant pour ne pas
+    //perdre l'espace qui reste dans celui-ci
+    if(taille > arene->taille_bloc / 4)
+    {
+        bloc = (t_bloc_arene*)malloc(taille_entete + taille);
+
+        if(bloc == NULL)
+        {
+
+            return NULL;
+        }
+
+        bloc->taille = taille;
+        bloc->utilise = taille;
+
+        if(arene->blocs == NULL)
+        {
+            bloc->suivant = NULL;
+            arene->blocs = bloc;
+        }
+        else
+        {
+            bloc->suivant = arene->blocs->suivant;
+            arene->blocs->suivant = bloc;
+        }
+
+        arene->taille_reservee += taille;
+        arene->taille_utilisee += taille;
+
+        return (char*)bloc + taille_entete;
+    }
+
+    if(arene->blocs == NULL || arene->blocs->utilise + taille > arene->blocs->taille)
+    {
+        bloc = (t_bloc_arene*)malloc(taille_entete + arene->taille_bloc);
+
+        if(bloc == NULL)
+        {
+
+            return NULL;
+        }
+
+        bloc->taille = arene->taille_bloc;
+        bloc->utilise = 0;
+        bloc->suivant = arene->blocs;
+        arene->blocs = bloc;
+        arene->taille_reservee += arene->taille_bloc;
+    }
+
+    zone = (char*)arene->blocs + taille_entete + arene->blocs->utilise;
+    arene->blocs->utilise += taille;
+    arene->taille_utilisee += taille;
+
+
+    return zone;
+}
+
+void t_arene_liberer(t_arene *arene, void *zone)
+{
+    if(arene == NULL)
+    {
+        free(zone);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+Module: T_ARENE
+Description: Définit le type t_arene, une zone de mémoire dans laquelle on découpe les composants
+			 d'un circuit (portes, pins, noms, etc.). L'arène réserve de gros blocs de mémoire et
+			 les découpe au fur et à mesure des demandes. La mémoire n'est jamais libérée élément
+			 par élément: tout est libéré d'un coup par t_arene_destroy.
+*/
+
+#ifndef T_ARENE_H_
+#define T_ARENE_H_
+
+#include <stdlib.h>
+
+#define ARENE_TAILLE_BLOC (1 << 20) //Taille par défaut d'un bloc de l'arène (en octets)
+#define ARENE_ALIGNEMENT 8 //Alignement des adresses retournées par l'arène (en octets)
+
+//Bloc de mémoire de l'arène. Les données suivent immédiatement l'en-tête.
+struct t_bloc_arene {
+	struct t_bloc_arene *suivant; //Bloc alloué précédemment
+	size_t taille; //Nombre d'octets de données du bloc
+	size_t utilise; //Nombre d'octets déjà découpés dans le bloc
+};
+
+typedef struct t_bloc_arene t_bloc_arene;
+
+struct t_arene {
+	t_bloc_arene *blocs; //Bloc courant (les blocs forment une liste chaînée)
+	size_t taille_bloc; //Taille des nouveaux blocs
+	size_t taille_reservee; //Nombre total d'octets réservés par l'arène
+	size_t taille_utilisee; //Nombre total d'octets découpés dans l'arène
+};
+
+typedef struct t_arene t_arene;
+
+/*
+Fonction: T_ARENE_INIT
+Description: Crée une nouvelle arène vide. Aucun bloc n'est réservé avant la première allocation.
+Paramètres:
+- taille_bloc: Taille des blocs réservés par l'arène (0 pour ARENE_TAILLE_BLOC).
+Retour: Pointeur vers l'arène créée (NULL si la mémoire manque).
+*/
+t_arene *t_arene_init(size_t taille_bloc);
+
+/*
+Fonction: T_ARENE_DESTROY
+Description: Libère toute la mémoire de l'arène, et donc tous les éléments qui y ont été alloués.
+Paramètres:
+- arene: Pointeur vers l'arène à détruire.
+Retour: Aucun.
+*/
+void t_arene_destroy(t_arene *arene);
+
+/*
+Fonction: T_ARENE_ALLOUER
+Description: Découpe une zone de mémoire dans l'arène. Si l'arène est NULL, la zone est allouée
+			 avec malloc (elle devra alors être libérée avec t_arene_liberer ou free). Ceci permet
+			 aux composants d'être créés seuls ou dans l'arène d'un circuit avec le même code.
+Paramètres:
+- arene: Pointeur vers l'arène (ou NULL).
+- taille: Nombre d'octets demandés.
+Retour: Adresse de la zone (alignée sur ARENE_ALIGNEMENT octets), NULL si la mémoire manque.
+*/
+void *t_arene_allouer(t_arene *arene, size_t taille);
+
+/*
+Fonction: T_ARENE_LIBERER
+Description: Libère une zone obtenue de t_arene_allouer. N'a aucun effet si l'arène n'est pas NULL:
+			 la zone sera libérée avec l'arène.
+Paramètres:
+- arene: Pointeur vers l'arène qui a fourni la zone (ou NULL).
+- zone: Adresse de la zone à libérer.
+Retour: Aucun.
+*/
+void t_arene_liberer(t_arene *arene, void *zone);
+
+#endif
@@ -0,0 +1,370 @@
+//
+// Balayage de vecteurs réparti entre plusieurs fils (voir t_balayage.h).
+//
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "t_balayage.h"
+
+typedef struct t_balayage t_balayage;
+
+/*
+État d'un fil: la plage de blocs qui lui reste et son tableau de valeurs privé.
+*/
+typedef struct {
+	t_balayage *balayage;
+	pthread_t fil;
+	int fil_cree; //Booléen: vrai si le fil a été créé (l'ouvrier 0 est le fil appelant)
+	pthread_mutex_t verrou; //Protège debut et fin (un autre fil peut voler la fin de la plage)
+	long long debut; //Prochain bloc à simuler
+	long long fin; //Bloc qui suit le dernier bloc de la plage
+	uint64_t *valeurs; //Valeurs des nets pour un bloc
+	uint64_t *sorties; //Sorties d'un bloc, pour le puits
+	long long nb_vols;
+} t_ouvrier_balayage;
+
+/*
+Description d'un balayage, partagée par tous les fils.
+*/
+struct t_balayage {
+	const t_netlist *netlist;
+	uint64_t premier; //Premier vecteur (balayage d'une plage)
+	const uint64_t *vecteurs; //Vecteurs à simuler (balayage d'une liste), NULL pour une plage
+	int nb_mots_vecteur; //Nombre de mots par vecteur de la liste
+	uint64_t nb_vecteurs;
+	long long nb_mots; //Nombre de mots de 64 vecteurs du balayage
+	int mots_par_bloc;
+	uint64_t *resultat;
+	t_puits_balayage puits;
+	void *contexte;
+	t_ouvrier_balayage *ouvriers;
+	int nb_ouvriers;
+};
+
+//Place dans valeurs les mots des entrées pour les mots premier_mot à premier_mot + nb_mots - 1
+static void t_balayage_remplir_entrees(const t_balayage *balayage, uint64_t *valeurs, long long premier_mot, int nb_mots)
+{
+    const int nb_entrees = balayage->netlist->nb_entrees;
+    uint64_t vecteur;
+    uint64_t rang;
+    const uint64_t *source;
+
+    //Motifs des 6 premières entrées quand les 64 vecteurs d'un mot se suivent à partir d'un multiple de 64
+    static const uint64_t motifs[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                                       0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+    memset(valeurs, 0, sizeof(uint64_t) * nb_entrees * nb_mots);
+
+    for(int m = 0;m<nb_mots;m++)
+    {
+        rang = (uint64_t)(premier_mot + m) * 64;
+
+        if(balayage->vecteurs == NULL && balayage->premier % 64 == 0)
+        {
+            vecteur = balayage->premier + rang;
+
+            for(int i = 0;i<nb_entrees && i<64;i++)
+            {
+                valeurs[i * nb_mots + m] = i < 6 ? motifs[i] : ((vecteur >> i) & 1) ? ~(uint64_t)0 : 0;
+            }
+
+            continue;
+        }
+
+        for(int k = 0;k<64 && rang + k<balayage->nb_vecteurs;k++)
+        {
+            if(balayage->vecteurs == NULL)
+            {
+                vecteur = balayage->premier + rang + k;
+
+                for(int i = 0;i<nb_entrees && i<64;i++)
+                {
+                    valeurs[i * nb_mots + m] |= ((vecteur >> i) & 1) << k;
+                }
+            }
+            else
+            {
+                source = &balayage->vecteurs[(rang + k) * balayage->nb_mots_vecteur];
+
+                for(int i = 0;i<nb_entrees;i++)
+                {
+                    valeurs[i * nb_mots + m] |= ((source[i / 64] >> (i % 64)) & 1) << k;
+                }
+            }
+        }
+    }
+}
+
+//Simule un bloc et transmet ses sorties
+static void t_balayage_simuler_bloc(t_balayage *balayage, t_ouvrier_balayage *ouvrier, long long bloc)
+{
+    const t_netlist *netlist = balayage->netlist;
+    long long premier_mot = bloc * balayage->mots_par_bloc;
+    int nb_mots = balayage->mots_par_bloc;
+    uint64_t nb_vecteurs;
+
+    if(premier_mot + nb_mots > balayage->nb_mots)
+    {
+        nb_mots = (int)(balayage->nb_mots - premier_mot);
+    }
+
+    t_balayage_remplir_entrees(balayage, ouvrier->valeurs, premier_mot, nb_mots);
+    t_netlist_lire_etats(netlist, ouvrier->valeurs, nb_mots, premier_mot, balayage->nb_mots);
+    t_netlist_evaluer(netlist, ouvrier->valeurs, nb_mots);
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        const uint64_t *mots = &ouvrier->valeurs[(size_t)netlist->sorties[j] * nb_mots];
+
+        if(balayage->resultat != NULL)
+        {
+            memcpy(&balayage->resultat[j * balayage->nb_mots + premier_mot], mots, sizeof(uint64_t) * nb_mots);
+        }
+
+        if(balayage->puits != NULL)
+        {
+            memcpy(&ouvrier->sorties[j * nb_mots], mots, sizeof(uint64_t) * nb_mots);
+        }
+    }
+
+    if(balayage->puits != NULL)
+    {
+        nb_vecteurs = balayage->nb_vecteurs - (uint64_t)premier_mot * 64;
+
+        if(nb_vecteurs > (uint64_t)nb_mots * 64)
+        {
+            nb_vecteurs = (uint64_t)nb_mots * 64;
+        }
+
+        balayage->puits(balayage->contexte, (uint64_t)premier_mot * 64, (int)nb_vecteurs, ouvrier->sorties, nb_mots);
+    }
+}
+
+//Donne le prochain bloc à simuler par l'ouvrier. Quand sa plage est vide, l'ouvrier vole la
+//moitié de la plage la plus longue. Retourne faux s'il ne reste plus de travail.
+static int t_balayage_prendre_bloc(t_balayage *balayage, t_ouvrier_balayage *ouvrier, long long *bloc)
+{
+    t_ouvrier_balayage *victime;
+    long long plus_long;
+    long long reste;
+    long long moitie;
+
+    pthread_mutex_lock(&ouvrier->verrou);
+
+    if(ouvrier->debut < ouvrier->fin)
+    {
+        *bloc = ouvrier->debut++;
+        pthread_mutex_unlock(&ouvrier->verrou);
+
+        return 1;
+    }
+
+    pthread_mutex_unlock(&ouvrier->verrou);
+
+    for(;;)
+    {
+        //Un seul verrou est tenu à la fois: aucun interblocage possible
+        victime = NULL;
+        plus_long = 0;
+
+        for(int o = 0;o<balayage->nb_ouvriers;o++)
+        {
+            pthread_mutex_lock(&balayage->ouvriers[o].verrou);
+            reste = balayage->ouvriers[o].fin - balayage->ouvriers[o].debut;
+            pthread_mutex_unlock(&balayage->ouvriers[o].verrou);
+
+            if(reste > plus_long)
+            {
+                plus_long = reste;
+                victime = &balayage->ouvriers[o];
+            }
+        }
+
+        if(victime == NULL)
+        {
+
+            return 0;
+        }
+
+        pthread_mutex_lock(&victime->verrou);
+        reste = victime->fin - victime->debut;
+
+        if(reste <= 0)
+        {
+            //La plage a été terminée ou volée entre-temps
+            pthread_mutex_unlock(&victime->verrou);
+            continue;
+        }
+
+        moitie = (reste + 1) / 2;
+        victime->fin -= moitie;
+        *bloc = victime->fin;
+        pthread_mutex_unlock(&victime->verrou);
+
+        pthread_mutex_lock(&ouvrier->verrou);
+        ouvrier->debut = *bloc + 1;
+        ouvrier->fin = *bloc + moitie;
+        ouvrier->nb_vols++;
+        pthread_mutex_unlock(&ouvrier->verrou);
+
+
+        return 1;
+    }
+}
+
+static void *t_balayage_executer(void *argument)
+{
+    t_ouvrier_balayage *ouvrier = (t_ouvrier_balayage*)argument;
+    long long bloc;
+
+    while(t_balayage_prendre_bloc(ouvrier->balayage, ouvrier, &bloc))
+    {
+        t_balayage_simuler_bloc(ouvrier->balayage, ouvrier, bloc);
+    }
+
+
+    return NULL;
+}
+
+//Répartit les blocs entre les fils, attend la fin du balayage et libère les ouvriers
+static long long t_balayage_lancer(t_balayage *balayage, int nb_fils)
+{
+    const t_netlist *netlist = balayage->netlist;
+    long long nb_blocs;
+    long long nb_vols = 0;
+    int succes = 1;
+
+    if(nb_fils < 1)
+    {
+        nb_fils = 1;
+    }
+
+    balayage->nb_mots = (long long)((balayage->nb_vecteurs + 63) / 64);
+
+    //Les blocs sont assez petits pour que les valeurs d'un fil restent dans le cache
+    balayage->mots_par_bloc = (int)(BALAYAGE_OCTETS_TAMPON / (sizeof(uint64_t) * (netlist->nb_nets + 1)));
+
+    if(balayage->mots_par_bloc > BALAYAGE_MOTS_MAX)
+    {
+        balayage->mots_par_bloc = BALAYAGE_MOTS_MAX;
+    }
+
+    if(balayage->mots_par_bloc < 1)
+    {
+        balayage->mots_par_bloc = 1;
+    }
+
+    nb_blocs = (balayage->nb_mots + balayage->mots_par_bloc - 1) / balayage->mots_par_bloc;
+
+    if(nb_fils > nb_blocs && nb_blocs > 0)
+    {
+        nb_fils = (int)nb_blocs;
+    }
+
+    balayage->ouvriers = (t_ouvrier_balayage*)calloc(nb_fils, sizeof(t_ouvrier_balayage));
+
+    if(balayage->ouvriers == NULL)
+    {
+
+        return -1;
+    }
+
+    balayage->nb_ouvriers = nb_fils;
+
+    for(int o = 0;o<nb_fils;o++)
+    {
+        t_ouvrier_balayage *ouvrier = &balayage->ouvriers[o];
+
+        ouvrier->balayage = balayage;
+        ouvrier->debut = nb_blocs * o / nb_fils;
+        ouvrier->fin = nb_blocs * (o + 1) / nb_fils;
+        ouvrier->valeurs = (uint64_t*)calloc((size_t)netlist->nb_nets * balayage->mots_par_bloc, sizeof(uint64_t));
+        ouvrier->sorties = (uint64_t*)malloc(sizeof(uint64_t) * (netlist->nb_sorties + 1) * balayage->mots_par_bloc);
+        pthread_mutex_init(&ouvrier->verrou, NULL);
+        succes = succes && ouvrier->valeurs != NULL && ouvrier->sorties != NULL;
+    }
+
+    if(succes)
+    {
+        //Le fil appelant est l'ouvrier 0. Si un fil ne peut pas être créé, sa plage sera volée
+        //par les autres ouvriers.
+        for(int o = 1;o<nb_fils;o++)
+        {
+            balayage->ouvriers[o].fil_cree = pthread_create(&balayage->ouvriers[o].fil, NULL, t_balayage_executer,
+                                                            &balayage->ouvriers[o]) == 0;
+        }
+
+        t_balayage_executer(&balayage->ouvriers[0]);
+
+        for(int o = 1;o<nb_fils;o++)
+        {
+            if(balayage->ouvriers[o].fil_cree)
+            {
+                pthread_join(balayage->ouvriers[o].fil, NULL);
+            }
+        }
+    }
+
+    for(int o = 0;o<nb_fils;o++)
+    {
+        nb_vols += balayage->ouvriers[o].nb_vols;
+        pthread_mutex_destroy(&balayage->ouvriers[o].verrou);
+        free(balayage->ouvriers[o].valeurs);
+        free(balayage->ouvriers[o].sorties);
+    }
+
+    free(balayage->ouvriers);
+
+
+    return succes ? nb_vols : -1;
+}
+
+long long t_balayage_plage(t_circuit *circuit, uint64_t premier, uint64_t nb_vecteurs, int nb_fils,
+                           uint64_t resultat[], t_puits_balayage puits, void *contexte)
+{
+    t_balayage balayage;
+
+    memset(&balayage, 0, sizeof(t_balayage));
+    balayage.netlist = t_circuit_get_netlist(circuit);
+
+    if(balayage.netlist == NULL)
+    {
+
+        return -1;
+    }
+
+    balayage.premier = premier;
+    balayage.nb_vecteurs = nb_vecteurs;
+    balayage.resultat = resultat;
+    balayage.puits = puits;
+    balayage.contexte = contexte;
+
+
+    return t_balayage_lancer(&balayage, nb_fils);
+}
+
+long long t_balayage_liste(t_circuit *circuit, const uint64_t vecteurs[], uint64_t nb_vecteurs, int nb_fils,
+                           uint64_t resultat[], t_puits_balayage puits, void *contexte)
+{
+    t_balayage balayage;
+
+    memset(&balayage, 0, sizeof(t_balayage));
+    balayage.netlist = t_circuit_get_netlist(circuit);
+
+    if(balayage.netlist == NULL)
+    {
+
+        return -1;
+    }
+
+    balayage.vecteurs = vecteurs;
+    balayage.nb_mots_vecteur = (balayage.netlist->nb_entrees + 63) / 64;
+    balayage.nb_vecteurs = nb_vecteurs;
+    balayage.resultat = resultat;
+    balayage.puits = puits;
+    balayage.contexte = contexte;
+
+
+    return t_balayage_lancer(&balayage, nb_fils);
+}
@@ -0,0 +1,83 @@
+/*
+Module: T_BALAYAGE
+Description: Simulation d'un grand nombre de vecteurs d'entrée répartis entre plusieurs fils
+			 d'exécution (par exemple pour calculer la table de vérité complète d'un circuit:
+			 2^n vecteurs). Contrairement à t_simulation_parallele, qui partage les portes d'un
+			 niveau entre les fils, chaque fil simule ici ses propres vecteurs sur la netlist
+			 partagée (en lecture seule), avec son propre tableau de valeurs des nets.
+
+			 Les vecteurs sont découpés en blocs de mots de 64 vecteurs. Chaque fil reçoit une
+			 plage de blocs; un fil qui a terminé sa plage vole la moitié de la plage restante
+			 d'un autre fil (vol de travail), ce qui équilibre les fils même si certains sont
+			 ralentis.
+
+			 Résultats: le mot w de la sortie j est le mot resultat[j * nb_mots + w], où
+			 nb_mots = (nb_vecteurs + 63) / 64; le bit k de ce mot est la valeur de la sortie pour
+			 le vecteur 64 * w + k du balayage. Les bits au-delà du dernier vecteur ne sont pas
+			 significatifs. Les résultats peuvent aussi (ou plutôt) être envoyés à un puits, appelé
+			 pour chaque bloc simulé.
+
+			 Circuits séquentiels: les bascules fournissent l'état courant de la netlist, comme si
+			 tout le balayage était un seul lot de nb_mots mots (voir t_netlist_lire_etats); un
+			 balayage ne fait pas de front d'horloge.
+*/
+
+#ifndef T_BALAYAGE_H_
+#define T_BALAYAGE_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+
+#define BALAYAGE_OCTETS_TAMPON (1 << 21) //Taille visée du tableau de valeurs de chaque fil
+#define BALAYAGE_MOTS_MAX 16 //Nombre maximal de mots (de 64 vecteurs) par bloc
+
+typedef struct t_circuit t_circuit;
+
+/*
+Puits de résultats: fonction appelée pour chaque bloc simulé, depuis le fil qui l'a simulé. Les
+blocs arrivent dans n'importe quel ordre et plusieurs fils peuvent appeler le puits en même temps.
+Paramètres:
+- contexte: Pointeur donné à la fonction de balayage.
+- premier_vecteur: Rang (dans le balayage) du premier vecteur du bloc, multiple de 64.
+- nb_vecteurs: Nombre de vecteurs du bloc.
+- sorties: Mots des sorties pour le bloc: sorties[j * nb_mots + m] est le mot m de la sortie j.
+- nb_mots: Nombre de mots par sortie dans le bloc.
+*/
+typedef void (*t_puits_balayage)(void *contexte, uint64_t premier_vecteur, int nb_vecteurs,
+                                 const uint64_t sorties[], int nb_mots);
+
+/*
+Fonction: T_BALAYAGE_PLAGE
+Description: Simule les vecteurs premier à premier + nb_vecteurs - 1. Le vecteur v donne à
+			 l'entrée i la valeur du bit i de v (les entrées au-delà de la 64e reçoivent 0).
+			 Pour une table de vérité: premier = 0, nb_vecteurs = 2^nb_entrees.
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+- premier: Premier vecteur de la plage.
+- nb_vecteurs: Nombre de vecteurs à simuler.
+- nb_fils: Nombre de fils (1 = dans le fil appelant seulement).
+- resultat: Tableau (nb_sorties * nb_mots mots) qui reçoit les sorties, ou NULL.
+- puits: Fonction qui reçoit les sorties de chaque bloc, ou NULL.
+- contexte: Pointeur donné au puits.
+Retour: Nombre de vols de travail effectués (>= 0), -1 si le circuit ne peut pas être compilé
+		ou si la mémoire manque. Un fil qui n'a pu être créé n'est pas une erreur: sa plage est
+		volée par les autres ouvriers et le balayage est complet.
+*/
+long long t_balayage_plage(t_circuit *circuit, uint64_t premier, uint64_t nb_vecteurs, int nb_fils,
+                           uint64_t resultat[], t_puits_balayage puits, void *contexte);
+
+/*
+Fonction: T_BALAYAGE_LISTE
+Description: Simule une liste de vecteurs. Chaque vecteur occupe (nb_entrees + 63) / 64 mots
+			 consécutifs du tableau vecteurs; le bit i % 64 du mot i / 64 est la valeur de l'entrée i.
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+- vecteurs: Vecteurs à simuler.
+- nb_vecteurs: Nombre de vecteurs.
+- nb_fils, resultat, puits, contexte: Voir t_balayage_plage.
+Retour: Voir t_balayage_plage.
+*/
+long long t_balayage_liste(t_circuit *circuit, const uint64_t vecteurs[], uint64_t nb_vecteurs, int nb_fils,
+                           uint64_t resultat[], t_puits_balayage puits, void *contexte);
+
+#endif
@@ -0,0 +1,579 @@
+//
+// Diagrammes de décision binaires réduits et ordonnés (voir t_bdd.h).
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "t_bdd.h"
+#include "t_aig.h"
+
+#define BDD_CAPACITE_INITIALE 1024 //Nombre de noeuds alloués à la création d'un gestionnaire
+
+//Motifs des 6 premiers signaux quand les 64 vecteurs d'un mot se suivent à partir d'un multiple de 64
+static const uint64_t motifs[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                                   0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+//Hachage d'un triplet d'entiers (noeud de la table unique ou calcul du cache)
+static uint64_t t_bdd_hacher(int a, int b, int c)
+{
+    uint64_t hachage = ((uint64_t)(uint32_t)a << 32 | (uint32_t)b) * 0x9E3779B97F4A7C15ull;
+
+    hachage = (hachage ^ (uint32_t)c) * 0xC2B2AE3D27D4EB4Full;
+
+
+    return hachage ^ hachage >> 29;
+}
+
+//Réalloue la table unique à une capacité donnée et y range tous les noeuds
+static int t_bdd_rehacher(t_bdd *bdd, int capacite)
+{
+    int *table = (int*)malloc(sizeof(int) * capacite);
+    size_t position;
+
+    if(table == NULL)
+    {
+
+        return 0;
+    }
+
+    memset(table, -1, sizeof(int) * capacite);
+
+    for(int k = 2;k<bdd->nb_noeuds;k++)
+    {
+        position = (size_t)t_bdd_hacher(bdd->noeuds[k].variable, bdd->noeuds[k].bas, bdd->noeuds[k].haut) & (capacite - 1);
+
+        while(table[position] != -1)
+        {
+            position = (position + 1) & (capacite - 1);
+        }
+
+        table[position] = k;
+    }
+
+    free(bdd->table_unique);
+    bdd->table_unique = table;
+    bdd->capacite_unique = capacite;
+
+
+    return 1;
+}
+
+//Agrandit le tableau des noeuds et le cache des calculs (vidé) en proportion
+static int t_bdd_agrandir(t_bdd *bdd)
+{
+    t_noeud_bdd *noeuds = (t_noeud_bdd*)realloc(bdd->noeuds, sizeof(t_noeud_bdd) * 2 * bdd->capacite_noeuds);
+    t_calcul_bdd *cache;
+    int taille_cache;
+
+    if(noeuds == NULL)
+    {
+
+        return 0;
+    }
+
+    bdd->noeuds = noeuds;
+    bdd->capacite_noeuds *= 2;
+    taille_cache = bdd->capacite_noeuds < BDD_TAILLE_CACHE_MAX ? bdd->capacite_noeuds : BDD_TAILLE_CACHE_MAX;
+
+    if(taille_cache > bdd->taille_cache)
+    {
+        cache = (t_calcul_bdd*)malloc(sizeof(t_calcul_bdd) * taille_cache);
+
+        //Sans mémoire pour un plus grand cache, l'ancien reste utilisable
+        if(cache != NULL)
+        {
+            memset(cache, -1, sizeof(t_calcul_bdd) * taille_cache);
+            free(bdd->cache);
+            bdd->cache = cache;
+            bdd->taille_cache = taille_cache;
+        }
+    }
+
+
+    return 1;
+}
+
+//Retourne le noeud (variable, bas, haut): un noeud existant, bas si bas == haut ou un nouveau noeud
+static int t_bdd_noeud(t_bdd *bdd, int variable, int bas, int haut)
+{
+    size_t position;
+    int k;
+
+    if(bas == haut)
+    {
+
+        return bas;
+    }
+
+    if(2 * (bdd->nb_noeuds + 1) > bdd->capacite_unique && !t_bdd_rehacher(bdd, 2 * bdd->capacite_unique))
+    {
+
+        return BDD_ECHEC;
+    }
+
+    position = (size_t)t_bdd_hacher(variable, bas, haut) & (bdd->capacite_unique - 1);
+
+    while(bdd->table_unique[position] != -1)
+    {
+        k = bdd->table_unique[position];
+
+        if(bdd->noeuds[k].variable == variable && bdd->noeuds[k].bas == bas && bdd->noeuds[k].haut == haut)
+        {
+
+            return k;
+        }
+
+        position = (position + 1) & (bdd->capacite_unique - 1);
+    }
+
+    if((bdd->max_noeuds > 0 && bdd->nb_noeuds >= bdd->max_noeuds)
+       || (bdd->nb_noeuds == bdd->capacite_noeuds && !t_bdd_agrandir(bdd)))
+    {
+
+        return BDD_ECHEC;
+    }
+
+    k = bdd->nb_noeuds++;
+    bdd->noeuds[k].variable = variable;
+    bdd->noeuds[k].bas = bas;
+    bdd->noeuds[k].haut = haut;
+    bdd->table_unique[position] = k;
+
+
+    return k;
+}
+
+t_bdd *t_bdd_init(int nb_variables, int max_noeuds)
+{
+    t_bdd *bdd = (t_bdd*)calloc(1, sizeof(t_bdd));
+
+    if(bdd == NULL)
+    {
+
+        return NULL;
+    }
+
+    bdd->nb_variables = nb_variables;
+    bdd->max_noeuds = max_noeuds;
+    bdd->capacite_noeuds = BDD_CAPACITE_INITIALE;
+    bdd->taille_cache = BDD_CAPACITE_INITIALE;
+    bdd->signaux = (int*)malloc(sizeof(int) * (nb_variables + 1));
+    bdd->noeuds = (t_noeud_bdd*)malloc(sizeof(t_noeud_bdd) * bdd->capacite_noeuds);
+    bdd->cache = (t_calcul_bdd*)malloc(sizeof(t_calcul_bdd) * bdd->taille_cache);
+
+    if(bdd->signaux == NULL || bdd->noeuds == NULL || bdd->cache == NULL || !t_bdd_rehacher(bdd, 2 * BDD_CAPACITE_INITIALE))
+    {
+        t_bdd_destroy(bdd);
+
+        return NULL;
+    }
+
+    for(int r = 0;r<nb_variables;r++)
+    {
+        bdd->signaux[r] = r;
+    }
+
+    memset(bdd->cache, -1, sizeof(t_calcul_bdd) * bdd->taille_cache);
+
+    //Les constantes testent une variable fictive après toutes les autres
+    for(int k = BDD_ZERO;k<=BDD_UN;k++)
+    {
+        bdd->noeuds[k].variable = nb_variables;
+        bdd->noeuds[k].bas = k;
+        bdd->noeuds[k].haut = k;
+    }
+
+    bdd->nb_noeuds = 2;
+
+
+    return bdd;
+}
+
+void t_bdd_destroy(t_bdd *bdd)
+{
+    if(bdd != NULL)
+    {
+        free(bdd->signaux);
+        free(bdd->noeuds);
+        free(bdd->table_unique);
+        free(bdd->cache);
+        free(bdd->sorties);
+        free(bdd->entrees_bascules);
+        free(bdd);
+    }
+}
+
+int t_bdd_variable(t_bdd *bdd, int rang)
+{
+
+    return t_bdd_noeud(bdd, rang, BDD_ZERO, BDD_UN);
+}
+
+int t_bdd_ite(t_bdd *bdd, int f, int g, int h)
+{
+    t_calcul_bdd *calcul;
+    int variable;
+    int f0, f1, g0, g1, h0, h1;
+    int haut;
+    int bas;
+    int resultat;
+
+    if(f < 0 || g < 0 || h < 0)
+    {
+
+        return BDD_ECHEC;
+    }
+
+    if(f == BDD_UN || g == h)
+    {
+
+        return g;
+    }
+
+    if(f == BDD_ZERO)
+    {
+
+        return h;
+    }
+
+    if(g == BDD_UN && h == BDD_ZERO)
+    {
+
+        return f;
+    }
+
+    bdd->nb_calculs++;
+    calcul = &bdd->cache[t_bdd_hacher(f, g, h) & (bdd->taille_cache - 1)];
+
+    if(calcul->f == f && calcul->g == g && calcul->h == h)
+    {
+        bdd->nb_succes_cache++;
+
+        return calcul->resultat;
+    }
+
+    //Variable testée en premier par un des opérandes, puis cofacteurs de chaque opérande
+    variable = bdd->noeuds[f].variable;
+    variable = bdd->noeuds[g].variable < variable ? bdd->noeuds[g].variable : variable;
+    variable = bdd->noeuds[h].variable < variable ? bdd->noeuds[h].variable : variable;
+    f0 = bdd->noeuds[f].variable == variable ? bdd->noeuds[f].bas : f;
+    f1 = bdd->noeuds[f].variable == variable ? bdd->noeuds[f].haut : f;
+    g0 = bdd->noeuds[g].variable == variable ? bdd->noeuds[g].bas : g;
+    g1 = bdd->noeuds[g].variable == variable ? bdd->noeuds[g].haut : g;
+    h0 = bdd->noeuds[h].variable == variable ? bdd->noeuds[h].bas : h;
+    h1 = bdd->noeuds[h].variable == variable ? bdd->noeuds[h].haut : h;
+
+    haut = t_bdd_ite(bdd, f1, g1, h1);
+    bas = t_bdd_ite(bdd, f0, g0, h0);
+    resultat = haut == BDD_ECHEC || bas == BDD_ECHEC ? BDD_ECHEC : t_bdd_noeud(bdd, variable, bas, haut);
+
+    if(resultat == BDD_ECHEC)
+    {
+
+        return BDD_ECHEC;
+    }
+
+    //Le cache a pu être réalloué pendant les appels récursifs
+    calcul = &bdd->cache[t_bdd_hacher(f, g, h) & (bdd->taille_cache - 1)];
+    calcul->f = f;
+    calcul->g = g;
+    calcul->h = h;
+    calcul->resultat = resultat;
+
+
+    return resultat;
+}
+
+int t_bdd_non(t_bdd *bdd, int f)
+{
+
+    return t_bdd_ite(bdd, f, BDD_ZERO, BDD_UN);
+}
+
+int t_bdd_et(t_bdd *bdd, int f, int g)
+{
+
+    return t_bdd_ite(bdd, f, g, BDD_ZERO);
+}
+
+int t_bdd_ou(t_bdd *bdd, int f, int g)
+{
+
+    return t_bdd_ite(bdd, f, BDD_UN, g);
+}
+
+int t_bdd_xor(t_bdd *bdd, int f, int g)
+{
+
+    return t_bdd_ite(bdd, f, t_bdd_non(bdd, g), g);
+}
+
+//BDD d'un littéral du graphe ET-inverseur, d'après le BDD de chaque variable du graphe
+static int t_bdd_litteral(t_bdd *bdd, const int racines[], uint32_t litteral)
+{
+
+    return AIG_EST_INVERSE(litteral) ? t_bdd_non(bdd, racines[AIG_VARIABLE(litteral)]) : racines[AIG_VARIABLE(litteral)];
+}
+
+t_bdd *t_bdd_compiler(t_circuit *circuit, const int ordre[], int max_noeuds)
+{
+    t_aig *aig = t_aig_compiler(circuit);
+    t_bdd *bdd;
+    int *racines;
+    int *rangs;
+    int nb_signaux;
+    int premier_et;
+    int succes;
+
+    if(aig == NULL)
+    {
+
+        return NULL;
+    }
+
+    nb_signaux = aig->nb_entrees + aig->nb_bascules;
+    premier_et = aig->nb_variables - aig->nb_et;
+    bdd = t_bdd_init(nb_signaux, max_noeuds);
+    racines = (int*)malloc(sizeof(int) * aig->nb_variables);
+    rangs = (int*)malloc(sizeof(int) * (nb_signaux + 1));
+    succes = bdd != NULL && racines != NULL && rangs != NULL;
+
+    if(succes)
+    {
+        bdd->nb_sorties = aig->nb_sorties;
+        bdd->nb_bascules = aig->nb_bascules;
+        bdd->sorties = (int*)malloc(sizeof(int) * (aig->nb_sorties + 1));
+        bdd->entrees_bascules = (int*)malloc(sizeof(int) * (aig->nb_bascules + 1));
+        succes = bdd->sorties != NULL && bdd->entrees_bascules != NULL;
+
+        for(int s = 0;s<nb_signaux;s++)
+        {
+            rangs[s] = -1;
+        }
+
+        //L'ordre doit être une permutation des signaux
+        for(int r = 0;r<nb_signaux && succes && ordre != NULL;r++)
+        {
+            succes = ordre[r] >= 0 && ordre[r] < nb_signaux && rangs[ordre[r]] == -1;
+
+            if(succes)
+            {
+                rangs[ordre[r]] = r;
+                bdd->signaux[r] = ordre[r];
+            }
+        }
+    }
+
+    if(succes)
+    {
+        racines[0] = BDD_ZERO;
+
+        for(int s = 0;s<nb_signaux;s++)
+        {
+            racines[1 + s] = t_bdd_variable(bdd, ordre != NULL ? rangs[s] : s);
+        }
+
+        for(int k = 0;k<aig->nb_et && succes;k++)
+        {
+            racines[premier_et + k] = t_bdd_et(bdd, t_bdd_litteral(bdd, racines, aig->operandes[2 * k]),
+                                               t_bdd_litteral(bdd, racines, aig->operandes[2 * k + 1]));
+            succes = racines[premier_et + k] != BDD_ECHEC;
+        }
+
+        for(int j = 0;j<aig->nb_sorties && succes;j++)
+        {
+            bdd->sorties[j] = t_bdd_litteral(bdd, racines, aig->sorties[j]);
+            succes = bdd->sorties[j] != BDD_ECHEC;
+        }
+
+        for(int b = 0;b<aig->nb_bascules && succes;b++)
+        {
+            bdd->entrees_bascules[b] = t_bdd_litteral(bdd, racines, aig->entrees_bascules[b]);
+            succes = bdd->entrees_bascules[b] != BDD_ECHEC;
+        }
+    }
+
+    free(racines);
+    free(rangs);
+    t_aig_destroy(aig);
+
+    if(!succes)
+    {
+        t_bdd_destroy(bdd);
+
+        return NULL;
+    }
+
+
+    return bdd;
+}
+
+int t_bdd_evaluer(const t_bdd *bdd, int racine, const int valeurs[])
+{
+    while(racine > BDD_UN)
+    {
+        racine = valeurs[bdd->signaux[bdd->noeuds[racine].variable]] ? bdd->noeuds[racine].haut : bdd->noeuds[racine].bas;
+    }
+
+
+    return racine;
+}
+
+//Fraction des affectations pour lesquelles le noeud vaut 1 (probabilites: -1 si pas encore calculée)
+static double t_bdd_probabilite(const t_bdd *bdd, int noeud, double probabilites[])
+{
+    if(noeud <= BDD_UN)
+    {
+
+        return noeud;
+    }
+
+    if(probabilites[noeud] < 0)
+    {
+        probabilites[noeud] = (t_bdd_probabilite(bdd, bdd->noeuds[noeud].bas, probabilites)
+                               + t_bdd_probabilite(bdd, bdd->noeuds[noeud].haut, probabilites)) / 2;
+    }
+
+
+    return probabilites[noeud];
+}
+
+double t_bdd_nb_solutions(const t_bdd *bdd, int racine)
+{
+    double *probabilites = (double*)malloc(sizeof(double) * bdd->nb_noeuds);
+    double nb_solutions;
+
+    if(probabilites == NULL)
+    {
+
+        return -1;
+    }
+
+    for(int k = 0;k<bdd->nb_noeuds;k++)
+    {
+        probabilites[k] = -1;
+    }
+
+    nb_solutions = t_bdd_probabilite(bdd, racine, probabilites);
+    free(probabilites);
+
+    for(int r = 0;r<bdd->nb_variables;r++)
+    {
+        nb_solutions *= 2;
+    }
+
+
+    return nb_solutions;
+}
+
+//Compte les noeuds non marqués accessibles depuis un noeud et les marque
+static int t_bdd_marquer(const t_bdd *bdd, int noeud, unsigned char marques[])
+{
+    if(noeud <= BDD_UN || marques[noeud])
+    {
+
+        return 0;
+    }
+
+    marques[noeud] = 1;
+
+
+    return 1 + t_bdd_marquer(bdd, bdd->noeuds[noeud].bas, marques) + t_bdd_marquer(bdd, bdd->noeuds[noeud].haut, marques);
+}
+
+int t_bdd_taille(const t_bdd *bdd, int racine)
+{
+    unsigned char *marques = (unsigned char*)calloc(bdd->nb_noeuds, sizeof(unsigned char));
+    int taille;
+
+    if(marques == NULL)
+    {
+
+        return -1;
+    }
+
+    taille = t_bdd_marquer(bdd, racine, marques);
+    free(marques);
+
+
+    return taille;
+}
+
+/*
+Mot de 64 vecteurs (le mot w de la table) d'un noeud. Un signal de rang 6 ou plus est constant dans
+le mot: seul un des deux fils est parcouru. Le mot de chaque noeud est gardé dans mots (valide si
+tours[noeud] == w) pour les noeuds partagés.
+*/
+static uint64_t t_bdd_mot(const t_bdd *bdd, int noeud, int w, uint64_t mots[], int tours[])
+{
+    const t_noeud_bdd *courant;
+    int signal;
+
+    if(noeud <= BDD_UN)
+    {
+
+        return noeud == BDD_UN ? ~(uint64_t)0 : 0;
+    }
+
+    if(tours[noeud] != w)
+    {
+        courant = &bdd->noeuds[noeud];
+        signal = bdd->signaux[courant->variable];
+
+        if(signal < 6)
+        {
+            mots[noeud] = (motifs[signal] & t_bdd_mot(bdd, courant->haut, w, mots, tours))
+                          | (~motifs[signal] & t_bdd_mot(bdd, courant->bas, w, mots, tours));
+        }
+        else
+        {
+            mots[noeud] = t_bdd_mot(bdd, ((w >> (signal - 6)) & 1) ? courant->haut : courant->bas, w, mots, tours);
+        }
+
+        tours[noeud] = w;
+    }
+
+
+    return mots[noeud];
+}
+
+t_table_verite *t_bdd_table_verite(const t_bdd *bdd)
+{
+    t_table_verite *table = t_table_verite_init(bdd->nb_variables, bdd->nb_sorties);
+    uint64_t *mots = (uint64_t*)malloc(sizeof(uint64_t) * bdd->nb_noeuds);
+    int *tours = (int*)malloc(sizeof(int) * bdd->nb_noeuds);
+    uint64_t masque = ~(uint64_t)0;
+
+    if(table == NULL || mots == NULL || tours == NULL)
+    {
+        t_table_verite_destroy(table);
+        free(mots);
+        free(tours);
+
+        return NULL;
+    }
+
+    if(bdd->nb_variables < 6)
+    {
+        masque = ((uint64_t)1 << (1 << bdd->nb_variables)) - 1;
+    }
+
+    for(int k = 0;k<bdd->nb_noeuds;k++)
+    {
+        tours[k] = -1;
+    }
+
+    for(int w = 0;w<table->nb_mots;w++)
+    {
+        for(int j = 0;j<table->nb_sorties;j++)
+        {
+            table->mots[(size_t)j * table->nb_mots + w] = t_bdd_mot(bdd, bdd->sorties[j], w, mots, tours) & masque;
+        }
+    }
+
+    free(mots);
+    free(tours);
+
+
+    return table;
+}
@@ -0,0 +1,196 @@
+/*
+Module: T_BDD
+Description: Diagrammes de décision binaires réduits et ordonnés (ROBDD) des sorties d'un circuit.
+			 Un BDD représente la fonction d'une sortie sans énumérer les 2^n vecteurs: il reste
+			 utilisable bien au-delà des TABLE_VERITE_MAX_ENTREES entrées d'une table de vérité
+			 tant que les fonctions ont une structure régulière (additionneurs, parités,
+			 comparateurs...).
+
+			 Les noeuds de tous les BDD d'un gestionnaire t_bdd sont rangés dans un même tableau:
+			 le noeud k teste la variable noeuds[k].variable et mène à noeuds[k].bas si elle vaut 0,
+			 à noeuds[k].haut si elle vaut 1. Les noeuds 0 et 1 sont les constantes BDD_ZERO et
+			 BDD_UN. Un BDD est désigné par l'indice de sa racine.
+
+			 - Table unique: un noeud (variable, bas, haut) n'existe qu'une fois et aucun noeud n'a
+			   bas == haut; deux fonctions égales ont donc la même racine.
+			 - Cache des calculs: toutes les opérations passent par ITE (si f alors g sinon h),
+			   dont les résultats sont gardés dans un cache à correspondance directe indexé par le
+			   triplet (f, g, h).
+
+			 Les variables sont numérotées par rang dans l'ordre du BDD (la variable 0 est testée
+			 en premier). Par défaut le rang r est le signal r: les entrées du circuit puis ses
+			 bascules, dont l'état courant est une variable (comme dans t_aig.h). Les noeuds
+			 intermédiaires de la construction restent dans le gestionnaire (pas de ramasse-miettes).
+*/
+
+#ifndef T_BDD_H_
+#define T_BDD_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+#include "t_table_verite.h"
+
+#define BDD_ZERO 0 //Racine de la constante 0
+#define BDD_UN 1 //Racine de la constante 1
+#define BDD_ECHEC -1 //Résultat d'une opération qui aurait dépassé le nombre maximal de noeuds
+#define BDD_TAILLE_CACHE_MAX (1 << 22) //Nombre maximal d'entrées du cache des calculs
+
+typedef struct t_circuit t_circuit;
+
+struct t_noeud_bdd {
+	int variable; //Rang de la variable testée (nb_variables pour les constantes)
+	int bas; //Noeud suivi si la variable vaut 0
+	int haut; //Noeud suivi si la variable vaut 1
+};
+
+typedef struct t_noeud_bdd t_noeud_bdd;
+
+//Entrée du cache des calculs: ite(f, g, h) = resultat
+struct t_calcul_bdd {
+	int f;
+	int g;
+	int h;
+	int resultat;
+};
+
+typedef struct t_calcul_bdd t_calcul_bdd;
+
+struct t_bdd {
+	int nb_variables; //Nombre de variables
+	int *signaux; //Signal (entrée puis bascule du circuit) de chaque variable, dans l'ordre du BDD
+
+	t_noeud_bdd *noeuds; //Noeuds de tous les BDD
+	int nb_noeuds; //Nombre de noeuds (constantes comprises)
+	int capacite_noeuds; //Nombre de noeuds alloués
+	int max_noeuds; //Nombre maximal de noeuds (0: pas de limite)
+	int *table_unique; //Table de hachage des noeuds (adressage ouvert, -1 pour une case vide)
+	int capacite_unique; //Taille de table_unique (une puissance de 2)
+	t_calcul_bdd *cache; //Cache des calculs (à correspondance directe)
+	int taille_cache; //Nombre d'entrées du cache (une puissance de 2)
+	long long nb_calculs; //Nombre d'appels récursifs de ITE qui ont consulté le cache
+	long long nb_succes_cache; //Nombre de ces appels résolus par le cache
+
+	int nb_sorties; //Nombre de sorties du circuit compilé (0 pour un gestionnaire de t_bdd_init)
+	int *sorties; //Racine de chaque sortie du circuit compilé
+	int nb_bascules; //Nombre de bascules du circuit compilé
+	int *entrees_bascules; //Racine de l'entrée de chaque bascule (état suivant)
+};
+
+typedef struct t_bdd t_bdd;
+
+/*
+Fonction: T_BDD_INIT
+Description: Crée un gestionnaire de BDD vide (seulement les deux constantes).
+Paramètres:
+- nb_variables: Nombre de variables.
+- max_noeuds: Nombre maximal de noeuds (0: pas de limite autre que la mémoire).
+Retour: Pointeur vers le gestionnaire, NULL si la mémoire manque.
+*/
+t_bdd *t_bdd_init(int nb_variables, int max_noeuds);
+
+/*
+Fonction: T_BDD_COMPILER
+Description: Construit le BDD de chaque sortie (et de l'entrée de chaque bascule) d'un circuit.
+			 Le circuit est traduit en graphe ET-inverseur (t_aig_compiler), puis chaque noeud ET
+			 devient un ET de BDD, dans l'ordre d'évaluation.
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+- ordre: Ordre des variables: ordre[r] est le signal testé au rang r (0 à nb_entrees - 1 pour
+		 les entrées, nb_entrees + b pour la bascule b). NULL: ordre des entrées puis des bascules.
+- max_noeuds: Nombre maximal de noeuds (0: pas de limite autre que la mémoire).
+Retour: Pointeur vers le gestionnaire (racines dans sorties et entrees_bascules), NULL si le
+		circuit est invalide, si l'ordre n'est pas une permutation des signaux, si le nombre
+		maximal de noeuds est atteint ou si la mémoire manque.
+*/
+t_bdd *t_bdd_compiler(t_circuit *circuit, const int ordre[], int max_noeuds);
+
+/*
+Fonction: T_BDD_DESTROY
+Description: Libère la mémoire occupée par le gestionnaire et tous ses BDD.
+Paramètres:
+- bdd: Pointeur vers le gestionnaire à détruire (NULL: aucun effet).
+Retour: Aucun.
+*/
+void t_bdd_destroy(t_bdd *bdd);
+
+/*
+Fonction: T_BDD_VARIABLE
+Description: Retourne le BDD d'une variable (la fonction qui vaut la variable).
+Paramètres:
+- bdd: Pointeur vers le gestionnaire.
+- rang: Rang de la variable (0 à nb_variables - 1).
+Retour: Racine du BDD, BDD_ECHEC si le nombre maximal de noeuds est atteint.
+*/
+int t_bdd_variable(t_bdd *bdd, int rang);
+
+/*
+Fonction: T_BDD_ITE
+Description: Calcule si f alors g sinon h, l'opération dont dérivent toutes les autres.
+Paramètres:
+- bdd: Pointeur vers le gestionnaire.
+- f, g, h: Racines des opérandes.
+Retour: Racine du résultat, BDD_ECHEC si le nombre maximal de noeuds est atteint ou si un
+		opérande vaut BDD_ECHEC.
+*/
+int t_bdd_ite(t_bdd *bdd, int f, int g, int h);
+
+/*
+Fonction: T_BDD_NON, T_BDD_ET, T_BDD_OU, T_BDD_XOR
+Description: Opérations logiques sur des BDD (cas particuliers de t_bdd_ite).
+Paramètres:
+- bdd: Pointeur vers le gestionnaire.
+- f, g: Racines des opérandes.
+Retour: Voir t_bdd_ite.
+*/
+int t_bdd_non(t_bdd *bdd, int f);
+int t_bdd_et(t_bdd *bdd, int f, int g);
+int t_bdd_ou(t_bdd *bdd, int f, int g);
+int t_bdd_xor(t_bdd *bdd, int f, int g);
+
+/*
+Fonction: T_BDD_EVALUER
+Description: Évalue un BDD pour une affectation des signaux: un seul chemin de la racine à une
+			 constante.
+Paramètres:
+- bdd: Pointeur vers le gestionnaire.
+- racine: Racine du BDD.
+- valeurs: Valeur (0 ou 1) de chaque signal (indexé par signal, pas par rang).
+Retour: 0 ou 1.
+*/
+int t_bdd_evaluer(const t_bdd *bdd, int racine, const int valeurs[]);
+
+/*
+Fonction: T_BDD_NB_SOLUTIONS
+Description: Compte les affectations des nb_variables variables pour lesquelles un BDD vaut 1,
+			 en un parcours des noeuds du BDD.
+Paramètres:
+- bdd: Pointeur vers le gestionnaire.
+- racine: Racine du BDD.
+Retour: Nombre d'affectations (exact jusqu'à 2^53), -1 si la mémoire manque.
+*/
+double t_bdd_nb_solutions(const t_bdd *bdd, int racine);
+
+/*
+Fonction: T_BDD_TAILLE
+Description: Compte les noeuds d'un BDD (constantes exclues).
+Paramètres:
+- bdd: Pointeur vers le gestionnaire.
+- racine: Racine du BDD.
+Retour: Nombre de noeuds, -1 si la mémoire manque.
+*/
+int t_bdd_taille(const t_bdd *bdd, int racine);
+
+/*
+Fonction: T_BDD_TABLE_VERITE
+Description: Déroule les BDD des sorties en table de vérité (le vecteur v donne au signal s la
+			 valeur du bit s de v). Chaque mot de 64 vecteurs est calculé par un parcours du
+			 BDD où les 6 premiers signaux valent leurs motifs de mot (0xAAAA..., 0xCCCC...,
+			 ...) et les suivants une constante.
+Paramètres:
+- bdd: Pointeur vers le gestionnaire d'un circuit compilé (t_bdd_compiler).
+Retour: Pointeur vers la table (nb_variables entrées, nb_sorties sorties), NULL s'il y a plus
+		de TABLE_VERITE_MAX_ENTREES variables ou si la mémoire manque.
+*/
+t_table_verite *t_bdd_table_verite(const t_bdd *bdd);
+
+#endif
@@ -2,26 +2,99 @@
 // Created by cedri on 2023-11-20.
 //
 
+#include <string.h>
 #include "t_circuit.h"
 
+//Agrandit un tableau dynamique (en doublant sa capacité) pour qu'il puisse contenir nb_requis éléments
+static int t_circuit_agrandir_tableau(void **tableau, int *capacite, int nb_requis, size_t taille_element)
+{
+    void *nouveau_tableau;
+    int nouvelle_capacite = *capacite > 0 ? *capacite : CIRCUIT_CAPACITE_INITIALE;
+
+    if(nb_requis <= *capacite)
+    {
+
+        return 1;
+    }
+
+    while(nouvelle_capacite < nb_requis)
+    {
+        nouvelle_capacite *= 2;
+    }
+
+    nouveau_tableau = realloc(*tableau, taille_element * nouvelle_capacite);
+
+    if(nouveau_tableau == NULL)
+    {
+
+        return 0;
+    }
+
+    *tableau = nouveau_tableau;
+    *capacite = nouvelle_capacite;
+
+
+    return 1;
+}
+
 t_circuit* t_circuit_init(void)
 {
     t_circuit* circuit;
 
     circuit = (t_circuit*)malloc(sizeof(t_circuit));
 
+    if(circuit == NULL)
+    {
+
+        return NULL;
+    }
 
     circuit->nb_entrees=0;
     circuit ->nb_portes=0;
     circuit -> nb_sorties=0;
 
-    if(circuit == NULL)
+    circuit->capacite_entrees = CIRCUIT_CAPACITE_INITIALE;
+    circuit->capacite_sorties = CIRCUIT_CAPACITE_INITIALE;
+    circuit->capacite_portes = CIRCUIT_CAPACITE_INITIALE;
+    circuit->entrees = (t_entree**)malloc(sizeof(t_entree*) * circuit->capacite_entrees);
+    circuit->sorties = (t_sortie**)malloc(sizeof(t_sortie*) * circuit->capacite_sorties);
+    circuit->portes = (t_porte**)malloc(sizeof(t_porte*) * circuit->capacite_portes);
+    circuit->ordre = (t_porte**)malloc(sizeof(t_porte*) * circuit->capacite_portes);
+    circuit->niveaux = (int*)malloc(sizeof(int) * circuit->capacite_portes);
+    circuit->arene = t_arene_init(0);
+
+    circuit->nb_niveaux = 0;
+    circuit->nb_portes_ordonnees = 0;
+    circuit->nb_portes_boucle = 0;
+    circuit->ordre_a_jour = 0;
+    circuit->revision_liens = 0;
+    circuit->revision_ordre = 0;
+    circuit->revision_en_cours = 0;
+    circuit->netlist = NULL;
+    circuit->netlist_a_jour = 0;
+    //Le tableau d'instances n'est alloué qu'à la première instance
+    circuit->instances = NULL;
+    circuit->nb_instances = 0;
+    circuit->capacite_instances = 0;
+    circuit->aplati = NULL;
+    circuit->sources_aplaties = NULL;
+    circuit->aplatissement_en_cours = 0;
+    //L'index des noms n'est construit qu'à la première recherche
+    circuit->index_noms = NULL;
+    circuit->capacite_index = 0;
+
+    for(int c = 0;c<4;c++)
     {
-
-        return NULL;
+        circuit->nb_indexes[c] = 0;
     }
 
+    if(circuit->entrees == NULL || circuit->sorties == NULL || circuit->portes == NULL
+       || circuit->ordre == NULL || circuit->niveaux == NULL || circuit->arene == NULL)
+    {
+        t_circuit_destroy(circuit);
 
+        return NULL;
+    }
 
 
     return circuit;
@@ -29,60 +102,349 @@ t_circuit* t_circuit_init(void)
 
 void t_circuit_destroy(t_circuit *circuit)
 {
+    t_netlist_destroy(circuit->netlist);
 
+    if(circuit->aplati != NULL)
+    {
+        t_circuit_destroy(circuit->aplati);
+    }
+
+    free(circuit->sources_aplaties);
+    free(circuit->instances);
+    free(circuit->index_noms);
+
+    free(circuit->entrees);
+    free(circuit->sorties);
+    free(circuit->portes);
+    free(circuit->ordre);
+    free(circuit->niveaux);
+    t_arene_destroy(circuit->arene);
     free(circuit);
 }
 
 t_porte* t_circuit_ajouter_porte(t_circuit *circuit, e_types_portes le_type)
+{
+
+    return t_circuit_ajouter_porte_n(circuit, le_type, t_porte_nb_entrees_defaut(le_type));
+}
+
+t_porte* t_circuit_ajouter_porte_n(t_circuit *circuit, e_types_portes le_type, int nb_entrees)
 {
     t_porte* nouvelle_porte;
+    int capacite = circuit->capacite_portes;
 
-    if(circuit->nb_portes<CIRCUIT_MAX_PORTES)
+    //Les tableaux "ordre" et "niveaux" suivent la capacité du tableau de portes
+    if(t_circuit_agrandir_tableau((void**)&circuit->ordre, &capacite, circuit->nb_portes + 1, sizeof(t_porte*)) == 0)
     {
-        nouvelle_porte = t_porte_init(circuit->nb_portes,le_type);
-        circuit->nb_portes++;
-        circuit->portes[circuit->nb_portes - 1] = nouvelle_porte;
-     // ajouter a la porte
-        return nouvelle_porte;
+
+        return NULL;
     }
-    return NULL;
 
+    capacite = circuit->capacite_portes;
+
+    if(t_circuit_agrandir_tableau((void**)&circuit->niveaux, &capacite, circuit->nb_portes + 1, sizeof(int)) == 0
+       || t_circuit_agrandir_tableau((void**)&circuit->portes, &circuit->capacite_portes, circuit->nb_portes + 1,
+                                     sizeof(t_porte*)) == 0)
+    {
+
+        return NULL;
+    }
+
+    nouvelle_porte = t_porte_init_arene(circuit->arene, circuit->nb_portes, le_type, nb_entrees);
+
+    if(nouvelle_porte == NULL)
+    {
+
+        return NULL;
+    }
+
+    for(int i = 0;i<nouvelle_porte->nb_entrees;i++)
+    {
+        nouvelle_porte->entrees[i]->revision = &circuit->revision_liens;
+    }
+
+    circuit->nb_portes++;
+    circuit->portes[circuit->nb_portes - 1] = nouvelle_porte;
+    circuit->ordre_a_jour = 0;
+    circuit->revision_liens++;
+
+
+    return nouvelle_porte;
+}
+
+t_instance* t_circuit_ajouter_instance(t_circuit *circuit, t_circuit *definition)
+{
+    t_instance* nouvelle_instance;
+
+    //La définition est compilée maintenant: ses instances partagent sa netlist
+    if(definition == circuit || t_circuit_get_netlist(definition) == NULL)
+    {
+
+        return NULL;
+    }
+
+    if(t_circuit_agrandir_tableau((void**)&circuit->instances, &circuit->capacite_instances,
+                                  circuit->nb_instances + 1, sizeof(t_instance*)) == 0)
+    {
+
+        return NULL;
+    }
+
+    nouvelle_instance = t_instance_init_arene(circuit->arene, circuit->nb_instances, definition);
+
+    if(nouvelle_instance == NULL)
+    {
+
+        return NULL;
+    }
+
+    for(int i = 0;i<nouvelle_instance->nb_entrees;i++)
+    {
+        nouvelle_instance->entrees[i]->revision = &circuit->revision_liens;
+    }
+
+    circuit->nb_instances++;
+    circuit->instances[circuit->nb_instances - 1] = nouvelle_instance;
+    circuit->ordre_a_jour = 0;
+    circuit->revision_liens++;
+
+
+    return nouvelle_instance;
 }
 
 t_entree* t_circuit_ajouter_entree(t_circuit * circuit)
 {
     t_entree* nouvelle_entree;
 
-    if(circuit->nb_entrees < MAX_ENTREES)
+    if(t_circuit_agrandir_tableau((void**)&circuit->entrees, &circuit->capacite_entrees, circuit->nb_entrees + 1,
+                                  sizeof(t_entree*)) == 0)
     {
-        nouvelle_entree = t_entree_init(circuit->nb_entrees);
 
+        return NULL;
+    }
+
+    nouvelle_entree = t_entree_init_arene(circuit->arene, circuit->nb_entrees);
 
-        circuit->nb_entrees++;
-        circuit->entrees[circuit->nb_entrees - 1] = nouvelle_entree;
-        return nouvelle_entree;
+    if(nouvelle_entree == NULL)
+    {
+
+        return NULL;
     }
 
+    circuit->nb_entrees++;
+    circuit->entrees[circuit->nb_entrees - 1] = nouvelle_entree;
+    circuit->ordre_a_jour = 0;
+    circuit->revision_liens++;
 
-    return NULL;
+
+    return nouvelle_entree;
 }
 
 t_sortie* t_circuit_ajouter_sortie(t_circuit * circuit)
 {
     t_sortie* nouvelle_sortie;
 
-    if(circuit->nb_sorties < MAX_SORTIES)
+    if(t_circuit_agrandir_tableau((void**)&circuit->sorties, &circuit->capacite_sorties, circuit->nb_sorties + 1,
+                                  sizeof(t_sortie*)) == 0)
+    {
+
+        return NULL;
+    }
+
+    nouvelle_sortie = t_sortie_init_arene(circuit->arene, circuit->nb_sorties);
+
+    if(nouvelle_sortie == NULL)
     {
-        nouvelle_sortie = t_sortie_init(circuit->nb_sorties);
 
+        return NULL;
+    }
+
+    nouvelle_sortie->pin->revision = &circuit->revision_liens;
+    circuit->nb_sorties++;
+    circuit->sorties[circuit->nb_sorties - 1] = nouvelle_sortie;
+    circuit->revision_liens++;
+
+
+    return nouvelle_sortie;
+}
+
+//Catégories des composants rangés dans l'index des noms (code = 4 * indice + catégorie)
+enum { INDEX_ENTREE, INDEX_PORTE, INDEX_SORTIE, INDEX_INSTANCE };
+
+//Hachage FNV-1a d'un nom
+static unsigned int t_circuit_hacher(const char *nom)
+{
+    unsigned int hache = 2166136261u;
 
-        circuit->nb_sorties++;
-        circuit->sorties[circuit->nb_sorties - 1] = nouvelle_sortie;
-        return nouvelle_sortie;
+    while(*nom != '\0')
+    {
+        hache = (hache ^ (unsigned char)*nom) * 16777619u;
+        nom++;
     }
 
 
-    return NULL;
+    return hache;
+}
+
+//Nombre de composants d'une catégorie
+static int t_circuit_nb_composants(const t_circuit *circuit, int categorie)
+{
+    const int nb[4] = {circuit->nb_entrees, circuit->nb_portes, circuit->nb_sorties, circuit->nb_instances};
+
+
+    return nb[categorie];
+}
+
+//Nom du composant identifié par un code de l'index
+static const char *t_circuit_nom_composant(const t_circuit *circuit, int code)
+{
+    switch(code & 3)
+    {
+        case INDEX_ENTREE:
+
+            return circuit->entrees[code >> 2]->nom;
+
+        case INDEX_PORTE:
+
+            return circuit->portes[code >> 2]->nom;
+
+        case INDEX_SORTIE:
+
+            return circuit->sorties[code >> 2]->nom;
+
+        default:
+
+            return circuit->instances[code >> 2]->nom;
+    }
+}
+
+//Place dans l'index les composants ajoutés depuis la dernière recherche. La table est
+//reconstruite, deux fois plus grande, quand elle serait remplie à plus de la moitié.
+//Retourne faux si la mémoire manque (l'index est alors laissé tel quel).
+static int t_circuit_indexer(t_circuit *circuit)
+{
+    int nb_total = circuit->nb_entrees + circuit->nb_portes + circuit->nb_sorties + circuit->nb_instances;
+    int capacite = circuit->capacite_index;
+    int *table = circuit->index_noms;
+    unsigned int position;
+
+    if(2 * nb_total > capacite)
+    {
+        capacite = capacite > 0 ? capacite : 64;
+
+        while(2 * nb_total > capacite)
+        {
+            capacite *= 2;
+        }
+
+        table = (int*)malloc(sizeof(int) * capacite);
+
+        if(table == NULL)
+        {
+
+            return 0;
+        }
+
+        memset(table, -1, sizeof(int) * capacite);
+        free(circuit->index_noms);
+        circuit->index_noms = table;
+        circuit->capacite_index = capacite;
+
+        for(int c = 0;c<4;c++)
+        {
+            circuit->nb_indexes[c] = 0;
+        }
+    }
+
+    for(int c = 0;c<4;c++)
+    {
+        for(int i = circuit->nb_indexes[c];i<t_circuit_nb_composants(circuit, c);i++)
+        {
+            position = t_circuit_hacher(t_circuit_nom_composant(circuit, 4 * i + c)) & (capacite - 1);
+
+            while(table[position] != -1)
+            {
+                position = (position + 1) & (capacite - 1);
+            }
+
+            table[position] = 4 * i + c;
+        }
+
+        circuit->nb_indexes[c] = t_circuit_nb_composants(circuit, c);
+    }
+
+
+    return 1;
+}
+
+//Retourne l'indice du composant de la catégorie donnée qui porte ce nom, -1 s'il n'existe pas.
+//Si la mémoire manque pour l'index, les composants sont parcourus un à un.
+static int t_circuit_trouver(t_circuit *circuit, const char *nom, int categorie)
+{
+    unsigned int position;
+    int code;
+
+    if(t_circuit_indexer(circuit) == 0)
+    {
+        for(int i = 0;i<t_circuit_nb_composants(circuit, categorie);i++)
+        {
+            if(strcmp(t_circuit_nom_composant(circuit, 4 * i + categorie), nom) == 0)
+            {
+
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    position = t_circuit_hacher(nom) & (circuit->capacite_index - 1);
+
+    while((code = circuit->index_noms[position]) != -1)
+    {
+        if((code & 3) == categorie && strcmp(t_circuit_nom_composant(circuit, code), nom) == 0)
+        {
+
+            return code >> 2;
+        }
+
+        position = (position + 1) & (circuit->capacite_index - 1);
+    }
+
+
+    return -1;
+}
+
+t_porte *t_circuit_trouver_porte(t_circuit *circuit, const char *nom)
+{
+    int indice = t_circuit_trouver(circuit, nom, INDEX_PORTE);
+
+
+    return indice == -1 ? NULL : circuit->portes[indice];
+}
+
+t_entree *t_circuit_trouver_entree(t_circuit *circuit, const char *nom)
+{
+    int indice = t_circuit_trouver(circuit, nom, INDEX_ENTREE);
+
+
+    return indice == -1 ? NULL : circuit->entrees[indice];
+}
+
+t_sortie *t_circuit_trouver_sortie(t_circuit *circuit, const char *nom)
+{
+    int indice = t_circuit_trouver(circuit, nom, INDEX_SORTIE);
+
+
+    return indice == -1 ? NULL : circuit->sorties[indice];
+}
+
+t_instance *t_circuit_trouver_instance(t_circuit *circuit, const char *nom)
+{
+    int indice = t_circuit_trouver(circuit, nom, INDEX_INSTANCE);
+
+
+    return indice == -1 ? NULL : circuit->instances[indice];
 }
 
 int t_circuit_est_valide(t_circuit *circuit)
@@ -96,6 +458,12 @@ int t_circuit_est_valide(t_circuit *circuit)
         }
     }
 
+
+    return t_circuit_est_simulable(circuit);
+}
+
+int t_circuit_est_simulable(t_circuit *circuit)
+{
     for(int i=0;i<circuit->nb_sorties;i++)
     {
         if(t_sortie_est_reliee(circuit->sorties[i]) == 0)
@@ -114,6 +482,15 @@ int t_circuit_est_valide(t_circuit *circuit)
         }
     }
 
+    for(int i=0;i<circuit->nb_instances;i++)
+    {
+        if(t_instance_est_reliee(circuit->instances[i]) == 0)
+        {
+
+            return 0;
+        }
+    }
+
 
     return 1;
 
@@ -121,35 +498,29 @@ int t_circuit_est_valide(t_circuit *circuit)
 
 int t_circuit_appliquer_signal(t_circuit * circuit, int signal[], int nb_bits)
 {
-    nb_bits = 0;
-
-    for(int i=0;i<MAX_ENTREES;i++)
+    if(nb_bits < circuit->nb_entrees)
     {
-       if(signal[i] == 1 || signal[i] == 0)
-       {
-
-           nb_bits ++;
-       }
-       else
-       {
 
-           i = MAX_ENTREES;
-       }
+        return 0;
     }
 
-    if(nb_bits>= circuit->nb_entrees)
+    for(int i=0;i<circuit->nb_entrees;i++)
     {
-        for(int i=0;i<circuit->nb_entrees;i++)
+        if(signal[i] != 1 && signal[i] != 0)
         {
-            t_pin_sortie_set_valeur(circuit->entrees[i]->pin,signal[i]);
 
+            return 0;
         }
+    }
+
+    for(int i=0;i<circuit->nb_entrees;i++)
+    {
+        t_pin_sortie_set_valeur(circuit->entrees[i]->pin,signal[i]);
 
-        return 1;
     }
 
 
-    return 0;
+    return 1;
 }
 
 void t_circuit_reset(t_circuit *circuit)
@@ -172,63 +543,854 @@ void t_circuit_reset(t_circuit *circuit)
         t_porte_reset(circuit->portes[i]);
 
     }
+
+    for(int i=0;i<circuit->nb_instances;i++)
+    {
+        t_instance_reset(circuit->instances[i]);
+    }
 }
 
-int t_circuit_propager_signal(t_circuit *circuit)
+/*
+État d'un aplatissement: pour chaque instance, la netlist de sa définition et l'identifiant
+(dans le circuit aplati) de la copie de sa première porte.
+*/
+typedef struct {
+	t_circuit *circuit;
+	t_circuit *plat;
+	t_netlist **netlists;
+	int *premiere_porte;
+	int *debut_sorties; //Numéro de la première sortie de chaque instance parmi les sorties d'instances
+	int *instance_signal; //Instance de chaque sortie d'instance
+} t_aplatissement;
+
+//Retourne la pin du circuit aplati qui porte le signal d'une pin sortie du circuit (numérotée
+//par t_circuit_aplatir_interne). Une sortie d'instance reliée directement à une entrée de sa
+//définition renvoie à la source de cette entrée: le parcours est borné par le nombre
+//d'instances pour ne pas tourner en rond.
+static t_pin_sortie *t_circuit_aplatir_source(const t_aplatissement *etat, const t_pin_sortie *source)
 {
-    t_file_porte * file;
-    t_porte* porte_courante;
-    int nb_portes = circuit->nb_portes;
-    int iteration = 0;
+    const t_circuit *circuit = etat->circuit;
+    const t_netlist *netlist;
+    int signal;
+    int instance;
+    int net;
 
-    file = t_file_porte_initialiser(CIRCUIT_MAX_PORTES);
-
-    if(t_circuit_est_valide(circuit) == 0)
+    for(int etape = 0;source != NULL && etape<=circuit->nb_instances;etape++)
     {
+        signal = source->indice;
 
-        return 0;
-    }
+        if(signal < circuit->nb_entrees)
+        {
 
-    for(int i = 0;i<circuit->nb_entrees;i++)
-    {
-        t_entree_propager_signal(circuit->entrees[i]);
+            return etat->plat->entrees[signal]->pin;
+        }
 
-    }
+        signal -= circuit->nb_entrees;
 
-    for (int i = 0; i < circuit->nb_portes; i++)
-    {
-        t_file_porte_enfiler(file,circuit->portes[i]);
+        if(signal < circuit->nb_portes)
+        {
 
-    }
+            return etat->plat->portes[signal]->sortie;
+        }
 
-    while(t_file_porte_est_vide(file) != 1 && iteration < nb_portes * (nb_portes+1)/2)
-    {
-        porte_courante = t_file_porte_defiler(file);
-        t_porte_propager_signal(porte_courante);
+        signal -= circuit->nb_portes;
+        instance = etat->instance_signal[signal];
+        netlist = etat->netlists[instance];
+        net = netlist->sorties[signal - etat->debut_sorties[instance]];
 
-        if( t_porte_propager_signal(porte_courante) == 0)
+        if(net >= netlist->nb_entrees)
         {
-            t_file_porte_enfiler(file,porte_courante);
 
+            return etat->plat->portes[etat->premiere_porte[instance] + net - netlist->nb_entrees]->sortie;
         }
 
-        iteration++;
+        source = circuit->instances[instance]->entrees[net]->liaison;
     }
 
-    if(t_file_porte_est_vide(file) != 1)
-    {
-
 
+    return NULL;
+}
 
-        return 0;
+//Relie une entrée d'une porte du circuit aplati (rien à faire si la source n'existe pas: le circuit
+//aplati sera invalide, comme le circuit d'origine)
+static void t_circuit_aplatir_relier(t_porte *porte, int num_entree, t_pin_sortie *source)
+{
+    if(source != NULL)
+    {
+        t_porte_relier(porte, num_entree, source);
     }
-
-
-    return 1;
 }
 
+//Aplatit le circuit; si "sources" n'est pas NULL, il reçoit la pin aplatie de chaque signal du circuit
+static t_circuit *t_circuit_aplatir_interne(t_circuit *circuit, t_pin_sortie ***sources)
+{
+    t_aplatissement etat;
+    t_circuit *plat;
+    t_instance *instance;
+    const t_netlist *netlist;
+    t_porte *porte;
+    t_pin_sortie *source;
+    int nb_sorties_instances = 0;
+    int nb_signaux;
+    int succes;
+    int net;
+
+    etat.circuit = circuit;
+    etat.netlists = (t_netlist**)malloc(sizeof(t_netlist*) * (circuit->nb_instances + 1));
+    etat.premiere_porte = (int*)malloc(sizeof(int) * (circuit->nb_instances + 1));
+    etat.debut_sorties = (int*)malloc(sizeof(int) * (circuit->nb_instances + 1));
+    succes = etat.netlists != NULL && etat.premiere_porte != NULL && etat.debut_sorties != NULL;
+
+    //Les définitions sont toutes compilées (et aplaties elles-mêmes au besoin) avant de garder leurs
+    //netlists: compiler une définition ne doit pas libérer la netlist déjà gardée d'une autre
+    for(int j = 0;succes && j<circuit->nb_instances;j++)
+    {
+        succes = t_circuit_get_netlist(circuit->instances[j]->definition) != NULL;
+    }
 
+    for(int j = 0;succes && j<circuit->nb_instances;j++)
+    {
+        etat.debut_sorties[j] = nb_sorties_instances;
+        nb_sorties_instances += circuit->instances[j]->nb_sorties;
+        etat.netlists[j] = t_circuit_get_netlist(circuit->instances[j]->definition);
+        succes = etat.netlists[j] != NULL;
+    }
 
+    etat.instance_signal = (int*)malloc(sizeof(int) * (nb_sorties_instances + 1));
+    plat = succes && etat.instance_signal != NULL ? t_circuit_init() : NULL;
+    succes = plat != NULL;
+    etat.plat = plat;
 
+    //Numérotation des signaux du circuit: entrées, portes (par identifiant), sorties des instances.
+    //Le circuit devra être ré-ordonné avant d'utiliser sa propre numérotation.
+    if(succes)
+    {
+        for(int i = 0;i<circuit->nb_entrees;i++)
+        {
+            circuit->entrees[i]->pin->indice = i;
+        }
+
+        for(int k = 0;k<circuit->nb_portes;k++)
+        {
+            circuit->portes[k]->sortie->indice = circuit->nb_entrees + k;
+        }
+
+        for(int j = 0;j<circuit->nb_instances;j++)
+        {
+            for(int s = 0;s<circuit->instances[j]->nb_sorties;s++)
+            {
+                circuit->instances[j]->sorties[s]->indice = circuit->nb_entrees + circuit->nb_portes
+                                                            + etat.debut_sorties[j] + s;
+                etat.instance_signal[etat.debut_sorties[j] + s] = j;
+            }
+        }
+
+        circuit->ordre_a_jour = 0;
+    }
+
+    //Toutes les portes sont créées avant les liens: une source peut être n'importe quelle porte
+    for(int i = 0;succes && i<circuit->nb_entrees;i++)
+    {
+        succes = t_circuit_ajouter_entree(plat) != NULL;
+    }
+
+    for(int j = 0;succes && j<circuit->nb_sorties;j++)
+    {
+        succes = t_circuit_ajouter_sortie(plat) != NULL;
+    }
+
+    for(int k = 0;succes && k<circuit->nb_portes;k++)
+    {
+        succes = t_circuit_ajouter_porte_n(plat, circuit->portes[k]->type, circuit->portes[k]->nb_entrees) != NULL;
+    }
+
+    for(int j = 0;succes && j<circuit->nb_instances;j++)
+    {
+        netlist = etat.netlists[j];
+        etat.premiere_porte[j] = plat->nb_portes;
+
+        for(int g = 0;succes && g<netlist->nb_portes;g++)
+        {
+            succes = t_circuit_ajouter_porte_n(plat, (e_types_portes)netlist->types[g],
+                                               netlist->debut_entrees[g + 1] - netlist->debut_entrees[g]) != NULL;
+        }
+    }
+
+    for(int k = 0;succes && k<circuit->nb_portes;k++)
+    {
+        for(int i = 0;i<circuit->portes[k]->nb_entrees;i++)
+        {
+            t_circuit_aplatir_relier(plat->portes[k], i, t_circuit_aplatir_source(&etat, circuit->portes[k]->entrees[i]->liaison));
+        }
+    }
+
+    for(int j = 0;succes && j<circuit->nb_instances;j++)
+    {
+        instance = circuit->instances[j];
+        netlist = etat.netlists[j];
+
+        for(int g = 0;g<netlist->nb_portes;g++)
+        {
+            porte = plat->portes[etat.premiere_porte[j] + g];
+
+            for(int i = 0;i<porte->nb_entrees;i++)
+            {
+                net = netlist->entrees[netlist->debut_entrees[g] + i];
+
+                if(net < netlist->nb_entrees)
+                {
+                    source = t_circuit_aplatir_source(&etat, instance->entrees[net]->liaison);
+                }
+                else
+                {
+                    source = plat->portes[etat.premiere_porte[j] + net - netlist->nb_entrees]->sortie;
+                }
+
+                t_circuit_aplatir_relier(porte, i, source);
+            }
+        }
+    }
+
+    for(int j = 0;succes && j<circuit->nb_sorties;j++)
+    {
+        source = t_circuit_aplatir_source(&etat, circuit->sorties[j]->pin->liaison);
+
+        if(source != NULL)
+        {
+            t_sortie_relier(plat->sorties[j], source);
+        }
+    }
+
+    nb_signaux = circuit->nb_entrees + circuit->nb_portes + nb_sorties_instances;
+
+    if(succes && sources != NULL)
+    {
+        *sources = (t_pin_sortie**)malloc(sizeof(t_pin_sortie*) * (nb_signaux + 1));
+        succes = *sources != NULL;
+
+        for(int i = 0;succes && i<circuit->nb_entrees;i++)
+        {
+            (*sources)[i] = plat->entrees[i]->pin;
+        }
+
+        for(int k = 0;succes && k<circuit->nb_portes;k++)
+        {
+            (*sources)[circuit->nb_entrees + k] = plat->portes[k]->sortie;
+        }
+
+        for(int j = 0;succes && j<circuit->nb_instances;j++)
+        {
+            for(int s = 0;s<circuit->instances[j]->nb_sorties;s++)
+            {
+                //NULL si la sortie boucle sur elle-même à travers les entrées des instances
+                source = circuit->instances[j]->sorties[s];
+                (*sources)[source->indice] = t_circuit_aplatir_source(&etat, source);
+                succes = succes && (*sources)[source->indice] != NULL;
+            }
+        }
+    }
+
+    free(etat.netlists);
+    free(etat.premiere_porte);
+    free(etat.debut_sorties);
+    free(etat.instance_signal);
+
+    if(succes == 0 && plat != NULL)
+    {
+        t_circuit_destroy(plat);
+        plat = NULL;
+
+        if(sources != NULL)
+        {
+            free(*sources);
+            *sources = NULL;
+        }
+    }
+
+
+    return plat;
+}
+
+t_circuit *t_circuit_aplatir(t_circuit *circuit)
+{
+
+    return t_circuit_aplatir_interne(circuit, NULL);
+}
+
+//Révision d'un circuit et des définitions de ses instances (récursivement): elle change dès que le
+//circuit ou une des définitions est modifié. Chaque compteur ne fait que croître, donc leur somme
+//aussi. Une définition répétée dans des instances consécutives n'est comptée qu'une fois.
+static unsigned long t_circuit_revision(t_circuit *circuit)
+{
+    unsigned long revision = circuit->revision_liens;
+
+    if(circuit->revision_en_cours)
+    {
+
+        return revision;
+    }
+
+    circuit->revision_en_cours = 1;
+
+    for(int j = 0;j<circuit->nb_instances;j++)
+    {
+        if(j == 0 || circuit->instances[j]->definition != circuit->instances[j - 1]->definition)
+        {
+            revision += t_circuit_revision(circuit->instances[j]->definition);
+        }
+    }
+
+    circuit->revision_en_cours = 0;
+
+
+    return revision;
+}
+
+//Ordonne un circuit qui contient des instances: sa forme aplatie est recalculée au besoin
+static int t_circuit_ordonner_aplati(t_circuit *circuit)
+{
+    if(circuit->aplatissement_en_cours)
+    {
+        //La définition d'une des instances contient ce circuit
+
+        return 0;
+    }
+
+    if(circuit->ordre_a_jour == 0 || circuit->revision_ordre != t_circuit_revision(circuit))
+    {
+        if(circuit->aplati != NULL)
+        {
+            t_circuit_destroy(circuit->aplati);
+        }
+
+        free(circuit->sources_aplaties);
+        circuit->sources_aplaties = NULL;
+        circuit->aplatissement_en_cours = 1;
+        circuit->aplati = t_circuit_aplatir_interne(circuit, &circuit->sources_aplaties);
+        circuit->aplatissement_en_cours = 0;
+        circuit->ordre_a_jour = 1;
+        circuit->revision_ordre = t_circuit_revision(circuit);
+    }
+
+    if(circuit->aplati == NULL || t_circuit_ordonner(circuit->aplati) == 0)
+    {
+
+        return 0;
+    }
+
+    circuit->nb_niveaux = circuit->aplati->nb_niveaux;
+
+
+    return 1;
+}
+
+//Vrai si la pin entrée appartient à une porte combinatoire: l'entrée d'une bascule n'est lue
+//qu'au front d'horloge, elle ne crée pas de dépendance dans le cycle (ni de boucle)
+static int t_circuit_lien_combinatoire(const t_pin_entree *pin)
+{
+
+    return pin->porte != NULL && pin->porte->type != PORTE_DFF;
+}
+
+int t_circuit_ordonner(t_circuit *circuit)
+{
+    int *degres; //Nombre d'entrées de chaque porte venant d'une autre porte
+    int *nb_par_niveau;
+    t_porte** traitees; //Portes dans l'ordre où elles ont été retirées de la file
+    t_file_porte* file;
+    t_porte* porte_courante;
+    t_porte* suivante;
+    t_pin_sortie* pin;
+    int nb_traitees = 0;
+    int niveau;
+    int retire;
+
+    if(circuit->nb_instances > 0)
+    {
+
+        return t_circuit_ordonner_aplati(circuit);
+    }
 
-
+    if(circuit->ordre_a_jour && circuit->revision_ordre == circuit->revision_liens)
+    {
+
+        return circuit->nb_portes_boucle == 0;
+    }
+
+    degres = (int*)malloc(sizeof(int) * (circuit->nb_portes + 1));
+    nb_par_niveau = (int*)malloc(sizeof(int) * (circuit->nb_portes + 2));
+    traitees = (t_porte**)malloc(sizeof(t_porte*) * (circuit->nb_portes + 1));
+    file = t_file_porte_initialiser(circuit->nb_portes);
+
+    if(degres == NULL || nb_par_niveau == NULL || traitees == NULL || file == NULL)
+    {
+        free(degres);
+        free(nb_par_niveau);
+        free(traitees);
+
+        if(file != NULL)
+        {
+            t_file_porte_detruire(file);
+        }
+
+        return 0;
+    }
+
+    for(int i = 0;i<circuit->nb_portes;i++)
+    {
+        degres[i] = 0;
+        circuit->niveaux[i] = 0;
+    }
+
+    for(int i = 0;i<circuit->nb_portes;i++)
+    {
+        pin = circuit->portes[i]->sortie;
+
+        for(int j = 0;j<pin->nb_liaisons;j++)
+        {
+            if(t_circuit_lien_combinatoire(pin->liaisons[j]))
+            {
+                degres[pin->liaisons[j]->porte->id]++;
+            }
+        }
+    }
+
+    //Algorithme de Kahn: on part des portes qui ne dépendent d'aucune autre porte
+
+    for(int i = 0;i<circuit->nb_portes;i++)
+    {
+        if(degres[i] == 0)
+        {
+            t_file_porte_enfiler(file,circuit->portes[i]);
+        }
+    }
+
+    while(t_file_porte_est_vide(file) != 1)
+    {
+        porte_courante = t_file_porte_defiler(file);
+        traitees[nb_traitees++] = porte_courante;
+        pin = porte_courante->sortie;
+
+        for(int j = 0;j<pin->nb_liaisons;j++)
+        {
+            suivante = pin->liaisons[j]->porte;
+
+            if(t_circuit_lien_combinatoire(pin->liaisons[j]))
+            {
+                niveau = circuit->niveaux[porte_courante->id] + 1;
+
+                if(niveau > circuit->niveaux[suivante->id])
+                {
+                    circuit->niveaux[suivante->id] = niveau;
+                }
+
+                degres[suivante->id]--;
+
+                if(degres[suivante->id] == 0)
+                {
+                    t_file_porte_enfiler(file,suivante);
+                }
+            }
+        }
+    }
+
+    t_file_porte_detruire(file);
+
+    //Tri par niveau (tri par dénombrement) des portes ordonnées
+    circuit->nb_niveaux = 0;
+
+    for(int i = 0;i<nb_traitees;i++)
+    {
+        if(circuit->niveaux[traitees[i]->id] + 1 > circuit->nb_niveaux)
+        {
+            circuit->nb_niveaux = circuit->niveaux[traitees[i]->id] + 1;
+        }
+    }
+
+    for(int i = 0;i<=circuit->nb_niveaux;i++)
+    {
+        nb_par_niveau[i] = 0;
+    }
+
+    for(int i = 0;i<nb_traitees;i++)
+    {
+        nb_par_niveau[circuit->niveaux[traitees[i]->id] + 1]++;
+    }
+
+    for(int i = 1;i<=circuit->nb_niveaux;i++)
+    {
+        nb_par_niveau[i] += nb_par_niveau[i-1];
+    }
+
+    for(int i = 0;i<nb_traitees;i++)
+    {
+        circuit->ordre[nb_par_niveau[circuit->niveaux[traitees[i]->id]]++] = traitees[i];
+    }
+
+    circuit->nb_portes_ordonnees = nb_traitees;
+    circuit->nb_portes_boucle = 0;
+
+    //Numérotation des signaux: entrées du circuit, puis sorties des portes dans l'ordre
+    for(int i = 0;i<circuit->nb_entrees;i++)
+    {
+        circuit->entrees[i]->pin->indice = i;
+    }
+
+    for(int i = 0;i<nb_traitees;i++)
+    {
+        circuit->ordre[i]->sortie->indice = circuit->nb_entrees + i;
+    }
+
+    //Les portes non ordonnées sont dans une boucle ou en aval d'une boucle. On retire
+    //celles qui sont seulement en aval: une porte dont aucune liaison ne mène à une autre
+    //porte non ordonnée ne peut pas faire partie d'un cycle.
+    if(nb_traitees < circuit->nb_portes)
+    {
+        do
+        {
+            retire = 0;
+
+            for(int i = 0;i<circuit->nb_portes;i++)
+            {
+                if(degres[i] > 0)
+                {
+                    int mene_a_boucle = 0;
+                    pin = circuit->portes[i]->sortie;
+
+                    for(int j = 0;j<pin->nb_liaisons && !mene_a_boucle;j++)
+                    {
+                        suivante = pin->liaisons[j]->porte;
+                        mene_a_boucle = t_circuit_lien_combinatoire(pin->liaisons[j]) && degres[suivante->id] > 0;
+                    }
+
+                    if(!mene_a_boucle)
+                    {
+                        degres[i] = 0;
+                        retire = 1;
+                    }
+                }
+            }
+        } while(retire);
+
+        for(int i = 0;i<circuit->nb_portes;i++)
+        {
+            if(degres[i] > 0)
+            {
+                circuit->ordre[nb_traitees + circuit->nb_portes_boucle] = circuit->portes[i];
+                circuit->nb_portes_boucle++;
+            }
+        }
+    }
+
+    free(degres);
+    free(nb_par_niveau);
+    free(traitees);
+
+    circuit->ordre_a_jour = 1;
+    circuit->revision_ordre = circuit->revision_liens;
+    circuit->netlist_a_jour = 0;
+
+
+    return circuit->nb_portes_boucle == 0;
+}
+
+int t_circuit_get_portes_boucle(t_circuit *circuit, t_porte *resultat[])
+{
+    t_circuit *aplati;
+    int nb_boucle = 0;
+    int id;
+
+    t_circuit_ordonner(circuit);
+
+    if(circuit->nb_instances > 0)
+    {
+        //Les portes du circuit gardent leurs identifiants dans la forme aplatie (voir
+        //t_circuit_aplatir): seules celles-ci sont retournées, les autres sont dans des instances
+        aplati = circuit->aplati;
+
+        for(int i = 0;aplati != NULL && i<aplati->nb_portes_boucle;i++)
+        {
+            id = aplati->ordre[aplati->nb_portes_ordonnees + i]->id;
+
+            if(id < circuit->nb_portes)
+            {
+                resultat[nb_boucle] = circuit->portes[id];
+                nb_boucle++;
+            }
+        }
+
+
+        return nb_boucle;
+    }
+
+    for(int i = 0;i<circuit->nb_portes_boucle;i++)
+    {
+        resultat[i] = circuit->ordre[circuit->nb_portes_ordonnees + i];
+    }
+
+
+    return circuit->nb_portes_boucle;
+}
+
+int t_circuit_get_instances_boucle(t_circuit *circuit, t_instance *resultat[])
+{
+    t_circuit *aplati;
+    t_netlist *netlist;
+    int nb_boucle = 0;
+    int debut;
+    int fin;
+    int id;
+
+    t_circuit_ordonner(circuit);
+    aplati = circuit->aplati;
+
+    if(circuit->nb_instances == 0 || aplati == NULL || aplati->nb_portes_boucle == 0)
+    {
+
+        return 0;
+    }
+
+    //Dans la forme aplatie, les copies des portes de chaque instance suivent celles du circuit,
+    //instance par instance
+    debut = circuit->nb_portes;
+
+    for(int j = 0;j<circuit->nb_instances;j++)
+    {
+        netlist = t_circuit_get_netlist(circuit->instances[j]->definition);
+        fin = debut + (netlist != NULL ? netlist->nb_portes : 0);
+
+        for(int i = 0;i<aplati->nb_portes_boucle;i++)
+        {
+            id = aplati->ordre[aplati->nb_portes_ordonnees + i]->id;
+
+            if(id >= debut && id < fin)
+            {
+                resultat[nb_boucle] = circuit->instances[j];
+                nb_boucle++;
+                break;
+            }
+        }
+
+        debut = fin;
+    }
+
+
+    return nb_boucle;
+}
+
+//Propage les signaux d'un circuit qui contient des instances: le circuit aplati est simulé, puis
+//chaque pin sortie du circuit (entrée, porte, sortie d'instance) reçoit la valeur de sa copie
+static int t_circuit_propager_aplati(t_circuit *circuit)
+{
+    t_pin_sortie *pin;
+
+    for(int i = 0;i<circuit->nb_entrees;i++)
+    {
+        t_pin_sortie_set_valeur(circuit->aplati->entrees[i]->pin, t_entree_get_valeur(circuit->entrees[i]));
+    }
+
+    if(t_circuit_propager_signal(circuit->aplati) == 0)
+    {
+
+        return 0;
+    }
+
+    for(int i = 0;i<circuit->nb_entrees;i++)
+    {
+        t_entree_propager_signal(circuit->entrees[i]);
+    }
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        pin = circuit->portes[k]->sortie;
+        t_pin_sortie_set_valeur(pin, t_pin_sortie_get_valeur(circuit->sources_aplaties[pin->indice]));
+        t_pin_sortie_propager_signal(pin);
+    }
+
+    for(int j = 0;j<circuit->nb_instances;j++)
+    {
+        for(int s = 0;s<circuit->instances[j]->nb_sorties;s++)
+        {
+            pin = circuit->instances[j]->sorties[s];
+            t_pin_sortie_set_valeur(pin, t_pin_sortie_get_valeur(circuit->sources_aplaties[pin->indice]));
+            t_pin_sortie_propager_signal(pin);
+        }
+    }
+
+
+    return 1;
+}
+
+int t_circuit_propager_signal(t_circuit *circuit)
+{
+    if(t_circuit_est_valide(circuit) == 0)
+    {
+
+        return 0;
+    }
+
+    if(t_circuit_ordonner(circuit) == 0)
+    {
+
+        return 0;
+    }
+
+    if(circuit->nb_instances > 0)
+    {
+
+        return t_circuit_propager_aplati(circuit);
+    }
+
+    for(int i = 0;i<circuit->nb_entrees;i++)
+    {
+        t_entree_propager_signal(circuit->entrees[i]);
+
+    }
+
+    //Les portes sont rangées par niveau: les entrées d'une porte sont toujours
+    //alimentées avant qu'on l'évalue.
+    for (int i = 0; i < circuit->nb_portes_ordonnees; i++)
+    {
+        if(t_porte_propager_signal(circuit->ordre[i]) == 0)
+        {
+
+            return 0;
+        }
+    }
+
+
+    return 1;
+}
+
+size_t t_circuit_get_memoire(const t_circuit *circuit)
+{
+    size_t taille = sizeof(t_circuit) + circuit->arene->taille_utilisee;
+
+    taille += sizeof(t_entree*) * circuit->capacite_entrees;
+    taille += sizeof(t_sortie*) * circuit->capacite_sorties;
+    taille += (sizeof(t_porte*) * 2 + sizeof(int)) * circuit->capacite_portes; //portes, ordre et niveaux
+    taille += sizeof(t_instance*) * circuit->capacite_instances;
+
+
+    return taille;
+}
+
+t_netlist *t_circuit_get_netlist(t_circuit *circuit)
+{
+    t_circuit_ordonner(circuit);
+
+    if(circuit->nb_instances > 0)
+    {
+
+        return circuit->aplati != NULL ? t_circuit_get_netlist(circuit->aplati) : NULL;
+    }
+
+    if(circuit->netlist_a_jour == 0)
+    {
+        t_netlist_destroy(circuit->netlist);
+        circuit->netlist = t_netlist_compiler(circuit);
+        circuit->netlist_a_jour = 1;
+    }
+
+
+    return circuit->netlist;
+}
+
+int t_circuit_simuler_lot(t_circuit *circuit, const uint64_t entrees[], uint64_t sorties[], int nb_mots)
+{
+    t_netlist *netlist;
+
+    if(t_circuit_est_simulable(circuit) == 0)
+    {
+
+        return 0;
+    }
+
+    netlist = t_circuit_get_netlist(circuit);
+
+    if(netlist == NULL)
+    {
+
+        return 0;
+    }
+
+
+    return t_netlist_simuler_lot(netlist, entrees, sorties, nb_mots);
+}
+
+int t_circuit_front_horloge(t_circuit *circuit)
+{
+    t_porte *porte;
+
+    if(circuit->nb_instances > 0)
+    {
+
+        return circuit->aplati != NULL && t_circuit_front_horloge(circuit->aplati);
+    }
+
+    //Toutes les entrées sont vérifiées avant de modifier un état. L'entrée d'une bascule a été
+    //calculée avec les anciens états: l'ordre des mises à jour est sans importance.
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        porte = circuit->portes[k];
+
+        if(porte->type == PORTE_DFF && t_pin_entree_get_valeur(porte->entrees[0]) == -1)
+        {
+
+            return 0;
+        }
+    }
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        porte = circuit->portes[k];
+
+        if(porte->type == PORTE_DFF)
+        {
+            porte->etat = t_pin_entree_get_valeur(porte->entrees[0]);
+        }
+    }
+
+
+    return 1;
+}
+
+int t_circuit_simuler_cycles(t_circuit *circuit, const uint64_t entrees[], uint64_t sorties[], int nb_cycles, int nb_mots)
+{
+    t_netlist *netlist;
+
+    if(t_circuit_est_simulable(circuit) == 0)
+    {
+
+        return 0;
+    }
+
+    netlist = t_circuit_get_netlist(circuit);
+
+    if(netlist == NULL)
+    {
+
+        return 0;
+    }
+
+
+    return t_netlist_simuler_cycles(netlist, entrees, sorties, nb_cycles, nb_mots);
+}
+
+void t_circuit_reinitialiser_etats(t_circuit *circuit)
+{
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        circuit->portes[k]->etat = 0;
+    }
+
+    if(circuit->netlist != NULL)
+    {
+        t_netlist_reinitialiser_etats(circuit->netlist);
+    }
+
+    if(circuit->aplati != NULL)
+    {
+        t_circuit_reinitialiser_etats(circuit->aplati);
+    }
+}
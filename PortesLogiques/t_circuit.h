@@ -9,15 +9,18 @@ Dernière modification: 2018-03-19
 #ifndef CIRCUIT_H_
 #define CIRCUIT_H_
 
+#include <stdint.h>
 
-#define MAX_ENTREES 50 //Nombre maximal d'entrées que peut contenir le circuit
-#define MAX_SORTIES 50 //Nombre maximal de sorties que peut contenir le circuit
-#define CIRCUIT_MAX_PORTES 100 //Nombre maximal de portes que peut contenir le circuit
+#define CIRCUIT_CAPACITE_INITIALE 8 //Capacité initiale des tableaux d'entrées, de sorties et de
+									//portes du circuit (les tableaux doublent de taille au besoin)
 
+#include "t_arene.h"
 #include "t_entree.h"
 #include "t_porte.h"
 #include "t_file_porte.h"
 #include "t_sortie.h"
+#include "t_netlist.h"
+#include "t_instance.h"
 
 
 typedef struct t_entree t_entree; 
@@ -25,24 +28,87 @@ typedef struct t_porte t_porte;
 typedef struct t_file_porte t_file_porte;
 typedef struct t_sortie t_sortie;
 typedef enum e_types_portes e_types_portes;
+typedef struct t_netlist t_netlist;
+typedef struct t_instance t_instance;
 
 
 /*
 Définit le type t_circuit qui permet de stocker l'information relative à un circuit. 
 */
 struct t_circuit {
-	//Tableu statique qui stocke des pointeurs vers les entrées incluses dans le circuit
-	t_entree *entrees[MAX_ENTREES]; 
-	//Tableu statique qui stocke des pointeurs vers les sorties incluses dans le circuit
-	t_sortie *sorties[MAX_SORTIES]; 
-	//Tableu statique qui stocke des pointeurs vers les portes incluses dans le circuit
-	t_porte *portes[CIRCUIT_MAX_PORTES]; 
+	//Tableau dynamique qui stocke des pointeurs vers les entrées incluses dans le circuit
+	t_entree **entrees;
+	//Tableau dynamique qui stocke des pointeurs vers les sorties incluses dans le circuit
+	t_sortie **sorties;
+	//Tableau dynamique qui stocke des pointeurs vers les portes incluses dans le circuit
+	t_porte **portes;
+	//Arène dans laquelle sont créés tous les composants du circuit (portes, entrées, sorties,
+	//pins et noms). Détruire le circuit libère l'arène d'un coup.
+	t_arene *arene;
 	//Nombre d'entrées dans le tableau d'entrées du circuit
 	int nb_entrees;
 	//Nombre de sorties dans le tableau de sorties du circuit
 	int nb_sorties; 
 	//Nombre de portes dans le tableau de portes du circuit
 	int nb_portes;
+	//Capacités des tableaux d'entrées, de sorties et de portes (les tableaux "ordre" et
+	//"niveaux" ont la même capacité que le tableau de portes)
+	int capacite_entrees;
+	int capacite_sorties;
+	int capacite_portes;
+
+	//Ordre d'évaluation des portes, trié par niveau (calculé par t_circuit_ordonner).
+	//Si le circuit contient une boucle, les portes qui forment la boucle sont stockées
+	//à la suite des portes ordonnées.
+	t_porte **ordre;
+	//Niveau de chaque porte (indexé par l'identifiant de la porte). Une porte dont toutes
+	//les entrées viennent des entrées du circuit est au niveau 0.
+	int *niveaux;
+	//Nombre de niveaux du circuit ordonné
+	int nb_niveaux;
+	//Nombre de portes ordonnées dans le tableau "ordre"
+	int nb_portes_ordonnees;
+	//Nombre de portes formant une boucle (stockées après les portes ordonnées)
+	int nb_portes_boucle;
+	//Booléen: vrai si l'ordre a été calculé depuis le dernier ajout de porte
+	int ordre_a_jour;
+	//Compteur de révision du circuit: incrémenté à chaque ajout de composant et à chaque liaison
+	//d'une pin entrée du circuit (voir le champs "revision" de t_pin_entree). Les modifications
+	//d'un autre circuit ne le changent pas.
+	unsigned long revision_liens;
+	//Révision du circuit et des définitions de ses instances lors du calcul de l'ordre
+	unsigned long revision_ordre;
+	//Booléen: vrai pendant le calcul de la révision (une définition qui se contient elle-même
+	//n'est comptée qu'une fois)
+	int revision_en_cours;
+
+	//Netlist compilée à partir du circuit (voir t_circuit_get_netlist). NULL si pas encore compilée.
+	t_netlist *netlist;
+	//Booléen: vrai si la netlist correspond à l'ordre courant du circuit
+	int netlist_a_jour;
+
+	//Instances d'autres circuits utilisées comme portes (voir t_instance.h)
+	t_instance **instances;
+	int nb_instances;
+	int capacite_instances;
+	//Forme aplatie du circuit (voir t_circuit_aplatir). Un circuit qui contient des instances
+	//est ordonné, compilé en netlist et simulé par sa forme aplatie, recalculée en même temps
+	//que l'ordre. NULL si le circuit ne contient aucune instance ou si l'aplatissement a échoué.
+	t_circuit *aplati;
+	//Pin de la forme aplatie qui porte chaque signal du circuit (indexé par le champs "indice"
+	//des pins sortie: entrées, portes, puis sorties des instances)
+	t_pin_sortie **sources_aplaties;
+	//Booléen: vrai pendant l'aplatissement (une définition qui se contient elle-même est refusée)
+	int aplatissement_en_cours;
+
+	//Index des noms des composants (voir t_circuit_trouver_porte): table de hachage à adressage
+	//ouvert qui contient 4 * indice + catégorie (entrée, porte, sortie ou instance) de chaque
+	//composant, -1 pour une case vide. NULL tant qu'aucune recherche n'a été faite.
+	int *index_noms;
+	int capacite_index;
+	//Nombre d'entrées, de portes, de sorties et d'instances déjà placées dans l'index: les
+	//composants ajoutés depuis la dernière recherche y sont insérés à la recherche suivante
+	int nb_indexes[4];
 };
 
 typedef struct t_circuit t_circuit;
@@ -51,14 +117,15 @@ typedef struct t_circuit t_circuit;
 Fonction: T_CIRCUIT_INIT
 Description: Crée un nouveau circuit vide. 
 Paramètres: Aucun
-Retour: Pointeur vers le circuit créé
+Retour: Pointeur vers le circuit créé (NULL si la mémoire manque)
 Paramètres modifié: Aucun.
 */
 t_circuit* t_circuit_init(void);
 
 /*
 Fonction: T_CIRCUIT_DESTROY
-Description: Libère la mémoire occupée par le circuit et tous ses composants.
+Description: Libère la mémoire occupée par le circuit et tous ses composants. Les composants
+			 sont tous dans l'arène du circuit: ils sont libérés d'un coup avec elle.
 Paramètres: 
 - circuit: Pointeur vers le circuit à détruire. 
 Retour: Aucun.
@@ -70,24 +137,51 @@ void t_circuit_destroy(t_circuit *circuit);
 Fonction: T_CIRCUIT_AJOUTER_PORTE
 Description: Crée une nouvelle porte et l'ajoute au circuit. 
 NDE: 
-- Il faut s'assurer qu'on ne dépasse pas le nombre de portes permis (CIRCUIT_MAX_PORTES).
+- Le tableau de portes est agrandi (sa capacité double) lorsqu'il est plein.
 - Il faut s'assurer que la porte aura un identifiant unique parmi les portes du circuit.
 Paramètres:
 - circuit: Pointeur vers le circuit auquel la porte sera ajoutée
 - type: Type de la porte créée parmi les types de portes prédéfinis (e_type_porte, c.f. t_porte.h)
-Retour: Pointeur vers la nouvelle porte créée s'il a été possible de la créer. NULL sinon.
+Retour: Pointeur vers la nouvelle porte créée s'il a été possible de la créer. NULL si la mémoire manque.
 */
 t_porte* t_circuit_ajouter_porte(t_circuit *circuit, e_types_portes le_type);
 
+/*
+Fonction: T_CIRCUIT_AJOUTER_PORTE_N
+Description: Crée une nouvelle porte à nb_entrees entrées et l'ajoute au circuit (ex.: une porte
+			 ET à 32 entrées au lieu d'un arbre de 31 portes à deux entrées).
+Paramètres:
+- circuit: Pointeur vers le circuit auquel la porte sera ajoutée
+- type: Type de la porte créée
+- nb_entrees: Nombre d'entrées de la porte (voir t_porte_nb_entrees_valide)
+Retour: Pointeur vers la nouvelle porte créée, NULL si la mémoire manque ou si le nombre
+		d'entrées n'est pas permis pour ce type.
+*/
+t_porte* t_circuit_ajouter_porte_n(t_circuit *circuit, e_types_portes le_type, int nb_entrees);
+
+/*
+Fonction: T_CIRCUIT_AJOUTER_INSTANCE
+Description: Ajoute au circuit une instance d'un autre circuit (la définition), utilisée comme une
+			 porte à definition->nb_entrees entrées et definition->nb_sorties sorties (voir
+			 t_instance.h). La définition est partagée, pas copiée: elle doit être valide (on doit
+			 pouvoir la compiler en netlist) et rester valide tant que le circuit existe.
+Paramètres:
+- circuit: Pointeur vers le circuit auquel l'instance sera ajoutée
+- definition: Circuit utilisé comme porte (différent de "circuit")
+Retour: Pointeur vers l'instance créée. NULL si la mémoire manque ou si la définition ne peut pas
+		être compilée.
+*/
+t_instance* t_circuit_ajouter_instance(t_circuit *circuit, t_circuit *definition);
+
 /*
 Fonction: T_CIRCUIT_AJOUTER_ENTREE
 Description: Crée une nouvelle entrée de circuit et l'ajoute au circuit.
 NDE:
-- Il faut s'assurer qu'on ne dépasse pas le nombre d'entrées permis (MAX_ENTREES).
+- Le tableau d'entrées est agrandi (sa capacité double) lorsqu'il est plein.
 - Il faut s'assurer que l'entrée aura un identifiant unique parmi les entrées du circuit.
 Paramètres:
 - circuit: Pointeur vers le circuit auquel l'entrée sera ajoutée
-Retour: Pointeur vers l'entrée créée s'il a été possible de la créer. NULL sinon.
+Retour: Pointeur vers l'entrée créée s'il a été possible de la créer. NULL si la mémoire manque.
 */
 t_entree* t_circuit_ajouter_entree(t_circuit * circuit);
 
@@ -95,14 +189,42 @@ t_entree* t_circuit_ajouter_entree(t_circuit * circuit);
 Fonction: T_CIRCUIT_AJOUTER_SORTIE
 Description: Crée une nouvelle sortie de circuit et l'ajoute au circuit.
 NDE:
-- Il faut s'assurer qu'on ne dépasse pas le nombre d'sorties permis (MAX_ENTREES).
+- Le tableau de sorties est agrandi (sa capacité double) lorsqu'il est plein.
 - Il faut s'assurer que la sortie aura un identifiant unique parmi les sorties du circuit.
 Paramètres:
 - circuit: Pointeur vers le circuit auquel l'sortie sera ajoutée
-Retour: Pointeur vers la sortie créée s'il a été possible de la créer. NULL sinon.
+Retour: Pointeur vers la sortie créée s'il a été possible de la créer. NULL si la mémoire manque.
 */
 t_sortie* t_circuit_ajouter_sortie(t_circuit * circuit);
 
+/*
+Fonction: T_CIRCUIT_TROUVER_PORTE
+Description: Retrouve une porte par son nom (ex.: P12) en temps constant. Les noms sont rangés
+			 dans une table de hachage (champs index_noms) construite à la première recherche et
+			 complétée aux recherches suivantes avec les composants ajoutés entre-temps.
+
+			 L'identifiant d'un composant est son indice dans le tableau du circuit: la porte
+			 d'identifiant id est circuit->portes[id].
+Paramètres:
+- circuit: Le circuit.
+- nom: Nom de la porte.
+Retour: Pointeur vers la porte, NULL si aucune porte du circuit ne porte ce nom.
+*/
+t_porte *t_circuit_trouver_porte(t_circuit *circuit, const char *nom);
+
+/*
+Fonction: T_CIRCUIT_TROUVER_ENTREE, T_CIRCUIT_TROUVER_SORTIE, T_CIRCUIT_TROUVER_INSTANCE
+Description: Retrouvent une entrée (E#), une sortie (S#) ou une instance (I#) par son nom (voir
+			 t_circuit_trouver_porte).
+Paramètres:
+- circuit: Le circuit.
+- nom: Nom du composant.
+Retour: Pointeur vers le composant, NULL si aucun composant de ce type ne porte ce nom.
+*/
+t_entree *t_circuit_trouver_entree(t_circuit *circuit, const char *nom);
+t_sortie *t_circuit_trouver_sortie(t_circuit *circuit, const char *nom);
+t_instance *t_circuit_trouver_instance(t_circuit *circuit, const char *nom);
+
 /*
 Fonction: T_CIRCUIT_EST_VALIDE
 Description: Vérifie si un circuit donné est un circuit valide. Pour qu'un circuit soit valide
@@ -114,6 +236,19 @@ Retour: (Booléen) Vrai si le circuit est valide, faux sinon.
 */
 int t_circuit_est_valide(t_circuit *circuit);
 
+/*
+Fonction: T_CIRCUIT_EST_SIMULABLE
+Description: Vérifie que les portes, sorties et instances du circuit sont toutes reliées. Contrairement
+			 à t_circuit_est_valide, une entrée qu'aucun composant ne lit est permise (par exemple
+			 une entrée redondante retirée par t_optimisation_simplifier): les sorties n'en
+			 dépendent pas. C'est la vérification des simulations par lots et par cycles, des
+			 fichiers de vecteurs et des fonctions d'écriture (voir t_circuit_io.h).
+Paramètres:
+- circuit: Pointeur vers le circuit.
+Retour: (Booléen) Vrai si le circuit peut être compilé et simulé, faux sinon.
+*/
+int t_circuit_est_simulable(t_circuit *circuit);
+
 /*
 Fonction: T_CIRCUIT_APPLIQUER_SIGNAL
 Description: Alimente le circuit avec le signal "signal" passé en paramètre. Le signal est un ensemble
@@ -144,6 +279,53 @@ Retour: Aucun.
 */
 void t_circuit_reset(t_circuit *circuit);
 
+/*
+Fonction: T_CIRCUIT_ORDONNER
+Description: Calcule l'ordre d'évaluation des portes du circuit (algorithme de Kahn sur les
+			 liaisons des pins sortie). Chaque porte reçoit un niveau: 0 si toutes ses entrées
+			 viennent des entrées du circuit, sinon 1 + le niveau maximal des portes qui
+			 l'alimentent. Les portes sont rangées dans le champs "ordre" par niveau croissant.
+
+			 L'ordre est conservé dans le circuit et n'est recalculé que si des portes ont été
+			 ajoutées ou si des liens ont été modifiés (t_porte_relier, t_sortie_relier) depuis
+			 le dernier calcul. Un circuit qui contient des instances est aplati (voir
+			 t_circuit_aplatir) et c'est sa forme aplatie qui est ordonnée.
+
+			 Une bascule (PORTE_DFF) est une source du cycle: elle est au niveau 0 et l'entrée
+			 qui l'alimente n'est pas une dépendance. Une boucle qui passe par une bascule n'est
+			 donc pas une boucle (seules les boucles combinatoires sont refusées).
+Paramètres:
+- circuit: Pointeur vers le circuit à ordonner.
+Retour: Booléen: Vrai si toutes les portes ont pu être ordonnées, faux si le circuit contient
+		une boucle (voir t_circuit_get_portes_boucle).
+*/
+int t_circuit_ordonner(t_circuit *circuit);
+
+/*
+Fonction: T_CIRCUIT_GET_PORTES_BOUCLE
+Description: Retourne les portes qui forment une boucle dans le circuit. Seules les portes qui
+			 font partie d'un cycle sont retournées (pas celles qui en dépendent seulement).
+Paramètres:
+- circuit: Pointeur vers le circuit.
+- resultat: Tableau (d'au moins circuit->nb_portes éléments) qui recevra les portes en boucle.
+Retour: Nombre de portes stockées dans résultat (0 si le circuit ne contient aucune boucle).
+		Si le circuit contient des instances, seules ses propres portes sont retournées: une
+		boucle qui ne passe que par des instances est donnée par t_circuit_get_instances_boucle.
+*/
+int t_circuit_get_portes_boucle(t_circuit *circuit, t_porte *resultat[]);
+
+/*
+Fonction: T_CIRCUIT_GET_INSTANCES_BOUCLE
+Description: Retourne les instances du circuit dont la définition contient une porte qui fait
+			 partie d'une boucle de la forme aplatie du circuit.
+Paramètres:
+- circuit: Pointeur vers le circuit.
+- resultat: Tableau (d'au moins circuit->nb_instances éléments) qui recevra les instances.
+Retour: Nombre d'instances stockées dans résultat (0 si le circuit ne contient aucune instance
+		ou aucune boucle).
+*/
+int t_circuit_get_instances_boucle(t_circuit *circuit, t_instance *resultat[]);
+
 /*
 Fonction: T_CIRCUIT_PROPAGER_SIGNAL
 Description: Propage le signal appliqué aux entrée du circuit à tous les composants. Le signal est propagé
@@ -158,13 +340,111 @@ Description: Propage le signal appliqué aux entrée du circuit à tous les comp
 			 La fonction retourne faux s'il a été impossible de propager un signal dans l'un des cas suivants:
 			 - Le circuit est invalide (voir t_circuit_est_valide)
 			 - Le circuit n'a pas été préalablement alimenté (voir t_circuit_appliquer_signal)
-			 - En cas de présence de boucles dans le circuit
-NDE: Pour propager le signal de proche en proche, vous utiliserez l'algorithme décrit dans l'énoncé qui utilise 
-     une file de portes (t_file_porte)
+			 - En cas de présence de boucles dans le circuit (voir t_circuit_get_portes_boucle)
+NDE: Les portes sont évaluées une seule fois chacune, dans l'ordre calculé par t_circuit_ordonner.
+	 Un circuit qui contient des instances est évalué sur sa forme aplatie, puis les valeurs
+	 sont recopiées sur ses entrées, portes, instances et sorties.
 Paramètres:
 - circuit: Pointeur vers le circuit à réinitialiser.
 Retour: Booléen vrai si le signal s'est correctement propagé jusqu'aux sorties. Faux sinon. 
 */
 int t_circuit_propager_signal(t_circuit *circuit);
 
+/*
+Fonction: T_CIRCUIT_APLATIR
+Description: Construit un nouveau circuit équivalent qui ne contient que des portes: chaque instance
+			 est remplacée par une copie des portes de la netlist de sa définition (les instances
+			 imbriquées sont donc aplaties aussi). Les portes du circuit gardent leurs identifiants
+			 (P0 à P<nb_portes-1>); les portes des instances suivent, instance par instance.
+Paramètres:
+- circuit: Pointeur vers le circuit à aplatir.
+Retour: Pointeur vers le circuit aplati (à détruire avec t_circuit_destroy). NULL si la mémoire
+		manque ou si une définition ne peut pas être compilée.
+*/
+t_circuit *t_circuit_aplatir(t_circuit *circuit);
+
+/*
+Fonction: T_CIRCUIT_GET_MEMOIRE
+Description: Calcule la mémoire occupée par la structure du circuit: ses composants (arène) et ses
+			 tableaux. La netlist, la forme aplatie et les définitions des instances ne sont pas
+			 comptées.
+Paramètres:
+- circuit: Pointeur vers le circuit.
+Retour: Nombre d'octets.
+*/
+size_t t_circuit_get_memoire(const t_circuit *circuit);
+
+/*
+Fonction: T_CIRCUIT_GET_NETLIST
+Description: Retourne la netlist compilée du circuit (voir t_netlist.h). La netlist est conservée
+			 dans le circuit et n'est recompilée que si l'ordre des portes a changé. La netlist
+			 d'un circuit qui contient des instances est celle de sa forme aplatie.
+Paramètres:
+- circuit: Pointeur vers le circuit.
+Retour: Pointeur vers la netlist du circuit (détruite avec le circuit). NULL si le circuit ne peut
+		pas être compilé (liens manquants ou boucle).
+*/
+t_netlist *t_circuit_get_netlist(t_circuit *circuit);
+
+/*
+Fonction: T_CIRCUIT_SIMULER_LOT
+Description: Simule un lot de vecteurs d'entrée en parallèle. Les vecteurs sont groupés par mots
+			 de 64 bits: le bit k du mot m de l'entrée i est la valeur de l'entrée i pour le vecteur
+			 64*m + k. La simulation se fait sur la netlist compilée du circuit (t_circuit_get_netlist):
+			 chaque porte est évaluée une seule fois par mot avec une opération binaire.
+
+			 Contrairement à t_circuit_propager_signal, cette fonction ne modifie pas la valeur
+			 des pins du circuit.
+Paramètres:
+- circuit: Pointeur vers le circuit à simuler.
+- entrees: Mots des entrées: entrees[i * nb_mots + m] est le mot m de l'entrée i.
+- sorties: Tableau (nb_sorties * nb_mots mots) qui reçoit les mots des sorties, même disposition.
+- nb_mots: Nombre de mots par entrée (le lot compte 64 * nb_mots vecteurs).
+Retour: Booléen: Vrai si le lot a été simulé. Faux si un lien manque (voir t_circuit_est_simulable)
+		ou si le circuit contient une boucle.
+*/
+int t_circuit_simuler_lot(t_circuit *circuit, const uint64_t entrees[], uint64_t sorties[], int nb_mots);
+
+/*
+Fonction: T_CIRCUIT_FRONT_HORLOGE
+Description: Front d'horloge pour l'interpréteur des portes: chaque bascule (PORTE_DFF) prend la
+			 valeur de son entrée, qui devient sa sortie au prochain t_circuit_propager_signal.
+			 Un cycle est donc: t_circuit_appliquer_signal, t_circuit_propager_signal (lecture
+			 des sorties), t_circuit_front_horloge.
+Paramètres:
+- circuit: Pointeur vers le circuit.
+Retour: Booléen: Vrai si l'état des bascules a été mis à jour, faux si l'entrée d'une bascule n'a
+		pas de valeur (le signal n'a pas été propagé).
+*/
+int t_circuit_front_horloge(t_circuit *circuit);
+
+/*
+Fonction: T_CIRCUIT_SIMULER_CYCLES
+Description: Simule nb_cycles cycles d'horloge sur la netlist compilée du circuit (voir
+			 t_netlist_simuler_cycles): à chaque cycle, les portes sont évaluées une fois dans
+			 l'ordre des niveaux, puis les bascules sont mises à jour. L'état des bascules est
+			 conservé d'un appel à l'autre tant que le circuit et nb_mots ne changent pas; il est
+			 distinct de l'état utilisé par t_circuit_front_horloge.
+Paramètres:
+- circuit: Pointeur vers le circuit à simuler.
+- entrees: Mots des entrées de chaque cycle: entrees[(c * nb_entrees + i) * nb_mots + m] est le
+		   mot m de l'entrée i au cycle c.
+- sorties: Tableau (nb_cycles * nb_sorties * nb_mots mots) qui reçoit les mots des sorties de
+		   chaque cycle, même disposition.
+- nb_cycles: Nombre de cycles à simuler.
+- nb_mots: Nombre de mots par entrée (64 * nb_mots séquences indépendantes).
+Retour: Booléen: Vrai si les cycles ont été simulés. Faux si un lien manque (voir
+		t_circuit_est_simulable) ou si le circuit contient une boucle combinatoire.
+*/
+int t_circuit_simuler_cycles(t_circuit *circuit, const uint64_t entrees[], uint64_t sorties[], int nb_cycles, int nb_mots);
+
+/*
+Fonction: T_CIRCUIT_REINITIALISER_ETATS
+Description: Remet à zéro l'état de toutes les bascules du circuit (interpréteur et netlist).
+Paramètres:
+- circuit: Pointeur vers le circuit.
+Retour: Aucun.
+*/
+void t_circuit_reinitialiser_etats(t_circuit *circuit);
+
 #endif
\ No newline at end of file
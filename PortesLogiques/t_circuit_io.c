@@ -0,0 +1,1937 @@
+//
+// Lecture et écriture de circuits (voir t_circuit_io.h).
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "t_circuit_io.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define CHARGEUR_TAILLE_LIGNE 256 //Taille initiale du tampon de lecture d'une ligne
+#define CHARGEUR_TAILLE_NOMS 65536 //Taille des blocs de l'arène qui stocke les noms de signaux
+
+/*
+Signal nommé d'un fichier (.bench, BLIF ou texte). Un signal est produit soit par une pin sortie
+(entrée du circuit ou porte), soit par un autre signal (tampon BUFF ou couverture triviale).
+*/
+typedef struct {
+	const char *nom;
+	t_pin_sortie *pin; //Pin qui produit le signal, NULL si pas encore défini ou si alias
+	int alias; //Signal recopié par ce signal, -1 si aucun
+} t_signal;
+
+/*
+Lien qui ne peut être fait qu'à la fin de la lecture, parce que le signal source n'est pas
+encore défini au moment où la porte est créée.
+*/
+typedef struct {
+	t_porte *porte;
+	int num_entree;
+	int signal;
+} t_lien_attente;
+
+/*
+Opérande utilisée pour construire une porte: soit une porte déjà créée, soit un signal nommé.
+*/
+typedef struct {
+	t_porte *porte;
+	int signal;
+} t_operande;
+
+/*
+État d'un chargement: le circuit en construction et la table des signaux nommés.
+*/
+typedef struct {
+	t_circuit *circuit;
+	const char *nom_fichier;
+	int num_ligne;
+
+	t_arene *noms; //Copie des noms de signaux
+	t_signal *signaux;
+	int nb_signaux;
+	int capacite_signaux;
+	int *table; //Table de hachage (adressage ouvert) des signaux par nom, -1 si la case est libre
+	int capacite_table;
+
+	t_lien_attente *liens;
+	int nb_liens;
+	int capacite_liens;
+	int *signaux_sorties; //Signal relié à chaque sortie du circuit
+	int capacite_sorties;
+
+	//Tableaux de travail pour la construction des portes
+	t_operande *operandes;
+	int capacite_operandes;
+	t_operande *termes;
+	int capacite_termes;
+} t_chargeur;
+
+
+/*******FONCTIONS UTILITAIRES***********/
+
+//Agrandit un tableau dynamique (en doublant sa capacité) pour qu'il contienne nb_requis éléments
+static int t_circuit_io_agrandir(void **tableau, int *capacite, int nb_requis, size_t taille_element)
+{
+    int nouvelle_capacite = *capacite > 0 ? *capacite : 16;
+    void *nouveau;
+
+    if(nb_requis <= *capacite)
+    {
+
+        return 1;
+    }
+
+    while(nouvelle_capacite < nb_requis)
+    {
+        nouvelle_capacite *= 2;
+    }
+
+    nouveau = realloc(*tableau, taille_element * nouvelle_capacite);
+
+    if(nouveau == NULL)
+    {
+
+        return 0;
+    }
+
+    *tableau = nouveau;
+    *capacite = nouvelle_capacite;
+
+
+    return 1;
+}
+
+//Lit une ligne complète (sans le saut de ligne) dans un tampon qui grandit au besoin.
+//Retourne NULL à la fin du fichier.
+static char *t_circuit_io_lire_ligne(FILE *fichier, char **tampon, int *capacite)
+{
+    int longueur = 0;
+
+    if(*tampon == NULL && t_circuit_io_agrandir((void**)tampon, capacite, CHARGEUR_TAILLE_LIGNE, sizeof(char)) == 0)
+    {
+
+        return NULL;
+    }
+
+    while(fgets(*tampon + longueur, *capacite - longueur, fichier) != NULL)
+    {
+        longueur += (int)strlen(*tampon + longueur);
+
+        if(longueur > 0 && (*tampon)[longueur - 1] == '\n')
+        {
+            break;
+        }
+
+        if(t_circuit_io_agrandir((void**)tampon, capacite, *capacite + 1, sizeof(char)) == 0)
+        {
+
+            return NULL;
+        }
+    }
+
+    if(longueur == 0 && feof(fichier))
+    {
+
+        return NULL;
+    }
+
+    while(longueur > 0 && ((*tampon)[longueur - 1] == '\n' || (*tampon)[longueur - 1] == '\r'))
+    {
+        longueur--;
+    }
+
+    (*tampon)[longueur] = '\0';
+
+
+    return *tampon;
+}
+
+//Retourne le prochain mot de la ligne (délimité par un caractère de "separateurs") et avance
+//le curseur après le mot. Retourne NULL s'il n'y a plus de mot.
+static char *t_circuit_io_prochain_mot(char **curseur, const char *separateurs)
+{
+    char *debut = *curseur;
+    char *fin;
+
+    debut += strspn(debut, separateurs);
+
+    if(*debut == '\0')
+    {
+        *curseur = debut;
+
+        return NULL;
+    }
+
+    fin = debut + strcspn(debut, separateurs);
+
+    if(*fin != '\0')
+    {
+        *fin = '\0';
+        fin++;
+    }
+
+    *curseur = fin;
+
+
+    return debut;
+}
+
+//Retire le commentaire (à partir de '#') d'une ligne
+static void t_circuit_io_retirer_commentaire(char *ligne)
+{
+    char *diese = strchr(ligne, '#');
+
+    if(diese != NULL)
+    {
+        *diese = '\0';
+    }
+}
+
+
+/*******TABLE DES SIGNAUX***********/
+
+static void t_chargeur_erreur(t_chargeur *chargeur, const char *message, const char *detail)
+{
+    printf("ERREUR DE LECTURE: %s, ligne %d: %s%s%s\n", chargeur->nom_fichier, chargeur->num_ligne, message,
+           detail != NULL ? " " : "", detail != NULL ? detail : "");
+}
+
+static int t_chargeur_init(t_chargeur *chargeur, const char *nom_fichier)
+{
+    memset(chargeur, 0, sizeof(t_chargeur));
+    chargeur->nom_fichier = nom_fichier;
+    chargeur->circuit = t_circuit_init();
+    chargeur->noms = t_arene_init(CHARGEUR_TAILLE_NOMS);
+
+    if(chargeur->circuit == NULL || chargeur->noms == NULL)
+    {
+        printf("ERREUR DE LECTURE: %s: memoire insuffisante\n", nom_fichier);
+
+        return 0;
+    }
+
+
+    return 1;
+}
+
+//Libère l'état du chargement. Le circuit n'est détruit que si "garder_circuit" est faux.
+static void t_chargeur_destroy(t_chargeur *chargeur, int garder_circuit)
+{
+    if(garder_circuit == 0 && chargeur->circuit != NULL)
+    {
+        t_circuit_destroy(chargeur->circuit);
+    }
+
+    if(chargeur->noms != NULL)
+    {
+        t_arene_destroy(chargeur->noms);
+    }
+
+    free(chargeur->signaux);
+    free(chargeur->table);
+    free(chargeur->liens);
+    free(chargeur->signaux_sorties);
+    free(chargeur->operandes);
+    free(chargeur->termes);
+}
+
+//Hachage FNV-1a d'un nom
+static unsigned int t_chargeur_hacher(const char *nom)
+{
+    unsigned int hache = 2166136261u;
+
+    while(*nom != '\0')
+    {
+        hache = (hache ^ (unsigned char)*nom) * 16777619u;
+        nom++;
+    }
+
+
+    return hache;
+}
+
+//Double la taille de la table de hachage et y replace tous les signaux
+static int t_chargeur_agrandir_table(t_chargeur *chargeur)
+{
+    int capacite = chargeur->capacite_table > 0 ? chargeur->capacite_table * 2 : 1024;
+    int *table = (int*)malloc(sizeof(int) * capacite);
+    unsigned int position;
+
+    if(table == NULL)
+    {
+
+        return 0;
+    }
+
+    memset(table, -1, sizeof(int) * capacite);
+
+    for(int s = 0;s<chargeur->nb_signaux;s++)
+    {
+        position = t_chargeur_hacher(chargeur->signaux[s].nom) & (capacite - 1);
+
+        while(table[position] != -1)
+        {
+            position = (position + 1) & (capacite - 1);
+        }
+
+        table[position] = s;
+    }
+
+    free(chargeur->table);
+    chargeur->table = table;
+    chargeur->capacite_table = capacite;
+
+
+    return 1;
+}
+
+//Retourne l'indice du signal qui porte ce nom (le signal est créé s'il n'existe pas), -1 si la mémoire manque
+static int t_chargeur_signal(t_chargeur *chargeur, const char *nom)
+{
+    unsigned int position;
+    size_t longueur;
+    char *copie;
+
+    //La table reste remplie à moins de la moitié
+    if(2 * (chargeur->nb_signaux + 1) > chargeur->capacite_table && t_chargeur_agrandir_table(chargeur) == 0)
+    {
+
+        return -1;
+    }
+
+    position = t_chargeur_hacher(nom) & (chargeur->capacite_table - 1);
+
+    while(chargeur->table[position] != -1)
+    {
+        if(strcmp(chargeur->signaux[chargeur->table[position]].nom, nom) == 0)
+        {
+
+            return chargeur->table[position];
+        }
+
+        position = (position + 1) & (chargeur->capacite_table - 1);
+    }
+
+    longueur = strlen(nom) + 1;
+    copie = (char*)t_arene_allouer(chargeur->noms, longueur);
+
+    if(copie == NULL || t_circuit_io_agrandir((void**)&chargeur->signaux, &chargeur->capacite_signaux,
+                                              chargeur->nb_signaux + 1, sizeof(t_signal)) == 0)
+    {
+
+        return -1;
+    }
+
+    memcpy(copie, nom, longueur);
+    chargeur->signaux[chargeur->nb_signaux].nom = copie;
+    chargeur->signaux[chargeur->nb_signaux].pin = NULL;
+    chargeur->signaux[chargeur->nb_signaux].alias = -1;
+    chargeur->table[position] = chargeur->nb_signaux;
+
+
+    return chargeur->nb_signaux++;
+}
+
+//Donne la source d'un signal. Retourne faux si le signal a déjà été défini.
+static int t_chargeur_definir(t_chargeur *chargeur, int signal, t_pin_sortie *pin, int alias)
+{
+    if(chargeur->signaux[signal].pin != NULL || chargeur->signaux[signal].alias != -1)
+    {
+        t_chargeur_erreur(chargeur, "signal defini plusieurs fois:", chargeur->signaux[signal].nom);
+
+        return 0;
+    }
+
+    chargeur->signaux[signal].pin = pin;
+    chargeur->signaux[signal].alias = alias;
+
+
+    return 1;
+}
+
+//Retourne la pin qui produit un signal en suivant les alias, NULL si le signal n'est pas défini
+static t_pin_sortie *t_chargeur_resoudre(t_chargeur *chargeur, int signal)
+{
+    //Une chaîne d'alias plus longue que le nombre de signaux contient une boucle
+    for(int i = 0;i<=chargeur->nb_signaux && signal != -1;i++)
+    {
+        if(chargeur->signaux[signal].pin != NULL)
+        {
+
+            return chargeur->signaux[signal].pin;
+        }
+
+        signal = chargeur->signaux[signal].alias;
+    }
+
+
+    return NULL;
+}
+
+//Relie l'entrée num_entree d'une porte à une opérande. Si l'opérande est un signal pas encore
+//défini, le lien est mis en attente jusqu'à la fin de la lecture.
+static int t_chargeur_relier(t_chargeur *chargeur, t_porte *porte, int num_entree, t_operande operande)
+{
+    t_lien_attente *lien;
+
+    if(operande.porte != NULL)
+    {
+
+        return t_porte_relier(porte, num_entree, operande.porte->sortie);
+    }
+
+    if(chargeur->signaux[operande.signal].pin != NULL)
+    {
+
+        return t_porte_relier(porte, num_entree, chargeur->signaux[operande.signal].pin);
+    }
+
+    if(t_circuit_io_agrandir((void**)&chargeur->liens, &chargeur->capacite_liens, chargeur->nb_liens + 1,
+                             sizeof(t_lien_attente)) == 0)
+    {
+
+        return 0;
+    }
+
+    lien = &chargeur->liens[chargeur->nb_liens++];
+    lien->porte = porte;
+    lien->num_entree = num_entree;
+    lien->signal = operande.signal;
+
+
+    return 1;
+}
+
+//Crée une porte NOT alimentée par l'opérande
+static t_operande t_chargeur_inverser(t_chargeur *chargeur, t_operande operande)
+{
+    t_operande resultat = {NULL, -1};
+    t_porte *porte = t_circuit_ajouter_porte(chargeur->circuit, PORTE_NOT);
+
+    if(porte != NULL && t_chargeur_relier(chargeur, porte, 0, operande))
+    {
+        resultat.porte = porte;
+    }
+
+
+    return resultat;
+}
+
+//Crée une porte du type donné alimentée par les nb opérandes (0 pour une constante). Avec une seule opérande,
+//une porte ET, OU ou XOR est remplacée par l'opérande elle-même et une porte NAND, NOR ou XNOR
+//par une porte NOT.
+static t_operande t_chargeur_porte(t_chargeur *chargeur, e_types_portes type, t_operande operandes[], int nb)
+{
+    t_operande resultat = {NULL, -1};
+    t_porte *porte;
+
+    if(nb == 1 && (type == PORTE_ET || type == PORTE_OU || type == PORTE_XOR))
+    {
+
+        return operandes[0];
+    }
+
+    if(nb == 1 && (type == PORTE_NAND || type == PORTE_NOR || type == PORTE_XNOR))
+    {
+        type = PORTE_NOT;
+    }
+
+    porte = t_circuit_ajouter_porte_n(chargeur->circuit, type, nb);
+
+    if(porte == NULL)
+    {
+
+        return resultat;
+    }
+
+    for(int i = 0;i<nb;i++)
+    {
+        if(t_chargeur_relier(chargeur, porte, i, operandes[i]) == 0)
+        {
+
+            return resultat;
+        }
+    }
+
+    resultat.porte = porte;
+
+
+    return resultat;
+}
+
+//Donne une opérande comme source d'un signal
+static int t_chargeur_definir_operande(t_chargeur *chargeur, int signal, t_operande operande)
+{
+    if(operande.porte != NULL)
+    {
+
+        return t_chargeur_definir(chargeur, signal, operande.porte->sortie, -1);
+    }
+
+    if(operande.signal == -1)
+    {
+        t_chargeur_erreur(chargeur, "memoire insuffisante", NULL);
+
+        return 0;
+    }
+
+
+    return t_chargeur_definir(chargeur, signal, NULL, operande.signal);
+}
+
+//Ajoute une sortie au circuit, reliée au signal donné à la fin de la lecture
+static int t_chargeur_ajouter_sortie(t_chargeur *chargeur, int signal)
+{
+    int num = chargeur->circuit->nb_sorties;
+
+    if(t_circuit_ajouter_sortie(chargeur->circuit) == NULL
+       || t_circuit_io_agrandir((void**)&chargeur->signaux_sorties, &chargeur->capacite_sorties, num + 1, sizeof(int)) == 0)
+    {
+        t_chargeur_erreur(chargeur, "memoire insuffisante", NULL);
+
+        return 0;
+    }
+
+    chargeur->signaux_sorties[num] = signal;
+
+
+    return 1;
+}
+
+//Fait les liens en attente et relie les sorties du circuit
+static int t_chargeur_terminer(t_chargeur *chargeur)
+{
+    t_pin_sortie *pin;
+
+    for(int i = 0;i<chargeur->nb_liens;i++)
+    {
+        pin = t_chargeur_resoudre(chargeur, chargeur->liens[i].signal);
+
+        if(pin == NULL || t_porte_relier(chargeur->liens[i].porte, chargeur->liens[i].num_entree, pin) == 0)
+        {
+            t_chargeur_erreur(chargeur, "signal non defini:", chargeur->signaux[chargeur->liens[i].signal].nom);
+
+            return 0;
+        }
+    }
+
+    for(int j = 0;j<chargeur->circuit->nb_sorties;j++)
+    {
+        pin = chargeur->signaux_sorties[j] == -1 ? NULL : t_chargeur_resoudre(chargeur, chargeur->signaux_sorties[j]);
+
+        if(pin == NULL)
+        {
+            t_chargeur_erreur(chargeur, "sortie non reliee:", chargeur->circuit->sorties[j]->nom);
+
+            return 0;
+        }
+
+        t_sortie_relier(chargeur->circuit->sorties[j], pin);
+    }
+
+
+    return 1;
+}
+
+//Réserve les tableaux de travail pour au moins nb opérandes
+static int t_chargeur_reserver_operandes(t_chargeur *chargeur, int nb)
+{
+    if(t_circuit_io_agrandir((void**)&chargeur->operandes, &chargeur->capacite_operandes, nb, sizeof(t_operande)) == 0
+       || t_circuit_io_agrandir((void**)&chargeur->termes, &chargeur->capacite_termes, nb, sizeof(t_operande)) == 0)
+    {
+        t_chargeur_erreur(chargeur, "memoire insuffisante", NULL);
+
+        return 0;
+    }
+
+
+    return 1;
+}
+
+
+/*******FORMAT TEXTE***********/
+
+//Lit un nombre positif ou nul (en entier)
+static int t_circuit_io_lire_nombre(const char *mot, int *nombre)
+{
+    char *fin;
+    long valeur;
+
+    if(mot == NULL || *mot < '0' || *mot > '9')
+    {
+
+        return 0;
+    }
+
+    valeur = strtol(mot, &fin, 10);
+
+    if(*fin != '\0' || valeur > 0x3FFFFFFF)
+    {
+
+        return 0;
+    }
+
+    *nombre = (int)valeur;
+
+
+    return 1;
+}
+
+t_circuit *t_circuit_charger_texte(const char *nom_fichier)
+{
+    t_chargeur chargeur;
+    FILE *fichier;
+    char *tampon = NULL;
+    int capacite_tampon = 0;
+    char *curseur;
+    char *mot;
+    char nom[16];
+    int nombre;
+    int signal;
+    int entete_lue = 0;
+    int nb_operandes;
+    int succes = 1;
+    t_porte *porte;
+    e_types_portes type;
+
+    fichier = fopen(nom_fichier, "r");
+
+    if(fichier == NULL)
+    {
+        printf("ERREUR DE LECTURE: impossible d'ouvrir %s\n", nom_fichier);
+
+        return NULL;
+    }
+
+    if(t_chargeur_init(&chargeur, nom_fichier) == 0)
+    {
+        t_chargeur_destroy(&chargeur, 0);
+        fclose(fichier);
+
+        return NULL;
+    }
+
+    while(succes && (curseur = t_circuit_io_lire_ligne(fichier, &tampon, &capacite_tampon)) != NULL)
+    {
+        chargeur.num_ligne++;
+        t_circuit_io_retirer_commentaire(curseur);
+        mot = t_circuit_io_prochain_mot(&curseur, " \t");
+
+        if(mot == NULL)
+        {
+            continue;
+        }
+
+        if(strcmp(mot, "ENTREES") == 0 || strcmp(mot, "SORTIES") == 0 || strcmp(mot, "PORTES") == 0)
+        {
+            if(t_circuit_io_lire_nombre(t_circuit_io_prochain_mot(&curseur, " \t"), &nombre) == 0)
+            {
+                t_chargeur_erreur(&chargeur, "nombre attendu apres", mot);
+                succes = 0;
+            }
+            else if(mot[0] == 'E')
+            {
+                if(chargeur.circuit->nb_entrees > 0)
+                {
+                    t_chargeur_erreur(&chargeur, "ligne ENTREES en double", NULL);
+                    succes = 0;
+                }
+
+                for(int i = 0;succes && i<nombre;i++)
+                {
+                    snprintf(nom, sizeof(nom), "E%d", i);
+                    signal = t_chargeur_signal(&chargeur, nom);
+                    succes = signal != -1 && t_circuit_ajouter_entree(chargeur.circuit) != NULL
+                             && t_chargeur_definir(&chargeur, signal, chargeur.circuit->entrees[i]->pin, -1);
+                }
+            }
+            else if(mot[0] == 'S')
+            {
+                if(chargeur.circuit->nb_sorties > 0)
+                {
+                    t_chargeur_erreur(&chargeur, "ligne SORTIES en double", NULL);
+                    succes = 0;
+                }
+
+                for(int j = 0;succes && j<nombre;j++)
+                {
+                    succes = t_chargeur_ajouter_sortie(&chargeur, -1);
+                }
+            }
+
+            //La ligne PORTES sert seulement d'indication: les portes sont créées au fil de la lecture
+            entete_lue = 1;
+        }
+        else if(mot[0] == 'P' && t_circuit_io_lire_nombre(mot + 1, &nombre))
+        {
+            if(nombre != chargeur.circuit->nb_portes)
+            {
+                t_chargeur_erreur(&chargeur, "porte hors sequence:", mot);
+                succes = 0;
+            }
+            else if(t_porte_type_depuis_nom(t_circuit_io_prochain_mot(&curseur, " \t"), &type) == 0)
+            {
+                t_chargeur_erreur(&chargeur, "type de porte inconnu pour", mot);
+                succes = 0;
+            }
+            else
+            {
+                signal = t_chargeur_signal(&chargeur, mot);
+                succes = signal != -1;
+                nb_operandes = 0;
+
+                //Le nombre d'entrées de la porte est le nombre de sources sur la ligne
+                while(succes && (mot = t_circuit_io_prochain_mot(&curseur, " \t")) != NULL)
+                {
+                    succes = t_chargeur_reserver_operandes(&chargeur, nb_operandes + 1);
+
+                    if(succes)
+                    {
+                        chargeur.operandes[nb_operandes].porte = NULL;
+                        chargeur.operandes[nb_operandes].signal = t_chargeur_signal(&chargeur, mot);
+                        succes = chargeur.operandes[nb_operandes].signal != -1;
+                        nb_operandes++;
+                    }
+                }
+
+                if(succes && t_porte_nb_entrees_valide(type, nb_operandes) == 0)
+                {
+                    snprintf(nom, sizeof(nom), "P%d", nombre);
+                    t_chargeur_erreur(&chargeur, "nombre d'entrees invalide pour", nom);
+                    succes = 0;
+                }
+
+                porte = succes ? t_circuit_ajouter_porte_n(chargeur.circuit, type, nb_operandes) : NULL;
+                succes = porte != NULL && t_chargeur_definir(&chargeur, signal, porte->sortie, -1);
+
+                for(int i = 0;succes && i<nb_operandes;i++)
+                {
+                    succes = t_chargeur_relier(&chargeur, porte, i, chargeur.operandes[i]);
+                }
+            }
+        }
+        else if(mot[0] == 'S' && t_circuit_io_lire_nombre(mot + 1, &nombre))
+        {
+            if(nombre >= chargeur.circuit->nb_sorties)
+            {
+                t_chargeur_erreur(&chargeur, "sortie inexistante:", mot);
+                succes = 0;
+            }
+            else if(chargeur.signaux_sorties[nombre] != -1)
+            {
+                t_chargeur_erreur(&chargeur, "sortie definie plusieurs fois:", mot);
+                succes = 0;
+            }
+            else if((mot = t_circuit_io_prochain_mot(&curseur, " \t")) == NULL)
+            {
+                t_chargeur_erreur(&chargeur, "source de sortie manquante", NULL);
+                succes = 0;
+            }
+            else
+            {
+                chargeur.signaux_sorties[nombre] = t_chargeur_signal(&chargeur, mot);
+                succes = chargeur.signaux_sorties[nombre] != -1;
+            }
+        }
+        else
+        {
+            t_chargeur_erreur(&chargeur, "ligne invalide:", mot);
+            succes = 0;
+        }
+    }
+
+    if(succes && entete_lue == 0)
+    {
+        t_chargeur_erreur(&chargeur, "lignes ENTREES et SORTIES manquantes", NULL);
+        succes = 0;
+    }
+
+    //Les sources des liens en attente doivent être des noms E# ou P# définis
+    succes = succes && t_chargeur_terminer(&chargeur);
+
+    free(tampon);
+    fclose(fichier);
+    t_chargeur_destroy(&chargeur, succes);
+
+
+    return succes ? chargeur.circuit : NULL;
+}
+
+
+/*******FORMAT ISCAS .BENCH***********/
+
+//Noms des types de portes dans le format .bench (indexés par e_types_portes). DFF est la
+//bascule des circuits séquentiels ISCAS-89; les constantes s'écrivent CONST0() et CONST1().
+static const char *noms_bench[NB_TYPES_PORTES] = {"AND", "OR", "NOT", "XOR", "NAND", "NOR", "XNOR", "BUF", "MUX", "DFF",
+                                                   "CONST0", "CONST1"};
+
+//Vrai si le texte qui suit le signe "=" a la forme "TYPE(...)": un nom, une parenthèse ouvrante,
+//une seule parenthèse fermante, puis rien d'autre que des blancs
+static int t_circuit_io_bench_forme_valide(const char *curseur)
+{
+    const char *ouvrante;
+    const char *fermante;
+
+    curseur += strspn(curseur, " \t");
+    ouvrante = curseur + strcspn(curseur, " \t(),");
+
+    if(ouvrante == curseur)
+    {
+
+        return 0;
+    }
+
+    ouvrante += strspn(ouvrante, " \t");
+    fermante = *ouvrante == '(' ? strchr(ouvrante + 1, ')') : NULL;
+
+    if(fermante == NULL || memchr(ouvrante + 1, '(', (size_t)(fermante - ouvrante - 1)) != NULL)
+    {
+
+        return 0;
+    }
+
+
+    return fermante[1 + strspn(fermante + 1, " \t\r")] == '\0';
+}
+
+//Lit une ligne "y = TYPE(a, b, ...)"
+static int t_circuit_io_bench_porte(t_chargeur *chargeur, char *nom_signal, char *curseur)
+{
+    int forme_valide = t_circuit_io_bench_forme_valide(curseur);
+    char *nom_type = t_circuit_io_prochain_mot(&curseur, " \t(=");
+    char *mot;
+    int signal = t_chargeur_signal(chargeur, nom_signal);
+    int nb = 0;
+    int alias = 0;
+    e_types_portes type;
+    t_operande resultat;
+
+    if(forme_valide == 0 || nom_type == NULL || signal == -1)
+    {
+        t_chargeur_erreur(chargeur, "definition de porte invalide pour", nom_signal);
+
+        return 0;
+    }
+
+    while((mot = t_circuit_io_prochain_mot(&curseur, " \t,()")) != NULL)
+    {
+        if(t_chargeur_reserver_operandes(chargeur, nb + 1) == 0)
+        {
+
+            return 0;
+        }
+
+        chargeur->operandes[nb].porte = NULL;
+        chargeur->operandes[nb].signal = t_chargeur_signal(chargeur, mot);
+        nb++;
+    }
+
+    //BUFF est un simple alias (c'est aussi la forme des sorties écrites par t_circuit_sauvegarder_bench)
+    if(strcmp(nom_type, "BUFF") == 0)
+    {
+        type = PORTE_BUF;
+        alias = 1;
+    }
+    else
+    {
+        for(type = 0;(int)type<NB_TYPES_PORTES && strcmp(nom_type, noms_bench[type]) != 0;type++)
+        {
+        }
+    }
+
+    if((int)type == NB_TYPES_PORTES)
+    {
+        t_chargeur_erreur(chargeur, "type de porte non supporte:", nom_type);
+
+        return 0;
+    }
+
+    if(nb == 0 && t_porte_nb_entrees_valide(type, 0) == 0)
+    {
+        t_chargeur_erreur(chargeur, "porte sans entree:", nom_signal);
+
+        return 0;
+    }
+
+    if(t_porte_nb_entrees_valide(type, nb) == 0 && (nb != 1 || t_porte_nb_entrees_valide(type, 2) == 0))
+    {
+        t_chargeur_erreur(chargeur, "nombre d'entrees invalide pour", nom_signal);
+
+        return 0;
+    }
+
+    for(int i = 0;i<nb;i++)
+    {
+        if(chargeur->operandes[i].signal == -1)
+        {
+            t_chargeur_erreur(chargeur, "memoire insuffisante", NULL);
+
+            return 0;
+        }
+    }
+
+    resultat = alias ? chargeur->operandes[0] : t_chargeur_porte(chargeur, type, chargeur->operandes, nb);
+
+
+    return t_chargeur_definir_operande(chargeur, signal, resultat);
+}
+
+t_circuit *t_circuit_charger_bench(const char *nom_fichier)
+{
+    t_chargeur chargeur;
+    FILE *fichier;
+    char *tampon = NULL;
+    int capacite_tampon = 0;
+    char *curseur;
+    char *mot;
+    char *egal;
+    int signal;
+    int succes = 1;
+    t_entree *entree;
+
+    fichier = fopen(nom_fichier, "r");
+
+    if(fichier == NULL)
+    {
+        printf("ERREUR DE LECTURE: impossible d'ouvrir %s\n", nom_fichier);
+
+        return NULL;
+    }
+
+    if(t_chargeur_init(&chargeur, nom_fichier) == 0)
+    {
+        t_chargeur_destroy(&chargeur, 0);
+        fclose(fichier);
+
+        return NULL;
+    }
+
+    while(succes && (curseur = t_circuit_io_lire_ligne(fichier, &tampon, &capacite_tampon)) != NULL)
+    {
+        chargeur.num_ligne++;
+        t_circuit_io_retirer_commentaire(curseur);
+        egal = strchr(curseur, '=');
+
+        if(egal != NULL)
+        {
+            *egal = '\0';
+            mot = t_circuit_io_prochain_mot(&curseur, " \t");
+
+            if(mot == NULL)
+            {
+                t_chargeur_erreur(&chargeur, "nom de signal manquant", NULL);
+                succes = 0;
+            }
+            else
+            {
+                succes = t_circuit_io_bench_porte(&chargeur, mot, egal + 1);
+            }
+
+            continue;
+        }
+
+        //Une ligne blanche est ignorée, mais pas une ligne faite de parenthèses
+        if(curseur[strspn(curseur, " \t\r")] == '\0')
+        {
+            continue;
+        }
+
+        mot = t_circuit_io_prochain_mot(&curseur, " \t(");
+
+        if(mot == NULL)
+        {
+            t_chargeur_erreur(&chargeur, "ligne sans nom de signal ni mot-cle", NULL);
+            succes = 0;
+
+            continue;
+        }
+
+        if(strcmp(mot, "INPUT") == 0 || strcmp(mot, "OUTPUT") == 0)
+        {
+            char *nom = t_circuit_io_prochain_mot(&curseur, " \t()");
+
+            signal = nom != NULL ? t_chargeur_signal(&chargeur, nom) : -1;
+
+            if(signal == -1)
+            {
+                t_chargeur_erreur(&chargeur, "nom de signal invalide apres", mot);
+                succes = 0;
+            }
+            else if(mot[0] == 'I')
+            {
+                entree = t_circuit_ajouter_entree(chargeur.circuit);
+                succes = entree != NULL && t_chargeur_definir(&chargeur, signal, entree->pin, -1);
+            }
+            else
+            {
+                succes = t_chargeur_ajouter_sortie(&chargeur, signal);
+            }
+        }
+        else
+        {
+            t_chargeur_erreur(&chargeur, "ligne invalide:", mot);
+            succes = 0;
+        }
+    }
+
+    succes = succes && t_chargeur_terminer(&chargeur);
+
+    free(tampon);
+    fclose(fichier);
+    t_chargeur_destroy(&chargeur, succes);
+
+
+    return succes ? chargeur.circuit : NULL;
+}
+
+
+/*******FORMAT BLIF***********/
+
+/*
+Bloc .names en cours de lecture: les signaux d'entrée, le signal de sortie et les lignes de la
+couverture (une chaîne de nb_entrees caractères '0', '1' ou '-' par ligne).
+*/
+typedef struct {
+	int *entrees;
+	int capacite_entrees;
+	int nb_entrees;
+	int sortie; //-1 si aucun bloc n'est en cours
+	char *cubes;
+	int capacite_cubes;
+	int nb_cubes;
+	char valeur; //Valeur de sortie des lignes de la couverture ('1' ou '0')
+} t_bloc_names;
+
+//Construit les portes d'un bloc .names complet: un ET par ligne de la couverture et un OU des
+//lignes (un NOR si la couverture décrit les zéros de la fonction).
+static int t_circuit_io_blif_construire(t_chargeur *chargeur, t_bloc_names *bloc)
+{
+    int signal;
+    t_operande resultat;
+    int nb_termes = 0;
+    int nb_litteraux;
+    const char *cube;
+
+    if(bloc->sortie == -1)
+    {
+
+        return 1;
+    }
+
+    if(t_chargeur_reserver_operandes(chargeur, bloc->nb_cubes + bloc->nb_entrees) == 0)
+    {
+
+        return 0;
+    }
+
+    for(int c = 0;c<bloc->nb_cubes;c++)
+    {
+        cube = bloc->cubes + (size_t)c * bloc->nb_entrees;
+        nb_litteraux = 0;
+
+        for(int i = 0;i<bloc->nb_entrees;i++)
+        {
+            if(cube[i] == '-')
+            {
+                continue;
+            }
+
+            chargeur->operandes[nb_litteraux].porte = NULL;
+            chargeur->operandes[nb_litteraux].signal = bloc->entrees[i];
+
+            if(cube[i] == '0')
+            {
+                chargeur->operandes[nb_litteraux] = t_chargeur_inverser(chargeur, chargeur->operandes[nb_litteraux]);
+
+                if(chargeur->operandes[nb_litteraux].porte == NULL)
+                {
+                    t_chargeur_erreur(chargeur, "memoire insuffisante", NULL);
+
+                    return 0;
+                }
+            }
+
+            nb_litteraux++;
+        }
+
+        //Une ligne sans littéral vaut toujours 1
+        chargeur->termes[nb_termes++] = t_chargeur_porte(chargeur, nb_litteraux > 0 ? PORTE_ET : PORTE_UN,
+                                                         chargeur->operandes, nb_litteraux);
+    }
+
+    //Une couverture vide décrit la constante 0
+    if(nb_termes == 0)
+    {
+        resultat = t_chargeur_porte(chargeur, PORTE_ZERO, chargeur->termes, 0);
+    }
+    else
+    {
+        resultat = t_chargeur_porte(chargeur, bloc->valeur == '0' ? PORTE_NOR : PORTE_OU, chargeur->termes, nb_termes);
+    }
+
+    //Le bloc est terminé: un autre bloc .names peut commencer
+    signal = bloc->sortie;
+    bloc->sortie = -1;
+
+
+    return t_chargeur_definir_operande(chargeur, signal, resultat);
+}
+
+//Lit une ligne BLIF complète: les lignes terminées par '\' se poursuivent sur la ligne suivante
+static char *t_circuit_io_blif_lire_ligne(FILE *fichier, char **tampon, int *capacite, char **suite, int *capacite_suite)
+{
+    char *ligne = t_circuit_io_lire_ligne(fichier, tampon, capacite);
+    int longueur;
+
+    while(ligne != NULL && (longueur = (int)strlen(ligne)) > 0 && ligne[longueur - 1] == '\\')
+    {
+        ligne[longueur - 1] = ' ';
+
+        if(t_circuit_io_lire_ligne(fichier, suite, capacite_suite) == NULL)
+        {
+            break;
+        }
+
+        if(t_circuit_io_agrandir((void**)tampon, capacite, longueur + (int)strlen(*suite) + 1, sizeof(char)) == 0)
+        {
+
+            return NULL;
+        }
+
+        ligne = *tampon;
+        strcpy(ligne + longueur, *suite);
+    }
+
+
+    return ligne;
+}
+
+//Construit la bascule d'une ligne ".latch entree sortie [type controle] [valeur initiale]". Le
+//type et le contrôle sont ignorés (horloge globale); la valeur initiale doit être 0, 2 ou 3
+//(les bascules partent de 0).
+static int t_circuit_io_blif_latch(t_chargeur *chargeur, char *curseur)
+{
+    t_operande entree = {NULL, -1};
+    char *mots[6];
+    int nb_mots = 0;
+    int signal;
+
+    while(nb_mots < 6 && (mots[nb_mots] = t_circuit_io_prochain_mot(&curseur, " \t")) != NULL)
+    {
+        nb_mots++;
+    }
+
+    if(nb_mots < 2)
+    {
+        t_chargeur_erreur(chargeur, ".latch incomplet", NULL);
+
+        return 0;
+    }
+
+    if(nb_mots == 6)
+    {
+        t_chargeur_erreur(chargeur, ".latch trop long pour", mots[1]);
+
+        return 0;
+    }
+
+    if((nb_mots == 3 || nb_mots == 5) && strcmp(mots[nb_mots - 1], "1") == 0)
+    {
+        t_chargeur_erreur(chargeur, "valeur initiale 1 non supportee pour", mots[1]);
+
+        return 0;
+    }
+
+    if((nb_mots == 3 || nb_mots == 5) && strcmp(mots[nb_mots - 1], "0") != 0 && strcmp(mots[nb_mots - 1], "2") != 0
+       && strcmp(mots[nb_mots - 1], "3") != 0)
+    {
+        t_chargeur_erreur(chargeur, "valeur initiale invalide pour", mots[1]);
+
+        return 0;
+    }
+
+    entree.signal = t_chargeur_signal(chargeur, mots[0]);
+    signal = t_chargeur_signal(chargeur, mots[1]);
+
+    if(entree.signal == -1 || signal == -1)
+    {
+        t_chargeur_erreur(chargeur, "memoire insuffisante", NULL);
+
+        return 0;
+    }
+
+
+    return t_chargeur_definir_operande(chargeur, signal, t_chargeur_porte(chargeur, PORTE_DFF, &entree, 1));
+}
+
+t_circuit *t_circuit_charger_blif(const char *nom_fichier)
+{
+    t_chargeur chargeur;
+    t_bloc_names bloc = {NULL, 0, 0, -1, NULL, 0, 0, '1'};
+    FILE *fichier;
+    char *tampon = NULL;
+    int capacite_tampon = 0;
+    char *suite = NULL;
+    int capacite_suite = 0;
+    char *curseur;
+    char *mot;
+    char *valeur;
+    int signal;
+    int nb_modeles = 0;
+    int fin = 0;
+    int succes = 1;
+    t_entree *entree;
+
+    fichier = fopen(nom_fichier, "r");
+
+    if(fichier == NULL)
+    {
+        printf("ERREUR DE LECTURE: impossible d'ouvrir %s\n", nom_fichier);
+
+        return NULL;
+    }
+
+    if(t_chargeur_init(&chargeur, nom_fichier) == 0)
+    {
+        t_chargeur_destroy(&chargeur, 0);
+        fclose(fichier);
+
+        return NULL;
+    }
+
+    while(succes && fin == 0
+          && (curseur = t_circuit_io_blif_lire_ligne(fichier, &tampon, &capacite_tampon, &suite, &capacite_suite)) != NULL)
+    {
+        chargeur.num_ligne++;
+        t_circuit_io_retirer_commentaire(curseur);
+        mot = t_circuit_io_prochain_mot(&curseur, " \t");
+
+        if(mot == NULL)
+        {
+            continue;
+        }
+
+        if(mot[0] != '.')
+        {
+            //Ligne de la couverture du bloc .names en cours: "cube valeur"
+            valeur = bloc.nb_entrees > 0 ? t_circuit_io_prochain_mot(&curseur, " \t") : mot;
+
+            if(bloc.sortie == -1 || valeur == NULL || (bloc.nb_entrees > 0 && (int)strlen(mot) != bloc.nb_entrees)
+               || (valeur[0] != '0' && valeur[0] != '1') || valeur[1] != '\0'
+               || (bloc.nb_cubes > 0 && valeur[0] != bloc.valeur)
+               || (bloc.nb_entrees > 0 && strspn(mot, "01-") != strlen(mot)))
+            {
+                t_chargeur_erreur(&chargeur, "ligne de couverture invalide:", mot);
+                succes = 0;
+            }
+            else if(t_circuit_io_agrandir((void**)&bloc.cubes, &bloc.capacite_cubes,
+                                          (bloc.nb_cubes + 1) * bloc.nb_entrees + 1, sizeof(char)) == 0)
+            {
+                t_chargeur_erreur(&chargeur, "memoire insuffisante", NULL);
+                succes = 0;
+            }
+            else
+            {
+                memcpy(bloc.cubes + (size_t)bloc.nb_cubes * bloc.nb_entrees, mot, bloc.nb_entrees);
+                bloc.valeur = valeur[0];
+                bloc.nb_cubes++;
+            }
+
+            continue;
+        }
+
+        //Toute autre commande termine le bloc .names en cours
+        succes = t_circuit_io_blif_construire(&chargeur, &bloc);
+
+        if(succes == 0)
+        {
+            continue;
+        }
+
+        if(strcmp(mot, ".model") == 0)
+        {
+            if(++nb_modeles > 1)
+            {
+                t_chargeur_erreur(&chargeur, "un seul modele est supporte", NULL);
+                succes = 0;
+            }
+        }
+        else if(strcmp(mot, ".inputs") == 0 || strcmp(mot, ".outputs") == 0)
+        {
+            while(succes && (valeur = t_circuit_io_prochain_mot(&curseur, " \t")) != NULL)
+            {
+                signal = t_chargeur_signal(&chargeur, valeur);
+
+                if(signal == -1)
+                {
+                    t_chargeur_erreur(&chargeur, "memoire insuffisante", NULL);
+                    succes = 0;
+                }
+                else if(mot[1] == 'i')
+                {
+                    entree = t_circuit_ajouter_entree(chargeur.circuit);
+                    succes = entree != NULL && t_chargeur_definir(&chargeur, signal, entree->pin, -1);
+                }
+                else
+                {
+                    succes = t_chargeur_ajouter_sortie(&chargeur, signal);
+                }
+            }
+        }
+        else if(strcmp(mot, ".names") == 0)
+        {
+            bloc.nb_entrees = 0;
+            bloc.nb_cubes = 0;
+
+            while(succes && (valeur = t_circuit_io_prochain_mot(&curseur, " \t")) != NULL)
+            {
+                signal = t_chargeur_signal(&chargeur, valeur);
+
+                if(signal == -1 || t_circuit_io_agrandir((void**)&bloc.entrees, &bloc.capacite_entrees,
+                                                         bloc.nb_entrees + 1, sizeof(int)) == 0)
+                {
+                    t_chargeur_erreur(&chargeur, "memoire insuffisante", NULL);
+                    succes = 0;
+                }
+                else
+                {
+                    bloc.entrees[bloc.nb_entrees++] = signal;
+                }
+            }
+
+            if(succes && bloc.nb_entrees == 0)
+            {
+                t_chargeur_erreur(&chargeur, ".names sans signal", NULL);
+                succes = 0;
+            }
+            else if(succes)
+            {
+                //Le dernier signal de la liste est la sortie du bloc
+                bloc.sortie = bloc.entrees[--bloc.nb_entrees];
+            }
+        }
+        else if(strcmp(mot, ".latch") == 0)
+        {
+            succes = t_circuit_io_blif_latch(&chargeur, curseur);
+        }
+        else if(strcmp(mot, ".end") == 0)
+        {
+            fin = 1;
+        }
+        else
+        {
+            t_chargeur_erreur(&chargeur, "commande non supportee:", mot);
+            succes = 0;
+        }
+    }
+
+    succes = succes && t_circuit_io_blif_construire(&chargeur, &bloc) && t_chargeur_terminer(&chargeur);
+
+    free(bloc.entrees);
+    free(bloc.cubes);
+    free(tampon);
+    free(suite);
+    fclose(fichier);
+    t_chargeur_destroy(&chargeur, succes);
+
+
+    return succes ? chargeur.circuit : NULL;
+}
+
+
+/*******FORMAT BINAIRE***********/
+
+/*
+Disposition du fichier binaire (entiers int32_t):
+	entête:  magique, nb_entrees, nb_sorties, nb_portes, nb_liens
+	debut:   nb_portes + 1 entiers, les sources de la porte k sont sources[debut[k]] à sources[debut[k+1]-1]
+	sources: nb_liens entiers
+	sorties: nb_sorties entiers
+	types:   nb_portes octets (e_types_portes)
+Une source s désigne l'entrée s du circuit si s < nb_entrees, sinon la porte d'identifiant
+s - nb_entrees. Les portes sont stockées par identifiant, ce qui conserve leurs noms.
+*/
+#define BINAIRE_TAILLE_ENTETE 5
+
+const unsigned char *t_circuit_io_projeter(const char *nom_fichier, size_t *taille)
+{
+    unsigned char *contenu;
+#ifdef _WIN32
+    FILE *fichier = fopen(nom_fichier, "rb");
+    long longueur;
+
+    if(fichier == NULL || fseek(fichier, 0, SEEK_END) != 0 || (longueur = ftell(fichier)) <= 0)
+    {
+        if(fichier != NULL)
+        {
+            fclose(fichier);
+        }
+
+        return NULL;
+    }
+
+    rewind(fichier);
+    contenu = (unsigned char*)malloc((size_t)longueur);
+
+    if(contenu != NULL && fread(contenu, 1, (size_t)longueur, fichier) != (size_t)longueur)
+    {
+        free(contenu);
+        contenu = NULL;
+    }
+
+    fclose(fichier);
+    *taille = (size_t)longueur;
+#else
+    struct stat informations;
+    int descripteur = open(nom_fichier, O_RDONLY);
+
+    if(descripteur < 0)
+    {
+
+        return NULL;
+    }
+
+    if(fstat(descripteur, &informations) != 0 || informations.st_size <= 0)
+    {
+        close(descripteur);
+
+        return NULL;
+    }
+
+    *taille = (size_t)informations.st_size;
+    contenu = (unsigned char*)mmap(NULL, *taille, PROT_READ, MAP_PRIVATE, descripteur, 0);
+    close(descripteur);
+
+    if(contenu == MAP_FAILED)
+    {
+
+        return NULL;
+    }
+#endif
+
+
+    return contenu;
+}
+
+void t_circuit_io_liberer_projection(const unsigned char *contenu, size_t taille)
+{
+#ifdef _WIN32
+    (void)taille;
+    free((void*)contenu);
+#else
+    munmap((void*)contenu, taille);
+#endif
+}
+
+//Retourne la pin désignée par une source du format binaire, NULL si la source est invalide
+static t_pin_sortie *t_circuit_io_pin_source(t_circuit *circuit, int32_t source)
+{
+    if(source >= 0 && source < circuit->nb_entrees)
+    {
+
+        return circuit->entrees[source]->pin;
+    }
+
+    if(source >= circuit->nb_entrees && source - circuit->nb_entrees < circuit->nb_portes)
+    {
+
+        return circuit->portes[source - circuit->nb_entrees]->sortie;
+    }
+
+
+    return NULL;
+}
+
+//Construit le circuit décrit par le contenu d'un fichier binaire
+static t_circuit *t_circuit_io_decoder_binaire(const unsigned char *contenu, size_t taille, const char **erreur)
+{
+    const int32_t *entete = (const int32_t*)contenu;
+    const int32_t *debut;
+    const int32_t *sources;
+    const int32_t *sorties;
+    const unsigned char *types;
+    int32_t nb_entrees, nb_sorties, nb_portes, nb_liens;
+    t_circuit *circuit;
+    t_pin_sortie *pin;
+    int succes = 1;
+
+    *erreur = "fichier tronque ou invalide";
+
+    if(taille < BINAIRE_TAILLE_ENTETE * sizeof(int32_t) || entete[0] != CIRCUIT_BINAIRE_MAGIQUE)
+    {
+        *erreur = "signature invalide";
+
+        return NULL;
+    }
+
+    nb_entrees = entete[1];
+    nb_sorties = entete[2];
+    nb_portes = entete[3];
+    nb_liens = entete[4];
+
+    if(nb_entrees < 0 || nb_sorties < 0 || nb_portes < 0 || nb_liens < 0
+       || taille != sizeof(int32_t) * ((size_t)BINAIRE_TAILLE_ENTETE + nb_portes + 1 + nb_liens + nb_sorties) + (size_t)nb_portes)
+    {
+
+        return NULL;
+    }
+
+    debut = entete + BINAIRE_TAILLE_ENTETE;
+    sources = debut + nb_portes + 1;
+    sorties = sources + nb_liens;
+    types = (const unsigned char*)(sorties + nb_sorties);
+
+    if(debut[0] != 0 || debut[nb_portes] != nb_liens)
+    {
+
+        return NULL;
+    }
+
+    circuit = t_circuit_init();
+
+    if(circuit == NULL)
+    {
+        *erreur = "memoire insuffisante";
+
+        return NULL;
+    }
+
+    for(int i = 0;succes && i<nb_entrees;i++)
+    {
+        succes = t_circuit_ajouter_entree(circuit) != NULL;
+    }
+
+    for(int j = 0;succes && j<nb_sorties;j++)
+    {
+        succes = t_circuit_ajouter_sortie(circuit) != NULL;
+    }
+
+    for(int k = 0;succes && k<nb_portes;k++)
+    {
+        succes = types[k] < NB_TYPES_PORTES
+                 && t_circuit_ajouter_porte_n(circuit, (e_types_portes)types[k], debut[k + 1] - debut[k]) != NULL;
+    }
+
+    //Toutes les portes existent: les sources peuvent désigner n'importe quelle porte
+    for(int k = 0;succes && k<nb_portes;k++)
+    {
+        for(int i = 0;succes && i<circuit->portes[k]->nb_entrees;i++)
+        {
+            pin = t_circuit_io_pin_source(circuit, sources[debut[k] + i]);
+            succes = pin != NULL && t_porte_relier(circuit->portes[k], i, pin);
+        }
+    }
+
+    for(int j = 0;succes && j<nb_sorties;j++)
+    {
+        pin = t_circuit_io_pin_source(circuit, sorties[j]);
+        succes = pin != NULL && t_sortie_relier(circuit->sorties[j], pin);
+    }
+
+    if(succes == 0)
+    {
+        t_circuit_destroy(circuit);
+
+        return NULL;
+    }
+
+
+    return circuit;
+}
+
+t_circuit *t_circuit_charger_binaire(const char *nom_fichier)
+{
+    const unsigned char *contenu;
+    const char *erreur;
+    size_t taille = 0;
+    t_circuit *circuit;
+
+    contenu = t_circuit_io_projeter(nom_fichier, &taille);
+
+    if(contenu == NULL)
+    {
+        printf("ERREUR DE LECTURE: impossible d'ouvrir %s\n", nom_fichier);
+
+        return NULL;
+    }
+
+    circuit = t_circuit_io_decoder_binaire(contenu, taille, &erreur);
+    t_circuit_io_liberer_projection(contenu, taille);
+
+    if(circuit == NULL)
+    {
+        printf("ERREUR DE LECTURE: %s: %s\n", nom_fichier, erreur);
+    }
+
+
+    return circuit;
+}
+
+
+/*******ÉCRITURE***********/
+
+//Vérifie qu'un circuit peut être écrit: tous les liens sont faits et il n'y a pas de boucle.
+//Le circuit est ordonné, ce qui numérote les pins sortie (voir t_circuit_io_source).
+//Retourne le circuit à écrire: sa forme aplatie s'il contient des instances (les formats ne
+//décrivent que des portes), NULL s'il n'est pas valide.
+static t_circuit *t_circuit_io_preparer(t_circuit *circuit, const char *nom_fichier)
+{
+    if(t_circuit_est_simulable(circuit) == 0 || t_circuit_ordonner(circuit) == 0)
+    {
+        printf("ERREUR D'ECRITURE: %s: le circuit n'est pas valide (lien manquant ou boucle)\n", nom_fichier);
+
+        return NULL;
+    }
+
+    if(circuit->nb_instances > 0)
+    {
+
+        return circuit->aplati;
+    }
+
+
+    return circuit;
+}
+
+//Code d'une source pour l'écriture: s < nb_entrees pour l'entrée s, nb_entrees + id pour une porte.
+//La pin sortie reliée connaît le composant auquel elle appartient (entrée du circuit ou porte).
+static int t_circuit_io_source(t_circuit *circuit, const t_pin_entree *pin)
+{
+    if(pin->liaison->entree != NULL)
+    {
+
+        return pin->liaison->entree->id;
+    }
+
+
+    return circuit->nb_entrees + pin->liaison->porte->id;
+}
+
+//Écrit le nom d'une source (E# ou P#)
+static void t_circuit_io_ecrire_source(FILE *fichier, t_circuit *circuit, const t_pin_entree *pin)
+{
+    int source = t_circuit_io_source(circuit, pin);
+
+    if(source < circuit->nb_entrees)
+    {
+        fprintf(fichier, "E%d", source);
+    }
+    else
+    {
+        fprintf(fichier, "P%d", source - circuit->nb_entrees);
+    }
+}
+
+int t_circuit_sauvegarder_texte(t_circuit *circuit, const char *nom_fichier)
+{
+    FILE *fichier;
+    t_porte *porte;
+    int succes;
+
+    circuit = t_circuit_io_preparer(circuit, nom_fichier);
+
+    if(circuit == NULL)
+    {
+
+        return 0;
+    }
+
+    fichier = fopen(nom_fichier, "w");
+
+    if(fichier == NULL)
+    {
+        printf("ERREUR D'ECRITURE: impossible d'ouvrir %s\n", nom_fichier);
+
+        return 0;
+    }
+
+    fprintf(fichier, "ENTREES %d\nSORTIES %d\nPORTES %d\n", circuit->nb_entrees, circuit->nb_sorties, circuit->nb_portes);
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        porte = circuit->portes[k];
+        fprintf(fichier, "P%d %s", porte->id, t_porte_get_nom_type(porte->type));
+
+        for(int i = 0;i<porte->nb_entrees;i++)
+        {
+            fputc(' ', fichier);
+            t_circuit_io_ecrire_source(fichier, circuit, porte->entrees[i]);
+        }
+
+        fputc('\n', fichier);
+    }
+
+    for(int j = 0;j<circuit->nb_sorties;j++)
+    {
+        fprintf(fichier, "S%d ", j);
+        t_circuit_io_ecrire_source(fichier, circuit, circuit->sorties[j]->pin);
+        fputc('\n', fichier);
+    }
+
+    succes = ferror(fichier) == 0;
+    succes = fclose(fichier) == 0 && succes;
+
+
+    return succes;
+}
+
+int t_circuit_sauvegarder_bench(t_circuit *circuit, const char *nom_fichier)
+{
+    FILE *fichier;
+    t_porte *porte;
+    int succes;
+
+    circuit = t_circuit_io_preparer(circuit, nom_fichier);
+
+    if(circuit == NULL)
+    {
+
+        return 0;
+    }
+
+    fichier = fopen(nom_fichier, "w");
+
+    if(fichier == NULL)
+    {
+        printf("ERREUR D'ECRITURE: impossible d'ouvrir %s\n", nom_fichier);
+
+        return 0;
+    }
+
+    fprintf(fichier, "# %d entrees, %d sorties, %d portes\n\n", circuit->nb_entrees, circuit->nb_sorties, circuit->nb_portes);
+
+    for(int i = 0;i<circuit->nb_entrees;i++)
+    {
+        fprintf(fichier, "INPUT(E%d)\n", i);
+    }
+
+    fputc('\n', fichier);
+
+    for(int j = 0;j<circuit->nb_sorties;j++)
+    {
+        fprintf(fichier, "OUTPUT(S%d)\n", j);
+    }
+
+    fputc('\n', fichier);
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        porte = circuit->portes[k];
+        fprintf(fichier, "P%d = %s(", porte->id, noms_bench[porte->type]);
+
+        for(int i = 0;i<porte->nb_entrees;i++)
+        {
+            if(i > 0)
+            {
+                fputs(", ", fichier);
+            }
+
+            t_circuit_io_ecrire_source(fichier, circuit, porte->entrees[i]);
+        }
+
+        fputs(")\n", fichier);
+    }
+
+    for(int j = 0;j<circuit->nb_sorties;j++)
+    {
+        fprintf(fichier, "S%d = BUFF(", j);
+        t_circuit_io_ecrire_source(fichier, circuit, circuit->sorties[j]->pin);
+        fputs(")\n", fichier);
+    }
+
+    succes = ferror(fichier) == 0;
+    succes = fclose(fichier) == 0 && succes;
+
+
+    return succes;
+}
+
+int t_circuit_sauvegarder_binaire(t_circuit *circuit, const char *nom_fichier)
+{
+    FILE *fichier;
+    int32_t entete[BINAIRE_TAILLE_ENTETE];
+    int32_t *debut;
+    int32_t *sources;
+    int32_t *sorties;
+    unsigned char *types;
+    int nb_liens = 0;
+    int succes;
+
+    circuit = t_circuit_io_preparer(circuit, nom_fichier);
+
+    if(circuit == NULL)
+    {
+
+        return 0;
+    }
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        nb_liens += circuit->portes[k]->nb_entrees;
+    }
+
+    debut = (int32_t*)malloc(sizeof(int32_t) * (circuit->nb_portes + 1));
+    sources = (int32_t*)malloc(sizeof(int32_t) * (nb_liens + 1));
+    sorties = (int32_t*)malloc(sizeof(int32_t) * (circuit->nb_sorties + 1));
+    types = (unsigned char*)malloc(sizeof(unsigned char) * (circuit->nb_portes + 1));
+
+    if(debut == NULL || sources == NULL || sorties == NULL || types == NULL)
+    {
+        printf("ERREUR D'ECRITURE: %s: memoire insuffisante\n", nom_fichier);
+        free(debut);
+        free(sources);
+        free(sorties);
+        free(types);
+
+        return 0;
+    }
+
+    nb_liens = 0;
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        debut[k] = nb_liens;
+        types[k] = (unsigned char)circuit->portes[k]->type;
+
+        for(int i = 0;i<circuit->portes[k]->nb_entrees;i++)
+        {
+            sources[nb_liens++] = t_circuit_io_source(circuit, circuit->portes[k]->entrees[i]);
+        }
+    }
+
+    debut[circuit->nb_portes] = nb_liens;
+
+    for(int j = 0;j<circuit->nb_sorties;j++)
+    {
+        sorties[j] = t_circuit_io_source(circuit, circuit->sorties[j]->pin);
+    }
+
+    entete[0] = CIRCUIT_BINAIRE_MAGIQUE;
+    entete[1] = circuit->nb_entrees;
+    entete[2] = circuit->nb_sorties;
+    entete[3] = circuit->nb_portes;
+    entete[4] = nb_liens;
+
+    fichier = fopen(nom_fichier, "wb");
+    succes = fichier != NULL;
+
+    if(succes)
+    {
+        succes = fwrite(entete, sizeof(int32_t), BINAIRE_TAILLE_ENTETE, fichier) == BINAIRE_TAILLE_ENTETE
+                 && fwrite(debut, sizeof(int32_t), circuit->nb_portes + 1, fichier) == (size_t)circuit->nb_portes + 1
+                 && fwrite(sources, sizeof(int32_t), nb_liens, fichier) == (size_t)nb_liens
+                 && fwrite(sorties, sizeof(int32_t), circuit->nb_sorties, fichier) == (size_t)circuit->nb_sorties
+                 && fwrite(types, sizeof(unsigned char), circuit->nb_portes, fichier) == (size_t)circuit->nb_portes;
+        succes = fclose(fichier) == 0 && succes;
+    }
+
+    if(succes == 0)
+    {
+        printf("ERREUR D'ECRITURE: impossible d'ecrire %s\n", nom_fichier);
+    }
+
+    free(debut);
+    free(sources);
+    free(sorties);
+    free(types);
+
+
+    return succes;
+}
+
+
+/*******SIMULATION D'UNE SUITE DE VECTEURS***********/
+
+int t_circuit_simuler_sequence(t_circuit *circuit, FILE *entrees, FILE *sorties)
+{
+    t_netlist *netlist;
+    uint64_t *mots_entrees;
+    uint64_t *mots_sorties;
+    char *tampon = NULL;
+    int capacite_tampon = 0;
+    char *ligne;
+    int num_ligne = 0;
+    int nb_cycles = 0;
+    int nb_valeurs;
+
+    netlist = t_circuit_est_simulable(circuit) ? t_circuit_get_netlist(circuit) : NULL;
+
+    if(netlist == NULL)
+    {
+        printf("ERREUR DE SIMULATION: le circuit n'est pas valide (lien manquant ou boucle combinatoire)\n");
+
+        return -1;
+    }
+
+    mots_entrees = (uint64_t*)malloc(sizeof(uint64_t) * (circuit->nb_entrees + 1));
+    mots_sorties = (uint64_t*)malloc(sizeof(uint64_t) * (circuit->nb_sorties + 1));
+
+    while(mots_entrees != NULL && mots_sorties != NULL && (ligne = t_circuit_io_lire_ligne(entrees, &tampon, &capacite_tampon)) != NULL)
+    {
+        num_ligne++;
+        t_circuit_io_retirer_commentaire(ligne);
+        nb_valeurs = 0;
+
+        for(char *c = ligne;*c != '\0' && nb_valeurs >= 0;c++)
+        {
+            if(*c == '0' || *c == '1')
+            {
+                if(nb_valeurs < circuit->nb_entrees)
+                {
+                    mots_entrees[nb_valeurs] = (uint64_t)(*c - '0');
+                }
+
+                nb_valeurs++;
+            }
+            else if(*c != ' ' && *c != '\t')
+            {
+                nb_valeurs = -1;
+            }
+        }
+
+        if(nb_valeurs == 0 && ligne[strspn(ligne, " \t")] == '\0')
+        {
+            continue;
+        }
+
+        if(nb_valeurs != circuit->nb_entrees)
+        {
+            printf("ERREUR DE SIMULATION: ligne %d: %d valeurs 0 ou 1 attendues\n", num_ligne, circuit->nb_entrees);
+            nb_cycles = -1;
+            break;
+        }
+
+        //Un cycle à la fois: la sortie d'un cycle est écrite avant de lire le vecteur suivant
+        if(t_netlist_simuler_cycles(netlist, mots_entrees, mots_sorties, 1, 1) == 0)
+        {
+            nb_cycles = -1;
+            break;
+        }
+
+        for(int j = 0;j<circuit->nb_sorties;j++)
+        {
+            fputc('0' + (int)(mots_sorties[j] & 1), sorties);
+        }
+
+        fputc('\n', sorties);
+        nb_cycles++;
+    }
+
+    if(mots_entrees == NULL || mots_sorties == NULL || ferror(sorties))
+    {
+        nb_cycles = -1;
+    }
+
+    free(mots_entrees);
+    free(mots_sorties);
+    free(tampon);
+
+
+    return nb_cycles;
+}
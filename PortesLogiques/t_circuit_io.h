@@ -0,0 +1,163 @@
+/*
+Module: T_CIRCUIT_IO
+Description: Fonctions de lecture et d'écriture de circuits dans des fichiers.
+
+			 Formats pris en charge:
+			 - Texte (format du projet). Les composants gardent leurs noms (E0, P3, S1...):
+					# commentaire
+					ENTREES 3
+					SORTIES 1
+					PORTES 4
+					P0 OU E0 E1
+					P1 ET E1 E2
+					P2 NOT P0
+					P3 XOR P2 P1
+					S0 P3
+			   Les lignes ENTREES et SORTIES doivent précéder les portes, la ligne PORTES est
+			   facultative. Le nombre d'entrées d'une porte est le nombre de sources sur sa ligne
+			   (ex.: P4 NAND E0 E1 E2). Les portes doivent apparaître dans l'ordre de leurs identifiants
+			   mais peuvent utiliser des portes définies plus loin.
+			 - ISCAS .bench (sous-ensemble): INPUT(x), OUTPUT(y), y = TYPE(a, b, ...) avec les
+			   types AND, OR, NOT, XOR, NAND, NOR, XNOR, BUF, MUX, DFF, CONST0, CONST1 et BUFF. BUFF
+			   ne crée pas de porte (le signal est un alias de son entrée), BUF crée une porte tampon.
+			   DFF est la bascule des circuits séquentiels ISCAS-89.
+			 - BLIF structurel (sous-ensemble): .model, .inputs, .outputs, .names (couverture
+			   en somme de produits; une couverture constante devient une porte ZERO ou UN),
+			   .latch (bascule sur l'horloge globale; valeur initiale 0, 2 ou 3, traitée comme 0) et .end. Un seul modèle
+			   par fichier.
+			 - Binaire compact: les tableaux du circuit sont écrits tels quels (entiers de 32 bits
+			   dans l'ordre des octets de la machine) et le fichier est projeté en mémoire (mmap)
+			   au chargement, sans analyse ligne par ligne.
+
+			 Les portes à plus de deux entrées des formats .bench et BLIF sont construites comme
+			 une seule porte à N entrées (une ligne de couverture BLIF devient une porte ET).
+
+			 En cas d'erreur, les fonctions de chargement affichent un message (ERREUR DE LECTURE)
+			 et retournent NULL.
+*/
+
+#ifndef T_CIRCUIT_IO_H_
+#define T_CIRCUIT_IO_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "t_circuit.h"
+
+#define CIRCUIT_BINAIRE_MAGIQUE 0x31424C50 //Signature des fichiers binaires ("PLB1")
+
+/*
+Fonction: T_CIRCUIT_CHARGER_TEXTE
+Description: Crée un circuit à partir d'un fichier au format texte du projet.
+Paramètres:
+- nom_fichier: Chemin du fichier à lire.
+Retour: Pointeur vers le circuit créé, NULL en cas d'erreur.
+*/
+t_circuit *t_circuit_charger_texte(const char *nom_fichier);
+
+/*
+Fonction: T_CIRCUIT_CHARGER_BENCH
+Description: Crée un circuit à partir d'un fichier ISCAS .bench. Les entrées et les sorties
+			 sont créées dans l'ordre des lignes INPUT et OUTPUT du fichier.
+Paramètres:
+- nom_fichier: Chemin du fichier à lire.
+Retour: Pointeur vers le circuit créé, NULL en cas d'erreur.
+*/
+t_circuit *t_circuit_charger_bench(const char *nom_fichier);
+
+/*
+Fonction: T_CIRCUIT_CHARGER_BLIF
+Description: Crée un circuit à partir d'un fichier BLIF. Les entrées et les sorties sont créées
+			 dans l'ordre des listes .inputs et .outputs du fichier.
+Paramètres:
+- nom_fichier: Chemin du fichier à lire.
+Retour: Pointeur vers le circuit créé, NULL en cas d'erreur.
+*/
+t_circuit *t_circuit_charger_blif(const char *nom_fichier);
+
+/*
+Fonction: T_CIRCUIT_CHARGER_BINAIRE
+Description: Crée un circuit à partir d'un fichier binaire écrit par t_circuit_sauvegarder_binaire.
+Paramètres:
+- nom_fichier: Chemin du fichier à lire.
+Retour: Pointeur vers le circuit créé, NULL en cas d'erreur.
+*/
+t_circuit *t_circuit_charger_binaire(const char *nom_fichier);
+
+/*
+Fonction: T_CIRCUIT_IO_PROJETER
+Description: Donne le contenu d'un fichier en mémoire, sans le copier: le fichier est projeté
+			 avec mmap (sous Windows, il est lu dans un tableau alloué).
+Paramètres:
+- nom_fichier: Chemin du fichier à lire.
+- taille: Reçoit la taille du fichier en octets.
+Retour: Pointeur vers le contenu (à rendre avec t_circuit_io_liberer_projection), NULL si le fichier
+		ne peut pas être lu ou s'il est vide.
+*/
+const unsigned char *t_circuit_io_projeter(const char *nom_fichier, size_t *taille);
+
+/*
+Fonction: T_CIRCUIT_IO_LIBERER_PROJECTION
+Description: Libère le contenu donné par t_circuit_io_projeter.
+Paramètres:
+- contenu: Contenu du fichier.
+- taille: Taille du fichier en octets.
+Retour: Aucun.
+*/
+void t_circuit_io_liberer_projection(const unsigned char *contenu, size_t taille);
+
+/*
+Fonction: T_CIRCUIT_SAUVEGARDER_TEXTE
+Description: Écrit un circuit dans un fichier au format texte du projet. Un circuit qui contient
+			 des instances est écrit sous sa forme aplatie (voir t_circuit_aplatir).
+Paramètres:
+- circuit: Pointeur vers le circuit à écrire. Toutes les entrées de portes et toutes les
+		   sorties doivent être reliées (voir t_circuit_est_simulable).
+- nom_fichier: Chemin du fichier à écrire.
+Retour: Booléen: Vrai si le fichier a été écrit, faux sinon.
+*/
+int t_circuit_sauvegarder_texte(t_circuit *circuit, const char *nom_fichier);
+
+/*
+Fonction: T_CIRCUIT_SAUVEGARDER_BENCH
+Description: Écrit un circuit dans un fichier ISCAS .bench. Les signaux gardent les noms des
+			 composants du circuit (les sorties sont des BUFF de leur source).
+Paramètres:
+- circuit: Pointeur vers le circuit à écrire (voir t_circuit_est_simulable: une entrée peut
+		   n'être lue par aucune porte).
+- nom_fichier: Chemin du fichier à écrire.
+Retour: Booléen: Vrai si le fichier a été écrit, faux sinon.
+*/
+int t_circuit_sauvegarder_bench(t_circuit *circuit, const char *nom_fichier);
+
+/*
+Fonction: T_CIRCUIT_SAUVEGARDER_BINAIRE
+Description: Écrit un circuit dans le format binaire compact.
+Paramètres:
+- circuit: Pointeur vers le circuit à écrire (voir t_circuit_est_simulable: une entrée peut
+		   n'être lue par aucune porte).
+- nom_fichier: Chemin du fichier à écrire.
+Retour: Booléen: Vrai si le fichier a été écrit, faux sinon.
+*/
+int t_circuit_sauvegarder_binaire(t_circuit *circuit, const char *nom_fichier);
+
+/*
+Fonction: T_CIRCUIT_SIMULER_SEQUENCE
+Description: Simule un circuit séquentiel avec une suite de vecteurs lue dans un fichier, un cycle
+			 d'horloge par ligne. Une ligne donne la valeur de chaque entrée ('0' ou '1', dans
+			 l'ordre des entrées; les espaces, les lignes vides et les commentaires '#' sont
+			 ignorés). Les sorties de chaque cycle sont écrites dès qu'elles sont calculées, une
+			 ligne par cycle dans le même format: les fichiers peuvent être des flux (stdin, tube).
+
+			 La simulation se fait sur la netlist (t_circuit_simuler_cycles) et part de l'état
+			 courant de ses bascules (voir t_circuit_reinitialiser_etats).
+Paramètres:
+- circuit: Pointeur vers le circuit à simuler.
+- entrees: Fichier des vecteurs, ouvert en lecture.
+- sorties: Fichier des sorties, ouvert en écriture.
+Retour: Nombre de cycles simulés. -1 si un lien du circuit manque (voir t_circuit_est_simulable),
+		si une ligne est invalide (un message est affiché) ou si l'écriture a échoué.
+*/
+int t_circuit_simuler_sequence(t_circuit *circuit, FILE *entrees, FILE *sorties);
+
+#endif
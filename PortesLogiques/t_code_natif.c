@@ -0,0 +1,358 @@
+//
+// Compilation d'un circuit en code machine (voir t_code_natif.h).
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "t_code_natif.h"
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+#define CODE_NATIF_COMMANDE_MAX 1024 //Taille maximale de la commande de compilation
+
+//Type du code généré. Avec GCC et Clang, un mot de W * 64 bits est un vecteur (vector_size):
+//chaque porte est une seule expression que le compilateur traduit sans boucle. Ailleurs, le
+//code travaille sur un seul mot de 64 bits à la fois.
+static const char *entete_code =
+    "#ifdef __GNUC__\n"
+    "typedef uint64_t mots __attribute__((vector_size(W * 8)));\n"
+    "#define MOT(x, k) (x)[k]\n"
+    "#else\n"
+    "#undef W\n"
+    "#define W 1\n"
+    "typedef uint64_t mots;\n"
+    "#define MOT(x, k) (x)\n"
+    "#endif\n";
+
+//Opérateur C qui combine les entrées de chaque type de porte et inversion de la sortie
+//(dans l'ordre de e_types_portes; le MUX et les constantes sont écrits à part, les bascules ne
+//sont pas supportées)
+static const char *operateurs[NB_TYPES_PORTES] = {" & ", " | ", "", " ^ ", " & ", " | ", " ^ ", "", "", "", "", ""};
+static const int inversions[NB_TYPES_PORTES] = {0, 0, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1};
+
+//Écrit l'opérande "net" d'une porte de la fonction f: variable locale si le net est calculé par f
+static void t_code_natif_operande(const t_netlist *netlist, int net, int f, FILE *fichier)
+{
+    int porte = net - netlist->nb_entrees;
+
+    if(porte >= 0 && porte / CODE_NATIF_PORTES_PAR_FONCTION == f)
+    {
+        fprintf(fichier, "n%d", net);
+    }
+    else
+    {
+        fprintf(fichier, "v[%d]", net);
+    }
+}
+
+int t_code_natif_generer_c(t_circuit *circuit, FILE *fichier)
+{
+    const t_netlist *netlist = t_circuit_get_netlist(circuit);
+    const int *entrees;
+    unsigned char *memorise;
+    int nb_fonctions;
+    int derniere;
+    int net;
+
+    if(netlist == NULL || netlist->nb_bascules > 0)
+    {
+
+        return 0;
+    }
+
+    entrees = netlist->entrees;
+    nb_fonctions = (netlist->nb_portes + CODE_NATIF_PORTES_PAR_FONCTION - 1) / CODE_NATIF_PORTES_PAR_FONCTION;
+    memorise = (unsigned char*)calloc(netlist->nb_nets + 1, 1);
+
+    if(memorise == NULL)
+    {
+
+        return 0;
+    }
+
+    //Un net est rangé dans v s'il est lu par une autre fonction ou par une sortie du circuit:
+    //les autres restent des variables locales (registres) de la fonction qui les calcule
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        memorise[netlist->sorties[j]] = 1;
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        net = netlist->nb_entrees + k;
+
+        for(int i = netlist->debut_fanout[net];i<netlist->debut_fanout[net + 1];i++)
+        {
+            if(netlist->fanout[i] / CODE_NATIF_PORTES_PAR_FONCTION != k / CODE_NATIF_PORTES_PAR_FONCTION)
+            {
+                memorise[net] = 1;
+            }
+        }
+    }
+
+    fprintf(fichier, "/* Code genere par t_code_natif_generer_c: %d entrees, %d sorties, %d portes */\n\n",
+            netlist->nb_entrees, netlist->nb_sorties, netlist->nb_portes);
+    fprintf(fichier, "#include <stdint.h>\n\n#define W %d\n\n", CODE_NATIF_MOTS);
+
+    fputs(entete_code, fichier);
+
+    //Portes, dans l'ordre d'évaluation de la netlist
+    for(int f = 0;f<nb_fonctions;f++)
+    {
+        fprintf(fichier, "\nstatic void portes_%d(mots *restrict v)\n{\n", f);
+        derniere = (f + 1) * CODE_NATIF_PORTES_PAR_FONCTION;
+
+        if(derniere > netlist->nb_portes)
+        {
+            derniere = netlist->nb_portes;
+        }
+
+        for(int k = f * CODE_NATIF_PORTES_PAR_FONCTION;k<derniere;k++)
+        {
+            net = netlist->nb_entrees + k;
+            fprintf(fichier, "    const mots n%d = %s(", net, inversions[netlist->types[k]] ? "~" : "");
+
+            if(netlist->types[k] == PORTE_MUX)
+            {
+                //Sélection, valeur si 0, valeur si 1
+                t_code_natif_operande(netlist, entrees[netlist->debut_entrees[k] + 1], f, fichier);
+                fputs(" & ~", fichier);
+                t_code_natif_operande(netlist, entrees[netlist->debut_entrees[k]], f, fichier);
+                fputs(") | (", fichier);
+                t_code_natif_operande(netlist, entrees[netlist->debut_entrees[k] + 2], f, fichier);
+                fputs(" & ", fichier);
+                t_code_natif_operande(netlist, entrees[netlist->debut_entrees[k]], f, fichier);
+            }
+            else if(netlist->debut_entrees[k] == netlist->debut_entrees[k + 1])
+            {
+                //Constante: ZERO, ou UN avec l'inversion
+                fputs("(mots){0}", fichier);
+            }
+            else
+            {
+                for(int i = netlist->debut_entrees[k];i<netlist->debut_entrees[k + 1];i++)
+                {
+                    if(i > netlist->debut_entrees[k])
+                    {
+                        fputs(operateurs[netlist->types[k]], fichier);
+                    }
+
+                    t_code_natif_operande(netlist, entrees[i], f, fichier);
+                }
+            }
+
+            fputs(");\n", fichier);
+        }
+
+        for(int k = f * CODE_NATIF_PORTES_PAR_FONCTION;k<derniere;k++)
+        {
+            net = netlist->nb_entrees + k;
+
+            if(memorise[net])
+            {
+                fprintf(fichier, "    v[%d] = n%d;\n", net, net);
+            }
+        }
+
+        fputs("}\n", fichier);
+    }
+
+    free(memorise);
+
+    //Fonction principale: W mots à la fois, le dernier groupe est complété par des zéros
+    fputs("\nvoid circuit_evaluer(const uint64_t *entrees, uint64_t *sorties, int nb_mots, uint64_t *travail)\n{\n", fichier);
+    fputs("    mots *v = (mots*)travail;\n\n", fichier);
+    fputs("    for(int m = 0;m<nb_mots;m += W)\n    {\n", fichier);
+    fputs("        int n = nb_mots - m < W ? nb_mots - m : W;\n\n", fichier);
+    fprintf(fichier, "        for(int i = 0;i<%d;i++)\n        {\n", netlist->nb_entrees);
+    fputs("            for(int k = 0;k<W;k++)\n            {\n", fichier);
+    fputs("                MOT(v[i], k) = k < n ? entrees[i*nb_mots + m + k] : 0;\n            }\n        }\n\n", fichier);
+
+    for(int f = 0;f<nb_fonctions;f++)
+    {
+        fprintf(fichier, "        portes_%d(v);\n", f);
+    }
+
+    fputc('\n', fichier);
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        fprintf(fichier, "        for(int k = 0;k<n;k++) sorties[%d*nb_mots + m + k] = MOT(v[%d], k);\n", j,
+                netlist->sorties[j]);
+    }
+
+    fputs("    }\n}\n", fichier);
+
+
+    return ferror(fichier) == 0;
+}
+
+#ifndef _WIN32
+
+static double t_code_natif_temps(void)
+{
+    struct timespec temps;
+
+    clock_gettime(CLOCK_MONOTONIC, &temps);
+
+
+    return temps.tv_sec + temps.tv_nsec * 1e-9;
+}
+
+//Supprime les fichiers temporaires du code
+static void t_code_natif_nettoyer(const t_code_natif *code)
+{
+    char chemin[CODE_NATIF_CHEMIN_MAX + 16];
+
+    snprintf(chemin, sizeof(chemin), "%s/circuit.c", code->repertoire);
+    unlink(chemin);
+    snprintf(chemin, sizeof(chemin), "%s/circuit.so", code->repertoire);
+    unlink(chemin);
+    rmdir(code->repertoire);
+}
+
+t_code_natif *t_code_natif_compiler(t_circuit *circuit)
+{
+    t_code_natif *code;
+    const t_netlist *netlist = t_circuit_get_netlist(circuit);
+    const char *compilateur = getenv("CC");
+    const char *repertoire_temporaire = getenv("TMPDIR");
+    char source[CODE_NATIF_CHEMIN_MAX + 16];
+    char bibliotheque[CODE_NATIF_CHEMIN_MAX + 16];
+    char commande[CODE_NATIF_COMMANDE_MAX];
+    FILE *fichier;
+    double debut;
+    int succes;
+
+    if(netlist == NULL)
+    {
+        printf("ERREUR DE COMPILATION: le circuit n'est pas valide\n");
+
+        return NULL;
+    }
+
+    if(netlist->nb_bascules > 0)
+    {
+        printf("ERREUR DE COMPILATION: circuit sequentiel (bascules) non supporte\n");
+
+        return NULL;
+    }
+
+    code = (t_code_natif*)calloc(1, sizeof(t_code_natif));
+
+    if(code == NULL)
+    {
+
+        return NULL;
+    }
+
+    code->nb_entrees = netlist->nb_entrees;
+    code->nb_sorties = netlist->nb_sorties;
+    code->nb_nets = netlist->nb_nets;
+    //Le code généré lit le tableau par vecteurs de CODE_NATIF_MOTS mots, qui doivent être alignés
+    code->travail = (uint64_t*)aligned_alloc(sizeof(uint64_t) * CODE_NATIF_MOTS,
+                                             sizeof(uint64_t) * CODE_NATIF_MOTS * (netlist->nb_nets + 1));
+    snprintf(code->repertoire, sizeof(code->repertoire), "%s/circuit_natif_XXXXXX",
+             repertoire_temporaire != NULL ? repertoire_temporaire : "/tmp");
+
+    if(code->travail == NULL || mkdtemp(code->repertoire) == NULL)
+    {
+        printf("ERREUR DE COMPILATION: impossible de creer le repertoire temporaire\n");
+        free(code->travail);
+        free(code);
+
+        return NULL;
+    }
+
+    snprintf(source, sizeof(source), "%s/circuit.c", code->repertoire);
+    snprintf(bibliotheque, sizeof(bibliotheque), "%s/circuit.so", code->repertoire);
+    fichier = fopen(source, "w");
+    succes = fichier != NULL && t_code_natif_generer_c(circuit, fichier);
+    succes = fichier != NULL && fclose(fichier) == 0 && succes;
+
+    if(succes)
+    {
+        snprintf(commande, sizeof(commande), "%s -std=c99 -O2 -shared -fPIC -o '%s' '%s'",
+                 compilateur != NULL ? compilateur : "cc", bibliotheque, source);
+        debut = t_code_natif_temps();
+        succes = system(commande) == 0;
+        code->duree_compilation = t_code_natif_temps() - debut;
+
+        if(succes == 0)
+        {
+            printf("ERREUR DE COMPILATION: echec de la commande: %s\n", commande);
+        }
+    }
+
+    if(succes)
+    {
+        code->bibliotheque = dlopen(bibliotheque, RTLD_NOW | RTLD_LOCAL);
+
+        if(code->bibliotheque != NULL)
+        {
+            *(void**)&code->evaluer = dlsym(code->bibliotheque, "circuit_evaluer");
+        }
+
+        if(code->evaluer == NULL)
+        {
+            printf("ERREUR DE COMPILATION: chargement impossible: %s\n", dlerror());
+            succes = 0;
+        }
+    }
+
+    if(succes == 0)
+    {
+        t_code_natif_destroy(code);
+
+        return NULL;
+    }
+
+
+    return code;
+}
+
+void t_code_natif_destroy(t_code_natif *code)
+{
+    if(code == NULL)
+    {
+
+        return;
+    }
+
+    if(code->bibliotheque != NULL)
+    {
+        dlclose(code->bibliotheque);
+    }
+
+    t_code_natif_nettoyer(code);
+    free(code->travail);
+    free(code);
+}
+
+#else
+
+t_code_natif *t_code_natif_compiler(t_circuit *circuit)
+{
+    (void)circuit;
+    printf("ERREUR DE COMPILATION: code natif non disponible sur ce systeme\n");
+
+    return NULL;
+}
+
+void t_code_natif_destroy(t_code_natif *code)
+{
+    free(code);
+}
+
+#endif
+
+void t_code_natif_simuler_lot(t_code_natif *code, const uint64_t entrees[], uint64_t sorties[], int nb_mots)
+{
+    code->evaluer(entrees, sorties, nb_mots, code->travail);
+}
@@ -0,0 +1,95 @@
+/*
+Module: T_CODE_NATIF
+Description: Compilation d'un circuit en code machine. Le circuit (sa netlist) est traduit en
+			 code C sans branchement: une instruction par porte, dans l'ordre des niveaux, sur des
+			 mots de 64 bits (64 vecteurs à la fois). Ce code est compilé par le compilateur du
+			 système (variable d'environnement CC, sinon "cc") en bibliothèque partagée, qui est
+			 ensuite chargée avec dlopen.
+
+			 Code généré: chaque porte devient une expression, par exemple n12 = ~(n3 & v[7] & n9)
+			 pour une porte NAND à trois entrées (une opération par entrée sur un vecteur de
+			 CODE_NATIF_MOTS mots avec GCC et Clang). Les portes sont regroupées en fonctions de CODE_NATIF_PORTES_PAR_FONCTION portes:
+			 dans une fonction, les nets sont des variables locales; seuls les nets lus par une autre
+			 fonction ou par une sortie sont rangés dans le tableau de travail v[nb_nets][CODE_NATIF_MOTS].
+			 Le compilateur du système coûte de l'ordre d'une milliseconde par porte (gcc -O2).
+
+			 Disponible sur les systèmes POSIX seulement (dlopen).
+*/
+
+#ifndef T_CODE_NATIF_H_
+#define T_CODE_NATIF_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include "t_circuit.h"
+
+#define CODE_NATIF_MOTS 4 //Nombre de mots évalués par chaque instruction du code généré
+#define CODE_NATIF_PORTES_PAR_FONCTION 200 //Nombre de portes par fonction du code généré
+#define CODE_NATIF_CHEMIN_MAX 256 //Taille maximale des chemins des fichiers temporaires
+
+typedef struct t_circuit t_circuit;
+
+/*
+Signature de la fonction générée: évalue nb_mots mots de chaque entrée (même disposition que
+t_circuit_simuler_lot). "v" est un tableau de travail de nb_nets * CODE_NATIF_MOTS mots.
+*/
+typedef void (*t_fonction_native)(const uint64_t *entrees, uint64_t *sorties, int nb_mots, uint64_t *v);
+
+struct t_code_natif {
+	void *bibliotheque; //Bibliothèque chargée par dlopen
+	t_fonction_native evaluer; //Fonction générée
+	int nb_entrees;
+	int nb_sorties;
+	int nb_nets;
+	uint64_t *travail; //Tableau de travail donné à la fonction générée
+	char repertoire[CODE_NATIF_CHEMIN_MAX]; //Répertoire temporaire du code source et de la bibliothèque
+	double duree_compilation; //Durée de la compilation par le compilateur du système, en secondes
+};
+
+typedef struct t_code_natif t_code_natif;
+
+/*
+Fonction: T_CODE_NATIF_GENERER_C
+Description: Écrit le code C qui évalue le circuit.
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+- fichier: Fichier ouvert en écriture.
+Retour: Booléen: Vrai si le code a été écrit, faux si le circuit ne peut pas être compilé en netlist
+		ou s'il contient des bascules (seuls les circuits combinatoires sont compilés).
+*/
+int t_code_natif_generer_c(t_circuit *circuit, FILE *fichier);
+
+/*
+Fonction: T_CODE_NATIF_COMPILER
+Description: Génère le code C du circuit, le compile en bibliothèque partagée et la charge.
+			 Le circuit peut être modifié ou détruit par la suite sans affecter le code compilé.
+Paramètres:
+- circuit: Pointeur vers le circuit à compiler.
+Retour: Pointeur vers le code compilé, NULL si le circuit est invalide ou séquentiel, si le compilateur du
+		système a échoué ou si la bibliothèque n'a pas pu être chargée (un message est affiché).
+*/
+t_code_natif *t_code_natif_compiler(t_circuit *circuit);
+
+/*
+Fonction: T_CODE_NATIF_DESTROY
+Description: Décharge la bibliothèque, supprime les fichiers temporaires et libère le code compilé.
+Paramètres:
+- code: Pointeur vers le code compilé.
+Retour: Aucun.
+*/
+void t_code_natif_destroy(t_code_natif *code);
+
+/*
+Fonction: T_CODE_NATIF_SIMULER_LOT
+Description: Simule un lot de vecteurs avec le code compilé (même disposition et même résultat
+			 que t_circuit_simuler_lot).
+Paramètres:
+- code: Pointeur vers le code compilé.
+- entrees: Mots des entrées: entrees[i * nb_mots + m] est le mot m de l'entrée i.
+- sorties: Tableau (nb_sorties * nb_mots mots) qui reçoit les mots des sorties.
+- nb_mots: Nombre de mots par entrée.
+Retour: Aucun.
+*/
+void t_code_natif_simuler_lot(t_code_natif *code, const uint64_t entrees[], uint64_t sorties[], int nb_mots);
+
+#endif
@@ -5,23 +5,28 @@
 #include "t_entree.h"
 
 t_entree *t_entree_init(int num)
+{
+
+    return t_entree_init_arene(NULL, num);
+}
+
+t_entree *t_entree_init_arene(t_arene *arene, int num)
 {
     t_entree * entree;
 
-    entree = (t_entree*)malloc(sizeof(t_entree));
+    entree = (t_entree*)t_arene_allouer(arene, sizeof(t_entree));
 
     if(entree == NULL)
     {
-        free(entree);
 
         return NULL;
     }
 
-    entree->nom = (char*) malloc(sizeof(char)*NOM_ENTREE_TAILLE_MAX);
+    entree->nom = (char*) t_arene_allouer(arene, sizeof(char)*(snprintf(NULL, 0, "E%i", num) + 1));
 
     if(entree->nom == NULL)
     {
-        free(entree);
+        t_arene_liberer(arene, entree);
 
         return NULL;
     }
@@ -31,16 +36,18 @@ t_entree *t_entree_init(int num)
 
     sprintf(entree->nom,"E%i",num);
 
-    entree->pin = t_pin_sortie_init();
+    entree->pin = t_pin_sortie_init_arene(arene);
 
      if(entree->pin == NULL)
      {
-         free(entree->nom);
-         free(entree);
+         t_arene_liberer(arene, entree->nom);
+         t_arene_liberer(arene, entree);
 
          return NULL;
      }
 
+    entree->pin->entree = entree;
+
     return entree;
 }
 
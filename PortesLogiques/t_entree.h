@@ -9,6 +9,7 @@ Dernière modification: 2018-03-19
 #ifndef ENTREE_H_
 #define ENTREE_H_
 
+#include "t_arene.h"
 #include "t_pin_sortie.h"
 
 #define NOM_ENTREE_TAILLE_MAX 10 //Taille maximale du nom
@@ -42,6 +43,18 @@ Paramètres modifié: Aucun.
 */
 t_entree *t_entree_init(int num);
 
+/*
+Fonction: T_ENTREE_INIT_ARENE
+Description: Crée une nouvelle entrée de circuit dans une arène (voir t_arene.h). Une entrée
+			 créée dans une arène est libérée avec l'arène et ne doit pas être passée à
+			 t_entree_destroy.
+Paramètres:
+- arene: Arène dans laquelle l'entrée est créée (NULL: même effet que t_entree_init).
+- num: Voir t_entree_init.
+Retour: Pointeur vers l'entrée de circuit créée (NULL si la mémoire manque)
+*/
+t_entree *t_entree_init_arene(t_arene *arene, int num);
+
 /*
 Fonction: T_ENTREE_DESTROY
 Description: Libère la mémoire occupée par l'entrée et tous ses composants (i.e. la pin).
@@ -0,0 +1,303 @@
+//
+// Vérification de l'équivalence de deux circuits (voir t_equivalence.h).
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "t_equivalence.h"
+
+//Générateur pseudo-aléatoire (xorshift64*) des vecteurs simulés
+static uint64_t t_equivalence_aleatoire(uint64_t *etat)
+{
+    *etat ^= *etat >> 12;
+    *etat ^= *etat << 25;
+    *etat ^= *etat >> 27;
+
+
+    return *etat * 0x2545F4914F6CDD1Dull;
+}
+
+/*
+Cherche dans un lot simulé (sorties du premier circuit puis du second) un vecteur pour lequel
+une paire de sorties diffère. Retourne l'indice de la sortie (-1 si aucune) et place le vecteur
+dans vecteur.
+*/
+static int t_equivalence_comparer_lot(const t_aig *aig, int nb_sorties, const uint64_t entrees[],
+                                      const uint64_t sorties[], int nb_mots, int vecteur[])
+{
+    uint64_t difference;
+    int bit;
+
+    for(int j = 0;j<nb_sorties;j++)
+    {
+        for(int m = 0;m<nb_mots;m++)
+        {
+            difference = sorties[j * nb_mots + m] ^ sorties[(nb_sorties + j) * nb_mots + m];
+
+            if(difference != 0)
+            {
+                bit = 0;
+
+                while(((difference >> bit) & 1) == 0)
+                {
+                    bit++;
+                }
+
+                for(int i = 0;i<aig->nb_entrees;i++)
+                {
+                    vecteur[i] = (int)((entrees[i * nb_mots + m] >> bit) & 1);
+                }
+
+                return j;
+            }
+        }
+    }
+
+
+    return -1;
+}
+
+//Ajoute les clauses de Tseitin du noeud ET de variable v (v = a ET b) avec les variables renumérotées
+static void t_equivalence_clauses_et(t_sat *sat, const int numeros[], int v, uint32_t a, uint32_t b)
+{
+    int sortie = SAT_LITTERAL(numeros[v], 0);
+    int litteral_a = SAT_LITTERAL(numeros[AIG_VARIABLE(a)], AIG_EST_INVERSE(a));
+    int litteral_b = SAT_LITTERAL(numeros[AIG_VARIABLE(b)], AIG_EST_INVERSE(b));
+    int clause[3];
+
+    //v implique a, v implique b, a et b impliquent v
+    clause[0] = sortie ^ 1;
+    clause[1] = litteral_a;
+    t_sat_ajouter_clause(sat, clause, 2);
+    clause[0] = sortie ^ 1;
+    clause[1] = litteral_b;
+    t_sat_ajouter_clause(sat, clause, 2);
+    clause[0] = sortie;
+    clause[1] = litteral_a ^ 1;
+    clause[2] = litteral_b ^ 1;
+    t_sat_ajouter_clause(sat, clause, 3);
+}
+
+/*
+Construit et résout la CNF du miter des paires de sorties de littéraux différents. Seules les
+variables dont ces sorties dépendent (le cône) sont numérotées dans le solveur. Retourne
+EQUIVALENTS, DIFFERENTS (vecteur reçoit le contre-exemple) ou EQUIVALENCE_INCONNUE.
+*/
+static int t_equivalence_resoudre(const t_aig *aig, int nb_sorties, t_rapport_equivalence *rapport, int vecteur[])
+{
+    int premier_et = aig->nb_variables - aig->nb_et;
+    int *numeros = (int*)malloc(sizeof(int) * aig->nb_variables);
+    int *miter = (int*)malloc(sizeof(int) * (nb_sorties + 1));
+    unsigned char *cone = (unsigned char*)calloc(aig->nb_variables, sizeof(unsigned char));
+    uint32_t sortie_a;
+    uint32_t sortie_b;
+    t_sat *sat = NULL;
+    int nb_numeros = 0;
+    int nb_paires = 0;
+    int clause[3];
+    int resultat = EQUIVALENCE_INCONNUE;
+
+    if(numeros != NULL && miter != NULL && cone != NULL)
+    {
+        //La constante fait toujours partie du cône: une sortie peut valoir 0 ou 1
+        cone[0] = 1;
+
+        for(int j = 0;j<nb_sorties;j++)
+        {
+            if(aig->sorties[j] != aig->sorties[nb_sorties + j])
+            {
+                cone[AIG_VARIABLE(aig->sorties[j])] = 1;
+                cone[AIG_VARIABLE(aig->sorties[nb_sorties + j])] = 1;
+                nb_paires++;
+            }
+        }
+
+        //Les opérandes d'un noeud ET sont des variables plus petites: un seul parcours à rebours suffit
+        for(int v = aig->nb_variables - 1;v>=premier_et;v--)
+        {
+            if(cone[v])
+            {
+                cone[AIG_VARIABLE(aig->operandes[2 * (v - premier_et)])] = 1;
+                cone[AIG_VARIABLE(aig->operandes[2 * (v - premier_et) + 1])] = 1;
+            }
+        }
+
+        for(int v = 0;v<aig->nb_variables;v++)
+        {
+            numeros[v] = cone[v] ? nb_numeros++ : -1;
+        }
+
+        sat = t_sat_init(nb_numeros + nb_paires);
+    }
+
+    if(sat != NULL)
+    {
+        clause[0] = SAT_LITTERAL(numeros[0], 1);
+        t_sat_ajouter_clause(sat, clause, 1);
+
+        for(int v = premier_et;v<aig->nb_variables;v++)
+        {
+            if(cone[v])
+            {
+                t_equivalence_clauses_et(sat, numeros, v, aig->operandes[2 * (v - premier_et)],
+                                         aig->operandes[2 * (v - premier_et) + 1]);
+            }
+        }
+
+        //La variable d de chaque paire implique que les deux sorties diffèrent; une des variables
+        //d doit être vraie
+        nb_paires = 0;
+
+        for(int j = 0;j<nb_sorties;j++)
+        {
+            sortie_a = aig->sorties[j];
+            sortie_b = aig->sorties[nb_sorties + j];
+
+            if(sortie_a != sortie_b)
+            {
+                miter[nb_paires] = SAT_LITTERAL(nb_numeros + nb_paires, 0);
+                clause[0] = miter[nb_paires] ^ 1;
+                clause[1] = SAT_LITTERAL(numeros[AIG_VARIABLE(sortie_a)], AIG_EST_INVERSE(sortie_a));
+                clause[2] = SAT_LITTERAL(numeros[AIG_VARIABLE(sortie_b)], AIG_EST_INVERSE(sortie_b));
+                t_sat_ajouter_clause(sat, clause, 3);
+                clause[0] = miter[nb_paires] ^ 1;
+                clause[1] = SAT_LITTERAL(numeros[AIG_VARIABLE(sortie_a)], AIG_EST_INVERSE(sortie_a)) ^ 1;
+                clause[2] = SAT_LITTERAL(numeros[AIG_VARIABLE(sortie_b)], AIG_EST_INVERSE(sortie_b)) ^ 1;
+                t_sat_ajouter_clause(sat, clause, 3);
+                nb_paires++;
+            }
+        }
+
+        t_sat_ajouter_clause(sat, miter, nb_paires);
+        rapport->nb_variables = sat->nb_variables;
+        rapport->nb_clauses = sat->nb_clauses;
+
+        switch(t_sat_resoudre(sat, EQUIVALENCE_MAX_CONFLITS))
+        {
+            case SAT_SATISFIABLE:
+                //Une entrée hors du cône n'influence aucune sortie comparée
+                for(int i = 0;i<aig->nb_entrees;i++)
+                {
+                    vecteur[i] = cone[1 + i] ? t_sat_valeur(sat, numeros[1 + i]) : 0;
+                }
+
+                resultat = DIFFERENTS;
+                break;
+            case SAT_INSATISFIABLE:
+                resultat = EQUIVALENTS;
+                break;
+            default:
+                resultat = EQUIVALENCE_INCONNUE;
+        }
+
+        rapport->nb_conflits = sat->nb_conflits;
+        rapport->nb_decisions = sat->nb_decisions;
+        t_sat_destroy(sat);
+    }
+
+    free(numeros);
+    free(miter);
+    free(cone);
+
+
+    return resultat;
+}
+
+int t_equivalence_verifier(t_circuit *circuit_a, t_circuit *circuit_b, int contre_exemple[],
+                           t_rapport_equivalence *rapport)
+{
+    t_rapport_equivalence rapport_local;
+    t_aig *aig;
+    uint64_t *entrees;
+    uint64_t *sorties;
+    int *vecteur;
+    uint64_t etat_aleatoire = 0x9E3779B97F4A7C15ull;
+    int nb_sorties = circuit_a->nb_sorties;
+    int resultat = EQUIVALENCE_INCONNUE;
+
+    if(rapport == NULL)
+    {
+        rapport = &rapport_local;
+    }
+
+    memset(rapport, 0, sizeof(t_rapport_equivalence));
+    rapport->sortie = -1;
+
+    if(circuit_a->nb_entrees != circuit_b->nb_entrees || circuit_a->nb_sorties != circuit_b->nb_sorties)
+    {
+
+        return EQUIVALENCE_INCONNUE;
+    }
+
+    aig = t_aig_compiler_paire(circuit_a, circuit_b);
+
+    if(aig == NULL)
+    {
+
+        return EQUIVALENCE_INCONNUE;
+    }
+
+    rapport->nb_noeuds_et = aig->nb_et;
+    entrees = (uint64_t*)malloc(sizeof(uint64_t) * (aig->nb_entrees + 1) * EQUIVALENCE_MOTS_SIMULATION);
+    sorties = (uint64_t*)malloc(sizeof(uint64_t) * (2 * nb_sorties + 1) * EQUIVALENCE_MOTS_SIMULATION);
+    vecteur = (int*)malloc(sizeof(int) * (aig->nb_entrees + 1));
+
+    if(aig->nb_bascules == 0 && entrees != NULL && sorties != NULL && vecteur != NULL)
+    {
+        for(int j = 0;j<nb_sorties;j++)
+        {
+            rapport->nb_sorties_fusionnees += aig->sorties[j] == aig->sorties[nb_sorties + j];
+        }
+
+        resultat = rapport->nb_sorties_fusionnees == nb_sorties ? EQUIVALENTS : EQUIVALENCE_INCONNUE;
+
+        //Simulation aléatoire: une différence fréquente est trouvée sans solveur
+        for(int l = 0;l<EQUIVALENCE_LOTS_SIMULATION && resultat == EQUIVALENCE_INCONNUE;l++)
+        {
+            for(int i = 0;i<aig->nb_entrees * EQUIVALENCE_MOTS_SIMULATION;i++)
+            {
+                entrees[i] = t_equivalence_aleatoire(&etat_aleatoire);
+            }
+
+            t_aig_simuler_lot(aig, entrees, sorties, EQUIVALENCE_MOTS_SIMULATION);
+            rapport->nb_vecteurs_simules += 64 * EQUIVALENCE_MOTS_SIMULATION;
+            rapport->sortie = t_equivalence_comparer_lot(aig, nb_sorties, entrees, sorties, EQUIVALENCE_MOTS_SIMULATION, vecteur);
+
+            if(rapport->sortie != -1)
+            {
+                rapport->trouve_par_simulation = 1;
+                resultat = DIFFERENTS;
+            }
+        }
+
+        if(resultat == EQUIVALENCE_INCONNUE)
+        {
+            resultat = t_equivalence_resoudre(aig, nb_sorties, rapport, vecteur);
+        }
+
+        //Sortie qui diffère pour le contre-exemple du solveur: le vecteur est simulé sur un mot
+        if(resultat == DIFFERENTS && rapport->sortie == -1)
+        {
+            for(int i = 0;i<aig->nb_entrees;i++)
+            {
+                entrees[i] = vecteur[i] ? ~0ull : 0;
+            }
+
+            t_aig_simuler_lot(aig, entrees, sorties, 1);
+            rapport->sortie = t_equivalence_comparer_lot(aig, nb_sorties, entrees, sorties, 1, vecteur);
+        }
+
+        if(resultat == DIFFERENTS && contre_exemple != NULL)
+        {
+            memcpy(contre_exemple, vecteur, sizeof(int) * aig->nb_entrees);
+        }
+    }
+
+    t_aig_destroy(aig);
+    free(entrees);
+    free(sorties);
+    free(vecteur);
+
+
+    return resultat;
+}
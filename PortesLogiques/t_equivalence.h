@@ -0,0 +1,71 @@
+/*
+Module: T_EQUIVALENCE
+Description: Vérification de l'équivalence combinatoire de deux circuits (par exemple un circuit
+			 et sa version optimisée): les deux circuits donnent-ils les mêmes sorties pour tous
+			 les vecteurs d'entrée? L'énumération des 2^n vecteurs est impossible au-delà d'une
+			 trentaine d'entrées; la vérification procède par étapes:
+			 1. les deux circuits sont traduits dans un même graphe ET-inverseur dont ils partagent
+				les entrées (t_aig_compiler_paire). Le hachage structurel fusionne la logique
+				commune: deux sorties de même littéral sont équivalentes sans autre calcul;
+			 2. des vecteurs aléatoires sont simulés 64 à la fois: une différence facile à trouver
+				l'est sans solveur;
+			 3. pour les sorties restantes, le miter (OU des XOR des paires de sorties) est traduit
+				en CNF par la transformation de Tseitin (trois clauses par noeud ET, seulement pour
+				les noeuds dont ces sorties dépendent) puis résolu par le solveur CDCL (t_sat). Si
+				le miter est satisfiable, l'affectation des entrées est un contre-exemple.
+
+			 Les circuits doivent avoir le même nombre d'entrées et de sorties (l'entrée i et la
+			 sortie j de l'un correspondent à l'entrée i et à la sortie j de l'autre) et ne pas
+			 contenir de bascule.
+*/
+
+#ifndef T_EQUIVALENCE_H_
+#define T_EQUIVALENCE_H_
+
+#include "t_circuit.h"
+#include "t_aig.h"
+#include "t_sat.h"
+
+#define EQUIVALENTS 1 //Retour de t_equivalence_verifier: les circuits sont équivalents
+#define DIFFERENTS 0 //Retour de t_equivalence_verifier: un contre-exemple a été trouvé
+#define EQUIVALENCE_INCONNUE -1 //Retour de t_equivalence_verifier: aucune conclusion (voir la fonction)
+#define EQUIVALENCE_MOTS_SIMULATION 16 //Mots de 64 vecteurs aléatoires par lot simulé
+#define EQUIVALENCE_LOTS_SIMULATION 8 //Nombre de lots de vecteurs aléatoires
+#define EQUIVALENCE_MAX_CONFLITS 2000000 //Limite de conflits du solveur
+
+typedef struct t_circuit t_circuit;
+
+/*
+Déroulement d'une vérification: ce que chaque étape a établi et le travail du solveur.
+*/
+struct t_rapport_equivalence {
+	int nb_noeuds_et; //Taille du graphe ET-inverseur commun aux deux circuits
+	int nb_sorties_fusionnees; //Paires de sorties de même littéral (équivalentes par hachage)
+	long long nb_vecteurs_simules; //Vecteurs aléatoires simulés
+	int trouve_par_simulation; //Booléen: vrai si le contre-exemple vient de la simulation
+	int nb_variables; //Variables de la CNF (0 si le solveur n'a pas été utilisé)
+	int nb_clauses; //Clauses de la CNF
+	long long nb_conflits; //Conflits du solveur
+	long long nb_decisions; //Décisions du solveur
+	int sortie; //Indice d'une sortie qui diffère (-1 si aucune)
+};
+
+typedef struct t_rapport_equivalence t_rapport_equivalence;
+
+/*
+Fonction: T_EQUIVALENCE_VERIFIER
+Description: Vérifie si deux circuits sont équivalents (voir la description du module).
+Paramètres:
+- circuit_a: Pointeur vers le premier circuit.
+- circuit_b: Pointeur vers le second circuit.
+- contre_exemple: Tableau (nb_entrees éléments) qui reçoit un vecteur d'entrée (valeurs 0 ou 1)
+				  pour lequel une sortie diffère, si les circuits sont différents. Peut être NULL.
+- rapport: Rapport rempli par la vérification (NULL si aucun rapport n'est voulu).
+Retour: EQUIVALENTS, DIFFERENTS ou EQUIVALENCE_INCONNUE si les interfaces diffèrent, si un
+		circuit est invalide ou contient une bascule, si le solveur atteint sa limite de
+		conflits ou si la mémoire manque.
+*/
+int t_equivalence_verifier(t_circuit *circuit_a, t_circuit *circuit_b, int contre_exemple[],
+                           t_rapport_equivalence *rapport);
+
+#endif
@@ -0,0 +1,472 @@
+//
+// Simulation des fautes de collage (voir t_fautes.h).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "t_fautes.h"
+#include "t_netlist.h"
+
+//Ajoute les deux fautes de collage d'un tronc ou d'une branche
+static void t_fautes_ajouter(t_fautes *fautes, int net, int lecteur, int entree)
+{
+    t_faute *faute;
+
+    for(int valeur = 0;valeur<2;valeur++)
+    {
+        faute = &fautes->fautes[fautes->nb_fautes];
+        faute->net = net;
+        faute->lecteur = lecteur;
+        faute->entree = entree;
+        faute->valeur = valeur;
+        faute->vecteur = -1;
+        fautes->restantes[fautes->nb_fautes] = fautes->nb_fautes;
+        fautes->nb_fautes++;
+    }
+
+    fautes->nb_restantes = fautes->nb_fautes;
+}
+
+//Énumère les fautes: les troncs de tous les nets, puis les branches des nets lus plusieurs fois
+static int t_fautes_enumerer(t_fautes *fautes)
+{
+    const t_netlist *netlist = fautes->netlist;
+    int nb_pins = netlist->debut_entrees[netlist->nb_portes];
+    int *lectures = (int*)calloc(netlist->nb_nets, sizeof(int));
+
+    fautes->fautes = (t_faute*)malloc(sizeof(t_faute) * 2 * (netlist->nb_nets + nb_pins + netlist->nb_sorties));
+    fautes->restantes = (int*)malloc(sizeof(int) * 2 * (netlist->nb_nets + nb_pins + netlist->nb_sorties));
+
+    if(lectures == NULL || fautes->fautes == NULL || fautes->restantes == NULL)
+    {
+        free(lectures);
+
+        return 0;
+    }
+
+    for(int i = 0;i<nb_pins;i++)
+    {
+        lectures[netlist->entrees[i]]++;
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        lectures[netlist->sorties[j]]++;
+    }
+
+    for(int n = 0;n<netlist->nb_nets;n++)
+    {
+        t_fautes_ajouter(fautes, n, -1, 0);
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        for(int i = netlist->debut_entrees[k];i<netlist->debut_entrees[k + 1];i++)
+        {
+            if(lectures[netlist->entrees[i]] > 1)
+            {
+                t_fautes_ajouter(fautes, netlist->entrees[i], k, i - netlist->debut_entrees[k]);
+            }
+        }
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        if(lectures[netlist->sorties[j]] > 1)
+        {
+            t_fautes_ajouter(fautes, netlist->sorties[j], netlist->nb_portes + j, 0);
+        }
+    }
+
+    free(lectures);
+
+
+    return 1;
+}
+
+t_fautes *t_fautes_init(t_circuit *circuit)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    t_fautes *fautes;
+    size_t nb_valeurs;
+    int max_entrees = 1;
+
+    if(netlist == NULL)
+    {
+
+        return NULL;
+    }
+
+    fautes = (t_fautes*)calloc(1, sizeof(t_fautes));
+
+    if(fautes == NULL)
+    {
+
+        return NULL;
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        if(netlist->debut_entrees[k + 1] - netlist->debut_entrees[k] > max_entrees)
+        {
+            max_entrees = netlist->debut_entrees[k + 1] - netlist->debut_entrees[k];
+        }
+    }
+
+    nb_valeurs = (size_t)(netlist->nb_nets + 1) * FAUTES_MOTS_BLOC;
+    fautes->netlist = netlist;
+    fautes->nb_entrees = netlist->nb_entrees + netlist->nb_bascules;
+    fautes->observes = (unsigned char*)calloc(netlist->nb_nets, sizeof(unsigned char));
+    fautes->bons = (uint64_t*)calloc(nb_valeurs, sizeof(uint64_t));
+    fautes->fautifs = (uint64_t*)calloc(nb_valeurs, sizeof(uint64_t));
+    fautes->modifies = (int*)malloc(sizeof(int) * (netlist->nb_nets + 1));
+    fautes->file_evenements = (int*)malloc(sizeof(int) * (netlist->nb_portes + 1));
+    fautes->nb_evenements = (int*)calloc(netlist->nb_niveaux + 1, sizeof(int));
+    fautes->en_file = (unsigned char*)calloc(netlist->nb_portes + 1, sizeof(unsigned char));
+    fautes->signaux = (int*)malloc(sizeof(int) * max_entrees);
+    fautes->etat_aleatoire = 0x9E3779B97F4A7C15ull;
+
+    if(fautes->observes == NULL || fautes->bons == NULL || fautes->fautifs == NULL || fautes->modifies == NULL ||
+       fautes->file_evenements == NULL || fautes->nb_evenements == NULL || fautes->en_file == NULL ||
+       fautes->signaux == NULL || t_fautes_enumerer(fautes) == 0)
+    {
+        t_fautes_destroy(fautes);
+
+        return NULL;
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        fautes->observes[netlist->sorties[j]] = 1;
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        fautes->observes[netlist->entrees[netlist->debut_entrees[netlist->bascules[b]]]] = 1;
+    }
+
+
+    return fautes;
+}
+
+void t_fautes_destroy(t_fautes *fautes)
+{
+    free(fautes->fautes);
+    free(fautes->restantes);
+    free(fautes->observes);
+    free(fautes->bons);
+    free(fautes->fautifs);
+    free(fautes->modifies);
+    free(fautes->file_evenements);
+    free(fautes->nb_evenements);
+    free(fautes->en_file);
+    free(fautes->signaux);
+    free(fautes);
+}
+
+//Ajoute à la file d'événements les portes alimentées par le net (si elles n'y sont pas déjà).
+//Retourne le nombre de portes ajoutées.
+static int t_fautes_planifier_fanout(t_fautes *fautes, int net)
+{
+    const t_netlist *netlist = fautes->netlist;
+    int porte;
+    int niveau;
+    int nb = 0;
+
+    for(int i = netlist->debut_fanout[net];i<netlist->debut_fanout[net + 1];i++)
+    {
+        porte = netlist->fanout[i];
+
+        if(fautes->en_file[porte] == 0)
+        {
+            niveau = netlist->niveaux[porte];
+            fautes->file_evenements[netlist->debut_niveaux[niveau] + fautes->nb_evenements[niveau]] = porte;
+            fautes->nb_evenements[niveau]++;
+            fautes->en_file[porte] = 1;
+            nb++;
+        }
+    }
+
+
+    return nb;
+}
+
+//Compare la valeur fautive d'un net à sa bonne valeur. Si elles diffèrent, le net est noté à
+//restaurer; retourne les bits qui diffèrent (pour les vecteurs valides) du premier mot qui diffère.
+static uint64_t t_fautes_comparer(t_fautes *fautes, int net, int nb_mots, const uint64_t masques[], int *mot)
+{
+    const uint64_t *bon = &fautes->bons[(size_t)net * nb_mots];
+    const uint64_t *fautif = &fautes->fautifs[(size_t)net * nb_mots];
+    uint64_t difference;
+
+    for(int m = 0;m<nb_mots;m++)
+    {
+        difference = (bon[m] ^ fautif[m]) & masques[m];
+
+        if(difference != 0)
+        {
+            fautes->modifies[fautes->nb_modifies++] = net;
+            *mot = m;
+
+            return difference;
+        }
+    }
+
+
+    return 0;
+}
+
+/*
+Simule une faute sur le bloc de vecteurs dont les bonnes valeurs sont dans bons. Retourne le rang
+dans le bloc d'un vecteur qui détecte la faute (à la première sortie qui diffère), -1 si aucun
+ne la détecte.
+*/
+static int t_fautes_propager(t_fautes *fautes, const t_faute *faute, int nb_mots, const uint64_t masques[])
+{
+    const t_netlist *netlist = fautes->netlist;
+    uint64_t colle = faute->valeur ? ~0ull : 0;
+    uint64_t *fautifs = fautes->fautifs;
+    uint64_t difference;
+    uint64_t detection = 0;
+    int mot_detection = 0;
+    int mot;
+    int net = faute->net;
+    int porte = faute->lecteur;
+    int branche_observee;
+    int en_attente = 0;
+    int niveau;
+    int bit;
+
+    fautes->nb_modifies = 0;
+
+    //Une branche lue par une sortie du circuit ou par une bascule est observée directement
+    branche_observee = porte >= netlist->nb_portes || (porte >= 0 && netlist->types[porte] == PORTE_DFF);
+
+    //Injection: la porte dont une entrée est collée est évaluée avec la valeur collée, sinon le
+    //net reçoit la valeur collée
+    if(porte >= 0 && branche_observee == 0)
+    {
+        memcpy(fautes->signaux, &netlist->entrees[netlist->debut_entrees[porte]],
+               sizeof(int) * (netlist->debut_entrees[porte + 1] - netlist->debut_entrees[porte]));
+        fautes->signaux[faute->entree] = netlist->nb_nets;
+        net = netlist->nb_entrees + porte;
+
+        for(int m = 0;m<nb_mots;m++)
+        {
+            fautifs[(size_t)netlist->nb_nets * nb_mots + m] = colle;
+        }
+
+        t_porte_calculer_mots((e_types_portes)netlist->types[porte], fautifs, fautes->signaux,
+                              netlist->debut_entrees[porte + 1] - netlist->debut_entrees[porte],
+                              &fautifs[(size_t)net * nb_mots], nb_mots);
+        fautes->nb_evaluations++;
+    }
+    else
+    {
+        for(int m = 0;m<nb_mots;m++)
+        {
+            fautifs[(size_t)net * nb_mots + m] = colle;
+        }
+    }
+
+    difference = t_fautes_comparer(fautes, net, nb_mots, masques, &mot);
+
+    if(difference == 0)
+    {
+        memcpy(&fautifs[(size_t)net * nb_mots], &fautes->bons[(size_t)net * nb_mots], sizeof(uint64_t) * nb_mots);
+    }
+    else if(branche_observee || fautes->observes[net])
+    {
+        detection = difference;
+        mot_detection = mot;
+    }
+    else
+    {
+        en_attente = t_fautes_planifier_fanout(fautes, net);
+    }
+
+    //Propagation niveau par niveau jusqu'à la détection ou l'extinction des événements
+    for(niveau = 0;niveau<netlist->nb_niveaux && en_attente > 0;niveau++)
+    {
+        for(int e = 0;e<fautes->nb_evenements[niveau];e++)
+        {
+            porte = fautes->file_evenements[netlist->debut_niveaux[niveau] + e];
+            fautes->en_file[porte] = 0;
+            en_attente--;
+
+            if(detection != 0)
+            {
+                continue;
+            }
+
+            net = netlist->nb_entrees + porte;
+            t_porte_calculer_mots((e_types_portes)netlist->types[porte], fautifs,
+                                  &netlist->entrees[netlist->debut_entrees[porte]],
+                                  netlist->debut_entrees[porte + 1] - netlist->debut_entrees[porte],
+                                  &fautifs[(size_t)net * nb_mots], nb_mots);
+            fautes->nb_evaluations++;
+            difference = t_fautes_comparer(fautes, net, nb_mots, masques, &mot);
+
+            if(difference != 0)
+            {
+                if(fautes->observes[net])
+                {
+                    detection = difference;
+                    mot_detection = mot;
+                }
+
+                en_attente += t_fautes_planifier_fanout(fautes, net);
+            }
+            else
+            {
+                //Seuls les bits des vecteurs valides sont comparés: le mot est remis à sa bonne valeur
+                memcpy(&fautifs[(size_t)net * nb_mots], &fautes->bons[(size_t)net * nb_mots], sizeof(uint64_t) * nb_mots);
+            }
+        }
+
+        fautes->nb_evenements[niveau] = 0;
+    }
+
+    //La valeur fautive de chaque net modifié redevient sa bonne valeur pour la faute suivante
+    for(int i = 0;i<fautes->nb_modifies;i++)
+    {
+        memcpy(&fautifs[(size_t)fautes->modifies[i] * nb_mots], &fautes->bons[(size_t)fautes->modifies[i] * nb_mots],
+               sizeof(uint64_t) * nb_mots);
+    }
+
+    if(detection == 0)
+    {
+
+        return -1;
+    }
+
+    bit = 0;
+
+    while(((detection >> bit) & 1) == 0)
+    {
+        bit++;
+    }
+
+
+    return 64 * mot_detection + bit;
+}
+
+int t_fautes_simuler_lot(t_fautes *fautes, const uint64_t entrees[], int nb_vecteurs)
+{
+    const t_netlist *netlist = fautes->netlist;
+    uint64_t masques[FAUTES_MOTS_BLOC];
+    int nb_mots_lot = (nb_vecteurs + 63) / 64;
+    int nb_mots;
+    int nb_detectees = 0;
+    int nb_restantes;
+    int vecteur;
+    int net;
+
+    for(int premier = 0;premier<nb_mots_lot && fautes->nb_restantes > 0;premier += FAUTES_MOTS_BLOC)
+    {
+        nb_mots = nb_mots_lot - premier < FAUTES_MOTS_BLOC ? nb_mots_lot - premier : FAUTES_MOTS_BLOC;
+
+        //Simulation sans faute du bloc; les vecteurs au-delà du dernier ne sont pas comparés
+        for(int i = 0;i<fautes->nb_entrees;i++)
+        {
+            net = i < netlist->nb_entrees ? i : netlist->nb_entrees + netlist->bascules[i - netlist->nb_entrees];
+            memcpy(&fautes->bons[(size_t)net * nb_mots], &entrees[(size_t)i * nb_mots_lot + premier], sizeof(uint64_t) * nb_mots);
+        }
+
+        for(int m = 0;m<nb_mots;m++)
+        {
+            vecteur = 64 * (premier + m);
+            masques[m] = nb_vecteurs - vecteur >= 64 ? ~0ull : (1ull << (nb_vecteurs - vecteur)) - 1;
+        }
+
+        t_netlist_evaluer(netlist, fautes->bons, nb_mots);
+        memcpy(fautes->fautifs, fautes->bons, sizeof(uint64_t) * netlist->nb_nets * nb_mots);
+
+        //Chaque faute restante est simulée seule; les fautes détectées sont retirées de la liste
+        nb_restantes = 0;
+
+        for(int f = 0;f<fautes->nb_restantes;f++)
+        {
+            vecteur = t_fautes_propager(fautes, &fautes->fautes[fautes->restantes[f]], nb_mots, masques);
+
+            if(vecteur >= 0)
+            {
+                fautes->fautes[fautes->restantes[f]].vecteur = fautes->nb_vecteurs + 64 * premier + vecteur;
+                nb_detectees++;
+            }
+            else
+            {
+                fautes->restantes[nb_restantes++] = fautes->restantes[f];
+            }
+        }
+
+        fautes->nb_restantes = nb_restantes;
+    }
+
+    fautes->nb_vecteurs += nb_vecteurs;
+    fautes->nb_detectees += nb_detectees;
+
+
+    return nb_detectees;
+}
+
+//Générateur pseudo-aléatoire (xorshift64*) des vecteurs de test
+static uint64_t t_fautes_aleatoire(uint64_t *etat)
+{
+    *etat ^= *etat >> 12;
+    *etat ^= *etat << 25;
+    *etat ^= *etat >> 27;
+
+
+    return *etat * 0x2545F4914F6CDD1Dull;
+}
+
+int t_fautes_simuler_aleatoire(t_fautes *fautes, long long nb_vecteurs)
+{
+    uint64_t *entrees = (uint64_t*)malloc(sizeof(uint64_t) * (fautes->nb_entrees + 1) * FAUTES_MOTS_BLOC);
+    int nb_detectees = 0;
+    int nb_bloc;
+
+    if(entrees == NULL)
+    {
+
+        return -1;
+    }
+
+    for(long long v = 0;v<nb_vecteurs && fautes->nb_restantes > 0;v += nb_bloc)
+    {
+        nb_bloc = nb_vecteurs - v < 64 * FAUTES_MOTS_BLOC ? (int)(nb_vecteurs - v) : 64 * FAUTES_MOTS_BLOC;
+
+        for(int i = 0;i<fautes->nb_entrees * ((nb_bloc + 63) / 64);i++)
+        {
+            entrees[i] = t_fautes_aleatoire(&fautes->etat_aleatoire);
+        }
+
+        nb_detectees += t_fautes_simuler_lot(fautes, entrees, nb_bloc);
+    }
+
+    free(entrees);
+
+
+    return nb_detectees;
+}
+
+double t_fautes_couverture(const t_fautes *fautes)
+{
+    if(fautes->nb_fautes == 0)
+    {
+
+        return 1.0;
+    }
+
+
+    return (double)fautes->nb_detectees / fautes->nb_fautes;
+}
+
+void t_fautes_afficher_rapport(const t_fautes *fautes)
+{
+    printf("Fautes: %i, detectees: %i, couverture: %.2f %%\n", fautes->nb_fautes, fautes->nb_detectees,
+           100.0 * t_fautes_couverture(fautes));
+    printf("Vecteurs simules: %lld, portes evaluees avec une faute: %lld\n", fautes->nb_vecteurs, fautes->nb_evaluations);
+}
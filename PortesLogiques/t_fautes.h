@@ -0,0 +1,149 @@
+/*
+Module: T_FAUTES
+Description: Définit le type t_fautes, un simulateur de fautes de collage (stuck-at) qui mesure la
+			 couverture d'une suite de vecteurs de test: la proportion des fautes qu'elle détecte.
+
+			 Fautes: chaque net (entrée du circuit, bascule ou sortie de porte) peut être collé à 0
+			 ou à 1 (faute sur le tronc: toutes ses lectures voient la valeur collée). Chaque pin
+			 d'entrée de porte et chaque sortie du circuit peut aussi être collée seule (faute sur
+			 une branche). Une branche d'un net qui n'est lu qu'une fois est équivalente au tronc:
+			 ses fautes ne sont pas énumérées.
+
+			 Simulation (parallel-pattern single-fault propagation): un bloc de vecteurs est d'abord
+			 simulé sans faute, 64 vecteurs par mot. Chaque faute non encore détectée est ensuite
+			 injectée seule; seules les portes dont une entrée diffère du circuit sans faute sont
+			 ré-évaluées (file d'événements triée par niveau, comme t_netlist_simuler_increment), et
+			 la propagation s'arrête dès qu'une sortie diffère. Une faute détectée est retirée de la
+			 liste (fault dropping): les blocs suivants ne la simulent plus.
+
+			 Bascules (balayage complet, full scan): l'état de chaque bascule est une pseudo-entrée
+			 donnée avec les vecteurs, et son entrée est une pseudo-sortie observée comme les sorties
+			 du circuit.
+
+			 Le simulateur utilise la netlist du circuit (t_circuit_get_netlist): le circuit ne doit
+			 pas être modifié tant que le simulateur existe. Les autres circuits peuvent l'être: la
+			 netlist n'est recompilée que si son propre circuit change (voir revision_liens).
+*/
+
+#ifndef T_FAUTES_H_
+#define T_FAUTES_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+
+#define FAUTES_MOTS_BLOC 4 //Nombre de mots (de 64 vecteurs) simulés à la fois pour chaque faute
+
+typedef struct t_circuit t_circuit;
+typedef struct t_netlist t_netlist;
+
+/*
+Faute de collage: le net, la lecture touchée et la valeur collée.
+*/
+struct t_faute {
+	int net; //Net de la faute (numérotation de la netlist)
+	//-1: faute sur le tronc du net. Sinon, faute sur une branche: la porte (dans l'ordre
+	//d'évaluation) dont l'entrée est collée, ou nb_portes + j pour la sortie j du circuit
+	int lecteur;
+	int entree; //Entrée collée de la porte lectrice (faute sur une branche)
+	int valeur; //Valeur collée (0 ou 1)
+	//Rang d'un vecteur qui détecte la faute, dans le premier bloc qui la détecte (-1 si elle n'est
+	//pas détectée)
+	long long vecteur;
+};
+
+typedef struct t_faute t_faute;
+
+struct t_fautes {
+	t_netlist *netlist; //Netlist du circuit simulé
+	int nb_entrees; //Nombre de pseudo-entrées des vecteurs: entrées du circuit puis bascules
+	t_faute *fautes; //Fautes énumérées
+	int nb_fautes;
+	int nb_detectees; //Nombre de fautes détectées
+	int *restantes; //Fautes non détectées (indices dans fautes)
+	int nb_restantes;
+	unsigned char *observes; //Booléen pour chaque net: vrai s'il est lu par une sortie ou une bascule
+
+	//Valeurs des nets sans faute et avec la faute simulée (nb_nets + 1 lignes de FAUTES_MOTS_BLOC
+	//mots au plus: la dernière reçoit la valeur collée d'une branche)
+	uint64_t *bons;
+	uint64_t *fautifs;
+	int *modifies; //Nets dont la valeur fautive diffère de la bonne (à restaurer)
+	int nb_modifies;
+	//File d'événements par niveau (même organisation que celle de t_netlist)
+	int *file_evenements;
+	int *nb_evenements;
+	unsigned char *en_file;
+	int *signaux; //Entrées d'une porte dont une branche est collée
+	uint64_t etat_aleatoire; //Générateur des vecteurs de t_fautes_simuler_aleatoire
+
+	long long nb_vecteurs; //Nombre de vecteurs simulés
+	long long nb_evaluations; //Nombre de portes évaluées avec une faute
+};
+
+typedef struct t_fautes t_fautes;
+
+/*
+Fonction: T_FAUTES_INIT
+Description: Énumère les fautes de collage d'un circuit (voir la description du module). Aucune
+			 faute n'est détectée au départ.
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+Retour: Pointeur vers le simulateur créé. NULL si le circuit ne peut pas être compilé ou si la
+		mémoire manque.
+*/
+t_fautes *t_fautes_init(t_circuit *circuit);
+
+/*
+Fonction: T_FAUTES_DESTROY
+Description: Libère la mémoire occupée par le simulateur (la netlist appartient au circuit).
+Paramètres:
+- fautes: Pointeur vers le simulateur à détruire.
+Retour: Aucun.
+*/
+void t_fautes_destroy(t_fautes *fautes);
+
+/*
+Fonction: T_FAUTES_SIMULER_LOT
+Description: Simule un lot de vecteurs de test sur les fautes non encore détectées et retire
+			 celles qu'il détecte. Les vecteurs prennent les rangs nb_vecteurs (du simulateur)
+			 et suivants.
+Paramètres:
+- fautes: Pointeur vers le simulateur.
+- entrees: Mots des pseudo-entrées: entrees[i * nb_mots + m] est le mot m de la pseudo-entrée i
+		   (entrées du circuit puis état des bascules), avec nb_mots = (nb_vecteurs + 63) / 64.
+- nb_vecteurs: Nombre de vecteurs du lot.
+Retour: Nombre de fautes détectées par ce lot.
+*/
+int t_fautes_simuler_lot(t_fautes *fautes, const uint64_t entrees[], int nb_vecteurs);
+
+/*
+Fonction: T_FAUTES_SIMULER_ALEATOIRE
+Description: Simule des vecteurs pseudo-aléatoires, par blocs de 64 * FAUTES_MOTS_BLOC vecteurs,
+			 jusqu'à nb_vecteurs vecteurs ou jusqu'à ce que toutes les fautes soient détectées.
+Paramètres:
+- fautes: Pointeur vers le simulateur.
+- nb_vecteurs: Nombre maximal de vecteurs à simuler.
+Retour: Nombre de fautes détectées par ces vecteurs. -1 si la mémoire manque.
+*/
+int t_fautes_simuler_aleatoire(t_fautes *fautes, long long nb_vecteurs);
+
+/*
+Fonction: T_FAUTES_COUVERTURE
+Description: Retourne la couverture des vecteurs simulés jusqu'ici.
+Paramètres:
+- fautes: Pointeur vers le simulateur.
+Retour: Proportion des fautes détectées (entre 0 et 1; 1 si le circuit n'a aucune faute).
+*/
+double t_fautes_couverture(const t_fautes *fautes);
+
+/*
+Fonction: T_FAUTES_AFFICHER_RAPPORT
+Description: Affiche le nombre de fautes, le nombre de fautes détectées, la couverture et le
+			 nombre de vecteurs simulés.
+Paramètres:
+- fautes: Pointeur vers le simulateur.
+Retour: Aucun.
+*/
+void t_fautes_afficher_rapport(const t_fautes *fautes);
+
+#endif
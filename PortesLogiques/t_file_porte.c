@@ -1,7 +1,7 @@
 /*
 Titre: File
 Description: Programme qui implémente les fonctions d'une file
-sur tableau statique.
+sur tableau circulaire dynamique.
 
 Auteur: Anis Boubaker
 Date: 2018-03-18
@@ -15,28 +15,161 @@ Date: 2018-03-18
 #include "t_file_porte.h"
 
 /***********CONSTANTES DE COMPILATION*************/
-
+#define TAILLE_MIN_FILE 16 //Capacité minimale du tableau circulaire
 
 /********* DÉFINITION DES FONCTION **************/
+
+//Agrandit le tableau circulaire pour qu'il puisse contenir au moins taille éléments.
+//Les éléments sont recopiés à partir de l'indice 0.
+static int t_file_porte_agrandir(t_file_porte *file, int taille)
+{
+	t_porte **nouv_tab;
+	int nouv_taille = file->taille_max;
+	int i; //compteur de boucle
+
+	if (taille <= file->taille_max)
+	{
+
+		return 1;
+	}
+
+	while (nouv_taille < taille)
+	{
+		nouv_taille *= 2;
+	}
+
+	nouv_tab = (t_porte**)malloc(sizeof(t_porte*) * nouv_taille);
+
+	if (nouv_tab == NULL)
+	{
+
+		return 0;
+	}
+
+	for (i = 0; i < file->nb_elts; i++)
+	{
+		nouv_tab[i] = file->tab[(file->debut + i) % file->taille_max];
+	}
+
+	free(file->tab);
+	file->tab = nouv_tab;
+	file->taille_max = nouv_taille;
+	file->debut = 0;
+
+	return 1;
+}
+
+//Réserve l'ensemble de bits pour pouvoir noter la présence de la porte d'identifiant id
+static int t_file_porte_reserver_presence(t_file_porte *file, int id)
+{
+	uint64_t *nouv_presence;
+	int nb_mots = file->nb_mots_presence;
+	int i; //compteur de boucle
+
+	if (id / 64 < file->nb_mots_presence)
+	{
+
+		return 1;
+	}
+
+	while (nb_mots <= id / 64)
+	{
+		nb_mots *= 2;
+	}
+
+	nouv_presence = (uint64_t*)realloc(file->presence, sizeof(uint64_t) * nb_mots);
+
+	if (nouv_presence == NULL)
+	{
+
+		return 0;
+	}
+
+	for (i = file->nb_mots_presence; i < nb_mots; i++)
+	{
+		nouv_presence[i] = 0;
+	}
+
+	file->presence = nouv_presence;
+	file->nb_mots_presence = nb_mots;
+
+	return 1;
+}
+
 t_file_porte * t_file_porte_initialiser(const int taille_max)
 {
 	t_file_porte *nouv_file = (t_file_porte*)malloc(sizeof(t_file_porte));
-	nouv_file->taille_max = taille_max;
+
+	if (nouv_file == NULL)
+	{
+
+		return NULL;
+	}
+
+	nouv_file->taille_max = taille_max > TAILLE_MIN_FILE ? taille_max : TAILLE_MIN_FILE;
+	nouv_file->debut = 0;
 	nouv_file->nb_elts = 0;
+	nouv_file->nb_mots_presence = (nouv_file->taille_max + 63) / 64;
+	nouv_file->tab = (t_porte**)malloc(sizeof(t_porte*) * nouv_file->taille_max);
+	nouv_file->presence = (uint64_t*)calloc(nouv_file->nb_mots_presence, sizeof(uint64_t));
 
+	if (nouv_file->tab == NULL || nouv_file->presence == NULL)
+	{
+		t_file_porte_detruire(nouv_file);
+
+		return NULL;
+	}
 
 	return nouv_file;
 }
 
+void t_file_porte_detruire(t_file_porte *file)
+{
+	free(file->tab);
+	free(file->presence);
+	free(file);
+}
+
 int t_file_porte_enfiler(t_file_porte *file, const t_porte *nouvelle_valeur)
 {
-	if (file->nb_elts >= file->taille_max)
+	if (t_file_porte_contient(file, nouvelle_valeur))
+	{
+
+		return 1;
+	}
+
+	if (t_file_porte_agrandir(file, file->nb_elts + 1) == 0
+		|| t_file_porte_reserver_presence(file, nouvelle_valeur->id) == 0)
 	{
 
 		return 0;
 	}
 
-	file->tab[file->nb_elts++] = (t_porte*)nouvelle_valeur;
+	file->tab[(file->debut + file->nb_elts) % file->taille_max] = (t_porte*)nouvelle_valeur;
+	file->nb_elts++;
+	file->presence[nouvelle_valeur->id / 64] |= (uint64_t)1 << (nouvelle_valeur->id % 64);
+
+	return 1;
+}
+
+int t_file_porte_enfiler_tableau(t_file_porte *file, t_porte *const portes[], int nb_portes)
+{
+	int i; //compteur de boucle
+
+	if (t_file_porte_agrandir(file, file->nb_elts + nb_portes) == 0)
+	{
+
+		return 0;
+	}
+
+	for (i = 0; i < nb_portes; i++)
+	{
+		if (t_file_porte_enfiler(file, portes[i]) == 0)
+		{
+
+			return 0;
+		}
+	}
 
 	return 1;
 }
@@ -45,7 +178,6 @@ int t_file_porte_enfiler(t_file_porte *file, const t_porte *nouvelle_valeur)
 t_porte* t_file_porte_defiler(t_file_porte *file)
 {
 	t_porte* valeur_a_retourner;
-	int i; //compteur de boucle
 
 	if (file->nb_elts<=0)
 	{
@@ -53,12 +185,10 @@ t_porte* t_file_porte_defiler(t_file_porte *file)
 		return NULL;
 	}
 
-	valeur_a_retourner = file->tab[0];
-	for (i = 1; i <= file->nb_elts ; i++) {
-		file->tab[i - 1] = file->tab[i];
-
-	}
+	valeur_a_retourner = file->tab[file->debut];
+	file->debut = (file->debut + 1) % file->taille_max;
 	file->nb_elts--;
+	file->presence[valeur_a_retourner->id / 64] &= ~((uint64_t)1 << (valeur_a_retourner->id % 64));
 
 	return valeur_a_retourner;
 }
@@ -72,19 +202,15 @@ int t_file_porte_est_vide(const t_file_porte* file)
 
 
 int t_file_porte_contient(const t_file_porte* file, const t_porte *valeur_recherchee) {
-	int i; //Compteur de boucle 
-	for (i = 0; i < file->nb_elts; i++)
-	{
-		if (file->tab[i] == valeur_recherchee)
-		{ //La valeur a été trouvée -> On retourne vrai
+	const int id = valeur_recherchee->id;
 
-			return 1;
-		}
+	if (id < 0 || id / 64 >= file->nb_mots_presence)
+	{ //Aucune porte avec cet identifiant n'a jamais été ajoutée
+
+		return 0;
 	}
-	//Tout le tableau a été parcouru et on n'a pas trouvé la
-	//valeur --> On renvoie faux.
 
-	return 0;
+	return (file->presence[id / 64] >> (id % 64)) & 1;
 }
 
 t_porte* t_file_porte_premier(const t_file_porte *file)
@@ -95,7 +221,7 @@ t_porte* t_file_porte_premier(const t_file_porte *file)
 		return NULL;
 	}
 
-	return file->tab[0];
+	return file->tab[file->debut];
 }
 
 
@@ -107,5 +233,5 @@ t_porte* t_file_porte_dernier(const t_file_porte *file)
 		return NULL;
 	}
 
-	return file->tab[file->nb_elts-1];
-}
\ No newline at end of file
+	return file->tab[(file->debut + file->nb_elts - 1) % file->taille_max];
+}
@@ -9,6 +9,7 @@ Dernière modification: 2018-03-19
 #ifndef FILE_PORTE_H_
 #define FILE_PORTE_H_
 
+#include <stdint.h>
 #include "t_porte.h"
 #include "t_circuit.h"
 
@@ -18,15 +19,25 @@ typedef struct t_circuit t_circuit;
 
 /*
 Définit le type t_file_porte qui permet de stocker une file de (pointeurs) de portes.
+La file est un tableau circulaire: la tête avance à chaque défilement au lieu de décaler
+tout le tableau, et le tableau double de taille lorsqu'il est plein.
+Une porte ne peut être présente qu'une seule fois dans la file. La présence des portes est
+notée dans un ensemble de bits indexé par l'identifiant de la porte: les portes d'une même
+file doivent donc avoir des identifiants distincts (c'est le cas des portes d'un circuit).
 */
 struct t_file_porte {
-	//Tableau statique de pointeurs de portes
-	t_porte *tab[CIRCUIT_MAX_PORTES];
-	//Nombre maximal de pointeurs de portes pouvant être ajoutés à 
-	//la file
+	//Tableau circulaire (dynamique) de pointeurs de portes
+	t_porte **tab;
+	//Capacité actuelle du tableau tab
 	int taille_max;
+	//Indice de la tête de file dans tab
+	int debut;
 	//Nombre d'éléments actuellement stockés dans la file
 	int nb_elts;
+	//Ensemble de bits: le bit id est à 1 si la porte d'identifiant id est dans la file
+	uint64_t *presence;
+	//Nombre de mots du tableau presence
+	int nb_mots_presence;
 };
 
 typedef struct t_file_porte t_file_porte;
@@ -35,25 +46,47 @@ typedef struct t_file_porte t_file_porte;
 Fonction: t_file_porte_initialiser
 Description: Crée une file de pointeurs de portes (t_porte*)
 Arguments:
-- taille_max (entier): Le nombre maximal de portes pouvant être contenues dans
-                       la file
-Retour: Un pointeur vers la file créée
+- taille_max (entier): Capacité initiale de la file. La file s'agrandit au besoin.
+Retour: Un pointeur vers la file créée (NULL si la mémoire manque)
 */
 t_file_porte *t_file_porte_initialiser(int taille_max);
 
+/*
+Fonction: t_file_porte_detruire
+Description: Libère la mémoire occupée par la file (mais pas celle des portes).
+Arguments:
+- file: Pointeur vers la file
+Retour: Aucun
+*/
+void t_file_porte_detruire(t_file_porte *file);
+
 
 /*
 Fonction: t_file_porte_enfiler
-Description: Ajoute un pointeur de porte à la fin de la file
+Description: Ajoute un pointeur de porte à la fin de la file. Si la porte est déjà
+			 dans la file, elle n'est pas ajoutée une deuxième fois.
 Arguments:
 - file: Pointeur vers la file
 - nouvelle_valeur: Pointeur vers la porte à ajouter à la file
-Retour: Booléen: Vrai si l'opération enfiler s'est bien effectuée
-				 (file n'est pas pleine), et faux sinon.
+Retour: Booléen: Vrai si la porte est dans la file après l'opération, et faux
+				 si la mémoire a manqué pour agrandir la file.
 Pré-requis: La file a déjà été initialisée.
 */
 int t_file_porte_enfiler(t_file_porte *file, const t_porte *nouvelle_valeur);
 
+/*
+Fonction: t_file_porte_enfiler_tableau
+Description: Ajoute plusieurs portes à la fin de la file, dans l'ordre du tableau.
+			 La file est agrandie une seule fois pour toutes les portes.
+Arguments:
+- file: Pointeur vers la file
+- portes: Tableau de pointeurs vers les portes à ajouter
+- nb_portes: Nombre de portes dans le tableau
+Retour: Booléen: Vrai si toutes les portes sont dans la file, faux si la mémoire a manqué.
+Pré-requis: La file a déjà été initialisée.
+*/
+int t_file_porte_enfiler_tableau(t_file_porte *file, t_porte *const portes[], int nb_portes);
+
 /*
 Fonction: t_file_porte_defiler
 Description: Retourne le pointeur vers la porte en début de file, et le supprime 
@@ -78,7 +111,7 @@ int t_file_porte_est_vide(const t_file_porte* file);
 
 /*
 Fonction: t_file_porte_contient
-Description: Vérifie si une porte existe dans la file (i.e. son adresse!).
+Description: Vérifie si une porte existe dans la file (par son identifiant, en temps constant).
 Arguments:
 - file : La file où l'on cheche la porte
 - valeur_recherchee (pointeur de t_porte): Valeur à rechercher dans la file
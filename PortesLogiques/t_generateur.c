@@ -0,0 +1,376 @@
+//
+// Génération de circuits synthétiques (voir t_generateur.h).
+//
+
+#include <stdlib.h>
+#include "t_generateur.h"
+
+//Ajoute une porte de deux entrées (NULL si la mémoire manque)
+static t_pin_sortie *t_generateur_porte(t_circuit *circuit, e_types_portes type, t_pin_sortie *a, t_pin_sortie *b)
+{
+    t_porte *porte = t_circuit_ajouter_porte(circuit, type);
+
+    if(porte == NULL)
+    {
+
+        return NULL;
+    }
+
+    t_porte_relier(porte, 0, a);
+    t_porte_relier(porte, 1, b);
+
+
+    return t_porte_get_pin_sortie(porte);
+}
+
+//Ajoute un additionneur complet de cinq portes. Retourne faux si la mémoire manque.
+static int t_generateur_additionneur_complet(t_circuit *circuit, t_pin_sortie *a, t_pin_sortie *b,
+                                             t_pin_sortie *retenue, t_pin_sortie **somme, t_pin_sortie **retenue_sortie)
+{
+    t_pin_sortie *ou_exclusif = t_generateur_porte(circuit, PORTE_XOR, a, b);
+    t_pin_sortie *et_entrees = t_generateur_porte(circuit, PORTE_ET, a, b);
+    t_pin_sortie *et_retenue;
+
+    if(ou_exclusif == NULL || et_entrees == NULL)
+    {
+
+        return 0;
+    }
+
+    *somme = t_generateur_porte(circuit, PORTE_XOR, ou_exclusif, retenue);
+    et_retenue = t_generateur_porte(circuit, PORTE_ET, ou_exclusif, retenue);
+    *retenue_sortie = et_retenue == NULL ? NULL : t_generateur_porte(circuit, PORTE_OU, et_entrees, et_retenue);
+
+
+    return *somme != NULL && *retenue_sortie != NULL;
+}
+
+//Ajoute les entrées du circuit. Retourne faux si la mémoire manque.
+static int t_generateur_entrees(t_circuit *circuit, int nb_entrees)
+{
+    for(int i = 0;i<nb_entrees;i++)
+    {
+        if(t_circuit_ajouter_entree(circuit) == NULL)
+        {
+
+            return 0;
+        }
+    }
+
+
+    return 1;
+}
+
+//Relie une nouvelle sortie du circuit. Retourne faux si la mémoire manque.
+static int t_generateur_sortie(t_circuit *circuit, t_pin_sortie *source)
+{
+    t_sortie *sortie = t_circuit_ajouter_sortie(circuit);
+
+    if(sortie == NULL)
+    {
+
+        return 0;
+    }
+
+    t_sortie_relier(sortie, source);
+
+
+    return 1;
+}
+
+t_circuit *t_generateur_additionneur(int nb_bits)
+{
+    t_circuit *circuit;
+    t_pin_sortie *retenue;
+    t_pin_sortie *somme;
+    int succes;
+
+    if(nb_bits < 1 || (circuit = t_circuit_init()) == NULL)
+    {
+
+        return NULL;
+    }
+
+    succes = t_generateur_entrees(circuit, 2 * nb_bits + 1);
+    retenue = succes ? t_entree_get_pin(circuit->entrees[2 * nb_bits]) : NULL;
+
+    for(int b = 0;b<nb_bits && succes;b++)
+    {
+        succes = t_generateur_additionneur_complet(circuit, t_entree_get_pin(circuit->entrees[b]),
+                                                   t_entree_get_pin(circuit->entrees[nb_bits + b]), retenue, &somme, &retenue)
+                 && t_generateur_sortie(circuit, somme);
+    }
+
+    if(succes == 0 || t_generateur_sortie(circuit, retenue) == 0)
+    {
+        t_circuit_destroy(circuit);
+
+        return NULL;
+    }
+
+
+    return circuit;
+}
+
+t_circuit *t_generateur_multiplicateur(int nb_bits, int echanger)
+{
+    t_circuit *circuit;
+    t_pin_sortie **accumulateur;
+    t_pin_sortie *retenue_haute;
+    t_pin_sortie *retenue;
+    t_pin_sortie *produit;
+    t_porte *zero;
+    int succes;
+
+    if(nb_bits < 1 || (circuit = t_circuit_init()) == NULL)
+    {
+
+        return NULL;
+    }
+
+    accumulateur = (t_pin_sortie**)malloc(sizeof(t_pin_sortie*) * nb_bits);
+    zero = t_circuit_ajouter_porte(circuit, PORTE_ZERO);
+    succes = accumulateur != NULL && zero != NULL && t_generateur_entrees(circuit, 2 * nb_bits);
+    retenue_haute = succes ? t_porte_get_pin_sortie(zero) : NULL;
+
+    //L'accumulateur contient les bits de poids i-1 à i+nb_bits-2, retenue_haute celui de poids i+nb_bits-1
+    for(int i = 0;i<nb_bits && succes;i++)
+    {
+        retenue = t_porte_get_pin_sortie(zero);
+
+        if(i > 0)
+        {
+            succes = t_generateur_sortie(circuit, accumulateur[0]);
+        }
+
+        for(int j = 0;j<nb_bits && succes;j++)
+        {
+            produit = t_generateur_porte(circuit, PORTE_ET, t_entree_get_pin(circuit->entrees[echanger ? nb_bits + j : j]),
+                                         t_entree_get_pin(circuit->entrees[echanger ? i : nb_bits + i]));
+            succes = produit != NULL;
+
+            if(i == 0)
+            {
+                accumulateur[j] = produit;
+            }
+            else if(succes)
+            {
+                succes = t_generateur_additionneur_complet(circuit, j + 1 < nb_bits ? accumulateur[j + 1] : retenue_haute,
+                                                           produit, retenue, &accumulateur[j], &retenue);
+            }
+        }
+
+        if(i > 0)
+        {
+            retenue_haute = retenue;
+        }
+    }
+
+    for(int j = 0;j<nb_bits && succes;j++)
+    {
+        succes = t_generateur_sortie(circuit, accumulateur[j]);
+    }
+
+    if(succes == 0 || t_generateur_sortie(circuit, retenue_haute) == 0)
+    {
+        t_circuit_destroy(circuit);
+        circuit = NULL;
+    }
+
+    free(accumulateur);
+
+
+    return circuit;
+}
+
+t_circuit *t_generateur_parite(int nb_entrees, int arite)
+{
+    t_circuit *circuit;
+    t_pin_sortie **signaux;
+    t_porte *porte;
+    int nb_signaux = nb_entrees;
+    int nb_suivants;
+    int nb;
+    int succes;
+
+    if(nb_entrees < 2 || arite < 2 || (circuit = t_circuit_init()) == NULL)
+    {
+
+        return NULL;
+    }
+
+    signaux = (t_pin_sortie**)malloc(sizeof(t_pin_sortie*) * nb_entrees);
+    succes = signaux != NULL && t_generateur_entrees(circuit, nb_entrees);
+
+    for(int i = 0;i<nb_entrees && succes;i++)
+    {
+        signaux[i] = t_entree_get_pin(circuit->entrees[i]);
+    }
+
+    //Chaque étage regroupe les signaux par paquets de arite; un signal seul passe à l'étage suivant
+    while(nb_signaux > 1 && succes)
+    {
+        nb_suivants = 0;
+
+        for(int s = 0;s<nb_signaux && succes;s += nb)
+        {
+            nb = nb_signaux - s < arite ? nb_signaux - s : arite;
+
+            if(nb == 1)
+            {
+                signaux[nb_suivants++] = signaux[s];
+                continue;
+            }
+
+            porte = t_circuit_ajouter_porte_n(circuit, PORTE_XOR, nb);
+            succes = porte != NULL;
+
+            for(int i = 0;i<nb && succes;i++)
+            {
+                t_porte_relier(porte, i, signaux[s + i]);
+            }
+
+            signaux[nb_suivants++] = succes ? t_porte_get_pin_sortie(porte) : NULL;
+        }
+
+        nb_signaux = nb_suivants;
+    }
+
+    if(succes == 0 || t_generateur_sortie(circuit, signaux[0]) == 0)
+    {
+        t_circuit_destroy(circuit);
+        circuit = NULL;
+    }
+
+    free(signaux);
+
+
+    return circuit;
+}
+
+//Générateur pseudo-aléatoire (xorshift64*) des graphes aléatoires
+static uint64_t t_generateur_aleatoire_suivant(uint64_t *etat)
+{
+    *etat ^= *etat >> 12;
+    *etat ^= *etat << 25;
+    *etat ^= *etat >> 27;
+
+
+    return *etat * 0x2545F4914F6CDD1Dull;
+}
+
+//Tire un signal parmi les nb premiers, en évitant ceux qui sont déjà lus fanout_max fois
+static int t_generateur_tirer_signal(uint64_t *etat, const int lectures[], int nb, int fanout_max)
+{
+    int signal = (int)(t_generateur_aleatoire_suivant(etat) % (uint64_t)nb);
+
+    for(int essai = 0;essai<8 && fanout_max > 0 && lectures[signal] >= fanout_max;essai++)
+    {
+        signal = (int)(t_generateur_aleatoire_suivant(etat) % (uint64_t)nb);
+    }
+
+
+    return signal;
+}
+
+t_circuit *t_generateur_aleatoire(const t_parametres_aleatoire *parametres)
+{
+    const e_types_portes types[8] = {PORTE_ET, PORTE_OU, PORTE_XOR, PORTE_NAND, PORTE_NOR, PORTE_XNOR, PORTE_NOT, PORTE_MUX};
+    int nb_entrees = parametres->nb_entrees;
+    int nb_niveaux = parametres->nb_niveaux;
+    uint64_t etat = parametres->graine * 0x9E3779B97F4A7C15ull + 1;
+    t_circuit *circuit;
+    t_pin_sortie **signaux;
+    t_porte *porte;
+    int *lectures;
+    e_types_portes type;
+    int nb_signaux = nb_entrees;
+    int debut_precedent = 0;
+    int largeur_precedente = nb_entrees;
+    int largeur;
+    int nb;
+    int signal;
+    int compteur_entrees = 0;
+    int succes;
+
+    if(nb_entrees < 1 || nb_niveaux < 1 || parametres->nb_portes < nb_niveaux || parametres->max_entrees_porte < 2
+       || (circuit = t_circuit_init()) == NULL)
+    {
+
+        return NULL;
+    }
+
+    signaux = (t_pin_sortie**)malloc(sizeof(t_pin_sortie*) * (nb_entrees + parametres->nb_portes));
+    lectures = (int*)calloc(nb_entrees + parametres->nb_portes, sizeof(int));
+    succes = signaux != NULL && lectures != NULL && t_generateur_entrees(circuit, nb_entrees);
+
+    for(int i = 0;i<nb_entrees && succes;i++)
+    {
+        signaux[i] = t_entree_get_pin(circuit->entrees[i]);
+    }
+
+    for(int l = 0;l<nb_niveaux && succes;l++)
+    {
+        //Les derniers niveaux reçoivent une porte de plus: aucun niveau n'est plus étroit que le précédent
+        largeur = parametres->nb_portes / nb_niveaux + (l >= nb_niveaux - parametres->nb_portes % nb_niveaux);
+
+        for(int j = 0;j<largeur && succes;j++)
+        {
+            type = types[t_generateur_aleatoire_suivant(&etat) % 8];
+            nb = t_porte_nb_entrees_defaut(type);
+
+            if(nb == 2)
+            {
+                nb += (int)(t_generateur_aleatoire_suivant(&etat) % (uint64_t)(parametres->max_entrees_porte - 1));
+            }
+
+            porte = t_circuit_ajouter_porte_n(circuit, type, nb);
+            succes = porte != NULL;
+
+            for(int i = 0;i<nb && succes;i++)
+            {
+                if(l == 0)
+                {
+                    signal = compteur_entrees++ % nb_entrees;
+                }
+                else if(i == 0)
+                {
+                    signal = debut_precedent + j % largeur_precedente;
+                }
+                else
+                {
+                    signal = t_generateur_tirer_signal(&etat, lectures, debut_precedent + largeur_precedente,
+                                                       parametres->fanout_max);
+                }
+
+                t_porte_relier(porte, i, signaux[signal]);
+                lectures[signal]++;
+            }
+
+            if(succes)
+            {
+                signaux[nb_signaux++] = t_porte_get_pin_sortie(porte);
+            }
+        }
+
+        debut_precedent = nb_signaux - largeur;
+        largeur_precedente = largeur;
+    }
+
+    for(int s = debut_precedent;s<nb_signaux && succes;s++)
+    {
+        succes = t_generateur_sortie(circuit, signaux[s]);
+    }
+
+    if(succes == 0)
+    {
+        t_circuit_destroy(circuit);
+        circuit = NULL;
+    }
+
+    free(signaux);
+    free(lectures);
+
+
+    return circuit;
+}
@@ -0,0 +1,91 @@
+/*
+Module: T_GENERATEUR
+Description: Génération de circuits synthétiques paramétrés, pour les bancs d'essai et les tests:
+			 - additionneur à propagation de retenue (ripple-carry) de nb_bits bits;
+			 - multiplicateur en tableau de nb_bits x nb_bits bits (c6288, le plus profond des
+			   circuits ISCAS-85, est un multiplicateur de ce type de 16 bits);
+			 - arbre de parité (XOR de toutes les entrées);
+			 - graphe acyclique pseudo-aléatoire de N portes dont la profondeur et le fanout sont
+			   contrôlés.
+
+			 Les portes des circuits générés sont toutes reliées et lues: les circuits sont valides
+			 (t_circuit_est_valide), sauf une entrée non lue d'un graphe aléatoire (voir
+			 t_generateur_aleatoire).
+*/
+
+#ifndef T_GENERATEUR_H_
+#define T_GENERATEUR_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+
+typedef struct t_circuit t_circuit;
+
+/*
+Paramètres d'un graphe aléatoire.
+*/
+struct t_parametres_aleatoire {
+	int nb_entrees; //Nombre d'entrées du circuit (>= 1)
+	int nb_portes; //Nombre de portes (>= nb_niveaux)
+	int nb_niveaux; //Nombre de niveaux (profondeur du circuit, >= 1)
+	int max_entrees_porte; //Nombre maximal d'entrées d'une porte ET, OU, XOR... (>= 2)
+	int fanout_max; //Nombre de lectures visé d'un signal au plus (0: pas de limite)
+	uint64_t graine; //Graine du générateur pseudo-aléatoire (même graine, même circuit)
+};
+
+typedef struct t_parametres_aleatoire t_parametres_aleatoire;
+
+/*
+Fonction: T_GENERATEUR_ADDITIONNEUR
+Description: Construit un additionneur à propagation de retenue: cinq portes par bit (deux XOR,
+			 deux ET, un OU).
+Paramètres:
+- nb_bits: Nombre de bits des opérandes (>= 1).
+Retour: Pointeur vers le circuit créé (entrées a0..a(n-1), b0..b(n-1), retenue; sorties somme0..
+		somme(n-1), retenue). NULL si nb_bits est invalide ou si la mémoire manque.
+*/
+t_circuit *t_generateur_additionneur(int nb_bits);
+
+/*
+Fonction: T_GENERATEUR_MULTIPLICATEUR
+Description: Construit un multiplicateur en tableau: nb_bits x nb_bits produits partiels (ET), puis
+			 une rangée d'additionneurs complets par bit de b.
+Paramètres:
+- nb_bits: Nombre de bits des opérandes (>= 1).
+- echanger: Booléen: vrai pour calculer b * a (mêmes portes, opérandes échangés), faux pour a * b.
+Retour: Pointeur vers le circuit créé (entrées a puis b; sorties les 2 * nb_bits bits du produit,
+		poids faible en premier). NULL si nb_bits est invalide ou si la mémoire manque.
+*/
+t_circuit *t_generateur_multiplicateur(int nb_bits, int echanger);
+
+/*
+Fonction: T_GENERATEUR_PARITE
+Description: Construit un arbre équilibré de portes XOR qui calcule la parité des entrées.
+Paramètres:
+- nb_entrees: Nombre d'entrées (>= 2).
+- arite: Nombre d'entrées de chaque porte XOR (>= 2).
+Retour: Pointeur vers le circuit créé (une sortie). NULL si un paramètre est invalide ou si la
+		mémoire manque.
+*/
+t_circuit *t_generateur_parite(int nb_entrees, int arite);
+
+/*
+Fonction: T_GENERATEUR_ALEATOIRE
+Description: Construit un graphe acyclique pseudo-aléatoire. Les portes sont réparties également
+			 entre les niveaux (les derniers niveaux reçoivent le reste): la première entrée de
+			 la porte j d'un niveau est la porte j (modulo la largeur) du niveau précédent, ce qui
+			 fixe la profondeur et fait lire chaque porte au moins une fois. Les autres entrées
+			 sont tirées parmi les entrées du circuit et les portes des niveaux précédents, en
+			 évitant les signaux déjà lus fanout_max fois (si quelques tirages n'en trouvent pas,
+			 la limite est dépassée). Les types sont tirés parmi ET, OU, XOR, NAND, NOR, XNOR, NOT et
+			 MUX. Les portes du dernier niveau sont les sorties du circuit.
+
+			 Les portes du premier niveau lisent les entrées du circuit à tour de rôle: une entrée
+			 n'est pas lue si elles ont moins d'entrées au total que le circuit.
+Paramètres:
+- parametres: Paramètres du graphe.
+Retour: Pointeur vers le circuit créé. NULL si un paramètre est invalide ou si la mémoire manque.
+*/
+t_circuit *t_generateur_aleatoire(const t_parametres_aleatoire *parametres);
+
+#endif
@@ -0,0 +1,117 @@
+//
+// Instances de circuits utilisées comme portes (voir t_instance.h).
+//
+
+#include <stdio.h>
+#include "t_instance.h"
+
+t_instance *t_instance_init_arene(t_arene *arene, int id, t_circuit *definition)
+{
+    t_instance *instance = (t_instance*)t_arene_allouer(arene, sizeof(t_instance));
+
+    if(instance == NULL)
+    {
+
+        return NULL;
+    }
+
+    instance->id = id;
+    instance->definition = definition;
+    instance->nb_entrees = definition->nb_entrees;
+    instance->nb_sorties = definition->nb_sorties;
+    instance->nom = (char*)t_arene_allouer(arene, sizeof(char) * (snprintf(NULL, 0, "I%i", id) + 1));
+    //Les tableaux ont au moins un élément pour qu'une définition sans entrée reste valide
+    instance->entrees = (t_pin_entree**)t_arene_allouer(arene, sizeof(t_pin_entree*) * (instance->nb_entrees + 1));
+    instance->sorties = (t_pin_sortie**)t_arene_allouer(arene, sizeof(t_pin_sortie*) * (instance->nb_sorties + 1));
+
+    if(instance->nom == NULL || instance->entrees == NULL || instance->sorties == NULL)
+    {
+
+        return NULL;
+    }
+
+    sprintf(instance->nom, "I%i", id);
+
+    for(int i = 0;i<instance->nb_entrees;i++)
+    {
+        instance->entrees[i] = t_pin_entree_init_arene(arene);
+
+        if(instance->entrees[i] == NULL)
+        {
+
+            return NULL;
+        }
+
+        instance->entrees[i]->instance = instance;
+    }
+
+    for(int j = 0;j<instance->nb_sorties;j++)
+    {
+        instance->sorties[j] = t_pin_sortie_init_arene(arene);
+
+        if(instance->sorties[j] == NULL)
+        {
+
+            return NULL;
+        }
+
+        instance->sorties[j]->instance = instance;
+    }
+
+
+    return instance;
+}
+
+int t_instance_relier(t_instance *instance, int num_entree, t_pin_sortie *source)
+{
+    if(num_entree < 0 || num_entree >= instance->nb_entrees)
+    {
+
+        return 0;
+    }
+
+    t_pin_entree_relier(instance->entrees[num_entree], source);
+
+
+    return 1;
+}
+
+t_pin_sortie *t_instance_get_pin_sortie(t_instance *instance, int num_sortie)
+{
+    if(num_sortie < 0 || num_sortie >= instance->nb_sorties)
+    {
+
+        return NULL;
+    }
+
+
+    return instance->sorties[num_sortie];
+}
+
+int t_instance_est_reliee(t_instance *instance)
+{
+    for(int i = 0;i<instance->nb_entrees;i++)
+    {
+        if(t_pin_entree_est_reliee(instance->entrees[i]) == 0)
+        {
+
+            return 0;
+        }
+    }
+
+
+    return 1;
+}
+
+void t_instance_reset(t_instance *instance)
+{
+    for(int i = 0;i<instance->nb_entrees;i++)
+    {
+        t_pin_entree_reset(instance->entrees[i]);
+    }
+
+    for(int j = 0;j<instance->nb_sorties;j++)
+    {
+        t_pin_sortie_reset(instance->sorties[j]);
+    }
+}
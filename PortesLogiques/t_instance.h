@@ -0,0 +1,98 @@
+/*
+Module: T_INSTANCE
+Description: Définit le type t_instance, une porte personnalisée: un circuit complet (la
+			 définition) utilisé comme un composant d'un autre circuit. Chaque entrée de la
+			 définition devient une pin entrée de l'instance et chaque sortie de la définition
+			 une pin sortie.
+
+			 La définition n'est pas copiée: toutes les instances d'un même circuit partagent
+			 sa netlist compilée. Une instance ne stocke que ses pins (les liaisons vers le
+			 reste du circuit), ce qui rend un circuit de 1000 additionneurs complets beaucoup
+			 plus petit que le même circuit construit porte par porte. Pour la simulation, le
+			 circuit qui contient des instances est aplati (voir t_circuit_aplatir).
+
+			 La définition doit rester valide (ni détruite, ni rendue invalide) tant que des
+			 instances y font référence.
+*/
+
+#ifndef T_INSTANCE_H_
+#define T_INSTANCE_H_
+
+#include "t_arene.h"
+#include "t_pin_entree.h"
+#include "t_pin_sortie.h"
+#include "t_circuit.h"
+
+typedef struct t_pin_entree t_pin_entree;
+typedef struct t_pin_sortie t_pin_sortie;
+typedef struct t_circuit t_circuit;
+
+struct t_instance {
+	int id; //Identifiant numérique de l'instance (unique parmi les instances d'un circuit)
+	char *nom; //Nom construit à partir de l'identifiant (ex.: I3)
+	t_circuit *definition; //Circuit utilisé comme porte (partagé entre les instances)
+	//Pins entrée de l'instance: l'entrée i alimente l'entrée i de la définition
+	t_pin_entree **entrees;
+	//Pins sortie de l'instance: la sortie j porte la valeur de la sortie j de la définition
+	t_pin_sortie **sorties;
+	int nb_entrees; //Nombre d'entrées de la définition
+	int nb_sorties; //Nombre de sorties de la définition
+};
+
+typedef struct t_instance t_instance;
+
+/*
+Fonction: T_INSTANCE_INIT_ARENE
+Description: Crée une nouvelle instance d'une définition dans l'arène d'un circuit (voir
+			 t_circuit_ajouter_instance, qui vérifie la définition). Le nom de l'instance est
+			 construit à partir de l'identifiant (ex.: I2).
+Paramètres:
+- arene: Arène dans laquelle l'instance et ses pins sont créées.
+- id: Identifiant numérique de l'instance.
+- definition: Circuit utilisé comme porte.
+Retour: Pointeur vers l'instance créée (NULL si la mémoire manque).
+*/
+t_instance *t_instance_init_arene(t_arene *arene, int id, t_circuit *definition);
+
+/*
+Fonction: T_INSTANCE_RELIER
+Description: Relie une des entrées de l'instance à un autre composant du circuit (entrée du
+			 circuit, porte ou sortie d'une autre instance). Un lien existant est remplacé.
+Paramètres:
+- instance: Pointeur vers l'instance à relier.
+- num_entree: Indice de l'entrée de l'instance (celui de l'entrée de la définition).
+- source: La pin sortie à laquelle l'entrée sera reliée.
+Retour: Booléen: Vrai si la liaison a été faite, faux si l'entrée n'existe pas.
+*/
+int t_instance_relier(t_instance *instance, int num_entree, t_pin_sortie *source);
+
+/*
+Fonction: T_INSTANCE_GET_PIN_SORTIE
+Description: Retourne la pin sortie qui porte la valeur d'une des sorties de la définition.
+Paramètres:
+- instance: Pointeur vers l'instance.
+- num_sortie: Indice de la sortie de la définition.
+Retour: Pointeur vers la pin sortie, NULL si la sortie n'existe pas.
+*/
+t_pin_sortie *t_instance_get_pin_sortie(t_instance *instance, int num_sortie);
+
+/*
+Fonction: T_INSTANCE_EST_RELIEE
+Description: Vérifie si toutes les entrées de l'instance sont reliées. Les sorties d'une
+			 instance peuvent rester inutilisées (ex.: la retenue du dernier additionneur).
+Paramètres:
+- instance: Pointeur vers l'instance.
+Retour: Booléen: Vrai si toutes les entrées sont reliées, faux sinon.
+*/
+int t_instance_est_reliee(t_instance *instance);
+
+/*
+Fonction: T_INSTANCE_RESET
+Description: Réinitialise les pins de l'instance (valeur -1).
+Paramètres:
+- instance: Pointeur vers l'instance.
+Retour: Aucun.
+*/
+void t_instance_reset(t_instance *instance);
+
+#endif
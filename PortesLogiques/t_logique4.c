@@ -0,0 +1,299 @@
+//
+// Simulation d'une netlist en logique à quatre valeurs (voir t_logique4.h).
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "t_logique4.h"
+#include "t_netlist.h"
+
+//Alloue les rails des nets pour au moins nb_mots mots par net
+static int t_logique4_reserver_mots(t_logique4 *simulation, int nb_mots)
+{
+    const t_netlist *netlist = simulation->netlist;
+    uint64_t *tableaux[4];
+    uint64_t **rails[4] = {&simulation->uns, &simulation->zeros, &simulation->suivants_uns, &simulation->suivants_zeros};
+    size_t tailles[4];
+
+    if(nb_mots <= simulation->nb_mots)
+    {
+
+        return 1;
+    }
+
+    tailles[0] = tailles[1] = sizeof(uint64_t) * netlist->nb_nets * nb_mots;
+    tailles[2] = tailles[3] = sizeof(uint64_t) * (netlist->nb_bascules + 1) * nb_mots;
+
+    for(int r = 0;r<4;r++)
+    {
+        tableaux[r] = (uint64_t*)realloc(*rails[r], tailles[r]);
+
+        if(tableaux[r] == NULL)
+        {
+
+            return 0;
+        }
+
+        *rails[r] = tableaux[r];
+    }
+
+    simulation->nb_mots = nb_mots;
+
+
+    return 1;
+}
+
+//Place l'état des bascules dans les nets pour nb_mots mots par net: l'état est remis à X s'il a
+//été rangé avec un autre nombre de mots (ou jamais)
+static void t_logique4_preparer_etats(t_logique4 *simulation, int nb_mots)
+{
+    const t_netlist *netlist = simulation->netlist;
+    size_t debut;
+
+    if(simulation->nb_mots_etats == nb_mots)
+    {
+
+        return;
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        debut = (size_t)(netlist->nb_entrees + netlist->bascules[b]) * nb_mots;
+        memset(&simulation->uns[debut], 0xFF, sizeof(uint64_t) * nb_mots);
+        memset(&simulation->zeros[debut], 0xFF, sizeof(uint64_t) * nb_mots);
+    }
+
+    simulation->nb_mots_etats = nb_mots;
+}
+
+//Évalue toutes les portes dans l'ordre des niveaux (les bascules ne calculent rien)
+static void t_logique4_evaluer(t_logique4 *simulation, int nb_mots)
+{
+    const t_netlist *netlist = simulation->netlist;
+    size_t sortie;
+    int debut;
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        debut = netlist->debut_entrees[k];
+        sortie = (size_t)(netlist->nb_entrees + k) * nb_mots;
+
+        t_porte_calculer_mots_x((e_types_portes)netlist->types[k], simulation->uns, simulation->zeros, &netlist->entrees[debut],
+                                netlist->debut_entrees[k + 1] - debut, &simulation->uns[sortie], &simulation->zeros[sortie], nb_mots);
+    }
+}
+
+//Copie les rails des entrées dans les nets
+static void t_logique4_appliquer(t_logique4 *simulation, const uint64_t entrees_uns[], const uint64_t entrees_zeros[], int nb_mots)
+{
+    size_t taille = sizeof(uint64_t) * simulation->netlist->nb_entrees * nb_mots;
+
+    memcpy(simulation->uns, entrees_uns, taille);
+    memcpy(simulation->zeros, entrees_zeros, taille);
+}
+
+//Copie les rails des sorties
+static void t_logique4_lire(const t_logique4 *simulation, uint64_t sorties_uns[], uint64_t sorties_zeros[], int nb_mots)
+{
+    const t_netlist *netlist = simulation->netlist;
+    size_t source;
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        source = (size_t)netlist->sorties[j] * nb_mots;
+        memcpy(&sorties_uns[(size_t)j * nb_mots], &simulation->uns[source], sizeof(uint64_t) * nb_mots);
+        memcpy(&sorties_zeros[(size_t)j * nb_mots], &simulation->zeros[source], sizeof(uint64_t) * nb_mots);
+    }
+}
+
+//Front d'horloge: chaque bascule prend la valeur de son entrée (Z devient X). Les entrées sont
+//toutes lues avant d'écrire les états, car l'entrée d'une bascule peut être l'état d'une autre.
+static void t_logique4_front_horloge(t_logique4 *simulation, int nb_mots)
+{
+    const t_netlist *netlist = simulation->netlist;
+    uint64_t haute_impedance;
+    size_t source;
+    size_t etat;
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        source = (size_t)netlist->entrees[netlist->debut_entrees[netlist->bascules[b]]] * nb_mots;
+
+        for(int m = 0;m<nb_mots;m++)
+        {
+            haute_impedance = ~(simulation->uns[source + m] | simulation->zeros[source + m]);
+            simulation->suivants_uns[(size_t)b * nb_mots + m] = simulation->uns[source + m] | haute_impedance;
+            simulation->suivants_zeros[(size_t)b * nb_mots + m] = simulation->zeros[source + m] | haute_impedance;
+        }
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        etat = (size_t)(netlist->nb_entrees + netlist->bascules[b]) * nb_mots;
+        memcpy(&simulation->uns[etat], &simulation->suivants_uns[(size_t)b * nb_mots], sizeof(uint64_t) * nb_mots);
+        memcpy(&simulation->zeros[etat], &simulation->suivants_zeros[(size_t)b * nb_mots], sizeof(uint64_t) * nb_mots);
+    }
+}
+
+t_logique4 *t_logique4_init(t_circuit *circuit)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    t_logique4 *simulation;
+
+    if(netlist == NULL)
+    {
+
+        return NULL;
+    }
+
+    simulation = (t_logique4*)calloc(1, sizeof(t_logique4));
+
+    if(simulation == NULL)
+    {
+
+        return NULL;
+    }
+
+    simulation->netlist = netlist;
+
+    if(t_logique4_reserver_mots(simulation, 1) == 0)
+    {
+        t_logique4_destroy(simulation);
+
+        return NULL;
+    }
+
+
+    return simulation;
+}
+
+void t_logique4_destroy(t_logique4 *simulation)
+{
+    if(simulation != NULL)
+    {
+        free(simulation->uns);
+        free(simulation->zeros);
+        free(simulation->suivants_uns);
+        free(simulation->suivants_zeros);
+        free(simulation);
+    }
+}
+
+int t_logique4_simuler_lot(t_logique4 *simulation, const uint64_t entrees_uns[], const uint64_t entrees_zeros[],
+                           uint64_t sorties_uns[], uint64_t sorties_zeros[], int nb_mots)
+{
+    if(t_logique4_reserver_mots(simulation, nb_mots) == 0)
+    {
+
+        return 0;
+    }
+
+    t_logique4_preparer_etats(simulation, nb_mots);
+    t_logique4_appliquer(simulation, entrees_uns, entrees_zeros, nb_mots);
+    t_logique4_evaluer(simulation, nb_mots);
+    t_logique4_lire(simulation, sorties_uns, sorties_zeros, nb_mots);
+
+
+    return 1;
+}
+
+int t_logique4_simuler_cycles(t_logique4 *simulation, const uint64_t entrees_uns[], const uint64_t entrees_zeros[],
+                              uint64_t sorties_uns[], uint64_t sorties_zeros[], int nb_cycles, int nb_mots)
+{
+    size_t taille_entrees = (size_t)simulation->netlist->nb_entrees * nb_mots;
+    size_t taille_sorties = (size_t)simulation->netlist->nb_sorties * nb_mots;
+
+    if(t_logique4_reserver_mots(simulation, nb_mots) == 0)
+    {
+
+        return 0;
+    }
+
+    t_logique4_preparer_etats(simulation, nb_mots);
+
+    for(int c = 0;c<nb_cycles;c++)
+    {
+        t_logique4_appliquer(simulation, &entrees_uns[c * taille_entrees], &entrees_zeros[c * taille_entrees], nb_mots);
+        t_logique4_evaluer(simulation, nb_mots);
+        t_logique4_lire(simulation, &sorties_uns[c * taille_sorties], &sorties_zeros[c * taille_sorties], nb_mots);
+        t_logique4_front_horloge(simulation, nb_mots);
+    }
+
+
+    return 1;
+}
+
+int t_logique4_simuler(t_logique4 *simulation, const int signal[], int resultat[])
+{
+    const t_netlist *netlist = simulation->netlist;
+    size_t source;
+
+    for(int i = 0;i<netlist->nb_entrees;i++)
+    {
+        if(signal[i] != LOGIQUE_0 && signal[i] != LOGIQUE_1 && signal[i] != LOGIQUE_X && signal[i] != LOGIQUE_Z)
+        {
+
+            return 0;
+        }
+    }
+
+    t_logique4_preparer_etats(simulation, 1);
+
+    //Un seul mot par net: la valeur est répétée sur les 64 bits des rails
+    for(int i = 0;i<netlist->nb_entrees;i++)
+    {
+        simulation->uns[i] = signal[i] == LOGIQUE_1 || signal[i] == LOGIQUE_X ? ~(uint64_t)0 : 0;
+        simulation->zeros[i] = signal[i] == LOGIQUE_0 || signal[i] == LOGIQUE_X ? ~(uint64_t)0 : 0;
+    }
+
+    t_logique4_evaluer(simulation, 1);
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        source = (size_t)netlist->sorties[j];
+
+        if((simulation->uns[source] & 1) == (simulation->zeros[source] & 1))
+        {
+            resultat[j] = (simulation->uns[source] & 1) ? LOGIQUE_X : LOGIQUE_Z;
+        }
+        else
+        {
+            resultat[j] = (int)(simulation->uns[source] & 1);
+        }
+    }
+
+
+    return 1;
+}
+
+void t_logique4_reinitialiser_etats(t_logique4 *simulation)
+{
+    simulation->nb_mots_etats = 0;
+}
+
+long long t_logique4_nb_etats_inconnus(const t_logique4 *simulation)
+{
+    const t_netlist *netlist = simulation->netlist;
+    const int nb_mots = simulation->nb_mots_etats;
+    long long nb_inconnus = 0;
+    size_t etat;
+
+    if(nb_mots == 0)
+    {
+
+        return -1;
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        etat = (size_t)(netlist->nb_entrees + netlist->bascules[b]) * nb_mots;
+
+        for(int m = 0;m<nb_mots;m++)
+        {
+            nb_inconnus += __builtin_popcountll(simulation->uns[etat + m] & simulation->zeros[etat + m]);
+        }
+    }
+
+
+    return nb_inconnus;
+}
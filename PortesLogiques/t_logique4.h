@@ -0,0 +1,132 @@
+/*
+Module: T_LOGIQUE4
+Description: Simulation d'une netlist en logique à quatre valeurs: 0, 1, X (inconnu) et Z (haute
+			 impédance: signal non alimenté). Sert à l'analyse de l'initialisation: les bascules
+			 partent de X et une séquence de remise à zéro doit les rendre toutes connues.
+
+			 Codage à deux rails (voir t_porte_calculer_mots_x): chaque net a un mot "uns" (peut
+			 valoir 1) et un mot "zeros" (peut valoir 0) par groupe de 64 vecteurs, si bien que la
+			 propagation des X simule 64 vecteurs par mot comme t_netlist_simuler_lot, pour
+			 environ trois fois plus d'opérations par porte.
+
+			   valeur   uns  zeros
+			   0         0     1
+			   1         1     0
+			   X         1     1
+			   Z         0     0
+
+			 Les rails des entrées et des sorties ont la disposition de t_circuit_simuler_lot: le
+			 mot m du signal i est uns[i * nb_mots + m] (et zeros[i * nb_mots + m]).
+*/
+
+#ifndef T_LOGIQUE4_H_
+#define T_LOGIQUE4_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+
+typedef struct t_circuit t_circuit;
+typedef struct t_netlist t_netlist;
+
+//Valeurs d'un signal (X vaut -1 comme une pin inactive)
+enum e_logique4 { LOGIQUE_0 = 0, LOGIQUE_1 = 1, LOGIQUE_X = -1, LOGIQUE_Z = 2 };
+typedef enum e_logique4 e_logique4;
+
+struct t_logique4 {
+	t_netlist *netlist; //Netlist simulée (celle du circuit: elle doit rester à jour)
+	uint64_t *uns; //Rail "peut valoir 1" des nets (nb_nets * nb_mots mots)
+	uint64_t *zeros; //Rail "peut valoir 0" des nets (nb_nets * nb_mots mots)
+	int nb_mots; //Nombre de mots par net alloués dans uns et zeros
+	//Prochain état des bascules au front d'horloge (nb_bascules * nb_mots mots par rail)
+	uint64_t *suivants_uns;
+	uint64_t *suivants_zeros;
+	//Nombre de mots par net de l'état des bascules rangé dans uns et zeros (0: l'état est à remettre à X)
+	int nb_mots_etats;
+};
+
+typedef struct t_logique4 t_logique4;
+
+/*
+Fonction: T_LOGIQUE4_INIT
+Description: Prépare la simulation à quatre valeurs d'un circuit. L'état des bascules est X.
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+Retour: Pointeur vers le simulateur, NULL si le circuit est invalide ou si la mémoire manque.
+*/
+t_logique4 *t_logique4_init(t_circuit *circuit);
+
+/*
+Fonction: T_LOGIQUE4_DESTROY
+Description: Libère la mémoire occupée par le simulateur (la netlist reste au circuit).
+Paramètres:
+- simulation: Pointeur vers le simulateur à détruire (NULL: aucun effet).
+Retour: Aucun.
+*/
+void t_logique4_destroy(t_logique4 *simulation);
+
+/*
+Fonction: T_LOGIQUE4_SIMULER_LOT
+Description: Simule un lot de vecteurs à quatre valeurs. Les bascules fournissent leur état courant.
+Paramètres:
+- simulation: Pointeur vers le simulateur.
+- entrees_uns, entrees_zeros: Rails des entrées (nb_entrees * nb_mots mots chacun).
+- sorties_uns, sorties_zeros: Tableaux (nb_sorties * nb_mots mots chacun) qui reçoivent les
+							   rails des sorties.
+- nb_mots: Nombre de mots par entrée.
+Retour: Booléen: Vrai si le lot a été simulé, faux si la mémoire manque.
+*/
+int t_logique4_simuler_lot(t_logique4 *simulation, const uint64_t entrees_uns[], const uint64_t entrees_zeros[],
+                           uint64_t sorties_uns[], uint64_t sorties_zeros[], int nb_mots);
+
+/*
+Fonction: T_LOGIQUE4_SIMULER_CYCLES
+Description: Simule nb_cycles cycles d'horloge (même sémantique et même disposition des tableaux
+			 que t_netlist_simuler_cycles, un tableau par rail). L'état des bascules est conservé
+			 d'un appel à l'autre; il part de X et est remis à X si nb_mots change. Une bascule
+			 dont l'entrée vaut Z prend l'état X.
+Paramètres:
+- simulation: Pointeur vers le simulateur.
+- entrees_uns, entrees_zeros: Rails des entrées de chaque cycle.
+- sorties_uns, sorties_zeros: Tableaux (nb_cycles * nb_sorties * nb_mots mots chacun) qui
+							   reçoivent les rails des sorties de chaque cycle.
+- nb_cycles: Nombre de cycles à simuler.
+- nb_mots: Nombre de mots par entrée.
+Retour: Booléen: Vrai si les cycles ont été simulés, faux si la mémoire manque.
+*/
+int t_logique4_simuler_cycles(t_logique4 *simulation, const uint64_t entrees_uns[], const uint64_t entrees_zeros[],
+                              uint64_t sorties_uns[], uint64_t sorties_zeros[], int nb_cycles, int nb_mots);
+
+/*
+Fonction: T_LOGIQUE4_SIMULER
+Description: Simule un seul vecteur donné par ses valeurs (e_logique4). Les bascules fournissent
+			 leur état courant, sur un mot.
+Paramètres:
+- simulation: Pointeur vers le simulateur.
+- signal: Valeur de chaque entrée (LOGIQUE_0, LOGIQUE_1, LOGIQUE_X ou LOGIQUE_Z).
+- resultat: Tableau (nb_sorties éléments) qui reçoit la valeur de chaque sortie.
+Retour: Booléen: Vrai si le vecteur a été simulé, faux si une valeur est invalide ou si la
+		mémoire manque.
+*/
+int t_logique4_simuler(t_logique4 *simulation, const int signal[], int resultat[]);
+
+/*
+Fonction: T_LOGIQUE4_REINITIALISER_ETATS
+Description: Remet l'état de toutes les bascules à X (au prochain cycle simulé).
+Paramètres:
+- simulation: Pointeur vers le simulateur.
+Retour: Aucun.
+*/
+void t_logique4_reinitialiser_etats(t_logique4 *simulation);
+
+/*
+Fonction: T_LOGIQUE4_NB_ETATS_INCONNUS
+Description: Compte les états de bascule encore inconnus (X) après la dernière simulation: une
+			 bascule compte une fois pour chacune des 64 * nb_mots séquences simulées où son
+			 état est X. Une séquence d'initialisation est complète quand le compte est nul.
+Paramètres:
+- simulation: Pointeur vers le simulateur.
+Retour: Nombre d'états inconnus, -1 si aucun état n'a encore été simulé.
+*/
+long long t_logique4_nb_etats_inconnus(const t_logique4 *simulation);
+
+#endif
@@ -0,0 +1,676 @@
+//
+// Netlist compilée à partir d'un t_circuit (voir t_netlist.h).
+//
+
+#include "t_netlist.h"
+
+//Alloue les valeurs des nets pour au moins nb_mots mots par net
+static int t_netlist_reserver_mots(t_netlist *netlist, int nb_mots)
+{
+    uint64_t *valeurs;
+
+    if(nb_mots <= netlist->nb_mots)
+    {
+
+        return 1;
+    }
+
+    valeurs = (uint64_t*)realloc(netlist->valeurs, sizeof(uint64_t) * netlist->nb_nets * nb_mots);
+
+    if(valeurs == NULL)
+    {
+
+        return 0;
+    }
+
+    netlist->valeurs = valeurs;
+
+    if(netlist->nb_bascules > 0)
+    {
+        valeurs = (uint64_t*)realloc(netlist->suivants, sizeof(uint64_t) * netlist->nb_bascules * nb_mots);
+
+        if(valeurs == NULL)
+        {
+
+            return 0;
+        }
+
+        netlist->suivants = valeurs;
+    }
+
+    if(netlist->transitions != NULL)
+    {
+        valeurs = (uint64_t*)realloc(netlist->precedents, sizeof(uint64_t) * nb_mots);
+
+        if(valeurs == NULL)
+        {
+
+            return 0;
+        }
+
+        netlist->precedents = valeurs;
+    }
+
+    netlist->nb_mots = nb_mots;
+
+
+    return 1;
+}
+
+t_netlist *t_netlist_compiler(t_circuit *circuit)
+{
+    t_netlist *netlist;
+    t_porte *porte;
+    t_pin_entree *pin;
+    int nb_liens = 0;
+    int nb_bascules = 0;
+    int position;
+
+    if(t_circuit_ordonner(circuit) == 0)
+    {
+
+        return NULL;
+    }
+
+    for(int k = 0;k<circuit->nb_portes;k++)
+    {
+        for(int i = 0;i<circuit->ordre[k]->nb_entrees;i++)
+        {
+            if(t_pin_entree_est_reliee(circuit->ordre[k]->entrees[i]) == 0)
+            {
+
+                return NULL;
+            }
+        }
+
+        nb_liens += circuit->ordre[k]->nb_entrees;
+        nb_bascules += circuit->ordre[k]->type == PORTE_DFF;
+    }
+
+    for(int j = 0;j<circuit->nb_sorties;j++)
+    {
+        if(t_sortie_est_reliee(circuit->sorties[j]) == 0)
+        {
+
+            return NULL;
+        }
+    }
+
+    netlist = (t_netlist*)calloc(1, sizeof(t_netlist));
+
+    if(netlist == NULL)
+    {
+
+        return NULL;
+    }
+
+    netlist->nb_entrees = circuit->nb_entrees;
+    netlist->nb_sorties = circuit->nb_sorties;
+    netlist->nb_portes = circuit->nb_portes;
+    netlist->nb_nets = circuit->nb_entrees + circuit->nb_portes;
+    netlist->nb_niveaux = circuit->nb_niveaux;
+    netlist->nb_bascules = nb_bascules;
+
+    netlist->types = (unsigned char*)malloc(sizeof(unsigned char) * (netlist->nb_portes + 1));
+    netlist->debut_entrees = (int*)malloc(sizeof(int) * (netlist->nb_portes + 1));
+    netlist->entrees = (int*)malloc(sizeof(int) * (nb_liens + 1));
+    netlist->debut_fanout = (int*)calloc(netlist->nb_nets + 1, sizeof(int));
+    netlist->fanout = (int*)malloc(sizeof(int) * (nb_liens + 1));
+    netlist->debut_niveaux = (int*)calloc(netlist->nb_niveaux + 1, sizeof(int));
+    netlist->niveaux = (int*)malloc(sizeof(int) * (netlist->nb_portes + 1));
+    netlist->sorties = (int*)malloc(sizeof(int) * (netlist->nb_sorties + 1));
+    netlist->portes = (t_porte**)malloc(sizeof(t_porte*) * (netlist->nb_portes + 1));
+    netlist->bascules = (int*)malloc(sizeof(int) * (nb_bascules + 1));
+
+    if(netlist->types == NULL || netlist->debut_entrees == NULL || netlist->entrees == NULL
+       || netlist->debut_fanout == NULL || netlist->fanout == NULL || netlist->debut_niveaux == NULL
+       || netlist->niveaux == NULL || netlist->sorties == NULL || netlist->portes == NULL
+       || netlist->bascules == NULL || t_netlist_reserver_mots(netlist, 1) == 0)
+    {
+        t_netlist_destroy(netlist);
+
+        return NULL;
+    }
+
+    //Entrées de chaque porte (les pins sortie ont été numérotées par t_circuit_ordonner)
+    nb_liens = 0;
+    nb_bascules = 0;
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        porte = circuit->ordre[k];
+        netlist->types[k] = (unsigned char)porte->type;
+        netlist->portes[k] = porte;
+        netlist->debut_entrees[k] = nb_liens;
+
+        if(porte->type == PORTE_DFF)
+        {
+            netlist->bascules[nb_bascules++] = k;
+        }
+
+        for(int i = 0;i<porte->nb_entrees;i++)
+        {
+            pin = porte->entrees[i];
+            netlist->entrees[nb_liens++] = pin->liaison->indice;
+            netlist->debut_fanout[pin->liaison->indice + 1] += porte->type != PORTE_DFF;
+        }
+
+        netlist->niveaux[k] = circuit->niveaux[porte->id];
+        netlist->debut_niveaux[netlist->niveaux[k] + 1]++;
+    }
+
+    netlist->debut_entrees[netlist->nb_portes] = nb_liens;
+
+    //Fanout en format compressé (CSR): cumul des compteurs puis remplissage
+    for(int n = 0;n<netlist->nb_nets;n++)
+    {
+        netlist->debut_fanout[n + 1] += netlist->debut_fanout[n];
+    }
+
+    for(int l = 0;l<netlist->nb_niveaux;l++)
+    {
+        netlist->debut_niveaux[l + 1] += netlist->debut_niveaux[l];
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        for(int i = netlist->debut_entrees[k];i<netlist->debut_entrees[k + 1] && netlist->types[k] != PORTE_DFF;i++)
+        {
+            position = netlist->debut_fanout[netlist->entrees[i]]++;
+            netlist->fanout[position] = k;
+        }
+    }
+
+    for(int n = netlist->nb_nets;n>0;n--)
+    {
+        netlist->debut_fanout[n] = netlist->debut_fanout[n - 1];
+    }
+
+    netlist->debut_fanout[0] = 0;
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        netlist->sorties[j] = circuit->sorties[j]->pin->liaison->indice;
+    }
+
+
+    return netlist;
+}
+
+void t_netlist_destroy(t_netlist *netlist)
+{
+    if(netlist == NULL)
+    {
+
+        return;
+    }
+
+    free(netlist->types);
+    free(netlist->debut_entrees);
+    free(netlist->entrees);
+    free(netlist->debut_fanout);
+    free(netlist->fanout);
+    free(netlist->debut_niveaux);
+    free(netlist->niveaux);
+    free(netlist->file_evenements);
+    free(netlist->nb_evenements);
+    free(netlist->en_file);
+    free(netlist->sorties);
+    free(netlist->portes);
+    free(netlist->bascules);
+    free(netlist->suivants);
+    free(netlist->valeurs);
+    free(netlist->transitions);
+    free(netlist->precedents);
+    free(netlist);
+}
+
+void t_netlist_evaluer(const t_netlist *netlist, uint64_t *valeurs, int nb_mots)
+{
+    t_netlist_evaluer_portes(netlist, valeurs, nb_mots, 0, netlist->nb_portes);
+}
+
+void t_netlist_evaluer_portes(const t_netlist *netlist, uint64_t *valeurs, int nb_mots, int premiere, int derniere)
+{
+    const int *entrees = netlist->entrees;
+    int debut;
+    int fin;
+
+    for(int k = premiere;k<derniere;k++)
+    {
+        debut = netlist->debut_entrees[k];
+        fin = netlist->debut_entrees[k + 1];
+
+        t_porte_calculer_mots((e_types_portes)netlist->types[k], valeurs, &entrees[debut], fin - debut,
+                              &valeurs[(size_t)(netlist->nb_entrees + k) * nb_mots], nb_mots);
+    }
+}
+
+//Sans l'instruction POPCNT (absente de la cible x86-64 de base), __builtin_popcountll est un appel
+//de fonction qui coûte plus que l'évaluation d'une porte: les compteurs de transitions ont une
+//version POPCNT, choisie par t_netlist_compter_transitions si le processeur l'a. Le choix est fait
+//à l'exécution et pas par target_clones, dont le résolveur (ifunc) est appelé avant l'initialisation
+//de ThreadSanitizer et fait échouer tout programme compilé avec -fsanitize=thread.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TRANSITIONS_POPCNT
+#define EN_LIGNE_TRANSITIONS __attribute__((always_inline)) inline
+#else
+#define EN_LIGNE_TRANSITIONS inline
+#endif
+
+//Transitions d'une séquence de nb_mots mots: le bit k est comparé au bit k - 1, le bit 0 d'un mot
+//au bit 63 du mot précédent (retenue pour le premier mot)
+static EN_LIGNE_TRANSITIONS long long t_netlist_transitions_lot(const uint64_t mots[], int nb_mots, uint64_t retenue)
+{
+    long long nb = 0;
+
+    for(int m = 0;m<nb_mots;m++)
+    {
+        nb += __builtin_popcountll(mots[m] ^ (mots[m] << 1 | retenue));
+        retenue = mots[m] >> 63;
+    }
+
+
+    return nb;
+}
+
+//Transitions de chaque bit entre deux cycles
+static EN_LIGNE_TRANSITIONS long long t_netlist_transitions_cycles(const uint64_t mots[], const uint64_t precedents[], int nb_mots)
+{
+    long long nb = 0;
+
+    for(int m = 0;m<nb_mots;m++)
+    {
+        nb += __builtin_popcountll(mots[m] ^ precedents[m]);
+    }
+
+
+    return nb;
+}
+
+#ifdef TRANSITIONS_POPCNT
+//Versions POPCNT: le corps des fonctions ci-dessus est recompilé pour la cible popcnt
+__attribute__((target("popcnt")))
+static long long t_netlist_transitions_lot_popcnt(const uint64_t mots[], int nb_mots, uint64_t retenue)
+{
+
+    return t_netlist_transitions_lot(mots, nb_mots, retenue);
+}
+
+__attribute__((target("popcnt")))
+static long long t_netlist_transitions_cycles_popcnt(const uint64_t mots[], const uint64_t precedents[], int nb_mots)
+{
+
+    return t_netlist_transitions_cycles(mots, precedents, nb_mots);
+}
+#endif
+
+//Évalue toutes les portes et compte les transitions de leur sortie (voir t_netlist_compter_transitions).
+//Les mots d'une porte sont comptés juste après leur calcul, pendant qu'ils sont dans le cache. En
+//mode cycles, les mots du cycle précédent sont sauvés avant d'être remplacés.
+static void t_netlist_evaluer_transitions(t_netlist *netlist, int nb_mots, int mode)
+{
+    const int amorce = netlist->amorce_transitions == mode && netlist->nb_mots_amorce == nb_mots;
+    uint64_t *sortie;
+    uint64_t retenue = 0;
+    int debut;
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        //L'état d'une bascule ne change qu'au front d'horloge (compté par t_netlist_front_horloge)
+        if(netlist->types[k] == PORTE_DFF)
+        {
+            continue;
+        }
+
+        debut = netlist->debut_entrees[k];
+        sortie = &netlist->valeurs[(size_t)(netlist->nb_entrees + k) * nb_mots];
+
+        if(mode == TRANSITIONS_LOT && amorce)
+        {
+            //Le premier vecteur suit le dernier vecteur du lot précédent
+            retenue = sortie[nb_mots - 1] >> 63;
+        }
+        else if(mode == TRANSITIONS_CYCLES && amorce)
+        {
+            memcpy(netlist->precedents, sortie, sizeof(uint64_t) * nb_mots);
+        }
+
+        t_porte_calculer_mots((e_types_portes)netlist->types[k], netlist->valeurs, &netlist->entrees[debut],
+                              netlist->debut_entrees[k + 1] - debut, sortie, nb_mots);
+
+        if(mode == TRANSITIONS_LOT)
+        {
+            //Sans lot précédent, le premier vecteur est comparé à lui-même
+            netlist->transitions[k] += netlist->transitions_lot(sortie, nb_mots, amorce ? retenue : sortie[0] & 1);
+        }
+        else if(amorce)
+        {
+            netlist->transitions[k] += netlist->transitions_cycles(sortie, netlist->precedents, nb_mots);
+        }
+    }
+
+    netlist->nb_paires += amorce || mode == TRANSITIONS_LOT ? 64LL * nb_mots - !amorce : 0;
+    netlist->amorce_transitions = mode;
+    netlist->nb_mots_amorce = nb_mots;
+}
+
+//Ajoute à la file d'événements les portes alimentées par le net (si elles n'y sont pas déjà)
+static void t_netlist_planifier_fanout(t_netlist *netlist, int net)
+{
+    int porte;
+    int niveau;
+
+    for(int i = netlist->debut_fanout[net];i<netlist->debut_fanout[net + 1];i++)
+    {
+        porte = netlist->fanout[i];
+
+        if(netlist->en_file[porte] == 0)
+        {
+            niveau = netlist->niveaux[porte];
+            netlist->file_evenements[netlist->debut_niveaux[niveau] + netlist->nb_evenements[niveau]] = porte;
+            netlist->nb_evenements[niveau]++;
+            netlist->en_file[porte] = 1;
+        }
+    }
+}
+
+//Place l'état des bascules dans les nets pour des valeurs de nb_mots mots par net: l'état est
+//remis à zéro s'il a été rangé avec un autre nombre de mots (ou jamais)
+static void t_netlist_preparer_etats(t_netlist *netlist, int nb_mots)
+{
+    if(netlist->nb_mots_etats == nb_mots)
+    {
+
+        return;
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        memset(&netlist->valeurs[(size_t)(netlist->nb_entrees + netlist->bascules[b]) * nb_mots], 0,
+               sizeof(uint64_t) * nb_mots);
+    }
+
+    netlist->nb_mots_etats = nb_mots;
+}
+
+//Front d'horloge: chaque bascule prend la valeur de son entrée. Les entrées sont toutes lues
+//avant d'écrire les états, car l'entrée d'une bascule peut être l'état d'une autre.
+static void t_netlist_front_horloge(t_netlist *netlist, int nb_mots)
+{
+    uint64_t *valeurs = netlist->valeurs;
+    int porte;
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        porte = netlist->bascules[b];
+        memcpy(&netlist->suivants[(size_t)b * nb_mots],
+               &valeurs[(size_t)netlist->entrees[netlist->debut_entrees[porte]] * nb_mots], sizeof(uint64_t) * nb_mots);
+    }
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        porte = netlist->bascules[b];
+
+        if(netlist->transitions != NULL)
+        {
+            netlist->transitions[porte] += netlist->transitions_cycles(&valeurs[(size_t)(netlist->nb_entrees + porte) * nb_mots],
+                                                                        &netlist->suivants[(size_t)b * nb_mots], nb_mots);
+        }
+
+        memcpy(&valeurs[(size_t)(netlist->nb_entrees + porte) * nb_mots],
+               &netlist->suivants[(size_t)b * nb_mots], sizeof(uint64_t) * nb_mots);
+    }
+}
+
+int t_netlist_simuler_lot(t_netlist *netlist, const uint64_t entrees[], uint64_t sorties[], int nb_mots)
+{
+    if(t_netlist_reserver_mots(netlist, nb_mots) == 0)
+    {
+
+        return 0;
+    }
+
+    t_netlist_preparer_etats(netlist, nb_mots);
+    memcpy(netlist->valeurs, entrees, sizeof(uint64_t) * netlist->nb_entrees * nb_mots);
+    netlist->etat_valide = 0;
+
+    if(netlist->transitions != NULL)
+    {
+        t_netlist_evaluer_transitions(netlist, nb_mots, TRANSITIONS_LOT);
+    }
+    else
+    {
+        t_netlist_evaluer(netlist, netlist->valeurs, nb_mots);
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        memcpy(&sorties[j * nb_mots], &netlist->valeurs[netlist->sorties[j] * nb_mots],
+               sizeof(uint64_t) * nb_mots);
+    }
+
+
+    return 1;
+}
+
+int t_netlist_simuler_cycles(t_netlist *netlist, const uint64_t entrees[], uint64_t sorties[], int nb_cycles, int nb_mots)
+{
+    size_t taille_entrees = (size_t)netlist->nb_entrees * nb_mots;
+    size_t taille_sorties = (size_t)netlist->nb_sorties * nb_mots;
+
+    if(t_netlist_reserver_mots(netlist, nb_mots) == 0)
+    {
+
+        return 0;
+    }
+
+    t_netlist_preparer_etats(netlist, nb_mots);
+    netlist->etat_valide = 0;
+
+    for(int c = 0;c<nb_cycles;c++)
+    {
+        memcpy(netlist->valeurs, &entrees[c * taille_entrees], sizeof(uint64_t) * taille_entrees);
+
+        if(netlist->transitions != NULL)
+        {
+            t_netlist_evaluer_transitions(netlist, nb_mots, TRANSITIONS_CYCLES);
+        }
+        else
+        {
+            t_netlist_evaluer(netlist, netlist->valeurs, nb_mots);
+        }
+
+        for(int j = 0;j<netlist->nb_sorties;j++)
+        {
+            memcpy(&sorties[c * taille_sorties + (size_t)j * nb_mots], &netlist->valeurs[(size_t)netlist->sorties[j] * nb_mots],
+                   sizeof(uint64_t) * nb_mots);
+        }
+
+        t_netlist_front_horloge(netlist, nb_mots);
+    }
+
+
+    return 1;
+}
+
+int t_netlist_compter_transitions(t_netlist *netlist, int actif)
+{
+    free(netlist->transitions);
+    free(netlist->precedents);
+    netlist->transitions = NULL;
+    netlist->precedents = NULL;
+    netlist->nb_paires = 0;
+    netlist->amorce_transitions = 0;
+
+    if(actif == 0)
+    {
+
+        return 1;
+    }
+
+    netlist->transitions = (long long*)calloc(netlist->nb_portes + 1, sizeof(long long));
+    netlist->precedents = (uint64_t*)malloc(sizeof(uint64_t) * (netlist->nb_mots + 1));
+
+    netlist->transitions_lot = t_netlist_transitions_lot;
+    netlist->transitions_cycles = t_netlist_transitions_cycles;
+
+#ifdef TRANSITIONS_POPCNT
+    if(__builtin_cpu_supports("popcnt"))
+    {
+        netlist->transitions_lot = t_netlist_transitions_lot_popcnt;
+        netlist->transitions_cycles = t_netlist_transitions_cycles_popcnt;
+    }
+#endif
+
+    if(netlist->transitions == NULL || netlist->precedents == NULL)
+    {
+        free(netlist->transitions);
+        free(netlist->precedents);
+        netlist->transitions = NULL;
+        netlist->precedents = NULL;
+
+        return 0;
+    }
+
+
+    return 1;
+}
+
+void t_netlist_reinitialiser_etats(t_netlist *netlist)
+{
+    netlist->nb_mots_etats = 0;
+}
+
+void t_netlist_lire_etats(const t_netlist *netlist, uint64_t *valeurs, int nb_mots, long long premier_mot, long long nb_mots_lot)
+{
+    size_t net;
+
+    for(int b = 0;b<netlist->nb_bascules;b++)
+    {
+        net = (size_t)(netlist->nb_entrees + netlist->bascules[b]);
+
+        if(netlist->nb_mots_etats == nb_mots_lot)
+        {
+            memcpy(&valeurs[net * nb_mots], &netlist->valeurs[net * nb_mots_lot + premier_mot], sizeof(uint64_t) * nb_mots);
+        }
+        else
+        {
+            memset(&valeurs[net * nb_mots], 0, sizeof(uint64_t) * nb_mots);
+        }
+    }
+}
+
+int t_netlist_simuler(t_netlist *netlist, const int signal[], int resultat[])
+{
+    //Un seul mot par net: le signal est répété sur les 64 bits du mot
+    t_netlist_preparer_etats(netlist, 1);
+
+    for(int i = 0;i<netlist->nb_entrees;i++)
+    {
+        if(signal[i] != 0 && signal[i] != 1)
+        {
+
+            return 0;
+        }
+
+        netlist->valeurs[i] = signal[i] ? ~(uint64_t)0 : 0;
+    }
+
+    t_netlist_evaluer(netlist, netlist->valeurs, 1);
+    t_netlist_lire_sorties(netlist, resultat);
+
+    netlist->etat_valide = 1;
+    netlist->amorce_transitions = 0; //Les valeurs ne sont plus le dernier vecteur d'un lot ou d'un cycle
+    netlist->nb_evaluations += netlist->nb_portes;
+
+
+    return 1;
+}
+
+int t_netlist_simuler_increment(t_netlist *netlist, const int indices[], const int valeurs[], int nb)
+{
+    uint64_t *mots = netlist->valeurs;
+    uint64_t nouvelle_valeur;
+    int nb_evaluees = 0;
+    int porte;
+    int debut;
+    int fin;
+
+    if(netlist->etat_valide == 0)
+    {
+
+        return -1;
+    }
+
+    if(netlist->file_evenements == NULL)
+    {
+        netlist->file_evenements = (int*)malloc(sizeof(int) * (netlist->nb_portes + 1));
+        netlist->nb_evenements = (int*)calloc(netlist->nb_niveaux + 1, sizeof(int));
+        netlist->en_file = (unsigned char*)calloc(netlist->nb_portes + 1, sizeof(unsigned char));
+
+        if(netlist->file_evenements == NULL || netlist->nb_evenements == NULL || netlist->en_file == NULL)
+        {
+
+            return -1;
+        }
+    }
+
+    for(int i = 0;i<nb;i++)
+    {
+        if(indices[i] < 0 || indices[i] >= netlist->nb_entrees || (valeurs[i] != 0 && valeurs[i] != 1))
+        {
+
+            return -1;
+        }
+    }
+
+    for(int i = 0;i<nb;i++)
+    {
+        nouvelle_valeur = valeurs[i] ? ~(uint64_t)0 : 0;
+
+        if(mots[indices[i]] != nouvelle_valeur)
+        {
+            mots[indices[i]] = nouvelle_valeur;
+            t_netlist_planifier_fanout(netlist, indices[i]);
+        }
+    }
+
+    //Une porte n'alimente que des portes de niveau supérieur: chaque file est complète
+    //lorsqu'on l'atteint.
+    for(int l = 0;l<netlist->nb_niveaux;l++)
+    {
+        for(int i = 0;i<netlist->nb_evenements[l];i++)
+        {
+            porte = netlist->file_evenements[netlist->debut_niveaux[l] + i];
+            debut = netlist->debut_entrees[porte];
+            fin = netlist->debut_entrees[porte + 1];
+
+            t_porte_calculer_mots((e_types_portes)netlist->types[porte], mots, &netlist->entrees[debut], fin - debut,
+                                  &nouvelle_valeur, 1);
+            nb_evaluees++;
+            netlist->en_file[porte] = 0;
+
+            if(nouvelle_valeur != mots[netlist->nb_entrees + porte])
+            {
+                mots[netlist->nb_entrees + porte] = nouvelle_valeur;
+                t_netlist_planifier_fanout(netlist, netlist->nb_entrees + porte);
+            }
+        }
+
+        netlist->nb_evenements[l] = 0;
+    }
+
+    netlist->nb_evaluations += nb_evaluees;
+
+
+    return nb_evaluees;
+}
+
+void t_netlist_lire_sorties(const t_netlist *netlist, int resultat[])
+{
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        resultat[j] = (int)(netlist->valeurs[netlist->sorties[j]] & 1);
+    }
+}
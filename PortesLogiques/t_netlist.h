@@ -0,0 +1,266 @@
+/*
+Module: T_NETLIST
+Description: Définit le type t_netlist, une forme compilée d'un circuit utilisée pour la simulation
+			 rapide. Un circuit (t_circuit) est construit avec les portes, entrées et sorties
+			 habituelles, puis compilé en une netlist: des tableaux contigus qui décrivent le type
+			 de chaque porte et les signaux (nets) qu'elle lit et qu'elle produit. La simulation
+			 sur une netlist ne parcourt jamais les pointeurs entre les pins.
+
+			 Numérotation des nets: les entrées du circuit ont les nets 0 à nb_entrees-1, la porte k
+			 (dans l'ordre d'évaluation) produit le net nb_entrees + k.
+
+			 Les valeurs des nets sont stockées par mots de 64 bits (voir t_porte_calculer_mots):
+			 le mot m du net n est valeurs[n * nb_mots + m].
+
+			 Circuits séquentiels: une bascule (PORTE_DFF) est une porte du niveau 0 que
+			 l'évaluation ne modifie pas; son net contient son état. Un cycle d'horloge évalue les
+			 portes dans l'ordre puis copie l'entrée de chaque bascule dans son net (front d'horloge,
+			 voir t_netlist_simuler_cycles).
+*/
+
+#ifndef T_NETLIST_H_
+#define T_NETLIST_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+
+typedef struct t_circuit t_circuit;
+typedef struct t_porte t_porte;
+
+struct t_netlist {
+	int nb_entrees; //Nombre d'entrées du circuit
+	int nb_sorties; //Nombre de sorties du circuit
+	int nb_portes; //Nombre de portes
+	int nb_nets; //Nombre de nets (nb_entrees + nb_portes)
+	int nb_niveaux; //Nombre de niveaux du circuit
+
+	unsigned char *types; //Type de chaque porte (e_types_portes), dans l'ordre d'évaluation
+	//Entrées des portes: les nets lus par la porte k sont entrees[debut_entrees[k]]
+	//à entrees[debut_entrees[k+1]-1]
+	int *debut_entrees;
+	int *entrees;
+	//Portes alimentées par chaque net: fanout[debut_fanout[n]] à fanout[debut_fanout[n+1]-1]
+	//(les bascules n'y sont pas: leur entrée n'est lue qu'au front d'horloge)
+	int *debut_fanout;
+	int *fanout;
+	//Les portes du niveau l sont les portes debut_niveaux[l] à debut_niveaux[l+1]-1
+	int *debut_niveaux;
+	int *niveaux; //Niveau de chaque porte
+	int *sorties; //Net relié à chaque sortie du circuit
+	t_porte **portes; //Porte du circuit d'origine de chaque porte (pour les rapports)
+
+	uint64_t *valeurs; //Valeurs des nets (nb_nets * nb_mots mots)
+	int nb_mots; //Nombre de mots par net alloués dans valeurs
+
+	int nb_bascules; //Nombre de bascules (PORTE_DFF)
+	int *bascules; //Porte (dans l'ordre d'évaluation) de chaque bascule
+	uint64_t *suivants; //Prochain état des bascules au front d'horloge (nb_bascules * nb_mots mots)
+	//Nombre de mots par net de l'état des bascules rangé dans valeurs (0: l'état est à remettre à zéro)
+	int nb_mots_etats;
+
+	//File d'événements de la simulation incrémentale, une file par niveau: les portes en attente
+	//du niveau l sont file_evenements[debut_niveaux[l]] à file_evenements[debut_niveaux[l] + nb_evenements[l] - 1]
+	int *file_evenements;
+	int *nb_evenements;
+	unsigned char *en_file; //Booléen pour chaque porte: vrai si la porte est dans la file
+	//Booléen: vrai si valeurs contient le résultat complet d'un vecteur (voir t_netlist_simuler)
+	int etat_valide;
+	//Nombre total d'évaluations de portes effectuées par t_netlist_simuler et
+	//t_netlist_simuler_increment (mesure de l'activité du circuit)
+	long long nb_evaluations;
+
+	//Comptage des transitions (voir t_netlist_compter_transitions): nombre de changements de la
+	//sortie de chaque porte (NULL: comptage inactif)
+	long long *transitions;
+	long long nb_paires; //Nombre de paires de vecteurs consécutifs observées pour chaque porte
+	//Dernier vecteur observé: 0 (aucun), TRANSITIONS_LOT ou TRANSITIONS_CYCLES, rangé avec
+	//nb_mots_amorce mots par net dans valeurs
+	int amorce_transitions;
+	int nb_mots_amorce;
+	uint64_t *precedents; //Mots de sortie d'une porte au cycle précédent (nb_mots mots)
+	//Fonctions de comptage choisies pour le processeur quand le comptage est activé
+	long long (*transitions_lot)(const uint64_t mots[], int nb_mots, uint64_t retenue);
+	long long (*transitions_cycles)(const uint64_t mots[], const uint64_t precedents[], int nb_mots);
+};
+
+typedef struct t_netlist t_netlist;
+
+#define TRANSITIONS_LOT 1 //Vecteurs observés par t_netlist_simuler_lot (une seule séquence)
+#define TRANSITIONS_CYCLES 2 //Vecteurs observés par t_netlist_simuler_cycles (une séquence par bit)
+
+/*
+Fonction: T_NETLIST_COMPILER
+Description: Compile un circuit en netlist. Le circuit est d'abord ordonné (t_circuit_ordonner).
+			 Le circuit peut être modifié ou détruit par la suite sans affecter la netlist.
+Paramètres:
+- circuit: Pointeur vers le circuit à compiler.
+Retour: Pointeur vers la netlist créée. NULL si une entrée de porte ou une sortie du circuit
+		n'est pas reliée, si le circuit contient une boucle ou si la mémoire manque.
+*/
+t_netlist *t_netlist_compiler(t_circuit *circuit);
+
+/*
+Fonction: T_NETLIST_DESTROY
+Description: Libère la mémoire occupée par la netlist.
+Paramètres:
+- netlist: Pointeur vers la netlist à détruire.
+Retour: Aucun.
+*/
+void t_netlist_destroy(t_netlist *netlist);
+
+/*
+Fonction: T_NETLIST_EVALUER
+Description: Évalue toutes les portes de la netlist dans l'ordre. Les mots des nets d'entrée
+			 doivent déjà être placés dans le tableau valeurs.
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- valeurs: Valeurs des nets (nb_nets * nb_mots mots). Peut être un tableau autre que celui de
+		   la netlist (par exemple pour simuler plusieurs lots en même temps).
+- nb_mots: Nombre de mots par net dans valeurs.
+Retour: Aucun.
+*/
+void t_netlist_evaluer(const t_netlist *netlist, uint64_t *valeurs, int nb_mots);
+
+/*
+Fonction: T_NETLIST_EVALUER_PORTES
+Description: Évalue les portes premiere à derniere-1 (dans l'ordre d'évaluation). Les portes d'un
+			 même niveau ne dépendent pas les unes des autres: des tranches disjointes d'un niveau
+			 peuvent être évaluées en même temps (voir t_simulation_parallele).
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- valeurs: Valeurs des nets (voir t_netlist_evaluer).
+- nb_mots: Nombre de mots par net dans valeurs.
+- premiere: Première porte à évaluer.
+- derniere: Porte qui suit la dernière porte à évaluer.
+Retour: Aucun.
+*/
+void t_netlist_evaluer_portes(const t_netlist *netlist, uint64_t *valeurs, int nb_mots, int premiere, int derniere);
+
+/*
+Fonction: T_NETLIST_SIMULER_LOT
+Description: Simule un lot de vecteurs groupés par mots de 64 bits (même disposition que
+			 t_circuit_simuler_lot). Les bascules fournissent leur état courant (celui laissé par
+			 t_netlist_simuler_cycles avec le même nombre de mots, zéro sinon) et ne changent pas.
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- entrees: Mots des entrées: entrees[i * nb_mots + m] est le mot m de l'entrée i.
+- sorties: Tableau (nb_sorties * nb_mots mots) qui reçoit les mots des sorties.
+- nb_mots: Nombre de mots par entrée.
+Retour: Booléen: Vrai si le lot a été simulé, faux si la mémoire manque.
+*/
+int t_netlist_simuler_lot(t_netlist *netlist, const uint64_t entrees[], uint64_t sorties[], int nb_mots);
+
+/*
+Fonction: T_NETLIST_SIMULER_CYCLES
+Description: Simule nb_cycles cycles d'horloge d'un circuit séquentiel. À chaque cycle, les entrées
+			 du cycle sont appliquées, les portes sont évaluées une fois dans l'ordre des niveaux
+			 (les bascules fournissent leur état), les sorties sont lues, puis chaque bascule prend
+			 la valeur de son entrée (front d'horloge). L'état des bascules est conservé d'un appel
+			 à l'autre; il part de zéro et est remis à zéro si nb_mots change (chaque bit des mots
+			 est une simulation indépendante: 64 * nb_mots séquences à la fois).
+
+			 Sans bascule, chaque cycle est une simulation combinatoire (t_netlist_simuler_lot).
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- entrees: Mots des entrées de chaque cycle: entrees[(c * nb_entrees + i) * nb_mots + m] est le
+		   mot m de l'entrée i au cycle c.
+- sorties: Tableau (nb_cycles * nb_sorties * nb_mots mots) qui reçoit les mots des sorties de
+		   chaque cycle, même disposition.
+- nb_cycles: Nombre de cycles à simuler.
+- nb_mots: Nombre de mots par entrée.
+Retour: Booléen: Vrai si les cycles ont été simulés, faux si la mémoire manque.
+*/
+int t_netlist_simuler_cycles(t_netlist *netlist, const uint64_t entrees[], uint64_t sorties[], int nb_cycles, int nb_mots);
+
+/*
+Fonction: T_NETLIST_COMPTER_TRANSITIONS
+Description: Active ou désactive le comptage des transitions de la sortie de chaque porte, pour
+			 estimer l'activité (et la puissance dynamique) du circuit. Le comptage est fait
+			 pendant l'évaluation, sur les mots de la porte qui viennent d'être calculés: une
+			 opération XOR entre mots consécutifs et un comptage de bits par mot.
+
+			 - t_netlist_simuler_lot: les 64 * nb_mots vecteurs du lot forment une seule
+			   séquence (le vecteur 64 * m + k suit le vecteur 64 * m + k - 1), qui continue
+			   celle du lot précédent s'il avait le même nombre de mots.
+			 - t_netlist_simuler_cycles: chaque bit des mots est une séquence de cycles; une
+			   transition est un changement d'un cycle au suivant, y compris pour l'état des
+			   bascules au front d'horloge.
+
+			 Les autres simulations (t_netlist_simuler, simulation incrémentale, parallèle ou
+			 balayage) ne comptent rien. La première observation (ou celle qui suit un changement de
+			 mode ou de nombre de mots) n'a pas de vecteur précédent.
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- actif: Booléen: vrai pour (re)commencer le comptage à zéro, faux pour l'arrêter et libérer
+		 les compteurs.
+Retour: Booléen: Vrai si le comptage est dans l'état demandé, faux si la mémoire manque.
+*/
+int t_netlist_compter_transitions(t_netlist *netlist, int actif);
+
+/*
+Fonction: T_NETLIST_REINITIALISER_ETATS
+Description: Remet à zéro l'état de toutes les bascules (au prochain cycle simulé).
+Paramètres:
+- netlist: Pointeur vers la netlist.
+Retour: Aucun.
+*/
+void t_netlist_reinitialiser_etats(t_netlist *netlist);
+
+/*
+Fonction: T_NETLIST_LIRE_ETATS
+Description: Copie l'état courant des bascules dans un tableau de valeurs privé, sans modifier la
+			 netlist (pour les simulations qui évaluent la netlist partagée, voir t_simulation_parallele
+			 et t_balayage). L'état copié est celui que t_netlist_simuler_lot lirait pour un lot de
+			 nb_mots_lot mots par net: zéro si l'état a été rangé avec un autre nombre de mots.
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- valeurs: Valeurs des nets (nb_mots mots par net) qui reçoivent l'état des bascules.
+- nb_mots: Nombre de mots par net dans valeurs.
+- premier_mot: Rang, dans le lot, du premier mot à copier.
+- nb_mots_lot: Nombre de mots par net du lot.
+Retour: Aucun.
+*/
+void t_netlist_lire_etats(const t_netlist *netlist, uint64_t *valeurs, int nb_mots, long long premier_mot, long long nb_mots_lot);
+
+/*
+Fonction: T_NETLIST_SIMULER
+Description: Simule un seul vecteur. Équivalent à t_circuit_appliquer_signal suivi de
+			 t_circuit_propager_signal, sans modifier les pins du circuit.
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- signal: Valeur (0 ou 1) de chaque entrée.
+- resultat: Tableau (nb_sorties éléments) qui reçoit la valeur de chaque sortie.
+Retour: Booléen: Vrai si le vecteur a été simulé, faux sinon.
+*/
+int t_netlist_simuler(t_netlist *netlist, const int signal[], int resultat[]);
+
+/*
+Fonction: T_NETLIST_SIMULER_INCREMENT
+Description: Modifie la valeur de quelques entrées et ne ré-évalue que les portes touchées par
+			 ces changements. Les portes à évaluer sont placées dans une file d'événements triée
+			 par niveau: une porte n'est évaluée que si une de ses entrées a changé, et le
+			 changement cesse de se propager dès qu'une porte garde la même sortie.
+
+			 Un vecteur complet doit avoir été simulé au préalable avec t_netlist_simuler. Les
+			 nouvelles valeurs des sorties se lisent avec t_netlist_lire_sorties.
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- indices: Indices des entrées modifiées (identifiant de l'entrée dans le circuit).
+- valeurs: Nouvelle valeur (0 ou 1) de chacune de ces entrées.
+- nb: Nombre d'entrées modifiées.
+Retour: Nombre de portes évaluées. -1 si aucun vecteur n'a été simulé, si un indice ou une valeur
+		est invalide ou si la mémoire manque.
+*/
+int t_netlist_simuler_increment(t_netlist *netlist, const int indices[], const int valeurs[], int nb);
+
+/*
+Fonction: T_NETLIST_LIRE_SORTIES
+Description: Lit la valeur des sorties après t_netlist_simuler ou t_netlist_simuler_increment.
+Paramètres:
+- netlist: Pointeur vers la netlist.
+- resultat: Tableau (nb_sorties éléments) qui reçoit la valeur de chaque sortie.
+Retour: Aucun.
+*/
+void t_netlist_lire_sorties(const t_netlist *netlist, int resultat[]);
+
+#endif
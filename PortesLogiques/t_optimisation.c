@@ -0,0 +1,584 @@
+//
+// Optimisation logique d'un circuit (voir t_optimisation.h).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "t_optimisation.h"
+#include "t_netlist.h"
+
+//Les deux premiers noeuds du graphe sont les constantes, suivies des entrées du circuit
+#define NOEUD_ZERO 0
+#define NOEUD_UN 1
+#define NOEUD_PREMIERE_ENTREE 2
+//Type des noeuds qui représentent une entrée du circuit
+#define TYPE_ENTREE NB_TYPES_PORTES
+
+/*
+Graphe reconstruit par l'optimisation. Chaque noeud est une constante, une entrée du circuit ou
+une porte dont les opérandes sont des noeuds créés avant elle (sauf l'entrée d'une bascule, fixée
+à la fin). Les portes sont rangées dans une table de hachage pour retrouver les portes identiques.
+*/
+typedef struct {
+	unsigned char *types; //Type de chaque noeud (TYPE_ENTREE pour une entrée du circuit)
+	//Opérandes du noeud n: operandes[debut[n]] à operandes[debut[n+1]-1]
+	int *debut;
+	int *operandes;
+	int nb_noeuds;
+	int *table; //Table de hachage à adressage ouvert (-1 pour une case vide)
+	size_t masque_table; //Taille de la table - 1 (une puissance de 2)
+	int fusion; //Dernier noeud retrouvé dans la table (-1 si aucun)
+} t_graphe_optimisation;
+
+static int t_optimisation_comparer(const void *a, const void *b)
+{
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+
+
+    return (x > y) - (x < y);
+}
+
+/*
+Retrouve dans la table la porte de ce type et de ces opérandes, ou la crée.
+*/
+static int t_optimisation_creer(t_graphe_optimisation *graphe, e_types_portes type, const int operandes[], int nb)
+{
+    uint64_t hachage = 0x9E3779B97F4A7C15ull * (uint64_t)(type + 1) ^ (uint64_t)nb;
+    size_t position;
+    int noeud;
+
+    for(int i = 0;i<nb;i++)
+    {
+        hachage = (hachage ^ (uint64_t)operandes[i]) * 0x100000001B3ull;
+    }
+
+    position = (size_t)(hachage ^ hachage >> 29) & graphe->masque_table;
+
+    while(graphe->table[position] != -1)
+    {
+        noeud = graphe->table[position];
+
+        if(graphe->types[noeud] == type && graphe->debut[noeud + 1] - graphe->debut[noeud] == nb
+           && memcmp(&graphe->operandes[graphe->debut[noeud]], operandes, sizeof(int) * nb) == 0)
+        {
+            graphe->fusion = noeud;
+
+            return noeud;
+        }
+
+        position = (position + 1) & graphe->masque_table;
+    }
+
+    noeud = graphe->nb_noeuds++;
+    graphe->types[noeud] = (unsigned char)type;
+    memcpy(&graphe->operandes[graphe->debut[noeud]], operandes, sizeof(int) * nb);
+    graphe->debut[noeud + 1] = graphe->debut[noeud] + nb;
+    graphe->table[position] = noeud;
+
+
+    return noeud;
+}
+
+/*
+Retourne le noeud qui vaut NOT noeud: une constante, l'opérande d'un NOT ou un nouveau NOT.
+*/
+static int t_optimisation_inverser(t_graphe_optimisation *graphe, int noeud)
+{
+    if(noeud == NOEUD_ZERO || noeud == NOEUD_UN)
+    {
+
+        return noeud ^ 1;
+    }
+
+    if(graphe->types[noeud] == PORTE_NOT)
+    {
+
+        return graphe->operandes[graphe->debut[noeud]];
+    }
+
+
+    return t_optimisation_creer(graphe, PORTE_NOT, &noeud, 1);
+}
+
+/*
+ET, OU et leurs inverses: retire l'élément neutre et les opérandes répétés, et replie la porte sur
+une constante si un opérande est absorbant ou si un opérande et son inverse sont présents.
+*/
+static int t_optimisation_simplifier_et_ou(t_graphe_optimisation *graphe, e_types_portes type, int operandes[], int nb)
+{
+    int est_et = type == PORTE_ET || type == PORTE_NAND;
+    int inversion = type == PORTE_NAND || type == PORTE_NOR;
+    int neutre = est_et ? NOEUD_UN : NOEUD_ZERO;
+    int absorbant = neutre ^ 1;
+    int nb_restants = 0;
+    int inverse;
+
+    for(int i = 0;i<nb;i++)
+    {
+        if(operandes[i] == absorbant)
+        {
+
+            return absorbant ^ inversion;
+        }
+
+        if(operandes[i] != neutre)
+        {
+            operandes[nb_restants++] = operandes[i];
+        }
+    }
+
+    qsort(operandes, nb_restants, sizeof(int), t_optimisation_comparer);
+    nb = nb_restants;
+    nb_restants = 0;
+
+    for(int i = 0;i<nb;i++)
+    {
+        if(nb_restants == 0 || operandes[nb_restants - 1] != operandes[i])
+        {
+            operandes[nb_restants++] = operandes[i];
+        }
+    }
+
+    for(int i = 0;i<nb_restants;i++)
+    {
+        if(graphe->types[operandes[i]] == PORTE_NOT)
+        {
+            inverse = graphe->operandes[graphe->debut[operandes[i]]];
+
+            if(bsearch(&inverse, operandes, nb_restants, sizeof(int), t_optimisation_comparer) != NULL)
+            {
+
+                return absorbant ^ inversion;
+            }
+        }
+    }
+
+    if(nb_restants == 0)
+    {
+
+        return neutre ^ inversion;
+    }
+
+    if(nb_restants == 1)
+    {
+
+        return inversion ? t_optimisation_inverser(graphe, operandes[0]) : operandes[0];
+    }
+
+
+    return t_optimisation_creer(graphe, type, operandes, nb_restants);
+}
+
+/*
+XOR et XNOR: les constantes et les NOT des opérandes sont reportés sur l'inversion de la porte, et
+les opérandes répétés s'annulent deux à deux.
+*/
+static int t_optimisation_simplifier_xor(t_graphe_optimisation *graphe, e_types_portes type, int operandes[], int nb)
+{
+    int inversion = type == PORTE_XNOR;
+    int nb_restants = 0;
+
+    for(int i = 0;i<nb;i++)
+    {
+        if(operandes[i] == NOEUD_ZERO || operandes[i] == NOEUD_UN)
+        {
+            inversion ^= operandes[i];
+        }
+        else
+        {
+            if(graphe->types[operandes[i]] == PORTE_NOT)
+            {
+                inversion ^= 1;
+                operandes[i] = graphe->operandes[graphe->debut[operandes[i]]];
+            }
+
+            operandes[nb_restants++] = operandes[i];
+        }
+    }
+
+    qsort(operandes, nb_restants, sizeof(int), t_optimisation_comparer);
+    nb = nb_restants;
+    nb_restants = 0;
+
+    for(int i = 0;i<nb;i++)
+    {
+        if(nb_restants > 0 && operandes[nb_restants - 1] == operandes[i])
+        {
+            nb_restants--;
+        }
+        else
+        {
+            operandes[nb_restants++] = operandes[i];
+        }
+    }
+
+    if(nb_restants == 0)
+    {
+
+        return NOEUD_ZERO ^ inversion;
+    }
+
+    if(nb_restants == 1)
+    {
+
+        return inversion ? t_optimisation_inverser(graphe, operandes[0]) : operandes[0];
+    }
+
+
+    return t_optimisation_creer(graphe, inversion ? PORTE_XNOR : PORTE_XOR, operandes, nb_restants);
+}
+
+/*
+MUX (s, a, b): une sélection constante choisit une branche, deux branches égales remplacent la
+porte, les branches (0, 1) donnent s et (1, 0) NOT s. Une sélection inversée échange les branches.
+*/
+static int t_optimisation_simplifier_mux(t_graphe_optimisation *graphe, int operandes[])
+{
+    int temporaire;
+
+    if(operandes[0] == NOEUD_ZERO || operandes[0] == NOEUD_UN)
+    {
+
+        return operandes[1 + operandes[0]];
+    }
+
+    if(operandes[1] == operandes[2])
+    {
+
+        return operandes[1];
+    }
+
+    if(operandes[1] == NOEUD_ZERO && operandes[2] == NOEUD_UN)
+    {
+
+        return operandes[0];
+    }
+
+    if(operandes[1] == NOEUD_UN && operandes[2] == NOEUD_ZERO)
+    {
+
+        return t_optimisation_inverser(graphe, operandes[0]);
+    }
+
+    if(graphe->types[operandes[0]] == PORTE_NOT)
+    {
+        operandes[0] = graphe->operandes[graphe->debut[operandes[0]]];
+        temporaire = operandes[1];
+        operandes[1] = operandes[2];
+        operandes[2] = temporaire;
+    }
+
+
+    return t_optimisation_creer(graphe, PORTE_MUX, operandes, 3);
+}
+
+/*
+Retourne le noeud qui remplace une porte combinatoire dont les opérandes sont déjà des noeuds.
+*/
+static int t_optimisation_simplifier_porte(t_graphe_optimisation *graphe, e_types_portes type, int operandes[], int nb)
+{
+    switch(type)
+    {
+        case PORTE_ET:
+        case PORTE_OU:
+        case PORTE_NAND:
+        case PORTE_NOR:
+
+            return t_optimisation_simplifier_et_ou(graphe, type, operandes, nb);
+        case PORTE_XOR:
+        case PORTE_XNOR:
+
+            return t_optimisation_simplifier_xor(graphe, type, operandes, nb);
+        case PORTE_NOT:
+
+            return t_optimisation_inverser(graphe, operandes[0]);
+        case PORTE_BUF:
+
+            return operandes[0];
+        case PORTE_MUX:
+
+            return t_optimisation_simplifier_mux(graphe, operandes);
+        case PORTE_ZERO:
+
+            return NOEUD_ZERO;
+        default:
+
+            return NOEUD_UN;
+    }
+}
+
+/*
+Construit le graphe optimisé à partir de la netlist. noeuds[net] reçoit le noeud qui porte la
+valeur de chaque net.
+*/
+static void t_optimisation_construire(t_graphe_optimisation *graphe, const t_netlist *netlist, int noeuds[],
+                                      int tampon[], t_rapport_optimisation *rapport)
+{
+    int ne = netlist->nb_entrees;
+    int nb;
+    int noeud;
+    int nb_noeuds_avant;
+
+    graphe->types[NOEUD_ZERO] = PORTE_ZERO;
+    graphe->types[NOEUD_UN] = PORTE_UN;
+
+    for(int i = 0;i<ne;i++)
+    {
+        graphe->types[NOEUD_PREMIERE_ENTREE + i] = TYPE_ENTREE;
+        noeuds[i] = NOEUD_PREMIERE_ENTREE + i;
+    }
+
+    graphe->nb_noeuds = NOEUD_PREMIERE_ENTREE + ne;
+
+    for(int n = 0;n<=graphe->nb_noeuds;n++)
+    {
+        graphe->debut[n] = 0;
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        if(netlist->types[k] == PORTE_DFF)
+        {
+            //L'entrée d'une bascule peut dépendre de portes qui suivent: elle est fixée à la fin
+            noeud = graphe->nb_noeuds++;
+            graphe->types[noeud] = PORTE_DFF;
+            graphe->operandes[graphe->debut[noeud]] = NOEUD_ZERO;
+            graphe->debut[noeud + 1] = graphe->debut[noeud] + 1;
+            noeuds[ne + k] = noeud;
+            continue;
+        }
+
+        nb = netlist->debut_entrees[k + 1] - netlist->debut_entrees[k];
+
+        for(int i = 0;i<nb;i++)
+        {
+            tampon[i] = noeuds[netlist->entrees[netlist->debut_entrees[k] + i]];
+        }
+
+        nb_noeuds_avant = graphe->nb_noeuds;
+        graphe->fusion = -1;
+        noeud = t_optimisation_simplifier_porte(graphe, (e_types_portes)netlist->types[k], tampon, nb);
+        noeuds[ne + k] = noeud;
+
+        if(noeud == NOEUD_ZERO || noeud == NOEUD_UN)
+        {
+            rapport->nb_constantes++;
+        }
+        else if(noeud == graphe->fusion)
+        {
+            rapport->nb_fusionnees++;
+        }
+        else if(noeud < nb_noeuds_avant)
+        {
+            rapport->nb_simplifiees++;
+        }
+    }
+
+    for(int k = 0;k<netlist->nb_portes;k++)
+    {
+        if(netlist->types[k] == PORTE_DFF)
+        {
+            noeud = noeuds[ne + k];
+            graphe->operandes[graphe->debut[noeud]] = noeuds[netlist->entrees[netlist->debut_entrees[k]]];
+        }
+    }
+}
+
+/*
+Marque les noeuds dont dépend une sortie du circuit (parcours en profondeur avec une pile).
+*/
+static void t_optimisation_marquer_vivants(const t_graphe_optimisation *graphe, const t_netlist *netlist,
+                                           const int noeuds[], unsigned char vivants[], int pile[])
+{
+    int nb_pile = 0;
+    int noeud;
+    int operande;
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        noeud = noeuds[netlist->sorties[j]];
+
+        if(vivants[noeud] == 0)
+        {
+            vivants[noeud] = 1;
+            pile[nb_pile++] = noeud;
+        }
+    }
+
+    while(nb_pile > 0)
+    {
+        noeud = pile[--nb_pile];
+
+        for(int i = graphe->debut[noeud];i<graphe->debut[noeud + 1];i++)
+        {
+            operande = graphe->operandes[i];
+
+            if(vivants[operande] == 0)
+            {
+                vivants[operande] = 1;
+                pile[nb_pile++] = operande;
+            }
+        }
+    }
+}
+
+/*
+Crée le circuit formé des noeuds vivants du graphe. pins reçoit la pin sortie de chaque noeud.
+*/
+static t_circuit *t_optimisation_reconstruire(const t_graphe_optimisation *graphe, const t_netlist *netlist,
+                                              const int noeuds[], const unsigned char vivants[], t_pin_sortie *pins[])
+{
+    t_circuit *circuit = t_circuit_init();
+    t_porte *porte;
+    int succes = circuit != NULL;
+
+    for(int i = 0;succes && i<netlist->nb_entrees;i++)
+    {
+        succes = t_circuit_ajouter_entree(circuit) != NULL;
+        pins[NOEUD_PREMIERE_ENTREE + i] = succes ? t_entree_get_pin(circuit->entrees[i]) : NULL;
+    }
+
+    for(int j = 0;succes && j<netlist->nb_sorties;j++)
+    {
+        succes = t_circuit_ajouter_sortie(circuit) != NULL;
+    }
+
+    for(int n = 0;succes && n<graphe->nb_noeuds;n++)
+    {
+        if(vivants[n] && graphe->types[n] != TYPE_ENTREE)
+        {
+            porte = t_circuit_ajouter_porte_n(circuit, (e_types_portes)graphe->types[n], graphe->debut[n + 1] - graphe->debut[n]);
+            succes = porte != NULL;
+            pins[n] = succes ? porte->sortie : NULL;
+        }
+    }
+
+    //Toutes les portes existent: l'entrée d'une bascule peut venir d'une porte qui la suit
+    for(int n = 0, k = 0;succes && n<graphe->nb_noeuds;n++)
+    {
+        if(vivants[n] && graphe->types[n] != TYPE_ENTREE)
+        {
+            porte = circuit->portes[k++];
+
+            for(int i = 0;succes && i<porte->nb_entrees;i++)
+            {
+                succes = t_porte_relier(porte, i, pins[graphe->operandes[graphe->debut[n] + i]]);
+            }
+        }
+    }
+
+    for(int j = 0;succes && j<netlist->nb_sorties;j++)
+    {
+        succes = t_sortie_relier(circuit->sorties[j], pins[noeuds[netlist->sorties[j]]]);
+    }
+
+    if(succes == 0 && circuit != NULL)
+    {
+        t_circuit_destroy(circuit);
+
+        return NULL;
+    }
+
+
+    return circuit;
+}
+
+t_circuit *t_optimisation_simplifier(t_circuit *circuit, t_rapport_optimisation *rapport)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    t_rapport_optimisation rapport_local;
+    t_graphe_optimisation graphe;
+    t_circuit *resultat = NULL;
+    int *noeuds;
+    int *tampon;
+    int *pile;
+    unsigned char *vivants;
+    t_pin_sortie **pins;
+    size_t taille_table = 1;
+    int max_noeuds;
+    int max_operandes;
+
+    if(netlist == NULL)
+    {
+
+        return NULL;
+    }
+
+    if(rapport == NULL)
+    {
+        rapport = &rapport_local;
+    }
+
+    memset(rapport, 0, sizeof(t_rapport_optimisation));
+    rapport->nb_portes_avant = netlist->nb_portes;
+    rapport->nb_niveaux_avant = netlist->nb_niveaux;
+
+    //Une porte crée au plus deux noeuds (la porte et un NOT) et une opérande de plus que ses entrées
+    max_noeuds = NOEUD_PREMIERE_ENTREE + netlist->nb_entrees + 2 * netlist->nb_portes;
+    max_operandes = netlist->debut_entrees[netlist->nb_portes] + 2 * netlist->nb_portes;
+
+    while(taille_table < 2 * (size_t)max_noeuds)
+    {
+        taille_table *= 2;
+    }
+
+    graphe.types = (unsigned char*)malloc(sizeof(unsigned char) * max_noeuds);
+    graphe.debut = (int*)malloc(sizeof(int) * (max_noeuds + 1));
+    graphe.operandes = (int*)malloc(sizeof(int) * (max_operandes + 1));
+    graphe.table = (int*)malloc(sizeof(int) * taille_table);
+    graphe.masque_table = taille_table - 1;
+    noeuds = (int*)malloc(sizeof(int) * (netlist->nb_nets + 1));
+    tampon = (int*)malloc(sizeof(int) * (netlist->debut_entrees[netlist->nb_portes] + 1));
+    pile = (int*)malloc(sizeof(int) * max_noeuds);
+    vivants = (unsigned char*)calloc(max_noeuds, sizeof(unsigned char));
+    pins = (t_pin_sortie**)calloc(max_noeuds, sizeof(t_pin_sortie*));
+
+    if(graphe.types != NULL && graphe.debut != NULL && graphe.operandes != NULL && graphe.table != NULL
+       && noeuds != NULL && tampon != NULL && pile != NULL && vivants != NULL && pins != NULL)
+    {
+        memset(graphe.table, -1, sizeof(int) * taille_table);
+        t_optimisation_construire(&graphe, netlist, noeuds, tampon, rapport);
+        t_optimisation_marquer_vivants(&graphe, netlist, noeuds, vivants, pile);
+
+        for(int n = NOEUD_PREMIERE_ENTREE + netlist->nb_entrees;n<graphe.nb_noeuds;n++)
+        {
+            rapport->nb_mortes += vivants[n] == 0;
+        }
+
+        resultat = t_optimisation_reconstruire(&graphe, netlist, noeuds, vivants, pins);
+    }
+
+    if(resultat != NULL && t_circuit_ordonner(resultat))
+    {
+        rapport->nb_portes_apres = resultat->nb_portes;
+        rapport->nb_niveaux_apres = resultat->nb_niveaux;
+    }
+    else if(resultat != NULL)
+    {
+        t_circuit_destroy(resultat);
+        resultat = NULL;
+    }
+
+    free(graphe.types);
+    free(graphe.debut);
+    free(graphe.operandes);
+    free(graphe.table);
+    free(noeuds);
+    free(tampon);
+    free(pile);
+    free(vivants);
+    free(pins);
+
+
+    return resultat;
+}
+
+void t_optimisation_afficher_rapport(const t_rapport_optimisation *rapport)
+{
+    printf("Portes: %i -> %i, niveaux: %i -> %i\n", rapport->nb_portes_avant, rapport->nb_portes_apres,
+           rapport->nb_niveaux_avant, rapport->nb_niveaux_apres);
+    printf("Constantes: %i, simplifiees: %i, fusionnees: %i, mortes: %i\n", rapport->nb_constantes,
+           rapport->nb_simplifiees, rapport->nb_fusionnees, rapport->nb_mortes);
+}
@@ -0,0 +1,67 @@
+/*
+Module: T_OPTIMISATION
+Description: Optimisation logique d'un circuit. La netlist du circuit est reconstruite porte par
+			 porte, dans l'ordre des niveaux, en appliquant:
+			 - la propagation des constantes (a ET 0 = 0, a OU 0 = a, a XOR 1 = NOT a, MUX dont la
+			   sélection est constante...);
+			 - les simplifications locales: entrée répétée (a ET a = a, a XOR a = 0), double NOT,
+			   a ET NOT a = 0, porte réduite à une seule entrée;
+			 - le partage des portes identiques (hash-consing): une porte du même type et avec les
+			   mêmes entrées qu'une porte déjà construite (dans n'importe quel ordre pour les portes
+			   commutatives) est remplacée par celle-ci;
+			 - l'élimination des portes mortes, dont aucune sortie du circuit ne dépend.
+
+			 Le résultat est un nouveau circuit équivalent (mêmes entrées et mêmes sorties, dans le
+			 même ordre). Les bascules sont conservées si une sortie en dépend, mais deux bascules
+			 identiques ne sont pas fusionnées. Une entrée dont plus aucune porte ne dépend reste
+			 dans le circuit sans être lue: t_circuit_est_valide refuse alors le circuit, mais il
+			 peut être simulé par lots ou par cycles et sauvegardé (voir t_circuit_est_simulable).
+*/
+
+#ifndef T_OPTIMISATION_H_
+#define T_OPTIMISATION_H_
+
+#include "t_circuit.h"
+
+typedef struct t_circuit t_circuit;
+
+/*
+Résultat d'une optimisation: taille et profondeur du circuit avant et après, et nombre de portes
+traitées par chaque règle.
+*/
+struct t_rapport_optimisation {
+	int nb_portes_avant;
+	int nb_portes_apres;
+	int nb_niveaux_avant;
+	int nb_niveaux_apres;
+	int nb_constantes; //Portes dont la sortie est constante
+	int nb_simplifiees; //Portes remplacées par un signal existant (entrée, double NOT...)
+	int nb_fusionnees; //Portes identiques à une porte déjà construite
+	int nb_mortes; //Portes construites dont aucune sortie ne dépend
+};
+
+typedef struct t_rapport_optimisation t_rapport_optimisation;
+
+/*
+Fonction: T_OPTIMISATION_SIMPLIFIER
+Description: Construit une version optimisée du circuit (voir la description du module). Le
+			 circuit d'origine n'est pas modifié.
+Paramètres:
+- circuit: Pointeur vers le circuit à optimiser (il est compilé en netlist au besoin).
+- rapport: Rapport rempli par l'optimisation (NULL si aucun rapport n'est voulu).
+Retour: Pointeur vers le nouveau circuit (à détruire avec t_circuit_destroy). NULL si le circuit
+		est invalide, contient une boucle combinatoire ou si la mémoire manque.
+*/
+t_circuit *t_optimisation_simplifier(t_circuit *circuit, t_rapport_optimisation *rapport);
+
+/*
+Fonction: T_OPTIMISATION_AFFICHER_RAPPORT
+Description: Affiche un rapport d'optimisation (portes et niveaux avant et après, puis le détail
+			 par règle).
+Paramètres:
+- rapport: Pointeur vers le rapport.
+Retour: Aucun.
+*/
+void t_optimisation_afficher_rapport(const t_rapport_optimisation *rapport);
+
+#endif
@@ -1,12 +1,26 @@
 #include "t_pin_entree.h"
 
 t_pin_entree *t_pin_entree_init()
+{
+	return t_pin_entree_init_arene(NULL);
+}
+
+t_pin_entree *t_pin_entree_init_arene(t_arene *arene)
 {
 	t_pin_entree *nouv_pin;
 
-	nouv_pin = (t_pin_entree*)malloc(sizeof(t_pin_entree));
+	nouv_pin = (t_pin_entree*)t_arene_allouer(arene, sizeof(t_pin_entree));
+
+	if (nouv_pin == NULL) {
+		return NULL;
+	}
+
 	nouv_pin->valeur = -1;
 	nouv_pin->liaison = NULL;
+	nouv_pin->porte = NULL;
+	nouv_pin->sortie = NULL;
+	nouv_pin->instance = NULL;
+	nouv_pin->revision = NULL;
 
 	return nouv_pin;
 }
@@ -35,6 +49,11 @@ void t_pin_entree_relier(t_pin_entree * pin_entree, t_pin_sortie * pin_sortie)
 	}
 	pin_entree->liaison = (t_pin_sortie*)pin_sortie;
 	t_pin_sortie_ajouter_lien(pin_sortie, pin_entree);
+
+	//L'ordre d'évaluation et la netlist du circuit propriétaire sont à recalculer
+	if (pin_entree->revision != NULL) {
+		(*pin_entree->revision)++;
+	}
 }
 
 int t_pin_entree_est_reliee(t_pin_entree * pin)
@@ -19,15 +19,26 @@ Dernière modification: 2018-03-19
 #define T_PIN_ENTREE_H_
 
 #include <stdlib.h>
+#include "t_arene.h"
 #include "t_pin_sortie.h"
 
 typedef struct t_pin_sortie t_pin_sortie;
+typedef struct t_porte t_porte;
+typedef struct t_sortie t_sortie;
+typedef struct t_instance t_instance;
 
 //Définit le type t_pin_entree
 struct t_pin_entree {
 	int valeur; //Valeur du signal reçu par la pin entree. -1 si la pin est inactive.
 	t_pin_sortie *liaison; //Pointeur vers la pin sortie
 								  //à laquelle cette pin est reliée
+	t_porte *porte; //Porte à laquelle appartient la pin (NULL pour la pin d'une
+					//sortie de circuit). Permet de parcourir le circuit à partir des liaisons.
+	t_sortie *sortie; //Sortie de circuit à laquelle appartient la pin (NULL sinon)
+	t_instance *instance; //Instance à laquelle appartient la pin (NULL sinon)
+	//Compteur de révision des liens du circuit auquel appartient la pin, incrémenté à chaque
+	//liaison (NULL pour une pin créée hors d'un circuit)
+	unsigned long *revision;
 };
 
 typedef struct t_pin_entree t_pin_entree;
@@ -41,6 +52,16 @@ Paramètres modifié: N/A.
 */
 t_pin_entree *t_pin_entree_init();
 
+/*
+Fonction: T_PIN_ENTREE_INIT_ARENE (constructeur)
+Description: Crée une nouvelle pin entrée dans une arène (voir t_arene.h). Une pin créée dans
+			 une arène est libérée avec l'arène et ne doit pas être passée à t_pin_entree_destroy.
+Paramètres:
+- arene: Arène dans laquelle la pin est créée (NULL: même effet que t_pin_entree_init).
+Retour: Pointeur vers la pin entrée qui a été créée (NULL si la mémoire manque)
+*/
+t_pin_entree *t_pin_entree_init_arene(t_arene *arene);
+
 /*
 Fonction: T_PIN_ENTREE_DESTROY (Destructeur)
 Description: Libère la mémoire occupée par la pin entree.
@@ -1,20 +1,39 @@
 #define _CRT_SECURE_NO_WARNINGS
+#include <string.h>
 #include "t_pin_sortie.h"
 
 t_pin_sortie *t_pin_sortie_init(void)
+{
+	return t_pin_sortie_init_arene(NULL);
+}
+
+t_pin_sortie *t_pin_sortie_init_arene(t_arene *arene)
 {
 	t_pin_sortie *nouv_pin;
 
-	nouv_pin = (t_pin_sortie*)malloc(sizeof(t_pin_sortie));
+	nouv_pin = (t_pin_sortie*)t_arene_allouer(arene, sizeof(t_pin_sortie));
+
+	if (nouv_pin == NULL) {
+		return NULL;
+	}
+
 	nouv_pin->valeur = -1;
+	nouv_pin->liaisons = NULL;
 	nouv_pin->nb_liaisons = 0;
+	nouv_pin->capacite_liaisons = 0;
+	nouv_pin->indice = -1;
+	nouv_pin->arene = arene;
+	nouv_pin->porte = NULL;
+	nouv_pin->entree = NULL;
+	nouv_pin->instance = NULL;
 
 	return nouv_pin;
 }
 
 void t_pin_sortie_destroy(t_pin_sortie * pin)
 {
-	free(pin);
+	t_arene_liberer(pin->arene, pin->liaisons);
+	t_arene_liberer(pin->arene, pin);
 }
 
 
@@ -34,8 +53,30 @@ void t_pin_sortie_set_valeur(t_pin_sortie *pin, int valeur)
 
 int t_pin_sortie_ajouter_lien(t_pin_sortie *pin_sortie, const t_pin_entree *pin_entree)
 {
-	if (pin_sortie->nb_liaisons >= SORTIE_MAX_LIAISONS) {
-		return 0;
+	t_pin_entree **nouv_liaisons;
+	int nouv_capacite;
+
+	if (pin_sortie->nb_liaisons >= pin_sortie->capacite_liaisons) {
+		nouv_capacite = pin_sortie->capacite_liaisons ? pin_sortie->capacite_liaisons * 2 : SORTIE_CAPACITE_INITIALE;
+
+		if (pin_sortie->arene == NULL) {
+			nouv_liaisons = (t_pin_entree**)realloc(pin_sortie->liaisons, sizeof(t_pin_entree*) * nouv_capacite);
+		}
+		else {
+			//L'ancien tableau reste dans l'arène: il sera libéré avec elle
+			nouv_liaisons = (t_pin_entree**)t_arene_allouer(pin_sortie->arene, sizeof(t_pin_entree*) * nouv_capacite);
+
+			if (nouv_liaisons != NULL && pin_sortie->nb_liaisons > 0) {
+				memcpy(nouv_liaisons, pin_sortie->liaisons, sizeof(t_pin_entree*) * pin_sortie->nb_liaisons);
+			}
+		}
+
+		if (nouv_liaisons == NULL) {
+			return 0;
+		}
+
+		pin_sortie->liaisons = nouv_liaisons;
+		pin_sortie->capacite_liaisons = nouv_capacite;
 	}
 
 	pin_sortie->liaisons[pin_sortie->nb_liaisons] = (t_pin_entree *)pin_entree;
@@ -61,7 +102,7 @@ void t_pin_sortie_supprimer_lien(t_pin_sortie * pin_sortie, const t_pin_entree *
 	}
 
 	//On décale toutes les liaisons après i
-	for (j = i + 1; j < pin_sortie->nb_liaisons; i++) {
+	for (j = i + 1; j < pin_sortie->nb_liaisons; j++) {
 		pin_sortie->liaisons[j - 1] = pin_sortie->liaisons[j];
 	}
 
@@ -99,65 +140,36 @@ void t_pin_sortie_reset(t_pin_sortie * pin)
 
 void t_pin_sortie_serialiser_liens(t_pin_sortie * pin, t_circuit * circuit, char* resultat)
 {
-	//int i, j, k ; //Compteurs de boucle
-	//const int nb_portes = circuit->nb_portes; //Le nombre de portes du circuit
-	//const int nb_sorties = circuit->nb_sorties; //Le nombre de sorties du circuit
-	//const t_porte **tab_portes = t_circuit_get_portes(circuit); //Tableau de portes du circuit
-	//const t_sortie **tab_sorties_circuit = t_circuit_get_sorties(circuit); //Tableau de sorties du circuit
-
-	//t_pin_entree **entrees_porte; //Stocke le tableau d'entr�es d'une
-	//							  //porte
-	//t_pin_entree *entree; //Temporaire, stocke la pin_entree trait�e
-	//					  //actuellement, avec qui la pin_sortie a une
-	//					  //liaison.
-	//
-	////Initialisation du r�sultat � la chaine vive
-	//resultat[0] = '\0';
-
-	////On parcourt toutes les liaisons de la pin � la recherche
-	////du composant (porte ou sortie de circuit) auquel elle peut-�tre 
-	////reli�e. 
-	////Tout ceci aurait pu �tre �vit� si la pin_entree ou la pin_sortie avait
-	////un lien vers son composant. Cependant, ceci aurait compliqu� la conception
-	////pour les �tudiants et �a a �t� abandonn� � la faveur d'une fonction de d�couverte
-	////des liens plus complexe et moins efficace, mais qui leur est fournie. 
-	//for (i = 0; i < pin->nb_liaisons; i++)
-	//{
-	//	//V�rification des liens avec les portes
-	//	for (j = 0; j < nb_portes; j++) 
-	//	{
-	//		entrees_porte = t_porte_get_pin_entrees(tab_portes[j]);
-	//		for (k = 0; k < t_porte_get_nb_entrees(tab_portes[j]); k++)
-	//		{
-	//			if (entrees_porte[k] == pin->liaisons[i]) 
-	//			{
-	//				strcat(resultat, t_porte_get_nom(tab_portes[j]));
-	//				strcat(resultat, ",");
-	//			}
-	//		}
-	//	}
-
-	//	//V�rification des liens avec les sorties
-	//	for (j = 0; j < nb_sorties; j++)
-	//	{
-	//		entree = t_sortie_get_pin(tab_sorties_circuit[j]);
-
-	//		if (entree == pin->liaisons[i])
-	//		{
-	//			strcat(resultat, t_sortie_get_nom(tab_sorties_circuit[j]));
-	//			strcat(resultat, ",");
-	//		}
-	//	}
-	//}
-	////Si on a trouv� des liens, il va y avoir une virgule (,) en trop � la fin
-	////--> On l'enl�ve
-	//if (strlen(resultat)) 
-	//{
-	//	resultat[strlen(resultat)-1] = '\0';
-	//}
-}
-
-
-
+	char *fin = resultat; //Fin du texte écrit: les noms sont ajoutés sans relire le résultat
+	const char *nom; //Nom du composant auquel appartient la pin entrée traitée
+	size_t longueur;
+	int i;
 
+	(void)circuit;
+	resultat[0] = '\0';
 
+	//Chaque pin entrée connaît le composant auquel elle appartient: un lien se nomme sans
+	//parcourir les portes et les sorties du circuit
+	for (i = 0; i < pin->nb_liaisons; i++) {
+		if (pin->liaisons[i]->porte != NULL) {
+			nom = pin->liaisons[i]->porte->nom;
+		}
+		else if (pin->liaisons[i]->sortie != NULL) {
+			nom = pin->liaisons[i]->sortie->nom;
+		}
+		else if (pin->liaisons[i]->instance != NULL) {
+			nom = pin->liaisons[i]->instance->nom;
+		}
+		else {
+			continue;
+		}
+
+		if (fin != resultat) {
+			*fin++ = ',';
+		}
+
+		longueur = strlen(nom);
+		memcpy(fin, nom, longueur + 1);
+		fin += longueur;
+	}
+}
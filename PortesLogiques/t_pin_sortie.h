@@ -21,23 +21,39 @@ Dernière modification: 2018-03-19
 #ifndef T_PIN_SORTIE_H_
 #define T_PIN_SORTIE_H_
 
-#define SORTIE_MAX_LIAISONS 10
+#define SORTIE_CAPACITE_INITIALE 2 //Capacité initiale du tableau de liaisons (il double au besoin)
 
+#include "t_arene.h"
 #include "t_pin_entree.h"
 #include "t_circuit.h"
 
 typedef struct t_pin_entree t_pin_entree;
 typedef struct t_circuit t_circuit;
+typedef struct t_porte t_porte;
+typedef struct t_entree t_entree;
+typedef struct t_instance t_instance;
 
 
 //Définit le type t_pin_sortie
 struct t_pin_sortie {
 	int valeur; //Valeur du signal reçu par la pin entree. -1 si la pin est inactive.
-	//Tableau de pointeurs vers des pin entrée auquel cette pin sortie est connectée
-	t_pin_entree *liaisons[SORTIE_MAX_LIAISONS];
+	//Tableau dynamique de pointeurs vers des pin entrée auquel cette pin sortie est connectée
+	t_pin_entree **liaisons;
 	//Nombre de pin entrée vers lesquels cette pin sortie est connectée.
 	//Ce champs représente le nombre d'éléments effectifs du tableau liaisons.
 	int nb_liaisons;
+	//Capacité du tableau liaisons (0 tant qu'aucune liaison n'a été ajoutée)
+	int capacite_liaisons;
+	//Arène dans laquelle la pin et son tableau de liaisons sont alloués (NULL: malloc)
+	t_arene *arene;
+	//Indice du signal porté par la pin dans le circuit ordonné (voir t_circuit_ordonner):
+	//les entrées du circuit, puis les sorties des portes par ordre d'évaluation.
+	int indice;
+	//Composant auquel appartient la pin: une porte, une entrée du circuit ou une instance
+	//(les deux autres champs valent NULL). Permet de nommer les extrémités d'un lien.
+	t_porte *porte;
+	t_entree *entree;
+	t_instance *instance;
 };
 typedef struct t_pin_sortie t_pin_sortie;
 
@@ -50,6 +66,17 @@ Paramètres modifié: N/A.
 */
 t_pin_sortie *t_pin_sortie_init(void);
 
+/*
+Fonction: T_PIN_SORTIE_INIT_ARENE (constructeur)
+Description: Crée une nouvelle pin sortie dans une arène (voir t_arene.h). Le tableau de liaisons
+			 de la pin est lui aussi découpé dans l'arène. Une pin créée dans une arène est libérée
+			 avec l'arène et ne doit pas être passée à t_pin_sortie_destroy.
+Paramètres:
+- arene: Arène dans laquelle la pin est créée (NULL: même effet que t_pin_sortie_init).
+Retour: Pointeur vers la pin sortie qui a été créée (NULL si la mémoire manque)
+*/
+t_pin_sortie *t_pin_sortie_init_arene(t_arene *arene);
+
 /*
 Fonction: T_PIN_SORTIE_DESTROY (Destructeur)
 Description: Libère la mémoire occupée par la pin sortie.
@@ -86,12 +113,11 @@ Fonction: T_PIN_SORTIE_AJOUTER_LIEN
 Description: Relie la pin sortie à une pin entrée. Cette fonction permet de relier le composant, auquel
 			 apparatien la pin sortie, à un autre composant, auquel appartient la pin entrée.
 
-			 La fonction doit vérifier qu'on excède le nombre maximal de liens autorisés 
-			 (SORTIE_MAX_LIAISONS)
+			 Le tableau de liaisons est agrandi (sa capacité double) lorsqu'il est plein.
 Paramètres:
 - pin_sortie: La pin sortie à relier
 - pin_entree: La pin entrée à laquelle la pin sortie sera reliée.
-Retour: Vrai si le lien a bien été ajouté, faux sinon.
+Retour: Vrai si le lien a bien été ajouté, faux si la mémoire manque.
 */
 int t_pin_sortie_ajouter_lien(t_pin_sortie *pin_sortie, const t_pin_entree *pin_entree);
 
@@ -144,7 +170,15 @@ void t_pin_sortie_reset(t_pin_sortie *pin);
 
 /*
 Fonction: T_PIN_SORTIE_SERIALISER_LIENS
-Description: Transforme en texte les informations de la pin sortie.
+Description: Transforme en texte les liens de la pin sortie: les noms des composants (portes,
+			 sorties du circuit ou instances) auxquels appartiennent les pins entrée reliées,
+			 séparés par des virgules (ex.: P3,P7,S0). Les noms sont lus à partir des pins entrée
+			 (champs porte, sortie et instance): le coût est proportionnel au nombre de liens.
+Paramètres:
+- pin: La pin sortie.
+- circuit: Circuit auquel appartient la pin (n'est plus nécessaire, conservé pour compatibilité).
+- resultat: Tampon qui reçoit le texte. Il doit pouvoir contenir tous les noms et leurs séparateurs.
+Retour: Aucun.
 */
 void t_pin_sortie_serialiser_liens(t_pin_sortie *pin, t_circuit *circuit, char *resultat);
 
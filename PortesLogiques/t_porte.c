@@ -3,9 +3,108 @@
 //
 #include "t_porte.h"
 
+//Opération qui combine les entrées d'une porte
+typedef enum { OPERATION_ET, OPERATION_OU, OPERATION_XOR, OPERATION_MUX, OPERATION_BASCULE,
+               OPERATION_CONSTANTE } e_operation_porte;
+
+/*
+Description d'un type de porte: la sortie est la combinaison de toutes les entrées par
+l'opération, inversée si "inverse" est vrai (NAND = ET inversé, NOT = tampon inversé).
+Le MUX (sélection, valeur si 0, valeur si 1) et la bascule (aucun calcul) sont traités à part;
+une constante vaut 0, ou 1 si elle est inversée.
+*/
+typedef struct {
+	const char *nom; //Nom du type dans les fichiers de circuit
+	int nb_entrees_min;
+	int nb_entrees_max; //-1 si le nombre d'entrées n'est pas limité
+	int nb_entrees_defaut;
+	e_operation_porte operation;
+	int inverse;
+} t_description_porte;
+
+//Description des types de portes, dans l'ordre de e_types_portes
+static const t_description_porte descriptions[NB_TYPES_PORTES] = {
+    {"ET", 2, -1, 2, OPERATION_ET, 0},
+    {"OU", 2, -1, 2, OPERATION_OU, 0},
+    {"NOT", 1, 1, 1, OPERATION_ET, 1},
+    {"XOR", 2, -1, 2, OPERATION_XOR, 0},
+    {"NAND", 2, -1, 2, OPERATION_ET, 1},
+    {"NOR", 2, -1, 2, OPERATION_OU, 1},
+    {"XNOR", 2, -1, 2, OPERATION_XOR, 1},
+    {"BUF", 1, 1, 1, OPERATION_ET, 0},
+    {"MUX", 3, 3, 3, OPERATION_MUX, 0},
+    {"DFF", 1, 1, 1, OPERATION_BASCULE, 0},
+    {"ZERO", 0, 0, 0, OPERATION_CONSTANTE, 0},
+    {"UN", 0, 0, 0, OPERATION_CONSTANTE, 1}
+};
+
+//Combine deux tableaux de mots: sortie[m] = (a[m] op b[m]) ^ inversion. Une boucle par
+//opération: chacune est vectorisée par le compilateur.
+static inline void t_porte_combiner(e_operation_porte operation, const uint64_t *a, const uint64_t *b,
+                                    uint64_t inversion, uint64_t *sortie, int nb_mots)
+{
+    switch(operation)
+    {
+        case OPERATION_ET:
+            for(int m = 0;m<nb_mots;m++)
+            {
+                sortie[m] = (a[m] & b[m]) ^ inversion;
+            }
+            break;
+
+        case OPERATION_OU:
+            for(int m = 0;m<nb_mots;m++)
+            {
+                sortie[m] = (a[m] | b[m]) ^ inversion;
+            }
+            break;
+
+        case OPERATION_XOR:
+            for(int m = 0;m<nb_mots;m++)
+            {
+                sortie[m] = (a[m] ^ b[m]) ^ inversion;
+            }
+            break;
+
+        case OPERATION_MUX:
+        case OPERATION_BASCULE:
+        case OPERATION_CONSTANTE:
+            break;
+    }
+}
+
+//Libère une porte dont la construction a échoué (rien à faire si elle est dans une arène)
+static void t_porte_abandonner(t_arene *arene, t_porte *porte)
+{
+    if(arene == NULL)
+    {
+        t_porte_destroy(porte);
+    }
+}
+
 t_porte *t_porte_init(int id, e_types_portes type)
 {
-    t_porte * porte = (t_porte*) malloc(sizeof(t_porte));
+
+    return t_porte_init_arene(NULL, id, type, t_porte_nb_entrees_defaut(type));
+}
+
+t_porte *t_porte_init_n(int id, e_types_portes type, int nb_entrees)
+{
+
+    return t_porte_init_arene(NULL, id, type, nb_entrees);
+}
+
+t_porte *t_porte_init_arene(t_arene *arene, int id, e_types_portes type, int nb_entrees)
+{
+    t_porte * porte;
+
+    if(t_porte_nb_entrees_valide(type, nb_entrees) == 0)
+    {
+
+        return NULL;
+    }
+
+    porte = (t_porte*) t_arene_allouer(arene, sizeof(t_porte));
 
     if( porte == NULL)
     {
@@ -15,36 +114,60 @@ t_porte *t_porte_init(int id, e_types_portes type)
 
     porte->id = id;
     porte->type = type;
+    porte->etat = 0;
 
-    porte->nom = (char*) malloc(sizeof(char)*NOM_PORTE_TAILLE_MAX);
+    //Le nom est alloué à sa taille exacte (ex.: "P12" et son '\0')
+    porte->nom = (char*) t_arene_allouer(arene, sizeof(char)*(snprintf(NULL, 0, "P%i", id) + 1));
 
     if(porte->nom == NULL)
     {
-        free(porte);
+        t_arene_liberer(arene, porte);
 
         return NULL;
     }
 
     sprintf(porte->nom,"P%i",id);
 
-    if(porte->type == PORTE_NOT)
+    porte->nb_entrees = nb_entrees;
+    porte->entrees = (t_pin_entree**) t_arene_allouer(arene, sizeof(t_pin_entree*) * porte->nb_entrees);
+
+    //Une constante n'a pas d'entrée (malloc(0) peut retourner NULL)
+    if(porte->entrees == NULL && porte->nb_entrees > 0)
     {
-        porte->nb_entrees = 1;
+        t_arene_liberer(arene, porte->nom);
+        t_arene_liberer(arene, porte);
 
+        return NULL;
     }
-    else
+
+    porte->sortie = NULL;
+
+    for(int i =0;i<porte->nb_entrees;i++)
     {
-        porte->nb_entrees = 2;
+        porte->entrees[i] = t_pin_entree_init_arene(arene);
+
+        if(porte->entrees[i] == NULL)
+        {
+            porte->nb_entrees = i;
+            t_porte_abandonner(arene, porte);
+
+            return NULL;
+        }
+
+        porte->entrees[i]->porte = porte;
 
     }
 
-    for(int i =0;i<porte->nb_entrees;i++)
+    porte->sortie = t_pin_sortie_init_arene(arene);
+
+    if(porte->sortie == NULL)
     {
-        porte->entrees[i] = t_pin_entree_init();
+        t_porte_abandonner(arene, porte);
 
+        return NULL;
     }
 
-    porte->sortie = t_pin_sortie_init();
+    porte->sortie->porte = porte;
 
 
     return porte;
@@ -54,7 +177,10 @@ void t_porte_destroy(t_porte *porte)
 {
     free(porte->nom);
 
-    t_pin_sortie_destroy(porte->sortie);
+    if(porte->sortie != NULL)
+    {
+        t_pin_sortie_destroy(porte->sortie);
+    }
 
 
     for(int i=0;i<porte->nb_entrees;i++)
@@ -62,76 +188,271 @@ void t_porte_destroy(t_porte *porte)
         t_pin_entree_destroy(porte->entrees[i]);
 
     }
+    free(porte->entrees);
     free(porte);
 }
 
+int t_porte_nb_entrees_defaut(e_types_portes type)
+{
+    if((int)type < 0 || (int)type >= NB_TYPES_PORTES)
+    {
+
+        return 0;
+    }
+
+
+    return descriptions[type].nb_entrees_defaut;
+}
+
+int t_porte_nb_entrees_valide(e_types_portes type, int nb_entrees)
+{
+    if((int)type < 0 || (int)type >= NB_TYPES_PORTES)
+    {
+
+        return 0;
+    }
+
+
+    return nb_entrees >= descriptions[type].nb_entrees_min
+           && (descriptions[type].nb_entrees_max == -1 || nb_entrees <= descriptions[type].nb_entrees_max);
+}
+
 void t_porte_calculer_sorties(t_porte *porte)
 {
+    //Les deux rails de chaque entrée (voir t_porte_calculer_mots_x): uns[i] puis zeros[i] = uns[nb_entrees + i].
+    //Pour une entrée connue (0 ou 1), uns[i] est aussi sa valeur.
+    uint64_t valeurs[2 * PORTE_ENTREES_LOCALES];
+    int signaux[PORTE_ENTREES_LOCALES];
+    uint64_t *tableau_valeurs = valeurs;
+    int *tableau_signaux = signaux;
+    uint64_t sortie = 0;
+    uint64_t sortie_zeros = 0;
+    int valeur;
+    int inconnue = 0;
+
+    if(porte->type == PORTE_DFF)
+    {
+        t_pin_sortie_set_valeur(porte->sortie, porte->etat);
 
-    if(porte->type == PORTE_ET)
+        return;
+    }
+
+    //Chaque entrée est un signal d'un seul mot (0 ou 1): même calcul que la simulation par mots
+    if(porte->nb_entrees > PORTE_ENTREES_LOCALES)
     {
-        if(t_pin_entree_get_valeur(porte->entrees[0]) & t_pin_entree_get_valeur(porte->entrees[1]))
+        tableau_valeurs = (uint64_t*)malloc(sizeof(uint64_t) * 2 * porte->nb_entrees);
+        tableau_signaux = (int*)malloc(sizeof(int) * porte->nb_entrees);
+
+        if(tableau_valeurs == NULL || tableau_signaux == NULL)
         {
-            t_pin_sortie_set_valeur(porte->sortie,1);
+            free(tableau_valeurs);
+            free(tableau_signaux);
 
+            return;
         }
-        else
-        {
-            t_pin_sortie_set_valeur(porte->sortie,0);
+    }
 
+    for(int i = 0;i<porte->nb_entrees;i++)
+    {
+        valeur = t_pin_entree_get_valeur(porte->entrees[i]);
+        tableau_valeurs[i] = (uint64_t)(valeur != 0);
+        tableau_valeurs[porte->nb_entrees + i] = (uint64_t)(valeur != 1);
+        tableau_signaux[i] = i;
+        inconnue |= valeur == -1;
+    }
 
-        }
+    if(inconnue == 0)
+    {
+        t_porte_calculer_mots(porte->type, tableau_valeurs, tableau_signaux, porte->nb_entrees, &sortie, 1);
+        t_pin_sortie_set_valeur(porte->sortie, (int)(sortie & 1));
+    }
+    else
+    {
+        t_porte_calculer_mots_x(porte->type, tableau_valeurs, &tableau_valeurs[porte->nb_entrees], tableau_signaux,
+                                porte->nb_entrees, &sortie, &sortie_zeros, 1);
+        t_pin_sortie_set_valeur(porte->sortie, (sortie & 1) == (sortie_zeros & 1) ? -1 : (int)(sortie & 1));
     }
 
-    if(porte->type == PORTE_OU)
+    if(tableau_valeurs != valeurs)
     {
-        if(t_pin_entree_get_valeur(porte->entrees[0]) | t_pin_entree_get_valeur(porte->entrees[1]))
-        {
-            t_pin_sortie_set_valeur(porte->sortie,1);
+        free(tableau_valeurs);
+        free(tableau_signaux);
+    }
+}
 
-        }
-        else
-        {
+void t_porte_calculer_mots(e_types_portes type, const uint64_t *valeurs, const int *signaux, int nb_entrees,
+                           uint64_t *sortie, int nb_mots)
+{
+    const t_description_porte *description = &descriptions[type];
+    const uint64_t *a;
+    const uint64_t *b;
+    const uint64_t *c;
+    uint64_t inversion = description->inverse ? ~(uint64_t)0 : 0;
 
-            t_pin_sortie_set_valeur(porte->sortie,0);
+    if(description->operation == OPERATION_BASCULE)
+    {
 
-        }
+        return;
     }
 
-    if(porte->type == PORTE_XOR)
+    if(description->operation == OPERATION_CONSTANTE)
     {
-        if(t_pin_entree_get_valeur(porte->entrees[0]) ^ t_pin_entree_get_valeur(porte->entrees[1]))
+        for(int m = 0;m<nb_mots;m++)
         {
-            t_pin_sortie_set_valeur(porte->sortie,1);
-
+            sortie[m] = inversion;
         }
-        else
-        {
-            t_pin_sortie_set_valeur(porte->sortie,0);
 
+        return;
+    }
+
+    a = &valeurs[(size_t)signaux[0] * nb_mots];
+
+    if(description->operation == OPERATION_MUX)
+    {
+        //MUX: a est la sélection, b la valeur si 0, c la valeur si 1
+        b = &valeurs[(size_t)signaux[1] * nb_mots];
+        c = &valeurs[(size_t)signaux[2] * nb_mots];
 
+        for(int m = 0;m<nb_mots;m++)
+        {
+            sortie[m] = (b[m] & ~a[m]) | (c[m] & a[m]);
         }
+
+        return;
     }
 
-    if(porte->type == PORTE_NOT)
+    if(nb_entrees == 1)
     {
-        if(t_pin_entree_get_valeur(porte->entrees[0]) == 0)
+        for(int m = 0;m<nb_mots;m++)
         {
-            t_pin_sortie_set_valeur(porte->sortie,1);
-
+            sortie[m] = a[m] ^ inversion;
         }
-        else
+
+        return;
+    }
+
+    //Les entrées sont combinées une à une dans la sortie; l'inversion est faite avec la dernière
+    for(int i = 1;i<nb_entrees;i++)
+    {
+        b = &valeurs[(size_t)signaux[i] * nb_mots];
+        t_porte_combiner(description->operation, a, b, i == nb_entrees - 1 ? inversion : 0, sortie, nb_mots);
+        a = sortie;
+    }
+}
+
+void t_porte_calculer_mots_x(e_types_portes type, const uint64_t *uns, const uint64_t *zeros, const int *signaux,
+                             int nb_entrees, uint64_t *sortie_uns, uint64_t *sortie_zeros, int nb_mots)
+{
+    const t_description_porte *description = &descriptions[type];
+    //L'inversion échange les rails: le résultat est calculé directement dans les rails échangés
+    uint64_t *un = description->inverse ? sortie_zeros : sortie_uns;
+    uint64_t *zero = description->inverse ? sortie_uns : sortie_zeros;
+    const uint64_t *a_un, *a_zero;
+    const uint64_t *b_un, *b_zero;
+    const uint64_t *c_un, *c_zero;
+    uint64_t z_a, z_b, z_c;
+    uint64_t temporaire;
+
+    if(description->operation == OPERATION_BASCULE)
+    {
+
+        return;
+    }
+
+    if(description->operation == OPERATION_CONSTANTE)
+    {
+        for(int m = 0;m<nb_mots;m++)
         {
-            t_pin_sortie_set_valeur(porte->sortie,0);
+            un[m] = 0;
+            zero[m] = ~(uint64_t)0;
+        }
+
+        return;
+    }
+
+    //Une entrée Z (aucun rail) est lue comme X (les deux rails): z_a est le masque des Z
+    a_un = &uns[(size_t)signaux[0] * nb_mots];
+    a_zero = &zeros[(size_t)signaux[0] * nb_mots];
 
+    if(description->operation == OPERATION_MUX)
+    {
+        //Chaque donnée compte pour la valeur de sélection qui peut la choisir
+        b_un = &uns[(size_t)signaux[1] * nb_mots];
+        b_zero = &zeros[(size_t)signaux[1] * nb_mots];
+        c_un = &uns[(size_t)signaux[2] * nb_mots];
+        c_zero = &zeros[(size_t)signaux[2] * nb_mots];
 
+        for(int m = 0;m<nb_mots;m++)
+        {
+            z_a = ~(a_un[m] | a_zero[m]);
+            z_b = ~(b_un[m] | b_zero[m]);
+            z_c = ~(c_un[m] | c_zero[m]);
+            un[m] = ((b_un[m] | z_b) & (a_zero[m] | z_a)) | ((c_un[m] | z_c) & (a_un[m] | z_a));
+            zero[m] = ((b_zero[m] | z_b) & (a_zero[m] | z_a)) | ((c_zero[m] | z_c) & (a_un[m] | z_a));
         }
+
+        return;
     }
 
+    for(int m = 0;m<nb_mots;m++)
+    {
+        z_a = ~(a_un[m] | a_zero[m]);
+        un[m] = a_un[m] | z_a;
+        zero[m] = a_zero[m] | z_a;
+    }
+
+    //Les entrées sont combinées une à une dans la sortie, une boucle par opération
+    for(int i = 1;i<nb_entrees;i++)
+    {
+        b_un = &uns[(size_t)signaux[i] * nb_mots];
+        b_zero = &zeros[(size_t)signaux[i] * nb_mots];
+
+        switch(description->operation)
+        {
+            case OPERATION_ET:
+                for(int m = 0;m<nb_mots;m++)
+                {
+                    z_b = ~(b_un[m] | b_zero[m]);
+                    un[m] &= b_un[m] | z_b;
+                    zero[m] |= b_zero[m] | z_b;
+                }
+                break;
+
+            case OPERATION_OU:
+                for(int m = 0;m<nb_mots;m++)
+                {
+                    z_b = ~(b_un[m] | b_zero[m]);
+                    un[m] |= b_un[m] | z_b;
+                    zero[m] &= b_zero[m] | z_b;
+                }
+                break;
+
+            case OPERATION_XOR:
+                for(int m = 0;m<nb_mots;m++)
+                {
+                    z_b = ~(b_un[m] | b_zero[m]);
+                    temporaire = (un[m] & (b_zero[m] | z_b)) | (zero[m] & (b_un[m] | z_b));
+                    zero[m] = (un[m] & (b_un[m] | z_b)) | (zero[m] & (b_zero[m] | z_b));
+                    un[m] = temporaire;
+                }
+                break;
+
+            case OPERATION_MUX:
+            case OPERATION_BASCULE:
+            case OPERATION_CONSTANTE:
+                break;
+        }
+    }
 }
 
 int t_porte_relier(t_porte *dest, int num_entree, t_pin_sortie *source)
 {
+    if(num_entree < 0 || num_entree >= dest->nb_entrees)
+    {
+
+        return 0;
+    }
+
     t_pin_entree_relier( dest->entrees[num_entree],source);
 
     if(dest->entrees[num_entree] == NULL)
@@ -165,34 +486,29 @@ void t_porte_reset(t_porte *porte)
 
     t_pin_sortie_reset(porte->sortie);
 
-    if(porte->type == PORTE_NOT)
+    for(int i = 0;i<porte->nb_entrees;i++)
     {
-        t_pin_entree_reset(porte->entrees[0]);
-
-    }
-    else
-    {
-        t_pin_entree_reset(porte->entrees[0]);
-        t_pin_entree_reset(porte->entrees[1]);
+        t_pin_entree_reset(porte->entrees[i]);
 
     }
 }
 
 int t_porte_propager_signal(t_porte *porte)
 {
-
-        if(t_pin_entree_get_valeur(porte->entrees[0]) != -1 && t_pin_entree_get_valeur(porte->entrees[porte->nb_entrees-1]) != -1)
+    for(int i = 0;i<porte->nb_entrees && porte->type != PORTE_DFF;i++)
+    {
+        if(t_pin_entree_get_valeur(porte->entrees[i]) == -1)
         {
-            t_porte_calculer_sorties(porte);
-            t_pin_sortie_propager_signal(porte->sortie);
 
-
-            return 1;
+            return 0;
         }
+    }
 
+    t_porte_calculer_sorties(porte);
+    t_pin_sortie_propager_signal(porte->sortie);
 
-    return 0;
 
+    return 1;
 }
 
 t_pin_sortie* t_porte_get_pin_sortie(t_porte* porte)
@@ -204,6 +520,30 @@ t_pin_sortie* t_porte_get_pin_sortie(t_porte* porte)
 
 }
 
+const char *t_porte_get_nom_type(e_types_portes type)
+{
+    if((int)type < 0 || (int)type >= NB_TYPES_PORTES)
+    {
+
+        return NULL;
+    }
+
+
+    return descriptions[type].nom;
+}
+
+int t_porte_type_depuis_nom(const char *nom, e_types_portes *type)
+{
+    for(int i = 0;i<NB_TYPES_PORTES;i++)
+    {
+        if(strcmp(nom, descriptions[i].nom) == 0)
+        {
+            *type = (e_types_portes)i;
 
+            return 1;
+        }
+    }
 
 
+    return 0;
+}
@@ -15,6 +15,8 @@ Dernière modification: 2018-03-19
 
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
+#include "t_arene.h"
 #include "t_pin_entree.h"
 #include "t_pin_sortie.h"
 #include "t_circuit.h"
@@ -27,14 +29,29 @@ typedef struct t_circuit t_circuit;
 
 #define NOM_PORTE_TAILLE_MAX 10 //Taille maximale du nom d'une porte
 								//En nombre de caractères
+#define PORTE_ENTREES_LOCALES 16 //Nombre d'entrées au-delà duquel t_porte_calculer_sorties
+								 //alloue ses tableaux de travail
 
 /*
 Énumération: E_TYPES_PORTES
-Description: Énumère les types de portes permis 
+Description: Énumère les types de portes permis. Les types ET, OU, XOR, NAND, NOR et XNOR
+			 acceptent 2 entrées ou plus; NOT et BUF (tampon) ont une seule entrée; MUX a trois
+			 entrées (sélection, valeur si 0, valeur si 1). Les nouveaux types sont ajoutés à la
+			 fin pour ne pas changer le code des types existants (format binaire).
+
+			 DFF est une bascule D (logique séquentielle) sur l'horloge globale du circuit: sa
+			 sortie garde, pendant tout un cycle, la valeur que son entrée avait à la fin du cycle
+			 précédent (voir t_circuit_front_horloge et t_circuit_simuler_cycles). Une boucle qui
+			 passe par une bascule est donc permise.
+
+			 ZERO et UN sont des constantes (aucune entrée).
 */
-enum e_types_portes { PORTE_ET, PORTE_OU, PORTE_NOT, PORTE_XOR };
+enum e_types_portes { PORTE_ET, PORTE_OU, PORTE_NOT, PORTE_XOR, PORTE_NAND, PORTE_NOR, PORTE_XNOR,
+					  PORTE_BUF, PORTE_MUX, PORTE_DFF, PORTE_ZERO, PORTE_UN };
 typedef enum e_types_portes e_types_portes;
 
+#define NB_TYPES_PORTES 12 //Nombre de types dans e_types_portes
+
 /*
 Définit le type t_porte qui permet de stocker l'information relative à une porte.
 */
@@ -43,14 +60,16 @@ struct t_porte {
 	//Nom de la porte construit automatiquement à partie de l'identifiant (ex.: P1)
 	char *nom; 
 	e_types_portes type; //Type de la porte (parmi les types énumérés)
-	//Tab statique de pointeurs vers des pin entrée. L'ensemble des pins entrée
-	//représente les entrées de la porte.
-	t_pin_entree *entrees[MAX_ENTREES];
+	//Tab dynamique (nb_entrees éléments) de pointeurs vers des pin entrée. L'ensemble
+	//des pins entrée représente les entrées de la porte.
+	t_pin_entree **entrees;
 	//Pointeur vers la pin sortie de la porte.
 	t_pin_sortie *sortie; 
 	//Nombre d'entrées de la porte. Représente le nombre d'éléments significatifs
 	//dans le tableau du champs "entrees"
 	int nb_entrees; 
+	//État d'une bascule (PORTE_DFF): valeur de sa sortie pendant le cycle courant (0 au départ)
+	int etat;
 };
 
 typedef struct t_porte t_porte;
@@ -68,10 +87,55 @@ Description: Crée une nouvelle porte du type spécifié en paramètre. Selon le
 Paramètres: 
 - id: Entier représentant l'identifiant numérique de la porte (unique dans un circuit)
 - type: Le type de porte à créer, selon la liste des types prédéfinis dans t_types_portes
-Retour: Pointeur vers la porte créée
+Retour: Pointeur vers la porte créée (NULL si la mémoire manque)
 Paramètres modifié: Aucun.
 */
 t_porte *t_porte_init(int id, e_types_portes type);
+
+/*
+Fonction: T_PORTE_INIT_N
+Description: Crée une nouvelle porte à nb_entrees entrées (ex.: une porte ET à 32 entrées).
+Paramètres:
+- id, type: Voir t_porte_init.
+- nb_entrees: Nombre d'entrées de la porte (voir t_porte_nb_entrees_valide).
+Retour: Pointeur vers la porte créée (NULL si la mémoire manque ou si le nombre d'entrées
+		n'est pas permis pour ce type).
+*/
+t_porte *t_porte_init_n(int id, e_types_portes type, int nb_entrees);
+
+/*
+Fonction: T_PORTE_INIT_ARENE
+Description: Crée une nouvelle porte dans une arène (voir t_arene.h). La porte, son nom et ses pins
+			 sont découpés dans l'arène. Une porte créée dans une arène est libérée avec l'arène
+			 et ne doit pas être passée à t_porte_destroy.
+Paramètres:
+- arene: Arène dans laquelle la porte est créée (NULL: même effet que t_porte_init_n).
+- id, type, nb_entrees: Voir t_porte_init_n.
+Retour: Pointeur vers la porte créée (NULL si la mémoire manque ou si le nombre d'entrées
+		n'est pas permis pour ce type)
+*/
+t_porte *t_porte_init_arene(t_arene *arene, int id, e_types_portes type, int nb_entrees);
+
+/*
+Fonction: T_PORTE_NB_ENTREES_DEFAUT
+Description: Retourne le nombre d'entrées d'une porte créée par t_porte_init (2 pour les portes
+			 ET, OU, XOR, NAND, NOR et XNOR, 1 pour NOT, BUF et DFF, 3 pour MUX, 0 pour ZERO et UN).
+Paramètres:
+- type: Type de porte.
+Retour: Nombre d'entrées, 0 si le type est invalide.
+*/
+int t_porte_nb_entrees_defaut(e_types_portes type);
+
+/*
+Fonction: T_PORTE_NB_ENTREES_VALIDE
+Description: Vérifie si une porte du type donné peut avoir nb_entrees entrées.
+Paramètres:
+- type: Type de porte.
+- nb_entrees: Nombre d'entrées.
+Retour: Booléen: Vrai si le nombre d'entrées est permis pour ce type.
+*/
+int t_porte_nb_entrees_valide(e_types_portes type, int nb_entrees);
+
 /*
 Fonction: T_PORTE_DESTROY
 Description: Libère la mémoire occupée par la porte et tous ses composants.
@@ -96,11 +160,58 @@ NDE:
 Paramètres:
 - porte: Pointeur vers la porte dont on souhaite calculer les sorties (dans cette version du 
 		 programme, il n'existe qu'une seule sortie par porte).
+		 La sortie d'une bascule (PORTE_DFF) est son état, peu importe son entrée.
+		 Une entrée inactive (-1) est une valeur inconnue (X): la sortie vaut -1, sauf si
+		 les entrées connues suffisent à la fixer (ex.: une entrée à 0 d'une porte ET), voir
+		 t_porte_calculer_mots_x.
 Retour: Aucun.
 */
 void t_porte_calculer_sorties(t_porte *porte);
 
 
+/*
+Fonction: T_PORTE_CALCULER_MOTS
+Description: Calcule la sortie d'une porte du type donné sur des signaux groupés par mots de
+			 64 bits: le bit k de chaque mot représente la valeur du signal pour le k-ième
+			 vecteur. Une seule opération binaire évalue donc 64 vecteurs à la fois.
+			 L'opération est choisie dans une table indexée par le type (pas de cascade de
+			 tests par porte) et la boucle sur les mots est écrite pour être vectorisée.
+			 Une bascule (PORTE_DFF) ne calcule rien: la sortie garde l'état de la bascule, qui
+			 ne change qu'au front d'horloge.
+Paramètres:
+- type: Type de la porte.
+- valeurs: Mots des signaux: le signal n occupe valeurs[n * nb_mots] à valeurs[n * nb_mots + nb_mots - 1].
+- signaux: Signal de chaque entrée de la porte (nb_entrees éléments).
+- nb_entrees: Nombre d'entrées de la porte.
+- sortie: Tableau qui reçoit les mots calculés (distinct des mots des entrées).
+- nb_mots: Nombre de mots par signal.
+Retour: Aucun.
+*/
+void t_porte_calculer_mots(e_types_portes type, const uint64_t *valeurs, const int *signaux, int nb_entrees,
+						   uint64_t *sortie, int nb_mots);
+
+/*
+Fonction: T_PORTE_CALCULER_MOTS_X
+Description: Version en logique à quatre valeurs (0, 1, X, Z) de t_porte_calculer_mots. Chaque
+			 signal est codé sur deux rails de mots: le bit k de "uns" vaut 1 si le signal peut
+			 valoir 1 pour le vecteur k, celui de "zeros" s'il peut valoir 0. 0 = (0, 1),
+			 1 = (1, 0), X = (1, 1) et Z = (0, 0) (haute impédance, signal non alimenté).
+			 Une entrée Z est lue comme X. Les portes calculent ce qui est certain: ET vaut 0 dès
+			 qu'une entrée vaut 0, OU vaut 1 dès qu'une entrée vaut 1, XOR vaut X dès qu'une
+			 entrée vaut X, MUX dont la sélection vaut X donne la valeur commune de ses deux
+			 données si elles sont égales, X sinon. Une porte ne produit jamais Z.
+Paramètres:
+- type: Type de la porte.
+- uns, zeros: Rails des signaux (même disposition que valeurs dans t_porte_calculer_mots).
+- signaux: Signal de chaque entrée de la porte (nb_entrees éléments).
+- nb_entrees: Nombre d'entrées de la porte.
+- sortie_uns, sortie_zeros: Tableaux qui reçoivent les rails calculés (distincts des rails des entrées).
+- nb_mots: Nombre de mots par signal.
+Retour: Aucun.
+*/
+void t_porte_calculer_mots_x(e_types_portes type, const uint64_t *uns, const uint64_t *zeros, const int *signaux,
+							 int nb_entrees, uint64_t *sortie_uns, uint64_t *sortie_zeros, int nb_mots);
+
 /*
 Fonction: T_PORTE_RELIER
 Description: Relie une des entrées de la porte à un autre composant du circuit (entrée ou une autre porte)
@@ -150,12 +261,15 @@ void t_porte_reset(t_porte *porte);
 Fonction: T_PORTE_PROPAGER_SIGNAL
 Description: Propage le signal à partir de la porte passée en paramètre.
 			 Pour que le signal puisse se propager, il faut que la porte
-			 ait une valeur sur chacune de ses entrées (i.e. !=-1).
+			 ait une valeur sur chacune de ses nb_entrees entrées (i.e. !=-1).
 			 Si c'est le cas, il suffit de calculer la sortie, puis de propager
 			 le signal à partir de la pin_sortie.
 
 NDE: Une fois que vous avez calculé la valeur de la pin sortie, utilisez 
 	 la fonction t_pin_sortie_propager_signal.
+
+			 Une bascule (PORTE_DFF) propage son état sans attendre son entrée: c'est une
+			 source du cycle courant.
 Paramètres:
 - porte: Pointeur vers la porte dont on veut propager le signal.
 Retour: Booléen: vrai si le signal a pu se propager (i.e. toutes les entrées ont
@@ -166,4 +280,24 @@ int t_porte_propager_signal(t_porte *porte);
 
 t_pin_sortie* t_porte_get_pin_sortie(t_porte* porte);
 
+/*
+Fonction: T_PORTE_GET_NOM_TYPE
+Description: Retourne le nom d'un type de porte tel qu'il est écrit dans les fichiers de
+			 circuit (ex.: "ET" pour PORTE_ET).
+Paramètres:
+- type: Type de porte.
+Retour: Nom du type (chaine constante), NULL si le type est invalide.
+*/
+const char *t_porte_get_nom_type(e_types_portes type);
+
+/*
+Fonction: T_PORTE_TYPE_DEPUIS_NOM
+Description: Retrouve un type de porte à partir de son nom (voir t_porte_get_nom_type).
+Paramètres:
+- nom: Nom du type.
+- type: Adresse où sera stocké le type trouvé.
+Retour: Booléen: Vrai si le nom correspond à un type de porte, faux sinon.
+*/
+int t_porte_type_depuis_nom(const char *nom, e_types_portes *type);
+
 #endif
\ No newline at end of file
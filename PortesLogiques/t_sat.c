@@ -0,0 +1,725 @@
+//
+// Solveur SAT CDCL (voir t_sat.h).
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "t_sat.h"
+
+#define SAT_CAPACITE_INITIALE 4
+#define SAT_DECROISSANCE_ACTIVITE 0.95 //Les activités décroissent de 5% à chaque conflit
+#define SAT_ACTIVITE_MAX 1e100 //Les activités sont réduites au-delà de cette valeur
+#define SAT_CONFLITS_REDEMARRAGE 100 //Unité de la suite de Luby (en conflits)
+
+//Valeur d'un littéral: 1 s'il est vrai, 0 s'il est faux, -1 si sa variable n'est pas affectée
+static int t_sat_valeur_litteral(const t_sat *sat, int litteral)
+{
+    int valeur = sat->valeurs[litteral >> 1];
+
+
+    return valeur < 0 ? -1 : valeur ^ (litteral & 1);
+}
+
+static int t_sat_ajouter_liste(t_liste_sat *liste, int clause)
+{
+    int *clauses;
+    int capacite;
+
+    if(liste->nb == liste->capacite)
+    {
+        capacite = liste->capacite == 0 ? SAT_CAPACITE_INITIALE : 2 * liste->capacite;
+        clauses = (int*)realloc(liste->clauses, sizeof(int) * capacite);
+
+        if(clauses == NULL)
+        {
+
+            return 0;
+        }
+
+        liste->clauses = clauses;
+        liste->capacite = capacite;
+    }
+
+    liste->clauses[liste->nb++] = clause;
+
+
+    return 1;
+}
+
+//Tas binaire des variables par activité décroissante
+static void t_sat_monter(t_sat *sat, int position)
+{
+    int variable = sat->tas[position];
+    int parent;
+
+    while(position > 0)
+    {
+        parent = (position - 1) / 2;
+
+        if(sat->activites[sat->tas[parent]] >= sat->activites[variable])
+        {
+            break;
+        }
+
+        sat->tas[position] = sat->tas[parent];
+        sat->positions_tas[sat->tas[position]] = position;
+        position = parent;
+    }
+
+    sat->tas[position] = variable;
+    sat->positions_tas[variable] = position;
+}
+
+static void t_sat_descendre(t_sat *sat, int position)
+{
+    int variable = sat->tas[position];
+    int enfant;
+
+    while(2 * position + 1 < sat->nb_tas)
+    {
+        enfant = 2 * position + 1;
+
+        if(enfant + 1 < sat->nb_tas && sat->activites[sat->tas[enfant + 1]] > sat->activites[sat->tas[enfant]])
+        {
+            enfant++;
+        }
+
+        if(sat->activites[sat->tas[enfant]] <= sat->activites[variable])
+        {
+            break;
+        }
+
+        sat->tas[position] = sat->tas[enfant];
+        sat->positions_tas[sat->tas[position]] = position;
+        position = enfant;
+    }
+
+    sat->tas[position] = variable;
+    sat->positions_tas[variable] = position;
+}
+
+static void t_sat_inserer_tas(t_sat *sat, int variable)
+{
+    if(sat->positions_tas[variable] == -1)
+    {
+        sat->tas[sat->nb_tas] = variable;
+        sat->positions_tas[variable] = sat->nb_tas;
+        sat->nb_tas++;
+        t_sat_monter(sat, sat->nb_tas - 1);
+    }
+}
+
+static int t_sat_extraire_tas(t_sat *sat)
+{
+    int variable = sat->tas[0];
+
+    sat->nb_tas--;
+    sat->positions_tas[variable] = -1;
+
+    if(sat->nb_tas > 0)
+    {
+        sat->tas[0] = sat->tas[sat->nb_tas];
+        sat->positions_tas[sat->tas[0]] = 0;
+        t_sat_descendre(sat, 0);
+    }
+
+
+    return variable;
+}
+
+//Augmente l'activité d'une variable qui participe à un conflit
+static void t_sat_activer(t_sat *sat, int variable)
+{
+    sat->activites[variable] += sat->increment;
+
+    if(sat->activites[variable] > SAT_ACTIVITE_MAX)
+    {
+        for(int v = 0;v<sat->nb_variables;v++)
+        {
+            sat->activites[v] /= SAT_ACTIVITE_MAX;
+        }
+
+        sat->increment /= SAT_ACTIVITE_MAX;
+    }
+
+    if(sat->positions_tas[variable] != -1)
+    {
+        t_sat_monter(sat, sat->positions_tas[variable]);
+    }
+}
+
+static void t_sat_affecter(t_sat *sat, int litteral, int raison)
+{
+    int variable = litteral >> 1;
+
+    sat->valeurs[variable] = (signed char)(1 ^ (litteral & 1));
+    sat->niveaux[variable] = sat->niveau;
+    sat->raisons[variable] = raison;
+    sat->trace[sat->nb_trace++] = litteral;
+}
+
+//Annule les affectations des niveaux supérieurs à niveau
+static void t_sat_annuler(t_sat *sat, int niveau)
+{
+    int variable;
+
+    if(sat->niveau <= niveau)
+    {
+
+        return;
+    }
+
+    for(int i = sat->nb_trace - 1;i>=sat->debut_niveaux[niveau + 1];i--)
+    {
+        variable = sat->trace[i] >> 1;
+        sat->phases[variable] = sat->valeurs[variable];
+        sat->valeurs[variable] = -1;
+        sat->raisons[variable] = -1;
+        t_sat_inserer_tas(sat, variable);
+    }
+
+    sat->nb_trace = sat->debut_niveaux[niveau + 1];
+    sat->tete_propagation = sat->nb_trace;
+    sat->niveau = niveau;
+}
+
+//Range une clause et surveille ses deux premiers littéraux. Retourne sa référence (-1 si la mémoire manque).
+static int t_sat_ranger_clause(t_sat *sat, const int litteraux[], int nb)
+{
+    size_t capacite = sat->capacite_clauses;
+    int *clauses;
+    int reference;
+
+    while(sat->taille_clauses + nb + 1 > capacite)
+    {
+        capacite = capacite == 0 ? 1024 : 2 * capacite;
+    }
+
+    if(capacite != sat->capacite_clauses)
+    {
+        clauses = (int*)realloc(sat->clauses, sizeof(int) * capacite);
+
+        if(clauses == NULL)
+        {
+
+            return -1;
+        }
+
+        sat->clauses = clauses;
+        sat->capacite_clauses = capacite;
+    }
+
+    reference = (int)sat->taille_clauses;
+    sat->clauses[reference] = nb;
+    memcpy(&sat->clauses[reference + 1], litteraux, sizeof(int) * nb);
+    sat->taille_clauses += nb + 1;
+
+    if(t_sat_ajouter_liste(&sat->surveillances[litteraux[0]], reference) == 0
+       || t_sat_ajouter_liste(&sat->surveillances[litteraux[1]], reference) == 0)
+    {
+
+        return -1;
+    }
+
+
+    return reference;
+}
+
+/*
+Propage les littéraux de la trace. Pour chaque littéral devenu faux, les clauses qui le surveillent
+cherchent un autre littéral non faux à surveiller; sinon la clause impose son autre littéral
+surveillé, ou elle est en conflit. Retourne la clause en conflit (-1 si aucun conflit).
+*/
+static int t_sat_propager(t_sat *sat)
+{
+    t_liste_sat *liste;
+    int *litteraux;
+    int faux;
+    int clause;
+    int taille;
+    int trouve;
+    int i;
+    int j;
+
+    while(sat->tete_propagation < sat->nb_trace)
+    {
+        faux = sat->trace[sat->tete_propagation++] ^ 1;
+        liste = &sat->surveillances[faux];
+        sat->nb_propagations++;
+        i = 0;
+        j = 0;
+
+        while(i < liste->nb)
+        {
+            clause = liste->clauses[i++];
+            taille = sat->clauses[clause];
+            litteraux = &sat->clauses[clause + 1];
+
+            //Le littéral faux est placé en deuxième position
+            if(litteraux[0] == faux)
+            {
+                litteraux[0] = litteraux[1];
+                litteraux[1] = faux;
+            }
+
+            if(t_sat_valeur_litteral(sat, litteraux[0]) == 1)
+            {
+                liste->clauses[j++] = clause;
+                continue;
+            }
+
+            trouve = 0;
+
+            for(int k = 2;k<taille && trouve == 0;k++)
+            {
+                if(t_sat_valeur_litteral(sat, litteraux[k]) != 0)
+                {
+                    litteraux[1] = litteraux[k];
+                    litteraux[k] = faux;
+                    trouve = 1;
+                }
+            }
+
+            //La clause surveille désormais un autre littéral
+            if(trouve)
+            {
+                sat->memoire_insuffisante |= t_sat_ajouter_liste(&sat->surveillances[litteraux[1]], clause) == 0;
+                continue;
+            }
+
+            liste->clauses[j++] = clause;
+
+            if(t_sat_valeur_litteral(sat, litteraux[0]) == 0)
+            {
+                while(i < liste->nb)
+                {
+                    liste->clauses[j++] = liste->clauses[i++];
+                }
+
+                liste->nb = j;
+                sat->tete_propagation = sat->nb_trace;
+
+                return clause;
+            }
+
+            t_sat_affecter(sat, litteraux[0], clause);
+        }
+
+        liste->nb = j;
+    }
+
+
+    return -1;
+}
+
+//Vrai si le littéral de la clause apprise est impliqué par les autres littéraux marqués
+static int t_sat_est_redondant(const t_sat *sat, int litteral)
+{
+    int raison = sat->raisons[litteral >> 1];
+    int variable;
+
+    if(raison == -1)
+    {
+
+        return 0;
+    }
+
+    for(int k = 1;k<sat->clauses[raison];k++)
+    {
+        variable = sat->clauses[raison + 1 + k] >> 1;
+
+        if(sat->marques[variable] == 0 && sat->niveaux[variable] > 0)
+        {
+
+            return 0;
+        }
+    }
+
+
+    return 1;
+}
+
+/*
+Analyse un conflit: construit la clause apprise (premier point d'implication unique) dans
+sat->apprise, son littéral impliqué en premier. Retourne le nombre de littéraux et place dans
+niveau_retour le niveau auquel la clause impose ce littéral.
+*/
+static int t_sat_analyser(t_sat *sat, int conflit, int *niveau_retour)
+{
+    int nb_apprise = 1;
+    int compteur = 0;
+    int litteral = -1;
+    int position = sat->nb_trace - 1;
+    int nb_gardes;
+    int variable;
+    int maximum;
+    int temporaire;
+
+    do
+    {
+        //Le premier littéral d'une raison est le littéral qu'elle a imposé
+        for(int k = litteral == -1 ? 0 : 1;k<sat->clauses[conflit];k++)
+        {
+            variable = sat->clauses[conflit + 1 + k] >> 1;
+
+            if(sat->marques[variable] == 0 && sat->niveaux[variable] > 0)
+            {
+                sat->marques[variable] = 1;
+                t_sat_activer(sat, variable);
+
+                if(sat->niveaux[variable] >= sat->niveau)
+                {
+                    compteur++;
+                }
+                else
+                {
+                    sat->apprise[nb_apprise++] = sat->clauses[conflit + 1 + k];
+                }
+            }
+        }
+
+        while(sat->marques[sat->trace[position] >> 1] == 0)
+        {
+            position--;
+        }
+
+        litteral = sat->trace[position--];
+        conflit = sat->raisons[litteral >> 1];
+        sat->marques[litteral >> 1] = 0;
+        compteur--;
+    }
+    while(compteur > 0);
+
+    sat->apprise[0] = litteral ^ 1;
+
+    //Minimisation: un littéral impliqué par les autres littéraux de la clause est placé à la fin
+    //(les marques de tous les littéraux sont effacées ensuite)
+    nb_gardes = 1;
+
+    for(int i = 1;i<nb_apprise;i++)
+    {
+        if(t_sat_est_redondant(sat, sat->apprise[i]) == 0)
+        {
+            temporaire = sat->apprise[nb_gardes];
+            sat->apprise[nb_gardes++] = sat->apprise[i];
+            sat->apprise[i] = temporaire;
+        }
+    }
+
+    for(int i = 1;i<nb_apprise;i++)
+    {
+        sat->marques[sat->apprise[i] >> 1] = 0;
+    }
+
+    //Le littéral du niveau le plus élevé (après le premier) est surveillé avec le premier
+    maximum = 1;
+
+    for(int i = 2;i<nb_gardes;i++)
+    {
+        if(sat->niveaux[sat->apprise[i] >> 1] > sat->niveaux[sat->apprise[maximum] >> 1])
+        {
+            maximum = i;
+        }
+    }
+
+    *niveau_retour = 0;
+
+    if(nb_gardes > 1)
+    {
+        temporaire = sat->apprise[1];
+        sat->apprise[1] = sat->apprise[maximum];
+        sat->apprise[maximum] = temporaire;
+        *niveau_retour = sat->niveaux[sat->apprise[1] >> 1];
+    }
+
+
+    return nb_gardes;
+}
+
+//Terme i (à partir de 0) de la suite de Luby: 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ...
+static long long t_sat_luby(long long i)
+{
+    long long taille = 1;
+    long long terme = 1;
+
+    while(taille < i + 1)
+    {
+        taille = 2 * taille + 1;
+        terme *= 2;
+    }
+
+    while(taille - 1 != i)
+    {
+        taille = (taille - 1) / 2;
+        terme /= 2;
+
+        i %= taille;
+    }
+
+
+    return terme;
+}
+
+t_sat *t_sat_init(int nb_variables)
+{
+    t_sat *sat = (t_sat*)calloc(1, sizeof(t_sat));
+    int n = nb_variables + 1;
+
+    if(sat == NULL)
+    {
+
+        return NULL;
+    }
+
+    sat->nb_variables = nb_variables;
+    sat->increment = 1.0;
+    sat->surveillances = (t_liste_sat*)calloc(2 * (size_t)n, sizeof(t_liste_sat));
+    sat->valeurs = (signed char*)malloc(sizeof(signed char) * n);
+    sat->niveaux = (int*)calloc(n, sizeof(int));
+    sat->raisons = (int*)malloc(sizeof(int) * n);
+    sat->trace = (int*)malloc(sizeof(int) * n);
+    sat->debut_niveaux = (int*)calloc(n + 1, sizeof(int));
+    sat->activites = (double*)calloc(n, sizeof(double));
+    sat->tas = (int*)malloc(sizeof(int) * n);
+    sat->positions_tas = (int*)malloc(sizeof(int) * n);
+    sat->phases = (signed char*)calloc(n, sizeof(signed char));
+    sat->marques = (unsigned char*)calloc(n, sizeof(unsigned char));
+    sat->apprise = (int*)malloc(sizeof(int) * n);
+    sat->modele = (signed char*)calloc(n, sizeof(signed char));
+
+    if(sat->surveillances == NULL || sat->valeurs == NULL || sat->niveaux == NULL || sat->raisons == NULL
+       || sat->trace == NULL || sat->debut_niveaux == NULL || sat->activites == NULL || sat->tas == NULL
+       || sat->positions_tas == NULL || sat->phases == NULL || sat->marques == NULL || sat->apprise == NULL
+       || sat->modele == NULL)
+    {
+        t_sat_destroy(sat);
+
+        return NULL;
+    }
+
+    memset(sat->valeurs, -1, sizeof(signed char) * n);
+    memset(sat->raisons, -1, sizeof(int) * n);
+    memset(sat->positions_tas, -1, sizeof(int) * n);
+
+    for(int v = 0;v<nb_variables;v++)
+    {
+        t_sat_inserer_tas(sat, v);
+    }
+
+
+    return sat;
+}
+
+void t_sat_destroy(t_sat *sat)
+{
+    if(sat->surveillances != NULL)
+    {
+        for(int l = 0;l<2 * sat->nb_variables;l++)
+        {
+            free(sat->surveillances[l].clauses);
+        }
+    }
+
+    free(sat->surveillances);
+    free(sat->clauses);
+    free(sat->valeurs);
+    free(sat->niveaux);
+    free(sat->raisons);
+    free(sat->trace);
+    free(sat->debut_niveaux);
+    free(sat->activites);
+    free(sat->tas);
+    free(sat->positions_tas);
+    free(sat->phases);
+    free(sat->marques);
+    free(sat->apprise);
+    free(sat->modele);
+    free(sat);
+}
+
+int t_sat_ajouter_clause(t_sat *sat, int litteraux[], int nb)
+{
+    int nb_gardes = 0;
+    int valeur;
+    int double_trouve;
+
+    t_sat_annuler(sat, 0);
+
+    if(sat->insatisfiable)
+    {
+
+        return 0;
+    }
+
+    //Retire les littéraux faux au niveau 0 et les répétitions; ignore une clause déjà vraie
+    for(int i = 0;i<nb;i++)
+    {
+        valeur = t_sat_valeur_litteral(sat, litteraux[i]);
+        double_trouve = 0;
+
+        for(int k = 0;k<nb_gardes && double_trouve == 0;k++)
+        {
+            if(litteraux[k] == (litteraux[i] ^ 1))
+            {
+
+                return 1;
+            }
+
+            double_trouve = litteraux[k] == litteraux[i];
+        }
+
+        if(valeur == 1)
+        {
+
+            return 1;
+        }
+
+        if(valeur == -1 && double_trouve == 0)
+        {
+            litteraux[nb_gardes++] = litteraux[i];
+        }
+    }
+
+    sat->nb_clauses++;
+
+    if(nb_gardes == 0)
+    {
+        sat->insatisfiable = 1;
+
+        return 0;
+    }
+
+    if(nb_gardes == 1)
+    {
+        t_sat_affecter(sat, litteraux[0], -1);
+        sat->insatisfiable = t_sat_propager(sat) != -1;
+
+        return sat->insatisfiable == 0;
+    }
+
+    if(t_sat_ranger_clause(sat, litteraux, nb_gardes) == -1)
+    {
+        sat->memoire_insuffisante = 1;
+
+        return 0;
+    }
+
+
+    return 1;
+}
+
+int t_sat_resoudre(t_sat *sat, long long max_conflits)
+{
+    long long nb_conflits = 0;
+    long long nb_redemarrages = 0;
+    long long conflits_redemarrage = 0;
+    long long limite = SAT_CONFLITS_REDEMARRAGE * t_sat_luby(0);
+    int conflit;
+    int niveau_retour;
+    int nb_apprise;
+    int reference;
+    int variable;
+
+    t_sat_annuler(sat, 0);
+
+    if(sat->memoire_insuffisante)
+    {
+
+        return SAT_INCONNU;
+    }
+
+    if(sat->insatisfiable || t_sat_propager(sat) != -1)
+    {
+        sat->insatisfiable = 1;
+
+        return SAT_INSATISFIABLE;
+    }
+
+    for(;;)
+    {
+        conflit = t_sat_propager(sat);
+
+        if(conflit != -1)
+        {
+            sat->nb_conflits++;
+            nb_conflits++;
+            conflits_redemarrage++;
+
+            if(sat->niveau == 0)
+            {
+                sat->insatisfiable = 1;
+
+                return SAT_INSATISFIABLE;
+            }
+
+            nb_apprise = t_sat_analyser(sat, conflit, &niveau_retour);
+            t_sat_annuler(sat, niveau_retour);
+
+            if(nb_apprise == 1)
+            {
+                t_sat_affecter(sat, sat->apprise[0], -1);
+            }
+            else
+            {
+                reference = t_sat_ranger_clause(sat, sat->apprise, nb_apprise);
+
+                if(reference == -1)
+                {
+                    sat->memoire_insuffisante = 1;
+                    t_sat_annuler(sat, 0);
+
+                    return SAT_INCONNU;
+                }
+
+                sat->nb_apprises++;
+                t_sat_affecter(sat, sat->apprise[0], reference);
+            }
+
+            sat->increment /= SAT_DECROISSANCE_ACTIVITE;
+
+            if((max_conflits > 0 && nb_conflits >= max_conflits) || sat->memoire_insuffisante)
+            {
+                t_sat_annuler(sat, 0);
+
+                return SAT_INCONNU;
+            }
+        }
+        else if(conflits_redemarrage >= limite)
+        {
+            t_sat_annuler(sat, 0);
+            nb_redemarrages++;
+            conflits_redemarrage = 0;
+            limite = SAT_CONFLITS_REDEMARRAGE * t_sat_luby(nb_redemarrages);
+        }
+        else
+        {
+            variable = -1;
+
+            while(sat->nb_tas > 0 && variable == -1)
+            {
+                variable = t_sat_extraire_tas(sat);
+                variable = sat->valeurs[variable] == -1 ? variable : -1;
+            }
+
+            if(variable == -1)
+            {
+                //Toutes les variables sont affectées sans conflit
+                memcpy(sat->modele, sat->valeurs, sizeof(signed char) * sat->nb_variables);
+                t_sat_annuler(sat, 0);
+
+                return SAT_SATISFIABLE;
+            }
+
+            sat->nb_decisions++;
+            sat->niveau++;
+            sat->debut_niveaux[sat->niveau] = sat->nb_trace;
+            t_sat_affecter(sat, SAT_LITTERAL(variable, sat->phases[variable] == 1 ? 0 : 1), -1);
+        }
+    }
+}
+
+int t_sat_valeur(const t_sat *sat, int variable)
+{
+
+    return sat->modele[variable] == 1;
+}
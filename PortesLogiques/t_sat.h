@@ -0,0 +1,128 @@
+/*
+Module: T_SAT
+Description: Définit le type t_sat, un solveur SAT de type CDCL (apprentissage de clauses dirigé
+			 par les conflits) pour des formules en forme normale conjonctive:
+			 - propagation unitaire avec deux littéraux surveillés par clause;
+			 - analyse des conflits au premier point d'implication unique, minimisation locale
+			   de la clause apprise et retour arrière non chronologique;
+			 - choix des variables par activité (VSIDS, tas binaire) avec mémorisation des phases;
+			 - redémarrages selon la suite de Luby.
+			 Les clauses apprises sont toutes conservées: la limite de conflits de t_sat_resoudre
+			 borne aussi la mémoire.
+
+			 Codage des littéraux (le même que t_aig): 2 * variable pour la variable vraie,
+			 2 * variable + 1 pour sa négation (voir SAT_LITTERAL). Un littéral d'un graphe
+			 ET-inverseur est donc directement un littéral du solveur.
+*/
+
+#ifndef T_SAT_H_
+#define T_SAT_H_
+
+#define SAT_LITTERAL(variable, negatif) (2 * (variable) + (negatif))
+#define SAT_SATISFIABLE 1 //Retour de t_sat_resoudre: une affectation satisfait toutes les clauses
+#define SAT_INSATISFIABLE 0 //Retour de t_sat_resoudre: aucune affectation ne convient
+#define SAT_INCONNU -1 //Retour de t_sat_resoudre: la limite de conflits a été atteinte
+
+/*
+Liste dynamique de clauses (références dans le tableau des clauses du solveur).
+*/
+typedef struct {
+	int *clauses;
+	int nb;
+	int capacite;
+} t_liste_sat;
+
+struct t_sat {
+	int nb_variables; //Nombre de variables (0 à nb_variables - 1)
+	//Clauses rangées bout à bout: la clause de référence c a clauses[c] littéraux,
+	//clauses[c + 1] à clauses[c + clauses[c]]. Les deux premiers littéraux sont surveillés.
+	int *clauses;
+	size_t taille_clauses;
+	size_t capacite_clauses;
+	int nb_clauses; //Nombre de clauses de la formule (sans les clauses apprises)
+	int nb_apprises; //Nombre de clauses apprises
+	t_liste_sat *surveillances; //Clauses qui surveillent chaque littéral (2 * nb_variables listes)
+
+	signed char *valeurs; //Valeur de chaque variable: 0, 1 ou -1 si elle n'est pas affectée
+	int *niveaux; //Niveau de décision auquel chaque variable a été affectée
+	int *raisons; //Clause qui a imposé chaque variable (-1 pour une décision)
+	int *trace; //Littéraux vrais, dans l'ordre d'affectation
+	int nb_trace;
+	int tete_propagation; //Prochain littéral de la trace à propager
+	int *debut_niveaux; //Position dans la trace du début de chaque niveau de décision
+	int niveau; //Niveau de décision courant
+
+	double *activites; //Activité de chaque variable (VSIDS)
+	double increment; //Valeur ajoutée à l'activité d'une variable d'un conflit
+	int *tas; //Tas binaire des variables, par activité décroissante
+	int nb_tas;
+	int *positions_tas; //Position de chaque variable dans le tas (-1 si absente)
+	signed char *phases; //Dernière valeur de chaque variable (mémorisation des phases)
+	unsigned char *marques; //Marques de l'analyse des conflits
+	int *apprise; //Clause apprise en cours de construction
+	signed char *modele; //Affectation trouvée par le dernier appel satisfiable
+
+	int insatisfiable; //Booléen: vrai si la formule est insatisfiable au niveau 0
+	int memoire_insuffisante; //Booléen: vrai si une clause n'a pas pu être rangée
+	long long nb_conflits;
+	long long nb_decisions;
+	long long nb_propagations;
+};
+
+typedef struct t_sat t_sat;
+
+/*
+Fonction: T_SAT_INIT
+Description: Crée un solveur sans clause.
+Paramètres:
+- nb_variables: Nombre de variables de la formule (numérotées de 0 à nb_variables - 1).
+Retour: Pointeur vers le solveur créé (NULL si la mémoire manque).
+*/
+t_sat *t_sat_init(int nb_variables);
+
+/*
+Fonction: T_SAT_DESTROY
+Description: Libère la mémoire occupée par le solveur.
+Paramètres:
+- sat: Pointeur vers le solveur à détruire.
+Retour: Aucun.
+*/
+void t_sat_destroy(t_sat *sat);
+
+/*
+Fonction: T_SAT_AJOUTER_CLAUSE
+Description: Ajoute une clause (disjonction de littéraux) à la formule. Les littéraux répétés
+			 sont retirés; une clause toujours vraie est ignorée. Une clause d'un seul littéral
+			 est propagée immédiatement. Des clauses peuvent être ajoutées entre deux appels à
+			 t_sat_resoudre.
+Paramètres:
+- sat: Pointeur vers le solveur.
+- litteraux: Littéraux de la clause (voir SAT_LITTERAL). Le tableau peut être modifié.
+- nb: Nombre de littéraux.
+Retour: Booléen: Faux si la formule est devenue insatisfiable (ou si la mémoire manque), vrai sinon.
+*/
+int t_sat_ajouter_clause(t_sat *sat, int litteraux[], int nb);
+
+/*
+Fonction: T_SAT_RESOUDRE
+Description: Cherche une affectation qui satisfait toutes les clauses.
+Paramètres:
+- sat: Pointeur vers le solveur.
+- max_conflits: Nombre maximal de conflits de cet appel (0: pas de limite).
+Retour: SAT_SATISFIABLE (l'affectation se lit avec t_sat_valeur), SAT_INSATISFIABLE ou SAT_INCONNU
+		si la limite de conflits a été atteinte ou si la mémoire manque.
+*/
+int t_sat_resoudre(t_sat *sat, long long max_conflits);
+
+/*
+Fonction: T_SAT_VALEUR
+Description: Retourne la valeur d'une variable dans l'affectation trouvée par le dernier appel
+			 satisfiable de t_sat_resoudre.
+Paramètres:
+- sat: Pointeur vers le solveur.
+- variable: Numéro de la variable.
+Retour: 0 ou 1 (0 si aucune affectation n'a été trouvée).
+*/
+int t_sat_valeur(const t_sat *sat, int variable);
+
+#endif
@@ -0,0 +1,315 @@
+//
+// Évaluation d'une netlist par plusieurs fils (voir t_simulation_parallele.h).
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "t_simulation_parallele.h"
+
+static void t_barriere_init(t_barriere *barriere, int nb_fils)
+{
+    atomic_init(&barriere->nb_arrives, 0);
+    atomic_init(&barriere->generation, 0);
+    barriere->nb_fils = nb_fils;
+    //Un fil qui attend activement sur un processeur partagé retarde le fil qu'il attend
+    barriere->attente_active = nb_fils <= sysconf(_SC_NPROCESSORS_ONLN) ? SIMULATION_ATTENTE_ACTIVE : 0;
+}
+
+//Attend que les nb_fils fils soient arrivés à la barrière
+static void t_barriere_attendre(t_barriere *barriere)
+{
+    int generation = atomic_load(&barriere->generation);
+    int nb_tours = 0;
+
+    if(atomic_fetch_add(&barriere->nb_arrives, 1) == barriere->nb_fils - 1)
+    {
+        //Dernier arrivé: remet le compteur à zéro puis libère les autres
+        atomic_store(&barriere->nb_arrives, 0);
+        atomic_fetch_add(&barriere->generation, 1);
+
+        return;
+    }
+
+    while(atomic_load(&barriere->generation) == generation)
+    {
+        if(++nb_tours > barriere->attente_active)
+        {
+            sched_yield();
+        }
+    }
+}
+
+//Découpe l'évaluation en étapes: un niveau large par étape, les niveaux étroits consécutifs
+//regroupés en une seule étape évaluée par le fil principal
+static void t_simulation_parallele_planifier(t_simulation_parallele *simulation, int nb_mots)
+{
+    const t_netlist *netlist = simulation->netlist;
+    int debut;
+    int fin;
+    int parallele;
+
+    if(simulation->nb_mots_plan == nb_mots && simulation->seuil_plan == simulation->seuil)
+    {
+
+        return;
+    }
+
+    simulation->nb_etapes = 0;
+    simulation->derniere_etape_parallele = -1;
+
+    for(int l = 0;l<netlist->nb_niveaux;l++)
+    {
+        debut = netlist->debut_niveaux[l];
+        fin = netlist->debut_niveaux[l + 1];
+        parallele = simulation->nb_fils > 1 && fin - debut >= simulation->nb_fils
+                    && (long long)(fin - debut) * nb_mots >= simulation->seuil;
+
+        if(parallele == 0 && simulation->nb_etapes > 0 && simulation->etapes[simulation->nb_etapes - 1].parallele == 0)
+        {
+            simulation->etapes[simulation->nb_etapes - 1].fin = fin;
+            continue;
+        }
+
+        if(parallele)
+        {
+            simulation->derniere_etape_parallele = simulation->nb_etapes;
+        }
+
+        simulation->etapes[simulation->nb_etapes].debut = debut;
+        simulation->etapes[simulation->nb_etapes].fin = fin;
+        simulation->etapes[simulation->nb_etapes].parallele = parallele;
+        simulation->nb_etapes++;
+    }
+
+    simulation->nb_mots_plan = nb_mots;
+    simulation->seuil_plan = simulation->seuil;
+}
+
+//Part du travail du fil "numero". Les fils auxiliaires s'arrêtent après la dernière étape
+//parallèle: les étapes série qui suivent ne concernent que le fil principal.
+static void t_simulation_parallele_executer(t_simulation_parallele *simulation, int numero, uint64_t *valeurs,
+                                            int nb_mots, int derniere_etape)
+{
+    const t_etape_simulation *etape;
+    int debut;
+    int fin;
+
+    for(int e = 0;e<=derniere_etape;e++)
+    {
+        etape = &simulation->etapes[e];
+
+        if(etape->parallele)
+        {
+            debut = etape->debut + (int)((long long)(etape->fin - etape->debut) * numero / simulation->nb_fils);
+            fin = etape->debut + (int)((long long)(etape->fin - etape->debut) * (numero + 1) / simulation->nb_fils);
+            t_netlist_evaluer_portes(simulation->netlist, valeurs, nb_mots, debut, fin);
+        }
+        else if(numero == 0)
+        {
+            t_netlist_evaluer_portes(simulation->netlist, valeurs, nb_mots, etape->debut, etape->fin);
+        }
+
+        t_barriere_attendre(&simulation->barriere);
+    }
+}
+
+//Boucle d'un fil auxiliaire: attend un lot, fait sa part, recommence
+static void *t_simulation_parallele_fil(void *argument)
+{
+    struct t_argument_fil *argument_fil = (struct t_argument_fil*)argument;
+    t_simulation_parallele *simulation = argument_fil->simulation;
+    int generation_vue = 0;
+    uint64_t *valeurs;
+    int nb_mots;
+    int derniere_etape;
+
+    for(;;)
+    {
+        pthread_mutex_lock(&simulation->verrou);
+
+        while(simulation->arret == 0 && simulation->generation == generation_vue)
+        {
+            pthread_cond_wait(&simulation->travail, &simulation->verrou);
+        }
+
+        if(simulation->arret)
+        {
+            pthread_mutex_unlock(&simulation->verrou);
+
+            break;
+        }
+
+        generation_vue = simulation->generation;
+        valeurs = simulation->valeurs;
+        nb_mots = simulation->nb_mots;
+        derniere_etape = simulation->derniere_etape_parallele;
+        pthread_mutex_unlock(&simulation->verrou);
+
+        t_simulation_parallele_executer(simulation, argument_fil->numero, valeurs, nb_mots, derniere_etape);
+    }
+
+
+    return NULL;
+}
+
+t_simulation_parallele *t_simulation_parallele_init(t_netlist *netlist, int nb_fils)
+{
+    t_simulation_parallele *simulation;
+
+    if(nb_fils < 1)
+    {
+        nb_fils = 1;
+    }
+
+    simulation = (t_simulation_parallele*)calloc(1, sizeof(t_simulation_parallele));
+
+    if(simulation == NULL)
+    {
+
+        return NULL;
+    }
+
+    simulation->netlist = netlist;
+    simulation->nb_fils = nb_fils;
+    simulation->seuil = SIMULATION_SEUIL_PARALLELE;
+    simulation->nb_mots_plan = -1;
+    simulation->etapes = (t_etape_simulation*)malloc(sizeof(t_etape_simulation) * (netlist->nb_niveaux + 1));
+    simulation->fils = (pthread_t*)malloc(sizeof(pthread_t) * nb_fils);
+    simulation->arguments = (struct t_argument_fil*)malloc(sizeof(struct t_argument_fil) * nb_fils);
+
+    if(simulation->etapes == NULL || simulation->fils == NULL || simulation->arguments == NULL)
+    {
+        free(simulation->etapes);
+        free(simulation->fils);
+        free(simulation->arguments);
+        free(simulation);
+
+        return NULL;
+    }
+
+    pthread_mutex_init(&simulation->verrou, NULL);
+    pthread_cond_init(&simulation->travail, NULL);
+    t_barriere_init(&simulation->barriere, nb_fils);
+
+    for(int f = 1;f<nb_fils;f++)
+    {
+        simulation->arguments[f].simulation = simulation;
+        simulation->arguments[f].numero = f;
+
+        if(pthread_create(&simulation->fils[f], NULL, t_simulation_parallele_fil, &simulation->arguments[f]) != 0)
+        {
+            t_simulation_parallele_destroy(simulation);
+
+            return NULL;
+        }
+
+        simulation->nb_fils_crees++;
+    }
+
+
+    return simulation;
+}
+
+void t_simulation_parallele_destroy(t_simulation_parallele *simulation)
+{
+    if(simulation == NULL)
+    {
+
+        return;
+    }
+
+    pthread_mutex_lock(&simulation->verrou);
+    simulation->arret = 1;
+    pthread_cond_broadcast(&simulation->travail);
+    pthread_mutex_unlock(&simulation->verrou);
+
+    for(int f = 1;f<=simulation->nb_fils_crees;f++)
+    {
+        pthread_join(simulation->fils[f], NULL);
+    }
+
+    pthread_mutex_destroy(&simulation->verrou);
+    pthread_cond_destroy(&simulation->travail);
+    free(simulation->etapes);
+    free(simulation->fils);
+    free(simulation->arguments);
+    free(simulation->valeurs_lot);
+    free(simulation);
+}
+
+int t_simulation_parallele_evaluer(t_simulation_parallele *simulation, uint64_t *valeurs, int nb_mots)
+{
+    t_simulation_parallele_planifier(simulation, nb_mots);
+
+    //Aucun niveau assez large: les fils auxiliaires ne sont pas réveillés
+    if(simulation->derniere_etape_parallele == -1)
+    {
+        t_netlist_evaluer(simulation->netlist, valeurs, nb_mots);
+
+        return 1;
+    }
+
+    pthread_mutex_lock(&simulation->verrou);
+    simulation->valeurs = valeurs;
+    simulation->nb_mots = nb_mots;
+    simulation->generation++;
+    pthread_cond_broadcast(&simulation->travail);
+    pthread_mutex_unlock(&simulation->verrou);
+
+    t_simulation_parallele_executer(simulation, 0, valeurs, nb_mots, simulation->derniere_etape_parallele);
+
+    //Étapes série après le dernier niveau large
+    for(int e = simulation->derniere_etape_parallele + 1;e<simulation->nb_etapes;e++)
+    {
+        t_netlist_evaluer_portes(simulation->netlist, valeurs, nb_mots, simulation->etapes[e].debut,
+                                 simulation->etapes[e].fin);
+    }
+
+
+    return 1;
+}
+
+int t_simulation_parallele_simuler_lot(t_simulation_parallele *simulation, const uint64_t entrees[],
+                                       uint64_t sorties[], int nb_mots)
+{
+    const t_netlist *netlist = simulation->netlist;
+    uint64_t *valeurs;
+
+    if(nb_mots > simulation->nb_mots_lot)
+    {
+        valeurs = (uint64_t*)realloc(simulation->valeurs_lot, sizeof(uint64_t) * netlist->nb_nets * nb_mots);
+
+        if(valeurs == NULL)
+        {
+
+            return 0;
+        }
+
+        simulation->valeurs_lot = valeurs;
+        simulation->nb_mots_lot = nb_mots;
+    }
+
+    memcpy(simulation->valeurs_lot, entrees, sizeof(uint64_t) * netlist->nb_entrees * nb_mots);
+
+    //Les bascules fournissent leur état courant, comme pour t_netlist_simuler_lot
+    t_netlist_lire_etats(netlist, simulation->valeurs_lot, nb_mots, 0, nb_mots);
+
+    if(t_simulation_parallele_evaluer(simulation, simulation->valeurs_lot, nb_mots) == 0)
+    {
+
+        return 0;
+    }
+
+    for(int j = 0;j<netlist->nb_sorties;j++)
+    {
+        memcpy(&sorties[j * nb_mots], &simulation->valeurs_lot[(size_t)netlist->sorties[j] * nb_mots],
+               sizeof(uint64_t) * nb_mots);
+    }
+
+
+    return 1;
+}
@@ -0,0 +1,135 @@
+/*
+Module: T_SIMULATION_PARALLELE
+Description: Évaluation d'une netlist par plusieurs fils d'exécution (pthreads). Les portes d'un
+			 même niveau sont indépendantes: chaque niveau large est découpé en tranches, une par
+			 fil, et une barrière sépare les niveaux. Les niveaux étroits (moins de "seuil"
+			 portes-mots) sont regroupés et évalués par un seul fil, sans synchronisation, car la
+			 barrière coûterait plus cher que le calcul.
+
+			 Les fils sont créés une seule fois par t_simulation_parallele_init et attendent les
+			 lots suivants: une simulation ne crée aucun fil.
+*/
+
+#ifndef T_SIMULATION_PARALLELE_H_
+#define T_SIMULATION_PARALLELE_H_
+
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "t_netlist.h"
+
+#define SIMULATION_SEUIL_PARALLELE 4096 //Nombre minimal de portes-mots d'un niveau évalué en parallèle
+#define SIMULATION_ATTENTE_ACTIVE 4096 //Nombre de tours d'attente active à une barrière avant de céder
+									   //le processeur (sched_yield). Aucune attente active s'il y a
+									   //plus de fils que de processeurs.
+
+typedef struct t_netlist t_netlist;
+
+/*
+Barrière entre les niveaux: attente active courte, puis sched_yield. Le compteur de générations
+permet de réutiliser la barrière sans la réinitialiser.
+*/
+typedef struct {
+	atomic_int nb_arrives;
+	atomic_int generation;
+	int nb_fils;
+	int attente_active; //Nombre de tours d'attente active avant sched_yield
+} t_barriere;
+
+/*
+Étape d'une évaluation: les portes debut à fin-1, évaluées par tous les fils (niveau large) ou
+par le fil principal seulement (suite de niveaux étroits).
+*/
+typedef struct {
+	int debut;
+	int fin;
+	int parallele;
+} t_etape_simulation;
+
+typedef struct t_simulation_parallele t_simulation_parallele;
+
+/*
+Argument d'un fil auxiliaire: la simulation et le numéro du fil (1 à nb_fils-1, le fil appelant a
+le numéro 0).
+*/
+struct t_argument_fil {
+	t_simulation_parallele *simulation;
+	int numero;
+};
+
+struct t_simulation_parallele {
+	t_netlist *netlist; //Netlist évaluée
+	int nb_fils; //Nombre de fils, y compris le fil qui appelle t_simulation_parallele_evaluer
+	int seuil; //Nombre minimal de portes-mots d'un niveau évalué en parallèle
+	pthread_t *fils; //Fils auxiliaires (indices 1 à nb_fils-1)
+	struct t_argument_fil *arguments; //Argument de chaque fil auxiliaire
+	int nb_fils_crees; //Nombre de fils auxiliaires démarrés
+
+	//Plan de l'évaluation (recalculé quand nb_mots ou le seuil change)
+	t_etape_simulation *etapes;
+	int nb_etapes;
+	int derniere_etape_parallele; //Indice de la dernière étape parallèle, -1 si aucune
+	int nb_mots_plan;
+	int seuil_plan;
+
+	//Travail en cours, publié aux fils sous la protection du verrou
+	uint64_t *valeurs;
+	int nb_mots;
+	int generation; //Incrémenté à chaque lot
+	int arret; //Booléen: vrai quand les fils doivent se terminer
+	pthread_mutex_t verrou;
+	pthread_cond_t travail;
+	t_barriere barriere;
+
+	//Valeurs des nets pour t_simulation_parallele_simuler_lot
+	uint64_t *valeurs_lot;
+	int nb_mots_lot;
+};
+
+/*
+Fonction: T_SIMULATION_PARALLELE_INIT
+Description: Crée un groupe de fils pour évaluer une netlist.
+Paramètres:
+- netlist: Pointeur vers la netlist à évaluer. Elle doit rester valide tant que la simulation existe.
+- nb_fils: Nombre de fils (1 = évaluation série dans le fil appelant).
+Retour: Pointeur vers la simulation créée, NULL si la mémoire manque ou si un fil n'a pu être créé.
+*/
+t_simulation_parallele *t_simulation_parallele_init(t_netlist *netlist, int nb_fils);
+
+/*
+Fonction: T_SIMULATION_PARALLELE_DESTROY
+Description: Arrête les fils et libère la simulation (la netlist n'est pas détruite).
+Paramètres:
+- simulation: Pointeur vers la simulation à détruire.
+Retour: Aucun.
+*/
+void t_simulation_parallele_destroy(t_simulation_parallele *simulation);
+
+/*
+Fonction: T_SIMULATION_PARALLELE_EVALUER
+Description: Évalue toutes les portes de la netlist (même résultat que t_netlist_evaluer).
+			 Une seule évaluation à la fois par simulation.
+Paramètres:
+- simulation: Pointeur vers la simulation.
+- valeurs: Valeurs des nets (nb_nets * nb_mots mots), les mots des entrées déjà placés.
+- nb_mots: Nombre de mots par net.
+Retour: Booléen: Vrai si les portes ont été évaluées, faux si la mémoire manque.
+*/
+int t_simulation_parallele_evaluer(t_simulation_parallele *simulation, uint64_t *valeurs, int nb_mots);
+
+/*
+Fonction: T_SIMULATION_PARALLELE_SIMULER_LOT
+Description: Simule un lot de vecteurs (même disposition et même résultat que t_netlist_simuler_lot).
+			 Les bascules fournissent l'état courant de la netlist, lu sans le modifier (voir
+			 t_netlist_lire_etats).
+Paramètres:
+- simulation: Pointeur vers la simulation.
+- entrees: Mots des entrées: entrees[i * nb_mots + m] est le mot m de l'entrée i.
+- sorties: Tableau (nb_sorties * nb_mots mots) qui reçoit les mots des sorties.
+- nb_mots: Nombre de mots par entrée.
+Retour: Booléen: Vrai si le lot a été simulé, faux si la mémoire manque.
+*/
+int t_simulation_parallele_simuler_lot(t_simulation_parallele *simulation, const uint64_t entrees[],
+                                       uint64_t sorties[], int nb_mots);
+
+#endif
@@ -6,44 +6,51 @@
 
 
  t_sortie *t_sortie_init(int num)
+ {
+
+    return t_sortie_init_arene(NULL, num);
+ }
+
+ t_sortie *t_sortie_init_arene(t_arene *arene, int num)
  {
     t_sortie * sortie;
 
-    sortie = (t_sortie*)malloc(sizeof(t_sortie));
+    sortie = (t_sortie*)t_arene_allouer(arene, sizeof(t_sortie));
 
     if(sortie == NULL)
     {
-        free(sortie);
 
         return NULL;
     }
 
-     sortie->nom = (char*) malloc( sizeof (char)*NOM_SORTIE_TAILLE_MAX);
+     sortie->nom = (char*) t_arene_allouer(arene, sizeof (char)*(snprintf(NULL, 0, "S%i", num) + 1));
 
     sortie -> id = num;
 
      if(sortie->nom == NULL)
      {
 
-         free(sortie);
+         t_arene_liberer(arene, sortie);
 
          return NULL;
      }
      sprintf(sortie ->nom, "S%i",num);
 
 
-     sortie->pin = t_pin_entree_init();
+     sortie->pin = t_pin_entree_init_arene(arene);
 
 
     if(sortie->pin == NULL)
     {
-            free(sortie->nom);
-            free(sortie);
+            t_arene_liberer(arene, sortie->nom);
+            t_arene_liberer(arene, sortie);
 
             return NULL;
 
     }
 
+    sortie->pin->sortie = sortie;
+
     return sortie;
 }
 
@@ -10,6 +10,7 @@ Dernière modification: 2018-03-19
 #ifndef SORTIE_H_
 #define SORTIE_H_
 
+#include "t_arene.h"
 #include "t_pin_entree.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -44,6 +45,18 @@ Paramètres modifié: Aucun.
 */
 t_sortie *t_sortie_init(int num);
 
+/*
+Fonction: T_SORTIE_INIT_ARENE
+Description: Crée une nouvelle sortie de circuit dans une arène (voir t_arene.h). Une sortie
+			 créée dans une arène est libérée avec l'arène et ne doit pas être passée à
+			 t_sortie_destroy.
+Paramètres:
+- arene: Arène dans laquelle la sortie est créée (NULL: même effet que t_sortie_init).
+- num: Voir t_sortie_init.
+Retour: Pointeur vers la sortie de circuit créée (NULL si la mémoire manque)
+*/
+t_sortie *t_sortie_init_arene(t_arene *arene, int num);
+
 /*
 Fonction: T_SORTIE_DESTROY
 Description: Libère la mémoire occupée par la sortie et tous ses composants (i.e. la pin).
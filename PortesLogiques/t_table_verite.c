@@ -0,0 +1,176 @@
+//
+// Tables de vérité compactes des sorties d'un circuit (voir t_table_verite.h).
+//
+
+#include <stdlib.h>
+#include "t_table_verite.h"
+#include "t_balayage.h"
+
+//Masques des bits du cofacteur à 0 de chacune des 6 premières entrées dans un mot
+static const uint64_t masques_cofacteurs[6] = {0x5555555555555555ull, 0x3333333333333333ull, 0x0F0F0F0F0F0F0F0Full,
+                                               0x00FF00FF00FF00FFull, 0x0000FFFF0000FFFFull, 0x00000000FFFFFFFFull};
+
+t_table_verite *t_table_verite_init(int nb_entrees, int nb_sorties)
+{
+    t_table_verite *table;
+
+    if(nb_entrees < 0 || nb_entrees > TABLE_VERITE_MAX_ENTREES || nb_sorties < 0)
+    {
+
+        return NULL;
+    }
+
+    table = (t_table_verite*)malloc(sizeof(t_table_verite));
+
+    if(table == NULL)
+    {
+
+        return NULL;
+    }
+
+    table->nb_entrees = nb_entrees;
+    table->nb_sorties = nb_sorties;
+    table->nb_mots = TABLE_VERITE_NB_MOTS(nb_entrees);
+    table->mots = (uint64_t*)calloc((size_t)nb_sorties * table->nb_mots + 1, sizeof(uint64_t));
+
+    if(table->mots == NULL)
+    {
+        free(table);
+
+        return NULL;
+    }
+
+
+    return table;
+}
+
+t_table_verite *t_table_verite_calculer(t_circuit *circuit, int nb_fils)
+{
+    t_netlist *netlist = t_circuit_get_netlist(circuit);
+    t_table_verite *table;
+    uint64_t masque;
+
+    if(netlist == NULL)
+    {
+
+        return NULL;
+    }
+
+    table = t_table_verite_init(netlist->nb_entrees, netlist->nb_sorties);
+
+    if(table == NULL)
+    {
+
+        return NULL;
+    }
+
+    if(t_balayage_plage(circuit, 0, (uint64_t)1 << table->nb_entrees, nb_fils, table->mots, NULL, NULL) < 0)
+    {
+        t_table_verite_destroy(table);
+
+        return NULL;
+    }
+
+    //Moins de 6 entrées: le mot unique de chaque sortie n'est que partiellement significatif
+    if(table->nb_entrees < 6)
+    {
+        masque = ((uint64_t)1 << (1 << table->nb_entrees)) - 1;
+
+        for(int j = 0;j<table->nb_sorties;j++)
+        {
+            table->mots[j] &= masque;
+        }
+    }
+
+
+    return table;
+}
+
+void t_table_verite_destroy(t_table_verite *table)
+{
+    if(table != NULL)
+    {
+        free(table->mots);
+        free(table);
+    }
+}
+
+int t_table_verite_valeur(const t_table_verite *table, int sortie, uint64_t vecteur)
+{
+
+    return (int)((table->mots[(size_t)sortie * table->nb_mots + vecteur / 64] >> (vecteur % 64)) & 1);
+}
+
+long long t_table_verite_nb_uns(const t_table_verite *table, int sortie)
+{
+    const uint64_t *mots = &table->mots[(size_t)sortie * table->nb_mots];
+    long long nb_uns = 0;
+
+    for(int w = 0;w<table->nb_mots;w++)
+    {
+        nb_uns += __builtin_popcountll(mots[w]);
+    }
+
+
+    return nb_uns;
+}
+
+int t_table_verite_depend(const t_table_verite *table, int sortie, int entree)
+{
+    const uint64_t *mots = &table->mots[(size_t)sortie * table->nb_mots];
+    int pas;
+
+    if(entree < 6)
+    {
+        //Les bits du cofacteur à 1 sont 2^entree rangs plus haut que ceux du cofacteur à 0
+        for(int w = 0;w<table->nb_mots;w++)
+        {
+            if(((mots[w] ^ mots[w] >> (1 << entree)) & masques_cofacteurs[entree]) != 0)
+            {
+
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    //Les mots du cofacteur à 1 sont 2^(entree - 6) mots plus loin que ceux du cofacteur à 0
+    pas = 1 << (entree - 6);
+
+    for(int w = 0;w<table->nb_mots;w++)
+    {
+        if((w & pas) == 0 && mots[w] != mots[w + pas])
+        {
+
+            return 1;
+        }
+    }
+
+
+    return 0;
+}
+
+int t_table_verite_comparer(const t_table_verite *table_a, const t_table_verite *table_b)
+{
+    if(table_a->nb_entrees != table_b->nb_entrees || table_a->nb_sorties != table_b->nb_sorties)
+    {
+
+        return table_a->nb_sorties;
+    }
+
+    for(int j = 0;j<table_a->nb_sorties;j++)
+    {
+        for(int w = 0;w<table_a->nb_mots;w++)
+        {
+            if(table_a->mots[(size_t)j * table_a->nb_mots + w] != table_b->mots[(size_t)j * table_b->nb_mots + w])
+            {
+
+                return j;
+            }
+        }
+    }
+
+
+    return -1;
+}
@@ -0,0 +1,115 @@
+/*
+Module: T_TABLE_VERITE
+Description: Tables de vérité compactes des sorties d'un circuit: un bit par vecteur d'entrée,
+			 64 vecteurs par mot. Le vecteur v donne à l'entrée i la valeur du bit i de v.
+
+			 La table est calculée par le balayage parallèle (t_balayage_plage): les entrées sont
+			 énumérées par mots entiers (motifs 0xAAAA..., 0xCCCC..., ... pour les 6 premières
+			 entrées, mot tout à 0 ou tout à 1 pour les suivantes), si bien que chaque porte ne
+			 coûte qu'une opération par mot de 64 vecteurs au lieu de 64 appels à
+			 t_circuit_propager_signal.
+
+			 Le nombre d'entrées est limité à TABLE_VERITE_MAX_ENTREES (2^24 bits, 2 Mo par
+			 sortie). Au-delà, voir t_bdd.h. Les bascules d'un circuit séquentiel valent 0 (même
+			 convention que t_balayage_plage).
+*/
+
+#ifndef T_TABLE_VERITE_H_
+#define T_TABLE_VERITE_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+
+#define TABLE_VERITE_MAX_ENTREES 24 //Nombre maximal d'entrées d'une table de vérité
+//Nombre de mots de 64 bits de la table d'une sortie d'un circuit à n entrées
+#define TABLE_VERITE_NB_MOTS(n) ((n) < 6 ? 1 : 1 << ((n) - 6))
+
+typedef struct t_circuit t_circuit;
+
+struct t_table_verite {
+	int nb_entrees; //Nombre d'entrées (variables) de la table
+	int nb_sorties; //Nombre de sorties
+	int nb_mots; //Nombre de mots par sortie (TABLE_VERITE_NB_MOTS(nb_entrees))
+	//Le bit v % 64 du mot mots[j * nb_mots + v / 64] est la valeur de la sortie j pour le vecteur v.
+	//Les bits au-delà du vecteur 2^nb_entrees - 1 (moins de 6 entrées) valent 0.
+	uint64_t *mots;
+};
+
+typedef struct t_table_verite t_table_verite;
+
+/*
+Fonction: T_TABLE_VERITE_INIT
+Description: Crée une table de vérité dont tous les bits valent 0.
+Paramètres:
+- nb_entrees: Nombre d'entrées (0 à TABLE_VERITE_MAX_ENTREES).
+- nb_sorties: Nombre de sorties.
+Retour: Pointeur vers la table, NULL si le nombre d'entrées est invalide ou si la mémoire manque.
+*/
+t_table_verite *t_table_verite_init(int nb_entrees, int nb_sorties);
+
+/*
+Fonction: T_TABLE_VERITE_CALCULER
+Description: Calcule la table de vérité de toutes les sorties d'un circuit.
+Paramètres:
+- circuit: Pointeur vers le circuit (il est compilé en netlist au besoin).
+- nb_fils: Nombre de fils du balayage (1 = dans le fil appelant seulement).
+Retour: Pointeur vers la table, NULL si le circuit a plus de TABLE_VERITE_MAX_ENTREES entrées,
+		s'il ne peut pas être compilé ou si la mémoire manque.
+*/
+t_table_verite *t_table_verite_calculer(t_circuit *circuit, int nb_fils);
+
+/*
+Fonction: T_TABLE_VERITE_DESTROY
+Description: Libère la mémoire occupée par la table.
+Paramètres:
+- table: Pointeur vers la table à détruire (NULL: aucun effet).
+Retour: Aucun.
+*/
+void t_table_verite_destroy(t_table_verite *table);
+
+/*
+Fonction: T_TABLE_VERITE_VALEUR
+Description: Retourne la valeur d'une sortie pour un vecteur d'entrée.
+Paramètres:
+- table: Pointeur vers la table.
+- sortie: Indice de la sortie.
+- vecteur: Vecteur d'entrée (0 à 2^nb_entrees - 1).
+Retour: 0 ou 1.
+*/
+int t_table_verite_valeur(const t_table_verite *table, int sortie, uint64_t vecteur);
+
+/*
+Fonction: T_TABLE_VERITE_NB_UNS
+Description: Compte les vecteurs d'entrée pour lesquels une sortie vaut 1.
+Paramètres:
+- table: Pointeur vers la table.
+- sortie: Indice de la sortie.
+Retour: Nombre de vecteurs (0 à 2^nb_entrees).
+*/
+long long t_table_verite_nb_uns(const t_table_verite *table, int sortie);
+
+/*
+Fonction: T_TABLE_VERITE_DEPEND
+Description: Indique si une sortie dépend d'une entrée, c'est-à-dire si ses deux cofacteurs
+			 (l'entrée à 0 et l'entrée à 1) diffèrent. Les cofacteurs sont comparés par mots
+			 entiers (par décalage à l'intérieur du mot pour les 6 premières entrées).
+Paramètres:
+- table: Pointeur vers la table.
+- sortie: Indice de la sortie.
+- entree: Indice de l'entrée.
+Retour: Booléen: Vrai si la sortie dépend de l'entrée.
+*/
+int t_table_verite_depend(const t_table_verite *table, int sortie, int entree);
+
+/*
+Fonction: T_TABLE_VERITE_COMPARER
+Description: Compare deux tables de vérité.
+Paramètres:
+- table_a: Pointeur vers la première table.
+- table_b: Pointeur vers la seconde table.
+Retour: -1 si les tables sont identiques, sinon l'indice de la première sortie qui diffère (ou
+		nb_sorties de table_a si les dimensions des tables diffèrent).
+*/
+int t_table_verite_comparer(const t_table_verite *table_a, const t_table_verite *table_b);
+
+#endif
@@ -0,0 +1,701 @@
+//
+// Lecture et écriture de fichiers de vecteurs par blocs (voir t_vecteurs.h).
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "t_vecteurs.h"
+
+#define VECTEURS_TAILLE_ENTETE 16 //Signature, nombre de signaux (32 bits) et nombre de vecteurs (64 bits)
+
+/*
+Double tampon partagé entre un producteur et un consommateur de blocs: le fil du lecteur et le fil
+appelant, ou le fil appelant et le fil de l'écrivain. Chaque tampon est rempli par le producteur,
+puis vidé par le consommateur, puis rendu au producteur.
+*/
+typedef struct {
+	uint64_t *tampons[2];
+	int nb_vecteurs[2]; //Nombre de vecteurs de chaque tampon plein (0: fin, -1: erreur)
+	int plein[2]; //Booléen: vrai si le tampon attend le consommateur
+	int production; //Tampon que le producteur remplit ensuite
+	int consommation; //Tampon que le consommateur vide ensuite
+	int arret; //Booléen: vrai quand le consommateur abandonne (le producteur doit s'arrêter)
+	pthread_mutex_t verrou;
+	pthread_cond_t changement; //Signalé chaque fois qu'un tampon change de main
+	pthread_t fil;
+	int fil_cree; //Booléen: vrai si le fil du lecteur ou de l'écrivain a été démarré
+} t_double_tampon;
+
+struct t_lecteur_vecteurs {
+	char *nom_fichier; //Copie du nom, pour les messages d'erreur
+	e_format_vecteurs format;
+	int nb_signaux;
+	int nb_mots;
+	int asynchrone;
+	//Fichier texte
+	FILE *fichier;
+	char *ligne;
+	size_t capacite_ligne;
+	int num_ligne;
+	//Fichier binaire projeté en mémoire
+	const unsigned char *contenu;
+	size_t taille;
+	long long nb_vecteurs_fichier;
+	long long prochain_vecteur;
+	//Résultat de la dernière lecture une fois la fin ou une erreur atteinte (0 ou -1), 1 avant
+	int resultat_final;
+	t_double_tampon double_tampon;
+};
+
+struct t_ecrivain_vecteurs {
+	FILE *fichier;
+	e_format_vecteurs format;
+	int nb_signaux;
+	int nb_mots;
+	int asynchrone;
+	char *texte; //Mise en forme d'un bloc au format texte (une ligne par vecteur)
+	uint64_t *paquet; //Paquet de 64 vecteurs au format binaire (un mot par signal)
+	long long nb_vecteurs; //Nombre de vecteurs acceptés
+	int termine; //Booléen: vrai après un bloc incomplet (binaire: plus aucun bloc n'est accepté)
+	atomic_int erreur; //Booléen: vrai si une écriture a échoué (écrit par le fil de l'écrivain)
+	t_double_tampon double_tampon;
+};
+
+//Alloue les deux tampons (nb_mots mots chacun). Retourne faux si la mémoire manque.
+static int t_double_tampon_init(t_double_tampon *double_tampon, size_t nb_mots)
+{
+    double_tampon->tampons[0] = (uint64_t*)malloc(sizeof(uint64_t) * nb_mots);
+    double_tampon->tampons[1] = (uint64_t*)malloc(sizeof(uint64_t) * nb_mots);
+    double_tampon->plein[0] = 0;
+    double_tampon->plein[1] = 0;
+    double_tampon->production = 0;
+    double_tampon->consommation = 0;
+    double_tampon->arret = 0;
+    double_tampon->fil_cree = 0;
+    pthread_mutex_init(&double_tampon->verrou, NULL);
+    pthread_cond_init(&double_tampon->changement, NULL);
+
+
+    return double_tampon->tampons[0] != NULL && double_tampon->tampons[1] != NULL;
+}
+
+//Arrête le fil (s'il a été démarré) et libère les tampons
+static void t_double_tampon_destroy(t_double_tampon *double_tampon)
+{
+    pthread_mutex_lock(&double_tampon->verrou);
+    double_tampon->arret = 1;
+    pthread_cond_broadcast(&double_tampon->changement);
+    pthread_mutex_unlock(&double_tampon->verrou);
+
+    if(double_tampon->fil_cree)
+    {
+        pthread_join(double_tampon->fil, NULL);
+    }
+
+    pthread_mutex_destroy(&double_tampon->verrou);
+    pthread_cond_destroy(&double_tampon->changement);
+    free(double_tampon->tampons[0]);
+    free(double_tampon->tampons[1]);
+}
+
+//Producteur: attend que le prochain tampon soit vide. Retourne NULL si le consommateur a abandonné.
+static uint64_t *t_double_tampon_prendre_vide(t_double_tampon *double_tampon)
+{
+    uint64_t *tampon;
+
+    pthread_mutex_lock(&double_tampon->verrou);
+
+    while(double_tampon->plein[double_tampon->production] && double_tampon->arret == 0)
+    {
+        pthread_cond_wait(&double_tampon->changement, &double_tampon->verrou);
+    }
+
+    tampon = double_tampon->arret ? NULL : double_tampon->tampons[double_tampon->production];
+    pthread_mutex_unlock(&double_tampon->verrou);
+
+
+    return tampon;
+}
+
+//Producteur: remet au consommateur le tampon rempli (nb_vecteurs <= 0 pour la fin ou une erreur)
+static void t_double_tampon_publier(t_double_tampon *double_tampon, int nb_vecteurs)
+{
+    pthread_mutex_lock(&double_tampon->verrou);
+    double_tampon->nb_vecteurs[double_tampon->production] = nb_vecteurs;
+    double_tampon->plein[double_tampon->production] = 1;
+    double_tampon->production ^= 1;
+    pthread_cond_broadcast(&double_tampon->changement);
+    pthread_mutex_unlock(&double_tampon->verrou);
+}
+
+//Consommateur: attend que le prochain tampon soit plein et donne son nombre de vecteurs
+static uint64_t *t_double_tampon_prendre_plein(t_double_tampon *double_tampon, int *nb_vecteurs)
+{
+    pthread_mutex_lock(&double_tampon->verrou);
+
+    while(double_tampon->plein[double_tampon->consommation] == 0)
+    {
+        pthread_cond_wait(&double_tampon->changement, &double_tampon->verrou);
+    }
+
+    *nb_vecteurs = double_tampon->nb_vecteurs[double_tampon->consommation];
+    pthread_mutex_unlock(&double_tampon->verrou);
+
+
+    return double_tampon->tampons[double_tampon->consommation];
+}
+
+//Consommateur: rend au producteur le tampon vidé
+static void t_double_tampon_liberer(t_double_tampon *double_tampon)
+{
+    pthread_mutex_lock(&double_tampon->verrou);
+    double_tampon->plein[double_tampon->consommation] = 0;
+    double_tampon->consommation ^= 1;
+    pthread_cond_broadcast(&double_tampon->changement);
+    pthread_mutex_unlock(&double_tampon->verrou);
+}
+
+
+/*******LECTURE***********/
+
+//Décode les lignes suivantes d'un fichier texte dans le bloc
+static int t_lecteur_vecteurs_remplir_texte(t_lecteur_vecteurs *lecteur, uint64_t bloc[])
+{
+    const int nb_signaux = lecteur->nb_signaux;
+    const int nb_mots = lecteur->nb_mots;
+    int nb_vecteurs = 0;
+    int nb_valeurs;
+    char *c;
+
+    memset(bloc, 0, sizeof(uint64_t) * nb_signaux * nb_mots);
+
+    while(nb_vecteurs < 64 * nb_mots && getline(&lecteur->ligne, &lecteur->capacite_ligne, lecteur->fichier) != -1)
+    {
+        lecteur->num_ligne++;
+        nb_valeurs = 0;
+
+        for(c = lecteur->ligne;*c != '\0' && *c != '#' && nb_valeurs >= 0;c++)
+        {
+            if(*c == '0' || *c == '1')
+            {
+                if(nb_valeurs < nb_signaux)
+                {
+                    bloc[nb_valeurs * nb_mots + nb_vecteurs / 64] |= (uint64_t)(*c - '0') << (nb_vecteurs % 64);
+                }
+
+                nb_valeurs++;
+            }
+            else if(*c != ' ' && *c != '\t' && *c != '\r' && *c != '\n')
+            {
+                nb_valeurs = -1;
+            }
+        }
+
+        //Ligne vide ou commentaire
+        if(nb_valeurs == 0)
+        {
+            continue;
+        }
+
+        if(nb_valeurs != nb_signaux)
+        {
+            printf("ERREUR DE LECTURE: %s, ligne %d: %d valeurs 0 ou 1 attendues\n", lecteur->nom_fichier,
+                   lecteur->num_ligne, nb_signaux);
+
+            return -1;
+        }
+
+        nb_vecteurs++;
+    }
+
+
+    return nb_vecteurs;
+}
+
+//Copie les paquets suivants d'un fichier binaire dans le bloc
+static int t_lecteur_vecteurs_remplir_binaire(t_lecteur_vecteurs *lecteur, uint64_t bloc[])
+{
+    const int nb_signaux = lecteur->nb_signaux;
+    const int nb_mots = lecteur->nb_mots;
+    long long restants = lecteur->nb_vecteurs_fichier - lecteur->prochain_vecteur;
+    int nb_vecteurs = restants < 64 * nb_mots ? (int)restants : 64 * nb_mots;
+    int nb_paquets = (nb_vecteurs + 63) / 64;
+    const uint64_t *paquet;
+    uint64_t masque;
+
+    for(int m = 0;m<nb_mots;m++)
+    {
+        //Les bits après le dernier vecteur du fichier valent 0
+        masque = m < nb_paquets - 1 || nb_vecteurs % 64 == 0 ? ~0ull : (1ull << (nb_vecteurs % 64)) - 1;
+        paquet = (const uint64_t*)(lecteur->contenu + VECTEURS_TAILLE_ENTETE)
+                 + (size_t)(lecteur->prochain_vecteur / 64 + m) * nb_signaux;
+
+        for(int i = 0;i<nb_signaux;i++)
+        {
+            bloc[i * nb_mots + m] = m < nb_paquets ? paquet[i] & masque : 0;
+        }
+    }
+
+    lecteur->prochain_vecteur += nb_vecteurs;
+
+
+    return nb_vecteurs;
+}
+
+static int t_lecteur_vecteurs_remplir(t_lecteur_vecteurs *lecteur, uint64_t bloc[])
+{
+
+    return lecteur->format == VECTEURS_TEXTE ? t_lecteur_vecteurs_remplir_texte(lecteur, bloc)
+                                             : t_lecteur_vecteurs_remplir_binaire(lecteur, bloc);
+}
+
+//Fil du lecteur: décode les blocs un à un, tant que le fil appelant libère les tampons
+static void *t_lecteur_vecteurs_fil(void *argument)
+{
+    t_lecteur_vecteurs *lecteur = (t_lecteur_vecteurs*)argument;
+    uint64_t *bloc;
+    int nb_vecteurs = 1;
+
+    while(nb_vecteurs > 0 && (bloc = t_double_tampon_prendre_vide(&lecteur->double_tampon)) != NULL)
+    {
+        nb_vecteurs = t_lecteur_vecteurs_remplir(lecteur, bloc);
+        t_double_tampon_publier(&lecteur->double_tampon, nb_vecteurs);
+    }
+
+
+    return NULL;
+}
+
+//Projette un fichier binaire et vérifie son en-tête. Retourne faux (avec un message) s'il est invalide.
+static int t_lecteur_vecteurs_projeter(t_lecteur_vecteurs *lecteur)
+{
+    uint32_t entete[2];
+    uint64_t nb_vecteurs;
+
+    lecteur->contenu = t_circuit_io_projeter(lecteur->nom_fichier, &lecteur->taille);
+
+    if(lecteur->contenu == NULL || lecteur->taille < VECTEURS_TAILLE_ENTETE)
+    {
+        printf("ERREUR DE LECTURE: impossible de lire %s\n", lecteur->nom_fichier);
+
+        return 0;
+    }
+
+    memcpy(entete, lecteur->contenu, sizeof(entete));
+    memcpy(&nb_vecteurs, lecteur->contenu + sizeof(entete), sizeof(nb_vecteurs));
+
+    if((int)entete[1] != lecteur->nb_signaux)
+    {
+        printf("ERREUR DE LECTURE: %s: %u signaux par vecteur, %d attendus\n", lecteur->nom_fichier, entete[1],
+               lecteur->nb_signaux);
+
+        return 0;
+    }
+
+    if((lecteur->taille - VECTEURS_TAILLE_ENTETE) / sizeof(uint64_t) / (lecteur->nb_signaux > 0 ? lecteur->nb_signaux : 1)
+       < (nb_vecteurs + 63) / 64)
+    {
+        printf("ERREUR DE LECTURE: %s: fichier tronque\n", lecteur->nom_fichier);
+
+        return 0;
+    }
+
+    lecteur->nb_vecteurs_fichier = (long long)nb_vecteurs;
+
+
+    return 1;
+}
+
+t_lecteur_vecteurs *t_lecteur_vecteurs_ouvrir(const char *nom_fichier, int nb_signaux, int nb_mots, int asynchrone)
+{
+    t_lecteur_vecteurs *lecteur;
+    uint32_t magique = 0;
+    int succes;
+
+    if(nb_signaux < 0 || nb_mots < 1 || (lecteur = (t_lecteur_vecteurs*)calloc(1, sizeof(t_lecteur_vecteurs))) == NULL)
+    {
+
+        return NULL;
+    }
+
+    lecteur->nb_signaux = nb_signaux;
+    lecteur->nb_mots = nb_mots;
+    lecteur->asynchrone = asynchrone;
+    lecteur->resultat_final = 1;
+    lecteur->nom_fichier = (char*)malloc(strlen(nom_fichier) + 1);
+    lecteur->fichier = fopen(nom_fichier, "rb");
+    succes = t_double_tampon_init(&lecteur->double_tampon, (size_t)(nb_signaux + 1) * nb_mots)
+             && lecteur->nom_fichier != NULL;
+
+    if(succes && lecteur->fichier == NULL)
+    {
+        printf("ERREUR DE LECTURE: impossible d'ouvrir %s\n", nom_fichier);
+        succes = 0;
+    }
+
+    if(succes)
+    {
+        strcpy(lecteur->nom_fichier, nom_fichier);
+
+        //La signature distingue les fichiers binaires; ceux-ci sont projetés en mémoire
+        if(fread(&magique, sizeof(magique), 1, lecteur->fichier) == 1 && magique == VECTEURS_BINAIRE_MAGIQUE)
+        {
+            lecteur->format = VECTEURS_BINAIRE;
+            fclose(lecteur->fichier);
+            lecteur->fichier = NULL;
+            succes = t_lecteur_vecteurs_projeter(lecteur);
+        }
+        else
+        {
+            lecteur->format = VECTEURS_TEXTE;
+            rewind(lecteur->fichier);
+        }
+    }
+
+    if(succes && asynchrone)
+    {
+        succes = pthread_create(&lecteur->double_tampon.fil, NULL, t_lecteur_vecteurs_fil, lecteur) == 0;
+        lecteur->double_tampon.fil_cree = succes;
+    }
+
+    if(succes == 0)
+    {
+        t_lecteur_vecteurs_fermer(lecteur);
+
+        return NULL;
+    }
+
+
+    return lecteur;
+}
+
+int t_lecteur_vecteurs_lire(t_lecteur_vecteurs *lecteur, uint64_t bloc[])
+{
+    const uint64_t *tampon;
+    int nb_vecteurs;
+
+    //Le fil s'est arrêté après la fin du fichier ou une erreur: rien ne viendra plus
+    if(lecteur->resultat_final <= 0)
+    {
+
+        return lecteur->resultat_final;
+    }
+
+    if(lecteur->asynchrone)
+    {
+        tampon = t_double_tampon_prendre_plein(&lecteur->double_tampon, &nb_vecteurs);
+
+        if(nb_vecteurs > 0)
+        {
+            memcpy(bloc, tampon, sizeof(uint64_t) * lecteur->nb_signaux * lecteur->nb_mots);
+        }
+
+        t_double_tampon_liberer(&lecteur->double_tampon);
+    }
+    else
+    {
+        nb_vecteurs = t_lecteur_vecteurs_remplir(lecteur, bloc);
+    }
+
+    if(nb_vecteurs <= 0)
+    {
+        lecteur->resultat_final = nb_vecteurs;
+    }
+
+
+    return nb_vecteurs;
+}
+
+void t_lecteur_vecteurs_fermer(t_lecteur_vecteurs *lecteur)
+{
+    if(lecteur == NULL)
+    {
+
+        return;
+    }
+
+    t_double_tampon_destroy(&lecteur->double_tampon);
+
+    if(lecteur->fichier != NULL)
+    {
+        fclose(lecteur->fichier);
+    }
+
+    if(lecteur->contenu != NULL)
+    {
+        t_circuit_io_liberer_projection(lecteur->contenu, lecteur->taille);
+    }
+
+    free(lecteur->ligne);
+    free(lecteur->nom_fichier);
+    free(lecteur);
+}
+
+
+/*******ÉCRITURE***********/
+
+//Met en forme et écrit un bloc
+static void t_ecrivain_vecteurs_vider(t_ecrivain_vecteurs *ecrivain, const uint64_t bloc[], int nb_vecteurs)
+{
+    const int nb_signaux = ecrivain->nb_signaux;
+    const int nb_mots = ecrivain->nb_mots;
+    char *c = ecrivain->texte;
+    size_t nb_ecrits;
+    size_t nb_attendus;
+    uint64_t masque;
+
+    if(ecrivain->format == VECTEURS_TEXTE)
+    {
+        for(int v = 0;v<nb_vecteurs;v++)
+        {
+            for(int j = 0;j<nb_signaux;j++)
+            {
+                *c++ = (char)('0' + ((bloc[j * nb_mots + v / 64] >> (v % 64)) & 1));
+            }
+
+            *c++ = '\n';
+        }
+
+        nb_attendus = (size_t)(c - ecrivain->texte);
+        nb_ecrits = fwrite(ecrivain->texte, 1, nb_attendus, ecrivain->fichier);
+    }
+    else
+    {
+        nb_attendus = 0;
+        nb_ecrits = 0;
+
+        for(int m = 0;m * 64 < nb_vecteurs;m++)
+        {
+            masque = nb_vecteurs - m * 64 >= 64 ? ~0ull : (1ull << (nb_vecteurs - m * 64)) - 1;
+
+            for(int j = 0;j<nb_signaux;j++)
+            {
+                ecrivain->paquet[j] = bloc[j * nb_mots + m] & masque;
+            }
+
+            nb_attendus += (size_t)nb_signaux;
+            nb_ecrits += fwrite(ecrivain->paquet, sizeof(uint64_t), (size_t)nb_signaux, ecrivain->fichier);
+        }
+    }
+
+    if(nb_ecrits != nb_attendus)
+    {
+        atomic_store(&ecrivain->erreur, 1);
+    }
+}
+
+//Fil de l'écrivain: écrit les blocs dans l'ordre où le fil appelant les a donnés, jusqu'au bloc vide
+static void *t_ecrivain_vecteurs_fil(void *argument)
+{
+    t_ecrivain_vecteurs *ecrivain = (t_ecrivain_vecteurs*)argument;
+    const uint64_t *bloc;
+    int nb_vecteurs;
+
+    do
+    {
+        bloc = t_double_tampon_prendre_plein(&ecrivain->double_tampon, &nb_vecteurs);
+
+        if(nb_vecteurs > 0)
+        {
+            t_ecrivain_vecteurs_vider(ecrivain, bloc, nb_vecteurs);
+        }
+
+        t_double_tampon_liberer(&ecrivain->double_tampon);
+    } while(nb_vecteurs > 0);
+
+
+    return NULL;
+}
+
+//Écrit l'en-tête d'un fichier binaire
+static int t_ecrivain_vecteurs_entete(t_ecrivain_vecteurs *ecrivain)
+{
+    const uint32_t entete[2] = {VECTEURS_BINAIRE_MAGIQUE, (uint32_t)ecrivain->nb_signaux};
+    const uint64_t nb_vecteurs = (uint64_t)ecrivain->nb_vecteurs;
+
+
+    return fwrite(entete, sizeof(entete), 1, ecrivain->fichier) == 1
+           && fwrite(&nb_vecteurs, sizeof(nb_vecteurs), 1, ecrivain->fichier) == 1;
+}
+
+t_ecrivain_vecteurs *t_ecrivain_vecteurs_ouvrir(const char *nom_fichier, e_format_vecteurs format, int nb_signaux,
+                                                int nb_mots, int asynchrone)
+{
+    t_ecrivain_vecteurs *ecrivain;
+    int succes;
+
+    if(nb_signaux < 0 || nb_mots < 1
+       || (ecrivain = (t_ecrivain_vecteurs*)calloc(1, sizeof(t_ecrivain_vecteurs))) == NULL)
+    {
+
+        return NULL;
+    }
+
+    ecrivain->format = format;
+    ecrivain->nb_signaux = nb_signaux;
+    ecrivain->nb_mots = nb_mots;
+    ecrivain->asynchrone = asynchrone;
+    atomic_init(&ecrivain->erreur, 0);
+    ecrivain->texte = (char*)malloc((size_t)(nb_signaux + 1) * 64 * nb_mots);
+    ecrivain->paquet = (uint64_t*)malloc(sizeof(uint64_t) * (nb_signaux + 1));
+    succes = t_double_tampon_init(&ecrivain->double_tampon, (size_t)(nb_signaux + 1) * nb_mots)
+             && ecrivain->texte != NULL && ecrivain->paquet != NULL;
+    ecrivain->fichier = succes ? fopen(nom_fichier, format == VECTEURS_BINAIRE ? "wb" : "w") : NULL;
+
+    if(succes && ecrivain->fichier == NULL)
+    {
+        printf("ERREUR D'ECRITURE: impossible de creer %s\n", nom_fichier);
+        succes = 0;
+    }
+
+    //Le nombre de vecteurs de l'en-tête est complété à la fermeture
+    if(succes && format == VECTEURS_BINAIRE)
+    {
+        succes = t_ecrivain_vecteurs_entete(ecrivain);
+    }
+
+    if(succes && asynchrone)
+    {
+        succes = pthread_create(&ecrivain->double_tampon.fil, NULL, t_ecrivain_vecteurs_fil, ecrivain) == 0;
+        ecrivain->double_tampon.fil_cree = succes;
+    }
+
+    if(succes == 0)
+    {
+        t_ecrivain_vecteurs_fermer(ecrivain);
+
+        return NULL;
+    }
+
+
+    return ecrivain;
+}
+
+int t_ecrivain_vecteurs_ecrire(t_ecrivain_vecteurs *ecrivain, const uint64_t bloc[], int nb_vecteurs)
+{
+    uint64_t *tampon;
+
+    if(nb_vecteurs < 1 || nb_vecteurs > 64 * ecrivain->nb_mots || atomic_load(&ecrivain->erreur)
+       || (ecrivain->termine && ecrivain->format == VECTEURS_BINAIRE))
+    {
+
+        return 0;
+    }
+
+    if(ecrivain->asynchrone)
+    {
+        tampon = t_double_tampon_prendre_vide(&ecrivain->double_tampon);
+        memcpy(tampon, bloc, sizeof(uint64_t) * ecrivain->nb_signaux * ecrivain->nb_mots);
+        t_double_tampon_publier(&ecrivain->double_tampon, nb_vecteurs);
+    }
+    else
+    {
+        t_ecrivain_vecteurs_vider(ecrivain, bloc, nb_vecteurs);
+    }
+
+    ecrivain->nb_vecteurs += nb_vecteurs;
+    ecrivain->termine = nb_vecteurs % 64 != 0;
+
+
+    return 1;
+}
+
+int t_ecrivain_vecteurs_fermer(t_ecrivain_vecteurs *ecrivain)
+{
+    int succes;
+
+    if(ecrivain == NULL)
+    {
+
+        return 1;
+    }
+
+    //Un bloc vide termine le fil, après les blocs en attente
+    if(ecrivain->double_tampon.fil_cree && t_double_tampon_prendre_vide(&ecrivain->double_tampon) != NULL)
+    {
+        t_double_tampon_publier(&ecrivain->double_tampon, 0);
+    }
+
+    t_double_tampon_destroy(&ecrivain->double_tampon);
+    succes = ecrivain->fichier != NULL && atomic_load(&ecrivain->erreur) == 0;
+
+    if(succes && ecrivain->format == VECTEURS_BINAIRE)
+    {
+        succes = fseek(ecrivain->fichier, 0, SEEK_SET) == 0 && t_ecrivain_vecteurs_entete(ecrivain);
+    }
+
+    if(ecrivain->fichier != NULL && fclose(ecrivain->fichier) != 0)
+    {
+        succes = 0;
+    }
+
+    free(ecrivain->texte);
+    free(ecrivain->paquet);
+    free(ecrivain);
+
+
+    return succes;
+}
+
+
+/*******SIMULATION D'UN FICHIER À L'AUTRE***********/
+
+long long t_vecteurs_simuler_fichiers(t_circuit *circuit, const char *fichier_entrees, const char *fichier_sorties,
+                                      e_format_vecteurs format_sorties, int asynchrone)
+{
+    t_lecteur_vecteurs *lecteur;
+    t_ecrivain_vecteurs *ecrivain;
+    uint64_t *entrees;
+    uint64_t *sorties;
+    long long nb_simules = 0;
+    int nb_vecteurs;
+
+    if(t_circuit_est_simulable(circuit) == 0 || t_circuit_get_netlist(circuit) == NULL)
+    {
+        printf("ERREUR DE SIMULATION: le circuit n'est pas valide (lien manquant ou boucle combinatoire)\n");
+
+        return -1;
+    }
+
+    lecteur = t_lecteur_vecteurs_ouvrir(fichier_entrees, circuit->nb_entrees, VECTEURS_MOTS_BLOC, asynchrone);
+    ecrivain = lecteur == NULL ? NULL : t_ecrivain_vecteurs_ouvrir(fichier_sorties, format_sorties, circuit->nb_sorties,
+                                                                   VECTEURS_MOTS_BLOC, asynchrone);
+    entrees = (uint64_t*)malloc(sizeof(uint64_t) * (circuit->nb_entrees + 1) * VECTEURS_MOTS_BLOC);
+    sorties = (uint64_t*)malloc(sizeof(uint64_t) * (circuit->nb_sorties + 1) * VECTEURS_MOTS_BLOC);
+
+    if(ecrivain == NULL || entrees == NULL || sorties == NULL)
+    {
+        nb_simules = -1;
+    }
+
+    //Pendant la simulation d'un bloc, le lecteur décode le suivant et l'écrivain écrit le précédent
+    while(nb_simules >= 0 && (nb_vecteurs = t_lecteur_vecteurs_lire(lecteur, entrees)) != 0)
+    {
+        if(nb_vecteurs < 0 || t_circuit_simuler_lot(circuit, entrees, sorties, VECTEURS_MOTS_BLOC) == 0
+           || t_ecrivain_vecteurs_ecrire(ecrivain, sorties, nb_vecteurs) == 0)
+        {
+            nb_simules = -1;
+        }
+        else
+        {
+            nb_simules += nb_vecteurs;
+        }
+    }
+
+    if(t_ecrivain_vecteurs_fermer(ecrivain) == 0)
+    {
+        nb_simules = -1;
+    }
+
+    t_lecteur_vecteurs_fermer(lecteur);
+    free(entrees);
+    free(sorties);
+
+
+    return nb_simules;
+}
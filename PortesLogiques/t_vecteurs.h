@@ -0,0 +1,144 @@
+/*
+Module: T_VECTEURS
+Description: Lecture et écriture de fichiers de vecteurs par blocs, pour simuler des millions de
+			 vecteurs d'un fichier à l'autre (voir t_vecteurs_simuler_fichiers).
+
+			 Formats pris en charge:
+			 - Texte: un vecteur par ligne, la valeur de chaque signal ('0' ou '1', dans l'ordre
+			   des signaux; les espaces, les lignes vides et les commentaires '#' sont ignorés).
+			   C'est le format de t_circuit_simuler_sequence.
+			 - Binaire compact: un en-tête (signature VECTEURS_BINAIRE_MAGIQUE, nombre de signaux
+			   sur 32 bits, nombre de vecteurs sur 64 bits), puis les vecteurs par paquets de 64:
+			   un mot de 64 bits par signal, dont le bit k est la valeur du signal pour le vecteur
+			   k du paquet (les bits après le dernier vecteur valent 0). Les entiers sont dans
+			   l'ordre des octets de la machine. Le fichier est projeté en mémoire (mmap) à la
+			   lecture: les paquets sont déjà dans la disposition des mots du simulateur.
+
+			 Les blocs échangés avec le simulateur ont la disposition de t_circuit_simuler_lot: le
+			 mot m du signal i est bloc[i * nb_mots + m], son bit k est la valeur du signal pour le
+			 vecteur 64 * m + k du bloc.
+
+			 Double tampon: un lecteur ou un écrivain asynchrone a son propre fil d'exécution et deux
+			 tampons de bloc. Pendant que le simulateur traite un bloc, le fil du lecteur décode le
+			 bloc suivant du fichier et le fil de l'écrivain met en forme et écrit le bloc
+			 précédent: les accès au disque se font en même temps que la simulation.
+*/
+
+#ifndef T_VECTEURS_H_
+#define T_VECTEURS_H_
+
+#include <stdint.h>
+#include "t_circuit.h"
+#include "t_circuit_io.h"
+
+#define VECTEURS_BINAIRE_MAGIQUE 0x31564C50 //Signature des fichiers binaires de vecteurs ("PLV1")
+#define VECTEURS_MOTS_BLOC 64 //Nombre de mots (de 64 vecteurs) d'un bloc de t_vecteurs_simuler_fichiers
+
+typedef struct t_circuit t_circuit;
+
+//Formats des fichiers de vecteurs
+enum e_format_vecteurs { VECTEURS_TEXTE, VECTEURS_BINAIRE };
+typedef enum e_format_vecteurs e_format_vecteurs;
+
+typedef struct t_lecteur_vecteurs t_lecteur_vecteurs;
+typedef struct t_ecrivain_vecteurs t_ecrivain_vecteurs;
+
+/*
+Fonction: T_LECTEUR_VECTEURS_OUVRIR
+Description: Ouvre un fichier de vecteurs en lecture. Le format est reconnu à la signature du
+			 fichier binaire; tout autre fichier est lu comme un fichier texte.
+Paramètres:
+- nom_fichier: Chemin du fichier à lire.
+- nb_signaux: Nombre de signaux de chaque vecteur (un fichier binaire doit avoir le même).
+- nb_mots: Nombre de mots (de 64 vecteurs) des blocs rendus par t_lecteur_vecteurs_lire.
+- asynchrone: Booléen: vrai pour décoder les blocs dans un fil séparé (double tampon), faux pour
+			  les décoder dans le fil appelant, à chaque lecture.
+Retour: Pointeur vers le lecteur, NULL si le fichier ne peut pas être ouvert, si son en-tête est
+		invalide (un message est affiché) ou si la mémoire manque.
+*/
+t_lecteur_vecteurs *t_lecteur_vecteurs_ouvrir(const char *nom_fichier, int nb_signaux, int nb_mots, int asynchrone);
+
+/*
+Fonction: T_LECTEUR_VECTEURS_LIRE
+Description: Lit le bloc suivant du fichier: jusqu'à 64 * nb_mots vecteurs. Seul le dernier bloc
+			 d'un fichier peut être incomplet; ses bits après le dernier vecteur valent 0.
+Paramètres:
+- lecteur: Le lecteur.
+- bloc: Tableau (nb_signaux * nb_mots mots) qui reçoit le bloc.
+Retour: Nombre de vecteurs du bloc, 0 à la fin du fichier, -1 si une ligne est invalide (un
+		message est affiché) ou si le fichier binaire est tronqué.
+*/
+int t_lecteur_vecteurs_lire(t_lecteur_vecteurs *lecteur, uint64_t bloc[]);
+
+/*
+Fonction: T_LECTEUR_VECTEURS_FERMER
+Description: Arrête le fil du lecteur, ferme le fichier et libère le lecteur. Le fichier n'a pas
+			 à avoir été lu jusqu'au bout.
+Paramètres:
+- lecteur: Le lecteur (NULL: aucun effet).
+Retour: Aucun.
+*/
+void t_lecteur_vecteurs_fermer(t_lecteur_vecteurs *lecteur);
+
+/*
+Fonction: T_ECRIVAIN_VECTEURS_OUVRIR
+Description: Crée un fichier de vecteurs.
+Paramètres:
+- nom_fichier: Chemin du fichier à écrire.
+- format: Format du fichier.
+- nb_signaux: Nombre de signaux de chaque vecteur.
+- nb_mots: Nombre de mots (de 64 vecteurs) des blocs donnés à t_ecrivain_vecteurs_ecrire.
+- asynchrone: Booléen: vrai pour écrire les blocs dans un fil séparé (double tampon).
+Retour: Pointeur vers l'écrivain, NULL si le fichier ne peut pas être créé ou si la mémoire manque.
+*/
+t_ecrivain_vecteurs *t_ecrivain_vecteurs_ouvrir(const char *nom_fichier, e_format_vecteurs format, int nb_signaux,
+                                                int nb_mots, int asynchrone);
+
+/*
+Fonction: T_ECRIVAIN_VECTEURS_ECRIRE
+Description: Ajoute un bloc de vecteurs au fichier. Le bloc est copié: le tableau peut être
+			 réutilisé dès le retour de la fonction. Dans un fichier binaire, les vecteurs sont
+			 rangés par paquets de 64: seul le dernier bloc peut avoir un nombre de vecteurs qui
+			 n'est pas un multiple de 64.
+Paramètres:
+- ecrivain: L'écrivain.
+- bloc: Bloc à écrire (nb_signaux * nb_mots mots, disposition de t_circuit_simuler_lot).
+- nb_vecteurs: Nombre de vecteurs du bloc (1 à 64 * nb_mots).
+Retour: Booléen: Vrai si le bloc a été accepté, faux si le nombre de vecteurs est invalide ou si
+		une écriture précédente a échoué.
+*/
+int t_ecrivain_vecteurs_ecrire(t_ecrivain_vecteurs *ecrivain, const uint64_t bloc[], int nb_vecteurs);
+
+/*
+Fonction: T_ECRIVAIN_VECTEURS_FERMER
+Description: Écrit les blocs en attente, complète l'en-tête d'un fichier binaire (nombre de
+			 vecteurs), ferme le fichier et libère l'écrivain.
+Paramètres:
+- ecrivain: L'écrivain (NULL: aucun effet).
+Retour: Booléen: Vrai si tout le fichier a été écrit, faux si une écriture a échoué.
+*/
+int t_ecrivain_vecteurs_fermer(t_ecrivain_vecteurs *ecrivain);
+
+/*
+Fonction: T_VECTEURS_SIMULER_FICHIERS
+Description: Simule tous les vecteurs d'un fichier et écrit les sorties de chaque vecteur dans un
+			 autre fichier, par blocs de 64 * VECTEURS_MOTS_BLOC vecteurs simulés avec
+			 t_circuit_simuler_lot. Avec un lecteur et un écrivain asynchrones, la lecture du bloc
+			 suivant et l'écriture du bloc précédent se font pendant la simulation.
+
+			 Les vecteurs sont indépendants: les bascules d'un circuit séquentiel gardent leur
+			 état courant (voir t_circuit_simuler_sequence pour simuler une suite de cycles).
+Paramètres:
+- circuit: Pointeur vers le circuit à simuler.
+- fichier_entrees: Fichier des vecteurs d'entrée (texte ou binaire, nb_entrees signaux).
+- fichier_sorties: Fichier des sorties à créer (nb_sorties signaux).
+- format_sorties: Format du fichier des sorties.
+- asynchrone: Booléen: vrai pour lire et écrire dans des fils séparés (double tampon), faux pour
+			  tout faire dans le fil appelant (pour mesurer le gain du double tampon).
+Retour: Nombre de vecteurs simulés, -1 si un lien du circuit manque (voir t_circuit_est_simulable)
+		ou en cas d'erreur de lecture ou d'écriture.
+*/
+long long t_vecteurs_simuler_fichiers(t_circuit *circuit, const char *fichier_entrees, const char *fichier_sorties,
+                                      e_format_vecteurs format_sorties, int asynchrone);
+
+#endif